@@ -8,25 +8,34 @@
 #include "GameObject.h"
 
 // Standard library includes
+#include <algorithm>
 #include <memory>
 
 namespace DDM
 {
 	// Class forward declarations
 	class Transform;
+	class Component;
 
+	// Generational handle to a component, resolves to nullptr once the component is destroyed
+	using ComponentHandle = Handle<Component>;
+
+	// Base class of every component
+	// Components are looked up by type id, not by dynamic casts: a component that derives from another component than this one
+	// has to register that base with DDM_COMPONENT_SUPER(Type, Base) in its class body, or GetComponent<Base> won't find it
+	// Debug builds throw from AddComponent and GetComponent when a registration is missing
 	class Component
 	{
 	public:
 		/// <summary>
 		/// Default constructor
 		/// </summary>
-		Component() = default;
+		Component() : m_Handle{ GetHandleTable().Insert(this) } {}
 
 		/// <summary>
-		/// Default destructor
+		/// Destructor
 		/// </summary>
-		virtual ~Component() = default;
+		virtual ~Component() { GetHandleTable().Remove(m_Handle); }
 
 		// Rule of five
 		Component(const Component& other) = delete;
@@ -92,7 +101,14 @@ namespace DDM
 		/// <summary>
 		/// Destroy this component
 		/// </summary>
-		virtual void Destroy() { m_ShouldDestroy = true; }
+		virtual void Destroy()
+		{
+			m_ShouldDestroy = true;
+
+			// Let the owner know it has to remove this component at the end of the frame
+			if (m_pOwner != nullptr)
+				m_pOwner->OnComponentDestroyed();
+		}
 
 		/// <summary>
 		/// Checks if component should be destroyed
@@ -125,8 +141,8 @@ namespace DDM
 		/// <summary>
 		/// Get the transform component of the owning game object
 		/// </summary>
-		/// <returns>Pointer to the transform component</returns>
-		std::shared_ptr<Transform> GetTransform() { return m_pOwner->GetTransform(); }
+		/// <returns>Non owning pointer to the transform component, valid as long as the owner exists</returns>
+		Transform* GetTransform() const { return m_pOwner->GetTransform(); }
 
 		/// <summary>
 		/// Check if component is active
@@ -152,10 +168,25 @@ namespace DDM
 		/// <param name="showImGui: ">new active mode of ImGui rendering</param>
 		void SetShowImGui(bool showImGui) { m_ShowImGui = showImGui; }
 
+		/// <summary>
+		/// Get a handle to this component that can be stored instead of a shared pointer
+		/// </summary>
+		/// <returns>Handle to this component</returns>
+		ComponentHandle GetHandle() const { return m_Handle; }
+
+		/// <summary>
+		/// Resolve a component handle
+		/// </summary>
+		/// <typeparam name="T">Type of component</typeparam>
+		/// <param name="handle: ">The handle to resolve</param>
+		/// <returns>Pointer to the component, nullptr if it was destroyed or is not of type T</returns>
+		template <class T = Component>
+		static T* Resolve(ComponentHandle handle);
+
 	private:
 		// Friend class declarations
-		template <class T>
-		friend std::shared_ptr<T> GameObject::AddComponent();
+		friend class GameObject;
+		friend class ComponentScheduler;
 
 		// Indicates if component should be destroyed
 		bool m_ShouldDestroy{ false };
@@ -169,6 +200,31 @@ namespace DDM
 		// Pointer to the game object that owns this component
 		GameObject* m_pOwner{nullptr};
 
+		// Type ids this component can be looked up with
+		const std::vector<ComponentTypeId>* m_pTypeIds{ nullptr };
+
+		// Id of the registration in the component scheduler
+		uint32_t m_ScheduleId{ ComponentScheduler::kInvalidId };
+
+		// Phases this component overrides, used to schedule it again when its object moves to another scene
+		ComponentPhaseMask m_Phases{};
+
+		// Indicates Update and FixedUpdate of this component can run in parallel jobs
+		bool m_IsThreadSafe{ false };
+
+		// Handle to this component
+		ComponentHandle m_Handle{};
+
+		/// <summary>
+		/// Get the table all component handles are resolved with
+		/// </summary>
+		/// <returns>Reference to the handle table</returns>
+		static SlotTable<Component>& GetHandleTable()
+		{
+			static SlotTable<Component> handleTable{};
+			return handleTable;
+		}
+
 		/// <summary>
 		/// Set new owner of this object
 		/// </summary>
@@ -176,6 +232,64 @@ namespace DDM
 		void SetOwner(GameObject* pOwner) { m_pOwner = pOwner; }
 	};
 
+	template <class T>
+	constexpr ComponentPhaseMask GetComponentPhases()
+	{
+		// A phase is overridden if the member function pointer of T does not point to the one of Component
+		ComponentPhaseMask phases{};
+
+		if (!std::is_same_v<decltype(&T::EarlyUpdate), decltype(&Component::EarlyUpdate)>)
+			phases |= 1 << kPhase_EARLY_UPDATE;
+
+		if (!std::is_same_v<decltype(&T::Update), decltype(&Component::Update)>)
+			phases |= 1 << kPhase_UPDATE;
+
+		if (!std::is_same_v<decltype(&T::FixedUpdate), decltype(&Component::FixedUpdate)>)
+			phases |= 1 << kPhase_FIXED_UPDATE;
+
+		if (!std::is_same_v<decltype(&T::LateUpdate), decltype(&Component::LateUpdate)>)
+			phases |= 1 << kPhase_LATE_UPDATE;
+
+		if (!std::is_same_v<decltype(&T::RenderDepth), decltype(&Component::RenderDepth)>)
+			phases |= 1 << kPhase_RENDER_DEPTH;
+
+		if (!std::is_same_v<decltype(&T::Render), decltype(&Component::Render)>)
+			phases |= 1 << kPhase_RENDER;
+
+		if (!std::is_same_v<decltype(&T::RenderTransparancy), decltype(&Component::RenderTransparancy)>)
+			phases |= 1 << kPhase_RENDER_TRANSPARANCY;
+
+		return phases;
+	}
+
+	template <class T>
+	inline T* Component::Resolve(ComponentHandle handle)
+	{
+		// Check if T is derived from Component
+		if (!std::is_base_of<Component, T>())
+			return nullptr;
+
+		auto pComponent{ GetHandleTable().Get(handle) };
+
+		if constexpr (std::is_same_v<T, Component>)
+		{
+			return pComponent;
+		}
+		else
+		{
+			// Check the type ids of the component instead of using a dynamic cast
+			if (pComponent == nullptr || pComponent->m_pTypeIds == nullptr)
+				return nullptr;
+
+			const auto& typeIds{ *pComponent->m_pTypeIds };
+
+			if (std::find(typeIds.begin(), typeIds.end(), GetComponentTypeId<T>()) == typeIds.end())
+				return nullptr;
+
+			return static_cast<T*>(pComponent);
+		}
+	}
+
 	template <class T>
 	inline std::shared_ptr<T> Component::GetComponent() const
 	{
@@ -0,0 +1,208 @@
+// ComponentTypeId.h
+// This file provides a unique numeric id for every component type without using RTTI
+// Ids are small and dense so they can be used as indices into per-object lookup tables
+// They are handed out at runtime on first use, a compile time id would have to hash the type name,
+// which differs between compilers and gives large sparse ids that can't index a lookup table
+// Debug builds check that every component registers its base components, release builds only use the ids
+
+#ifndef _DDM_COMPONENT_TYPE_ID_
+#define _DDM_COMPONENT_TYPE_ID_
+
+// Standard library includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+// Register the direct base component of a component type, so looking up the base also finds this type
+// Has to be used inside the class body of every component that derives from another component than Component,
+// a component without it would inherit the registration of its base and skip that base in its lookup chain
+// Parameters:
+//     Type: the component type that is being declared
+//     Base: the component it directly derives from
+#define DDM_COMPONENT_SUPER(Type, Base) \
+	using Super = Base; \
+	using SuperDeclaringType = Type
+
+namespace DDM
+{
+	// Class forward declarations
+	class Component;
+
+	// Numeric id of a component type
+	using ComponentTypeId = uint32_t;
+
+	namespace ComponentTypeIdDetail
+	{
+		/// <summary>
+		/// Hand out the next free component type id
+		/// </summary>
+		/// <returns>New component type id</returns>
+		inline ComponentTypeId NextComponentTypeId()
+		{
+			static std::atomic<ComponentTypeId> counter{};
+			return counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+#ifndef NDEBUG
+		// Checks if a component is of the type an id belongs to
+		struct ComponentTypeCheck
+		{
+			bool (*pIsType)(const Component* pComponent){};
+			const char* pName{};
+		};
+
+		// Check of every component type that has an id, indexed by the id
+		struct ComponentTypeChecks
+		{
+			std::mutex Mutex{};
+			std::vector<ComponentTypeCheck> Checks{};
+		};
+
+		/// <summary>
+		/// Get the checks of all component types that have an id
+		/// </summary>
+		/// <returns>Reference to the checks</returns>
+		inline ComponentTypeChecks& GetComponentTypeChecks()
+		{
+			static ComponentTypeChecks checks{};
+			return checks;
+		}
+
+		/// <summary>
+		/// Store the check of component type T, so components deriving from T can be checked for a missing DDM_COMPONENT_SUPER
+		/// </summary>
+		/// <typeparam name="T">Type of component</typeparam>
+		/// <param name="id: ">Id of T</param>
+		template <class T>
+		void RegisterComponentTypeCheck(ComponentTypeId id)
+		{
+			// Every component derives from Component, it is never part of the lookup chain
+			if constexpr (std::is_base_of_v<Component, T> && !std::is_same_v<T, Component>)
+			{
+				auto& checks{ GetComponentTypeChecks() };
+
+				std::lock_guard lock{ checks.Mutex };
+
+				if (id >= checks.Checks.size())
+				{
+					checks.Checks.resize(id + 1);
+				}
+
+				checks.Checks[id] = ComponentTypeCheck{ [](const Component* pComponent) { return dynamic_cast<const T*>(pComponent) != nullptr; }, typeid(T).name() };
+			}
+		}
+
+		/// <summary>
+		/// Throw if a component derives from a component type that is missing from its lookup chain
+		/// </summary>
+		/// <param name="pComponent: ">The component</param>
+		/// <param name="pName: ">Name of the type of the component</param>
+		/// <param name="ids: ">Ids the component can be looked up with</param>
+		inline void CheckComponentTypeIds(const Component* pComponent, const char* pName, const std::vector<ComponentTypeId>& ids)
+		{
+			auto& checks{ GetComponentTypeChecks() };
+
+			std::lock_guard lock{ checks.Mutex };
+
+			for (ComponentTypeId id{}; id < checks.Checks.size(); ++id)
+			{
+				const auto& check{ checks.Checks[id] };
+
+				if (check.pIsType == nullptr || std::find(ids.begin(), ids.end(), id) != ids.end())
+					continue;
+
+				if (check.pIsType(pComponent))
+				{
+					throw std::runtime_error(std::string{ pName } + " derives from component " + check.pName
+						+ " without registering it with DDM_COMPONENT_SUPER, looking up the base would not find it");
+				}
+			}
+		}
+#endif
+
+		/// <summary>
+		/// Add the id of T and the ids of all its registered base components to a list
+		/// A component registers its base component with DDM_COMPONENT_SUPER
+		/// </summary>
+		/// <typeparam name="T">Type of component</typeparam>
+		/// <param name="ids: ">List to add the ids to</param>
+		template <class T>
+		void AppendComponentTypeIds(std::vector<ComponentTypeId>& ids);
+	}
+
+	/// <summary>
+	/// Get the unique id of component type T
+	/// </summary>
+	/// <typeparam name="T">Type of component</typeparam>
+	/// <returns>Id of the component type</returns>
+	template <class T>
+	ComponentTypeId GetComponentTypeId()
+	{
+		static const ComponentTypeId id{ []()
+			{
+				const ComponentTypeId newId{ ComponentTypeIdDetail::NextComponentTypeId() };
+
+#ifndef NDEBUG
+				ComponentTypeIdDetail::RegisterComponentTypeCheck<T>(newId);
+#endif
+
+				return newId;
+			}() };
+
+		return id;
+	}
+
+	/// <summary>
+	/// Get the ids a component of type T can be looked up with, its own id followed by those of its base components
+	/// </summary>
+	/// <typeparam name="T">Type of component</typeparam>
+	/// <returns>Reference to the list of ids</returns>
+	template <class T>
+	const std::vector<ComponentTypeId>& GetComponentTypeIds()
+	{
+		static const std::vector<ComponentTypeId> ids{ []()
+			{
+				std::vector<ComponentTypeId> result{};
+				ComponentTypeIdDetail::AppendComponentTypeIds<T>(result);
+				return result;
+			}() };
+
+		return ids;
+	}
+
+	template <class T>
+	void ComponentTypeIdDetail::AppendComponentTypeIds(std::vector<ComponentTypeId>& ids)
+	{
+		// Add the id of T itself
+		ids.push_back(GetComponentTypeId<T>());
+
+		// Add the ids of the base component if one is registered
+		if constexpr (requires { typename T::Super; })
+		{
+			using Super = typename T::Super;
+
+			static_assert(requires { typename T::SuperDeclaringType; },
+				"Register the base component with DDM_COMPONENT_SUPER instead of declaring Super directly");
+
+			// A registration inherited from a base component would skip that base in the lookup chain
+			static_assert(std::is_same_v<typename T::SuperDeclaringType, T>,
+				"Components deriving from a registered component have to register their own base with DDM_COMPONENT_SUPER");
+
+			static_assert(std::is_base_of_v<Super, T> && !std::is_same_v<Super, T>,
+				"The registered base of a component has to be one of its base classes");
+
+			if constexpr (!std::is_same_v<Super, Component>)
+			{
+				AppendComponentTypeIds<Super>(ids);
+			}
+		}
+	}
+}
+
+#endif // !_DDM_COMPONENT_TYPE_ID_
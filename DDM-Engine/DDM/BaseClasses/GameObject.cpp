@@ -5,10 +5,75 @@
 
 // File includes
 #include "Components/Transform.h"
+#include "Engine/Scene.h"
 #include "Includes/ImGuiIncludes.h"
+#include "Managers/TransformManager.h"
+
+namespace
+{
+	// Pool all game objects are allocated from
+	using GameObjectPool = DDM::SlabPool<sizeof(DDM::GameObject), alignof(DDM::GameObject)>;
+
+	/// <summary>
+	/// Get the table all game object handles are resolved with
+	/// </summary>
+	/// <returns>Reference to the handle table</returns>
+	DDM::SlotTable<DDM::GameObject>& GetHandleTable()
+	{
+		static DDM::SlotTable<DDM::GameObject> handleTable{};
+		return handleTable;
+	}
+}
+
+DDM::GameObject::GameObject(const std::string& name, const std::string& tag)
+	:m_Name{ name }, m_Tag{ tag },
+	m_NameId{ NameRegistry::GetInstance().Intern(name) },
+	m_TagId{ NameRegistry::GetInstance().Intern(tag) }
+{
+	m_Handle = GetHandleTable().Insert(this);
+}
+
+void* DDM::GameObject::operator new(size_t size)
+{
+	// Derived types can't exist since the class is final, so the size always matches the pool
+	(void)size;
+	return GameObjectPool::GetInstance().Allocate();
+}
+
+void DDM::GameObject::operator delete(void* pMemory)
+{
+	GameObjectPool::GetInstance().Deallocate(pMemory);
+}
+
+void DDM::GameObject::ReservePool(size_t count)
+{
+	GameObjectPool::GetInstance().Reserve(count);
+}
+
+DDM::GameObject* DDM::GameObject::Resolve(GameObjectHandle handle)
+{
+	return GetHandleTable().Get(handle);
+}
 
 DDM::GameObject::~GameObject()
 {
+	// Invalidate all handles to this object
+	GetHandleTable().Remove(m_Handle);
+
+	// Remove this object from the name and tag index of its scene
+	if (m_pScene != nullptr)
+	{
+		m_pScene->UnregisterGameObject(this);
+	}
+
+	// Remove all components from the scheduler
+	if (m_pScheduler != nullptr)
+	{
+		for (auto& pComponent : m_pComponents)
+		{
+			m_pScheduler->Unregister(pComponent.get());
+		}
+	}
 }
 
 DDM::GameObject* DDM::GameObject::CreateNewObject(const std::string& name, const std::string& tag)
@@ -16,14 +81,54 @@ DDM::GameObject* DDM::GameObject::CreateNewObject(const std::string& name, const
 	// Create new game object
 	auto pNewObject{ std::make_unique<GameObject>(name, tag) };
 
+	// Use the same scheduler as this object
+	pNewObject->m_pScheduler = m_pScheduler;
+
 	// Initialize the new object
 	pNewObject->Init();
 
 	// Set parent to this object
 	pNewObject->m_pParent = this;
 
-	// Add new object to list of children to add next frame and return pointer to it
-	return m_pChildrenToAdd.emplace_back(std::move(pNewObject)).get();
+	// Make the new object findable by name and tag in the scene of this object
+	if (m_pScene != nullptr)
+	{
+		m_pScene->RegisterGameObject(pNewObject.get());
+	}
+
+	// Inherit the active state of this object
+	pNewObject->UpdateActiveInHierarchy();
+
+	// Link the transform of the new object to the transform of this object
+	pNewObject->m_pTransform->OnParentChanged();
+
+	// Add new object to list of children to add next frame
+	pNewObject->m_IndexInParent = static_cast<uint32_t>(m_pChildrenToAdd.size());
+	pNewObject->m_IsChildToAdd = true;
+
+	auto pChild{ m_pChildrenToAdd.emplace_back(std::move(pNewObject)).get() };
+
+	// Let the scene know this object has children to add
+	if (m_pScene != nullptr)
+	{
+		m_pScene->MarkNewChildren(this);
+	}
+
+	return pChild;
+}
+
+void DDM::GameObject::ReserveChildren(size_t count)
+{
+	// Reserve the list of children to add and the list of children they will be moved to
+	m_pChildrenToAdd.reserve(m_pChildrenToAdd.size() + count);
+	m_pChildren.reserve(m_pChildren.size() + m_pChildrenToAdd.capacity());
+
+	// Reserve the game objects themselves
+	ReservePool(count);
+
+	// Reserve the transform storage
+	auto& transformManager{ TransformManager::GetInstance() };
+	transformManager.Reserve(transformManager.GetTransformCount() + count);
 }
 
 void DDM::GameObject::RemoveAllChildren()
@@ -57,21 +162,20 @@ void DDM::GameObject::SetParent(GameObject* pParent, bool worldPositionStays)
 
 	if (m_pParent != nullptr)
 	{
-		// Find this object in the list of children of the current parent
-		for (auto it = m_pParent->m_pChildren.begin(); it != m_pParent->m_pChildren.end(); ++it)
-		{
-			if (it->get() == this)
-			{
-				// Save the child and remove it from the list
-				child = std::move(*it);
-				m_pParent->m_pChildren.erase(it);
-				break;
-			}
-		}
+		// Take this object out of the list it is stored in by the current parent
+		auto& pSiblings{ m_IsChildToAdd ? m_pParent->m_pChildrenToAdd : m_pParent->m_pChildren };
+		child = SwapRemoveChild(pSiblings, m_IndexInParent);
 	}
 
 	// Set new parent
 	m_pParent = pParent;
+	m_IsChildToAdd = false;
+
+	// Link the transform to the transform of the new parent
+	m_pTransform->OnParentChanged();
+
+	// Inherit the active state of the new parent
+	UpdateActiveInHierarchy();
 
 	// If new parent is not null, add this object to the list of children of the new parent
 	if (m_pParent != nullptr)
@@ -81,7 +185,20 @@ void DDM::GameObject::SetParent(GameObject* pParent, bool worldPositionStays)
 			child = std::unique_ptr<GameObject>(this);
 		}
 
+		m_IndexInParent = static_cast<uint32_t>(m_pParent->m_pChildren.size());
 		m_pParent->m_pChildren.emplace_back(std::move(child));
+
+		// A parent in another scene takes this object and its children along
+		if (m_pParent->m_pScene != m_pScene || m_pParent->m_pScheduler != m_pScheduler)
+		{
+			MoveToScene(m_pParent->m_pScene, m_pParent->m_pScheduler);
+		}
+
+		// If this object is marked for destruction, the new parent has to remove it
+		if (m_ShouldDestroy)
+		{
+			NotifyParentOfDestruction();
+		}
 	}
 }
 
@@ -107,10 +224,7 @@ void DDM::GameObject::OnSceneLoad()
 
 void DDM::GameObject::OnSceneUnload()
 {
-	// Mark object for destruction
-	m_ShouldDestroy = true;
-
-
+	// The object stays alive, the scene can be loaded again, deleting the scene destroys it
 	// Propagate scene unload to components and children
 	for (auto& component : m_pComponents)
 	{
@@ -123,235 +237,272 @@ void DDM::GameObject::OnSceneUnload()
 	}
 }
 
-void DDM::GameObject::StartFrame()
+void DDM::GameObject::OnGUI()
 {
-	// Add children that were created last frame
-	for (size_t i{}; i < m_pChildrenToAdd.size(); ++i)
+	// If object should show ImGui, create a window with the name of the object
+	if (m_ShowImGui)
 	{
-		m_pChildren.push_back(std::move(m_pChildrenToAdd[i]));
-	}
-
-	// Clear the list of children to add
-	m_pChildrenToAdd.clear();
+		// Create a window
+		ImGui::Begin(m_Name.c_str(), &m_ShowGuiWindow);
 
-	// Start frame for all children
-	for (auto& pChild : m_pChildren)
-	{
-		pChild->StartFrame();
-	}
-}
+		// Create a button
+		if (ImGui::Button("Destroy object"))
+		{
+			// Call the function with the text input
+			Destroy();
+		}
 
-void DDM::GameObject::EarlyUpdate()
-{
-	// Early update for all components
-	for (auto& component : m_pComponents)
-	{
-		if (component->IsActive())
+		// Render ImGui for all components that want to show it
+		if (m_ShowGuiWindow)
 		{
-			component->EarlyUpdate();
+			for (auto& component : m_pComponents)
+			{
+				if (component->ShouldShowImGui())
+				{
+					component->OnGUI();
+				}
+			}
 		}
+
+		// End the window
+		ImGui::End();
 	}
 
-	// Early update for all active children
+	// Render ImGui for all active children
 	for (auto& pChild : m_pChildren)
 	{
 		if (pChild->m_IsActive)
 		{
-			pChild->EarlyUpdate();
+			pChild->OnGUI();
 		}
 	}
 }
 
-void DDM::GameObject::Update()
+void DDM::GameObject::SetActive(bool isActive)
 {
-	// Update for all active components
-	for (auto& component : m_pComponents)
+	// Set active mode
+	m_IsActive = isActive;
+
+	// Update the active state of this object and all children
+	UpdateActiveInHierarchy();
+}
+
+void DDM::GameObject::UpdateActiveInHierarchy()
+{
+	// Object is active in the hierarchy if it and its parent are active
+	m_IsActiveInHierarchy = m_IsActive && (m_pParent == nullptr || m_pParent->m_IsActiveInHierarchy);
+
+	// Propagate to all children, including the ones that are added next frame
+	for (auto& pChild : m_pChildren)
 	{
-		if (component->IsActive())
-		{
-			component->Update();
-		}
+		pChild->UpdateActiveInHierarchy();
 	}
 
-	// Update for all active children
-	for (auto& pChild : m_pChildren)
+	for (auto& pChild : m_pChildrenToAdd)
 	{
-		if (pChild->m_IsActive)
-		{
-			pChild->Update();
-		}
+		pChild->UpdateActiveInHierarchy();
 	}
 }
 
-void DDM::GameObject::FixedUpdate()
+void DDM::GameObject::Destroy()
 {
-	// Fixed update for all active components
-	for (auto& component : m_pComponents)
+	// If object is already marked for destruction, return
+	if (m_ShouldDestroy)
 	{
-		if (component->IsActive())
-		{
-			component->FixedUpdate();
-		}
+		return;
 	}
 
-	// Fixed update for all active children
-	for (auto& pChild : m_pChildren)
+	// Mark object for destruction
+	m_ShouldDestroy = true;
+
+	NotifyParentOfDestruction();
+}
+
+void DDM::GameObject::AddNewChildren()
+{
+	// Add children that were created since the last frame
+	for (auto& pChild : m_pChildrenToAdd)
 	{
-		if (pChild->m_IsActive)
-		{
-			pChild->FixedUpdate();
-		}
+		pChild->m_IndexInParent = static_cast<uint32_t>(m_pChildren.size());
+		pChild->m_IsChildToAdd = false;
+
+		m_pChildren.push_back(std::move(pChild));
 	}
+
+	// Clear the list of children to add
+	m_pChildrenToAdd.clear();
 }
 
-void DDM::GameObject::LateUpdate()
+void DDM::GameObject::RemoveDestroyed(std::vector<std::unique_ptr<GameObject>>& pDestroyedObjects)
 {
-	// Late update for all active components
-	for (auto& component : m_pComponents)
+	// Remove components that are marked for destruction
+	auto componentsEnd{ std::remove_if(m_pComponents.begin(), m_pComponents.end(), [](std::shared_ptr<Component>& pComponent)
+		{
+			return pComponent->ShouldDestroy();
+		}) };
+
+	// Only rebuild the component lookup if components were removed
+	if (componentsEnd != m_pComponents.end())
 	{
-		if (component->IsActive())
+		// Remove the destroyed components from the scheduler
+		if (m_pScheduler != nullptr)
 		{
-			component->LateUpdate();
+			for (auto it{ componentsEnd }; it != m_pComponents.end(); ++it)
+			{
+				m_pScheduler->Unregister(it->get());
+			}
 		}
+
+		m_pComponents.erase(componentsEnd, m_pComponents.end());
+		RebuildComponentLookup();
 	}
 
-	// Late update for all active children
-	for (auto& pChild : m_pChildren)
+	// Move children that are marked for destruction out of both child lists, keeping the order of the others
+	for (auto pList : { &m_pChildren, &m_pChildrenToAdd })
 	{
-		if (pChild->m_IsActive)
+		auto& pChildren{ *pList };
+		uint32_t keptCount{};
+
+		for (auto& pChild : pChildren)
 		{
-			pChild->LateUpdate();
+			if (pChild->ShouldDestroy())
+			{
+				pDestroyedObjects.push_back(std::move(pChild));
+				continue;
+			}
+
+			pChild->m_IndexInParent = keptCount;
+
+			if (&pChildren[keptCount] != &pChild)
+			{
+				pChildren[keptCount] = std::move(pChild);
+			}
+
+			++keptCount;
 		}
+
+		pChildren.resize(keptCount);
 	}
 }
 
-void DDM::GameObject::PostUpdate()
+void DDM::GameObject::NotifyParentOfDestruction()
 {
-	// Remove components and children that are marked for destruction
-	m_pComponents.erase(std::remove_if(m_pComponents.begin(), m_pComponents.end(), [](std::shared_ptr<Component>& pComponent)
-		{
-			return pComponent->ShouldDestroy();
-		}), m_pComponents.end());
-
-	m_pChildren.erase(std::remove_if(m_pChildren.begin(), m_pChildren.end(), [](std::unique_ptr<GameObject>& pChild)
-		{
-			return pChild->ShouldDestroy();
-		}), m_pChildren.end());
-
-
-	// Post update for all components
-	for (auto& pChild : m_pChildren)
+	// The parent removes this object at the end of the frame
+	if (m_pParent != nullptr && m_pScene != nullptr)
 	{
-		pChild->PostUpdate();
+		m_pScene->MarkDestroyed(m_pParent);
 	}
 }
 
-void DDM::GameObject::RenderDepth() const
+void DDM::GameObject::MoveToScene(Scene* pScene, ComponentScheduler* pScheduler)
 {
-	// Render depth for all active components
-	for (auto& component : m_pComponents)
+	// Leaving the old scene clears the structural change list entries, the new scene has to process them
+	const bool hasNewChildren{ m_NewChildrenListSlot != m_NotListed };
+	const bool hasDestroyed{ m_DestroyedListSlot != m_NotListed };
+
+	if (m_pScene != pScene)
 	{
-		if (component->IsActive())
+		if (m_pScene != nullptr)
 		{
-			component->RenderDepth();
+			m_pScene->UnregisterGameObject(this);
 		}
-	}
 
-	// Render depth for all active children
-	for (auto& pChild : m_pChildren)
-	{
-		if (pChild->m_IsActive)
+		if (pScene != nullptr)
 		{
-			pChild->RenderDepth();
+			pScene->RegisterGameObject(this);
+
+			if (hasNewChildren)
+			{
+				pScene->MarkNewChildren(this);
+			}
+
+			if (hasDestroyed)
+			{
+				pScene->MarkDestroyed(this);
+			}
 		}
 	}
-}
 
-void DDM::GameObject::Render() const
-{
-	// Render for all active components
-	for (auto& component : m_pComponents)
+	// Schedule the components with the scheduler of the new scene
+	if (m_pScheduler != pScheduler)
 	{
-		if (component->IsActive())
+		for (auto& pComponent : m_pComponents)
 		{
-			component->Render();
+			if (m_pScheduler != nullptr)
+			{
+				m_pScheduler->Unregister(pComponent.get());
+			}
+
+			if (pScheduler != nullptr)
+			{
+				pScheduler->Register(pComponent.get(), pComponent->m_Phases, pComponent->m_IsThreadSafe);
+			}
 		}
+
+		m_pScheduler = pScheduler;
 	}
 
-	// Render for all active children
 	for (auto& pChild : m_pChildren)
 	{
-		if (pChild->m_IsActive)
-		{
-			pChild->Render();
-		}
+		pChild->MoveToScene(pScene, pScheduler);
 	}
-}
 
-void DDM::GameObject::RenderTransparancy() const
-{
-	// Render transparancy for all active components
-	for (auto& component : m_pComponents)
+	for (auto& pChild : m_pChildrenToAdd)
 	{
-		if (component->IsActive())
-		{
-			component->RenderTransparancy();
-		}
+		pChild->MoveToScene(pScene, pScheduler);
 	}
+}
 
-	// Render transparancy for all active children
-	for (auto& pChild : m_pChildren)
+void DDM::GameObject::OnComponentDestroyed()
+{
+	// This object removes the component at the end of the frame
+	if (m_pScene != nullptr)
 	{
-		if (pChild->m_IsActive)
-		{
-			pChild->RenderTransparancy();
-		}
+		m_pScene->MarkDestroyed(this);
 	}
 }
 
-void DDM::GameObject::OnGUI()
+std::unique_ptr<DDM::GameObject> DDM::GameObject::SwapRemoveChild(std::vector<std::unique_ptr<GameObject>>& pChildren, uint32_t index)
 {
-	// If object should show ImGui, create a window with the name of the object
-	if (m_ShowImGui)
+	auto pChild{ std::move(pChildren[index]) };
+
+	// Move the last child into the empty spot
+	if (index + 1 != pChildren.size())
 	{
-		// Create a window
-		ImGui::Begin(m_Name.c_str(), &m_ShowGuiWindow);
+		pChildren[index] = std::move(pChildren.back());
+		pChildren[index]->m_IndexInParent = index;
+	}
 
-		// Create a button
-		if (ImGui::Button("Destroy object"))
-		{
-			// Call the function with the text input
-			Destroy();
-		}
+	pChildren.pop_back();
 
-		// Render ImGui for all components that want to show it
-		if (m_ShowGuiWindow)
+	return pChild;
+}
+
+void DDM::GameObject::RegisterComponentTypeIds(const std::vector<ComponentTypeId>& typeIds, uint16_t index)
+{
+	for (auto typeId : typeIds)
+	{
+		// Grow the lookup table if needed
+		if (typeId >= m_ComponentLookup.size())
 		{
-			for (auto& component : m_pComponents)
-			{
-				if (component->ShouldShowImGui())
-				{
-					component->OnGUI();
-				}
-			}
+			m_ComponentLookup.resize(typeId + 1, m_NoComponent);
 		}
 
-		// End the window
-		ImGui::End();
-	}
-
-	// Render ImGui for all active children
-	for (auto& pChild : m_pChildren)
-	{
-		if (pChild->m_IsActive)
+		// Keep the first component registered for a type, like the order of the component list
+		if (m_ComponentLookup[typeId] == m_NoComponent)
 		{
-			pChild->OnGUI();
+			m_ComponentLookup[typeId] = index;
 		}
 	}
 }
 
-void DDM::GameObject::Destroy()
+void DDM::GameObject::RebuildComponentLookup()
 {
-	// Mark object for destruction
-	m_ShouldDestroy = true;
+	// Clear the table and register all remaining components again
+	std::fill(m_ComponentLookup.begin(), m_ComponentLookup.end(), m_NoComponent);
+
+	for (size_t index{}; index < m_pComponents.size(); ++index)
+	{
+		RegisterComponentTypeIds(*m_pComponents[index]->m_pTypeIds, static_cast<uint16_t>(index));
+	}
 }
@@ -5,17 +5,34 @@
 #ifndef _DDM_GAMEOBJECT_
 #define _DDM_GAMEOBJECT_
 
+// File includes
+#include "ComponentTypeId.h"
+
+#include "Engine/ComponentScheduler.h"
+
+#include "Managers/NameRegistry.h"
+
+#include "Utils/PoolAllocator.h"
+#include "Utils/SlotTable.h"
+
 // Standard library includes
 #include <string>
 #include <memory>
+#include <stdexcept>
+#include <typeinfo>
 #include <vector>
 
 namespace DDM
 {
 	// Class forward declarations
 	class Component;
+	class GameObject;
+	class Scene;
 	class Transform;
 
+	// Generational handle to a game object, resolves to nullptr once the object is destroyed
+	using GameObjectHandle = Handle<GameObject>;
+
 	class GameObject final
 	{
 	public:
@@ -24,7 +41,7 @@ namespace DDM
 		/// </summary>
 		/// <param name="name: ">The name of the game object</param>
 		/// <param name="tag: ">The tag associated with the game object</param>
-		GameObject(const std::string& name = "UnNamed", const std::string& tag = "Default") : m_Name{name}, m_Tag{tag} {}
+		GameObject(const std::string& name = "UnNamed", const std::string& tag = "Default");
 		
 		/// <summary>
 		/// Destructor
@@ -38,6 +55,32 @@ namespace DDM
 		GameObject& operator=(const GameObject& other) = delete;
 		GameObject& operator=(GameObject&& other) = delete;
 
+		/// <summary>
+		/// Allocate a game object from the game object pool
+		/// </summary>
+		/// <param name="size: ">Size of the object</param>
+		/// <returns>Pointer to the memory</returns>
+		static void* operator new(size_t size);
+
+		/// <summary>
+		/// Return a game object to the game object pool
+		/// </summary>
+		/// <param name="pMemory: ">Pointer to the memory</param>
+		static void operator delete(void* pMemory);
+
+		/// <summary>
+		/// Reserve memory for a number of game objects, used when the amount of objects to create is known up front
+		/// </summary>
+		/// <param name="count: ">Amount of game objects</param>
+		static void ReservePool(size_t count);
+
+		/// <summary>
+		/// Resolve a game object handle
+		/// </summary>
+		/// <param name="handle: ">The handle to resolve</param>
+		/// <returns>Pointer to the game object, nullptr if it was destroyed</returns>
+		static GameObject* Resolve(GameObjectHandle handle);
+
 		/// <summary>
 		/// Create a new child game object
 		/// </summary>
@@ -46,6 +89,13 @@ namespace DDM
 		/// <returns>Pointer to the new gameobject</returns>
 		GameObject* CreateNewObject(const std::string& name = "UnNamed", const std::string& tag = "Default");
 		
+		/// <summary>
+		/// Reserve memory for a number of children that are about to be created
+		/// Reserves the child list, the game object pool and the transform storage
+		/// </summary>
+		/// <param name="count: ">Amount of children that will be created</param>
+		void ReserveChildren(size_t count);
+
 		/// <summary>
 		/// Remove all child objects
 		/// </summary>
@@ -69,60 +119,15 @@ namespace DDM
 		void OnSceneLoad();
 
 		/// <summary>
-		/// Gets called when scene is unloaded
+		/// Gets called when scene is unloaded, the object is kept so the scene can be loaded again
 		/// </summary>
 		void OnSceneUnload();
 
-		/// <summary>
-		/// Gets called at the beginning of the frame, used to initialize children
-		/// </summary>
-		void StartFrame();
-
-		/// <summary>
-		/// Gets called at the start of the update loop
-		/// </summary>
-		void EarlyUpdate();
-
-		/// <summary>
-		/// Main update function
-		/// </summary>
-		void Update();
-
-		/// <summary>
-		/// Physics update function
-		/// </summary>
-		void FixedUpdate();
-
-		/// <summary>
-		/// Gets called at the end of the update loop
-		/// </summary>
-		void LateUpdate();
-
-		/// <summary>
-		/// Renders the depth prepass
-		/// </summary>
-		void RenderDepth() const;
-
-		/// <summary>
-		/// Main render fucntion
-		/// </summary>
-		void Render() const;
-
-		/// <summary>
-		/// Render transparancy pass
-		/// </summary>
-		void RenderTransparancy() const;
-
 		/// <summary>
 		/// Renders the ImGui elements
 		/// </summary>
 		void OnGUI();
 
-		/// <summary>
-		/// Gets called at the end of the update loop, used to delete components and children marked for destruction
-		/// </summary>
-		void PostUpdate();
-
 		/// <summary>
 		/// Destroy this game object and it's attached components and children
 		/// </summary>
@@ -188,7 +193,13 @@ namespace DDM
 		/// Set active mode of this object
 		/// </summary>
 		/// <param name="isActive: ">new active mode</param>
-		void SetActive(bool isActive) { m_IsActive = isActive; }
+		void SetActive(bool isActive);
+
+		/// <summary>
+		/// Check if this object and all of its parents are active
+		/// </summary>
+		/// <returns>Boolean indicating if object is active in the hierarchy</returns>
+		bool IsActiveInHierarchy() const { return m_IsActiveInHierarchy; }
 
 		/// <summary>
 		/// Check if object should render its ImGui elements
@@ -205,8 +216,8 @@ namespace DDM
 		/// <summary>
 		/// Get the transform component
 		/// </summary>
-		/// <returns>Pointer to the transform component</returns>
-		std::shared_ptr<Transform> GetTransform() { return m_pTransform; }
+		/// <returns>Non owning pointer to the transform component, valid as long as this object exists</returns>
+		Transform* GetTransform() const { return m_pTransform.get(); }
 
 		/// <summary>
 		/// Get the name of this object
@@ -220,16 +231,68 @@ namespace DDM
 		/// <returns>Reference to tag of this object</returns>
 		const std::string& GetTag() const { return m_Tag; }
 
+		/// <summary>
+		/// Get the interned id of the name of this object
+		/// </summary>
+		/// <returns>Id of the name</returns>
+		NameId GetNameId() const { return m_NameId; }
+
+		/// <summary>
+		/// Get the interned id of the tag of this object
+		/// </summary>
+		/// <returns>Id of the tag</returns>
+		NameId GetTagId() const { return m_TagId; }
+
+		/// <summary>
+		/// Get a handle to this object that can be stored instead of a raw pointer
+		/// </summary>
+		/// <returns>Handle to this object</returns>
+		GameObjectHandle GetHandle() const { return m_Handle; }
+
+		/// <summary>
+		/// Get the scene this object belongs to
+		/// </summary>
+		/// <returns>Pointer to the scene, nullptr if the object is not part of a scene</returns>
+		Scene* GetScene() const { return m_pScene; }
+
 	private:
+		// The scene sets the scheduler of its root object and applies structural changes
+		friend class Scene;
+
+		// Components notify their owner when they are destroyed
+		friend class Component;
+
+		// Value for list slots indicating the object is not in the list
+		static constexpr uint32_t m_NotListed{ 0xFFFFFFFF };
+
 		// Name of this object
 		const std::string m_Name;
 		
 		// Tag of this object
 		const std::string m_Tag;
 
+		// Interned id of the name
+		const NameId m_NameId;
+
+		// Interned id of the tag
+		const NameId m_TagId;
+
+		// Handle to this object
+		GameObjectHandle m_Handle{};
+
+		// Scene this object is indexed in, nullptr if it is not part of a scene
+		Scene* m_pScene{};
+
+		// Position of this object in the name and tag index of its scene
+		uint32_t m_NameIndexSlot{};
+		uint32_t m_TagIndexSlot{};
+
 		// Indicates wether this object is active or not
 		bool m_IsActive{ true };
 
+		// Indicates wether this object and all of its parents are active
+		bool m_IsActiveInHierarchy{ true };
+
 		// Indicates if object should render its ImGui elements
 		bool m_ShowImGui{ false };
 
@@ -248,11 +311,105 @@ namespace DDM
 		/// List of children to add next frame
 		std::vector<std::unique_ptr<GameObject>> m_pChildrenToAdd{};
 
+		// Index of this object in the list of children or children to add of its parent
+		uint32_t m_IndexInParent{};
+
+		// Indicates this object is still in the list of children to add of its parent
+		bool m_IsChildToAdd{ false };
+
+		// Position of this object in the structural change lists of its scene
+		uint32_t m_NewChildrenListSlot{ m_NotListed };
+		uint32_t m_DestroyedListSlot{ m_NotListed };
+
 		// Pointer to transform component
 		std::shared_ptr<Transform> m_pTransform{};
 
 		// List of components attached to this object
 		std::vector<std::shared_ptr<Component>> m_pComponents{};
+
+		// Scheduler the components of this object are registered to, nullptr if they are not updated
+		ComponentScheduler* m_pScheduler{};
+
+		// Value in the component lookup table indicating there is no component of that type
+		static constexpr uint16_t m_NoComponent{ 0xFFFF };
+
+		// Index into the list of components for every component type id
+		std::vector<uint16_t> m_ComponentLookup{};
+
+		/// <summary>
+		/// Get the index of the component with a given type id
+		/// </summary>
+		/// <param name="typeId: ">Id of the component type</param>
+		/// <returns>Index into the list of components, m_NoComponent if not found</returns>
+		uint16_t FindComponentIndex(ComponentTypeId typeId) const
+		{
+			return typeId < m_ComponentLookup.size() ? m_ComponentLookup[typeId] : m_NoComponent;
+		}
+
+		/// <summary>
+		/// Add the type ids of a component to the lookup table
+		/// </summary>
+		/// <param name="typeIds: ">List of type ids the component can be found with</param>
+		/// <param name="index: ">Index of the component in the list of components</param>
+		void RegisterComponentTypeIds(const std::vector<ComponentTypeId>& typeIds, uint16_t index);
+
+		/// <summary>
+		/// Rebuild the component lookup table after components were removed
+		/// </summary>
+		void RebuildComponentLookup();
+
+#ifndef NDEBUG
+		/// <summary>
+		/// Throw if a component derives from T without registering it, called when looking up T found nothing
+		/// </summary>
+		/// <typeparam name="T">Type of component</typeparam>
+		template <class T>
+		void CheckMissingComponent() const;
+#endif
+
+		/// <summary>
+		/// Recalculate if this object is active in the hierarchy and propagate it to all children
+		/// </summary>
+		void UpdateActiveInHierarchy();
+
+		/// <summary>
+		/// Move the children that were created since the last frame to the list of children
+		/// Only called by the scene for objects that have new children
+		/// </summary>
+		void AddNewChildren();
+
+		/// <summary>
+		/// Remove components and children marked for destruction
+		/// Only called by the scene for objects that had something destroyed
+		/// </summary>
+		/// <param name="pDestroyedObjects: ">List the removed children are moved to, so they can be destroyed in one batch</param>
+		void RemoveDestroyed(std::vector<std::unique_ptr<GameObject>>& pDestroyedObjects);
+
+		/// <summary>
+		/// Let the parent know this object has to be removed at the end of the frame
+		/// </summary>
+		void NotifyParentOfDestruction();
+
+		/// <summary>
+		/// Move this object and all of its children to another scene
+		/// The objects are indexed by the new scene and their components are scheduled by the new scheduler
+		/// </summary>
+		/// <param name="pScene: ">The new scene, can be nullptr</param>
+		/// <param name="pScheduler: ">Scheduler of the new scene, can be nullptr</param>
+		void MoveToScene(Scene* pScene, ComponentScheduler* pScheduler);
+
+		/// <summary>
+		/// Gets called when a component of this object is destroyed
+		/// </summary>
+		void OnComponentDestroyed();
+
+		/// <summary>
+		/// Remove a child from a list of children by moving the last child into its place
+		/// </summary>
+		/// <param name="pChildren: ">The list to remove the child from</param>
+		/// <param name="index: ">Index of the child in the list</param>
+		/// <returns>The removed child</returns>
+		static std::unique_ptr<GameObject> SwapRemoveChild(std::vector<std::unique_ptr<GameObject>>& pChildren, uint32_t index);
 	};
 
 	template<class T>
@@ -264,18 +421,23 @@ namespace DDM
 			return nullptr;
 		}
 
-		// Loop through all components and try to cast them to T
-		for (const auto& pComponent : m_pComponents)
+		// Look up the index of the component of type T
+		const uint16_t index{ FindComponentIndex(GetComponentTypeId<T>()) };
+
+		// If no component of type T is found, return nullptr
+		if (index == m_NoComponent)
 		{
-			// If component of type T is found, return it
-			if (auto pCastedComponent{ std::dynamic_pointer_cast<T>(pComponent) })
-			{
-				return pCastedComponent;
-			}
+#ifndef NDEBUG
+			CheckMissingComponent<T>();
+#endif
+
+			return nullptr;
 		}
-		
-		// If no component of type T is found, return nullptr
-		return nullptr;
+
+		// The returned copy shares ownership, hot paths should cache the component instead of looking it up every frame
+
+		// The lookup table guarantees the component is of type T
+		return std::static_pointer_cast<T>(m_pComponents[index]);
 	}
 
 	template<class T>
@@ -286,20 +448,38 @@ namespace DDM
 			return nullptr;
 	
 		// Check if component of type T already exists
-		if (HasComponent<T>())
+		if (auto pExisting{ GetComponent<T>() })
 		{
-			return GetComponent<T>();
+			return pExisting;
 		}
 
-		// Create new component of type T
-		auto pComponent = std::make_shared<T>();
+		// Create new component of type T, the component and its control block share one block of the pool for T
+		auto pComponent = std::allocate_shared<T>(PoolAllocator<T>{});
 
 		// Set owner to new component
 		pComponent->SetOwner(this);
 
+		// Register the type ids of the new component
+		pComponent->m_pTypeIds = &GetComponentTypeIds<T>();
+
+#ifndef NDEBUG
+		// A base component without DDM_COMPONENT_SUPER would silently be skipped by GetComponent of that base
+		ComponentTypeIdDetail::CheckComponentTypeIds(pComponent.get(), typeid(T).name(), *pComponent->m_pTypeIds);
+#endif
+		RegisterComponentTypeIds(*pComponent->m_pTypeIds, static_cast<uint16_t>(m_pComponents.size()));
+
 		// Add component to list
 		m_pComponents.push_back(pComponent);
 
+		// Schedule the component in the phases it overrides
+		pComponent->m_Phases = GetComponentPhases<T>();
+		pComponent->m_IsThreadSafe = IsThreadSafeComponent<T>();
+
+		if (m_pScheduler != nullptr)
+		{
+			m_pScheduler->Register(pComponent.get(), pComponent->m_Phases, pComponent->m_IsThreadSafe);
+		}
+
 		// Call init function on component
 		pComponent->Init();
 
@@ -336,19 +516,35 @@ namespace DDM
 		if (!std::is_base_of<Component, T>())
 			return false;
 
-		// Loop through all components and try to cast them to T
-		for (const auto& pComponent : m_pComponents)
+		// Check the lookup table for a component of type T
+		if (FindComponentIndex(GetComponentTypeId<T>()) != m_NoComponent)
+			return true;
+
+#ifndef NDEBUG
+		CheckMissingComponent<T>();
+#endif
+
+		return false;
+	}
+
+#ifndef NDEBUG
+	template<class T>
+	inline void GameObject::CheckMissingComponent() const
+	{
+		if constexpr (std::is_base_of_v<Component, T>)
 		{
-			// If component of type T is found, return true
-			if (std::dynamic_pointer_cast<T>(pComponent))
+			// A component of a type that derives from T without registering it was added before T had an id, so AddComponent couldn't catch it
+			for (const auto& pComponent : m_pComponents)
 			{
-				return true;
+				if (dynamic_cast<const T*>(pComponent.get()) != nullptr)
+				{
+					throw std::runtime_error(std::string{ "A component derives from " } + typeid(T).name()
+						+ " without registering it with DDM_COMPONENT_SUPER, looking it up does not find it");
+				}
 			}
 		}
-
-		// If no component of type T is found, return false
-		return false;
 	}
+#endif
 
 }
 
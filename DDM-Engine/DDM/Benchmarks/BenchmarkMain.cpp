@@ -0,0 +1,33 @@
+// BenchmarkMain.cpp
+// Entry point of the cpu microbenchmarks, runs without initializing vulkan
+// Usage: DDM-Benchmarks [--filter name] [--output file.json] [--label commit] [--baseline file.json] [--threshold percent]
+//                       [--samples count] [--min-time milliseconds]
+// Returns a failure when a benchmark got slower than the baseline allows
+
+// File includes
+#include "MicroBenchmark.h"
+#include "CoreBenchmarks.h"
+
+// Standard library includes
+#include <cstdlib>
+
+int main(int argc, char* argv[])
+{
+	DDM::MicroBenchmarkSettings settings{};
+
+	if (!DDM::MicroBenchmark::ParseArguments(argc, argv, settings))
+	{
+		return EXIT_FAILURE;
+	}
+
+	DDM::MicroBenchmark benchmark{ settings };
+
+	DDM::CoreBenchmarks::Register(benchmark);
+
+	benchmark.Run();
+
+	const bool isWritten{ benchmark.WriteJson() };
+	const bool passed{ benchmark.CompareToBaseline() };
+
+	return isWritten && passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
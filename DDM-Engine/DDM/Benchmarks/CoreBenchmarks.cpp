@@ -0,0 +1,455 @@
+// CoreBenchmarks.cpp
+
+// Header include
+#include "CoreBenchmarks.h"
+
+// File includes
+#include "MicroBenchmark.h"
+
+#include "BaseClasses/Component.h"
+#include "BaseClasses/GameObject.h"
+
+#include "Components/Transform.h"
+
+#include "Engine/DDMModelLoader.h"
+#include "Engine/Scene.h"
+
+#include "Managers/ConfigManager.h"
+#include "Managers/SceneManager.h"
+#include "Managers/TransformManager.h"
+#include "Managers/Input/KeyboardImpl.h"
+
+// Standard library includes
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Amounts of objects the scaling benchmarks run at
+	constexpr std::array<size_t, 3> kSizes{ 1'000, 10'000, 100'000 };
+
+	// Amounts of objects the scene benchmarks run at, 50'000 is the size of a large scene
+	// Build with DDM_DISABLE_POOLS and compare against a pooled baseline to see what the slab pools save
+	constexpr std::array<size_t, 4> kSceneSizes{ 1'000, 10'000, 50'000, 100'000 };
+
+	// Amount of objects in every chain of the transform hierarchy benchmarks
+	constexpr size_t kHierarchyDepth{ 64 };
+
+	// Components that do nothing, only used to fill up game objects
+	class BenchmarkComponentA final : public DDM::Component {};
+	class BenchmarkComponentB final : public DDM::Component {};
+	class BenchmarkComponentC final : public DDM::Component {};
+
+	// Game objects outside of a scene, destroyed together with the root
+	struct ObjectState
+	{
+		std::unique_ptr<DDM::GameObject> pRoot{};
+
+		// The first object of every chain
+		std::vector<DDM::Transform*> pChainRoots{};
+
+		// The last object of every chain
+		std::vector<DDM::Transform*> pLeaves{};
+
+		// Every object created under the root
+		std::vector<DDM::GameObject*> pObjects{};
+	};
+
+	// Create a root game object outside of any scene
+	std::unique_ptr<DDM::GameObject> CreateRoot()
+	{
+		auto pRoot{ std::make_unique<DDM::GameObject>("Benchmark Root") };
+		pRoot->Init();
+
+		return pRoot;
+	}
+
+	// Create chains of game objects that are each kHierarchyDepth objects deep
+	// Parameters:
+	//     size: the total amount of objects
+	std::shared_ptr<ObjectState> CreateHierarchy(size_t size)
+	{
+		auto pState{ std::make_shared<ObjectState>() };
+		pState->pRoot = CreateRoot();
+
+		DDM::TransformManager::GetInstance().Reserve(size + 1);
+
+		for (size_t chain{}; chain < size / kHierarchyDepth; ++chain)
+		{
+			auto pObject{ pState->pRoot->CreateNewObject("Chain") };
+			pState->pChainRoots.push_back(pObject->GetTransform());
+
+			for (size_t depth{ 1 }; depth < kHierarchyDepth; ++depth)
+			{
+				pObject = pObject->CreateNewObject("Link");
+				pObject->GetTransform()->SetLocalPosition(glm::vec3{ 0.0f, 1.0f, 0.0f });
+			}
+
+			pState->pLeaves.push_back(pObject->GetTransform());
+		}
+
+		// Start from a clean state so the first query doesn't pay for building the hierarchy
+		DDM::TransformManager::GetInstance().UpdateWorldTransforms();
+
+		return pState;
+	}
+
+	// Create game objects with three components each
+	// Parameters:
+	//     size: the amount of objects
+	std::shared_ptr<ObjectState> CreateComponentObjects(size_t size)
+	{
+		auto pState{ std::make_shared<ObjectState>() };
+		pState->pRoot = CreateRoot();
+		pState->pObjects.reserve(size);
+
+		DDM::GameObject::ReservePool(size + 1);
+		DDM::TransformManager::GetInstance().Reserve(size + 1);
+
+		for (size_t index{}; index < size; ++index)
+		{
+			auto pObject{ pState->pRoot->CreateNewObject("Object") };
+			pObject->AddComponent<BenchmarkComponentA>();
+			pObject->AddComponent<BenchmarkComponentB>();
+			pObject->AddComponent<BenchmarkComponentC>();
+
+			pState->pObjects.push_back(pObject);
+		}
+
+		return pState;
+	}
+
+	// The lookup GetComponent used before components got type ids, tries to cast every component in order
+	// Parameters:
+	//     pComponents: the components of a game object
+	template<class T>
+	std::shared_ptr<T> FindComponentByCast(const std::vector<std::shared_ptr<DDM::Component>>& pComponents)
+	{
+		for (const auto& pComponent : pComponents)
+		{
+			if (auto pCast{ std::dynamic_pointer_cast<T>(pComponent) })
+				return pCast;
+		}
+
+		return nullptr;
+	}
+
+	void RegisterTransformBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		for (const size_t size : kSizes)
+		{
+			// Read the world position of the end of every chain while nothing moved
+			benchmark.Add("Transform/WorldPositionClean", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pState{ CreateHierarchy(size) };
+
+					return [pState](uint64_t iterations)
+						{
+							float total{};
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								for (auto pLeaf : pState->pLeaves)
+								{
+									total += pLeaf->GetWorldPosition().y;
+								}
+							}
+
+							DDM::KeepResult(total);
+						};
+				});
+
+			// Move the first object of every chain and read the world position of the end of every chain
+			benchmark.Add("Transform/WorldPositionDirtyRoots", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pState{ CreateHierarchy(size) };
+
+					return [pState](uint64_t iterations)
+						{
+							float total{};
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								const glm::vec3 offset{ static_cast<float>(iteration % 16), 0.0f, 0.0f };
+
+								for (auto pChainRoot : pState->pChainRoots)
+								{
+									pChainRoot->SetLocalPosition(offset);
+								}
+
+								for (auto pLeaf : pState->pLeaves)
+								{
+									total += pLeaf->GetWorldPosition().x;
+								}
+							}
+
+							DDM::KeepResult(total);
+						};
+				});
+
+			// Move the first object of a single chain and read the world matrix of the end of that chain
+			benchmark.Add("Transform/WorldMatrixDirtyChain", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pState{ CreateHierarchy(size) };
+
+					if (pState->pChainRoots.empty())
+						return {};
+
+					return [pState](uint64_t iterations)
+						{
+							float total{};
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								pState->pChainRoots.front()->SetLocalPosition(glm::vec3{ static_cast<float>(iteration % 16), 0.0f, 0.0f });
+
+								total += pState->pLeaves.front()->GetWorldMatrix()[3][0];
+							}
+
+							DDM::KeepResult(total);
+						};
+				});
+		}
+	}
+
+	void RegisterComponentBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		for (const size_t size : kSizes)
+		{
+			// Look up the last added component of every object through the type id table
+			benchmark.Add("GameObject/GetComponent", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pState{ CreateComponentObjects(size) };
+
+					return [pState](uint64_t iterations)
+						{
+							uint64_t found{};
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								for (auto pObject : pState->pObjects)
+								{
+									found += pObject->GetComponent<BenchmarkComponentC>() != nullptr;
+								}
+							}
+
+							DDM::KeepResult(found);
+						};
+				});
+
+			// The same lookups with the dynamic cast over the component list GetComponent used to do
+			benchmark.Add("GameObject/GetComponentByCast", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pState{ CreateComponentObjects(size) };
+
+					// The component lists of the objects in the order they were added
+					auto pComponentLists{ std::make_shared<std::vector<std::vector<std::shared_ptr<DDM::Component>>>>() };
+					pComponentLists->reserve(pState->pObjects.size());
+
+					for (auto pObject : pState->pObjects)
+					{
+						pComponentLists->push_back({ pObject->GetComponent<DDM::Transform>(), pObject->GetComponent<BenchmarkComponentA>(),
+							pObject->GetComponent<BenchmarkComponentB>(), pObject->GetComponent<BenchmarkComponentC>() });
+					}
+
+					return [pState, pComponentLists](uint64_t iterations)
+						{
+							uint64_t found{};
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								for (const auto& pComponents : *pComponentLists)
+								{
+									found += FindComponentByCast<BenchmarkComponentC>(pComponents) != nullptr;
+								}
+							}
+
+							DDM::KeepResult(found);
+						};
+				});
+		}
+	}
+
+	void RegisterSceneBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		for (const size_t size : kSceneSizes)
+		{
+			// Create a scene with a flat list of objects and destroy it again
+			benchmark.Add("Scene/CreateDestroy", size, [size]() -> DDM::BenchmarkBody
+				{
+					return [size](uint64_t iterations)
+						{
+							auto& sceneManager{ DDM::SceneManager::GetInstance() };
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								auto pScene{ sceneManager.CreateScene("Benchmark Scene", false) };
+								pScene->ReserveGameObjects(size);
+
+								for (size_t index{}; index < size; ++index)
+								{
+									pScene->CreateGameObject("Object");
+								}
+
+								sceneManager.DeleteScene("Benchmark Scene");
+
+								// Destroys the scene and every object in it
+								pScene.reset();
+							}
+						};
+				});
+		}
+	}
+
+	void RegisterModelBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		for (const size_t size : kSizes)
+		{
+			// Convert the vertices of a loaded mesh to the vertex layout of the engine
+			benchmark.Add("DDMModelLoader/ConvertVertices", size, [size]() -> DDM::BenchmarkBody
+				{
+					auto pSource{ std::make_shared<std::vector<DDMML::Vertex>>(size) };
+
+					for (size_t index{}; index < size; ++index)
+					{
+						const float value{ static_cast<float>(index) };
+
+						auto& vertex{ (*pSource)[index] };
+						vertex.pos = glm::vec3{ value, value * 0.5f, -value };
+						vertex.normal = glm::vec3{ 0.0f, 1.0f, 0.0f };
+						vertex.color = glm::vec3{ 1.0f };
+						vertex.tangent = glm::vec3{ 1.0f, 0.0f, 0.0f };
+						vertex.texCoord = glm::vec2{ value / static_cast<float>(size), 0.5f };
+					}
+
+					// Reused, so only the first run allocates
+					auto pVertices{ std::make_shared<std::vector<DDM::Vertex>>() };
+
+					return [pSource, pVertices](uint64_t iterations)
+						{
+							auto& modelLoader{ DDM::DDMModelLoader::GetInstance() };
+
+							for (uint64_t iteration{}; iteration < iterations; ++iteration)
+							{
+								modelLoader.ConvertVertices(*pSource, *pVertices);
+							}
+
+							DDM::KeepResult(pVertices->data());
+						};
+				});
+		}
+	}
+
+	void RegisterInputBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		// Apply a frame of key events, a quick tap of every letter and a held key
+		benchmark.Add("KeyBoardImpl/Update", 0, []() -> DDM::BenchmarkBody
+			{
+				auto pEvents{ std::make_shared<std::vector<DDM::InputEvent>>() };
+
+				for (int key{ GLFW_KEY_A }; key < GLFW_KEY_A + 26; ++key)
+				{
+					pEvents->push_back(DDM::InputEvent{ .Code = key, .Action = GLFW_PRESS, .Type = DDM::InputEventType::Key });
+					pEvents->push_back(DDM::InputEvent{ .Code = key, .Action = GLFW_RELEASE, .Type = DDM::InputEventType::Key });
+				}
+
+				pEvents->push_back(DDM::InputEvent{ .Code = GLFW_KEY_SPACE, .Action = GLFW_REPEAT, .Type = DDM::InputEventType::Key });
+
+				auto pKeyboard{ std::make_shared<DDM::KeyBoardImpl>() };
+
+				return [pKeyboard, pEvents](uint64_t iterations)
+					{
+						uint64_t down{};
+
+						for (uint64_t iteration{}; iteration < iterations; ++iteration)
+						{
+							pKeyboard->Update(*pEvents);
+							down += pKeyboard->IsDown(GLFW_KEY_W);
+						}
+
+						DDM::KeepResult(down);
+					};
+			});
+	}
+
+	void RegisterConfigBenchmarks(DDM::MicroBenchmark& benchmark)
+	{
+		// Missing properties print a message on every lookup, so skip when the config file doesn't have them
+		auto hasConfig = []()
+			{
+				return DDM::ConfigManager::GetInstance().GetInt("WindowWidth") != 0;
+			};
+
+		benchmark.Add("ConfigManager/GetInt", 0, [hasConfig]() -> DDM::BenchmarkBody
+			{
+				if (!hasConfig())
+					return {};
+
+				return [](uint64_t iterations)
+					{
+						auto& configManager{ DDM::ConfigManager::GetInstance() };
+
+						uint64_t total{};
+
+						for (uint64_t iteration{}; iteration < iterations; ++iteration)
+						{
+							total += static_cast<uint64_t>(configManager.GetInt("WindowWidth"));
+						}
+
+						DDM::KeepResult(total);
+					};
+			});
+
+		benchmark.Add("ConfigManager/GetFloat", 0, [hasConfig]() -> DDM::BenchmarkBody
+			{
+				if (!hasConfig())
+					return {};
+
+				return [](uint64_t iterations)
+					{
+						auto& configManager{ DDM::ConfigManager::GetInstance() };
+
+						float total{};
+
+						for (uint64_t iteration{}; iteration < iterations; ++iteration)
+						{
+							total += configManager.GetFloat("FrameBudgetMs");
+						}
+
+						DDM::KeepResult(total);
+					};
+			});
+
+		benchmark.Add("ConfigManager/GetString", 0, [hasConfig]() -> DDM::BenchmarkBody
+			{
+				if (!hasConfig())
+					return {};
+
+				return [](uint64_t iterations)
+					{
+						auto& configManager{ DDM::ConfigManager::GetInstance() };
+
+						uint64_t length{};
+
+						for (uint64_t iteration{}; iteration < iterations; ++iteration)
+						{
+							length += configManager.GetString("DefaultTextureName").size();
+						}
+
+						DDM::KeepResult(length);
+					};
+			});
+	}
+}
+
+void DDM::CoreBenchmarks::Register(MicroBenchmark& benchmark)
+{
+	RegisterTransformBenchmarks(benchmark);
+	RegisterComponentBenchmarks(benchmark);
+	RegisterSceneBenchmarks(benchmark);
+	RegisterModelBenchmarks(benchmark);
+	RegisterInputBenchmarks(benchmark);
+	RegisterConfigBenchmarks(benchmark);
+}
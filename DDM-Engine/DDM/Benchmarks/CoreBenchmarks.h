@@ -0,0 +1,22 @@
+// CoreBenchmarks.h
+// This file registers the cpu microbenchmarks of the engine core
+// Every benchmark that depends on the amount of objects runs at 1k, 10k and 100k objects
+
+#ifndef CoreBenchmarksIncluded
+#define CoreBenchmarksIncluded
+
+namespace DDM
+{
+	// Class forward declarations
+	class MicroBenchmark;
+
+	namespace CoreBenchmarks
+	{
+		// Register every core benchmark
+		// Parameters:
+		//     benchmark: the runner the benchmarks are added to
+		void Register(MicroBenchmark& benchmark);
+	}
+}
+
+#endif // !CoreBenchmarksIncluded
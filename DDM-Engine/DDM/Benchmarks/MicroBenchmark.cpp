@@ -0,0 +1,307 @@
+// MicroBenchmark.cpp
+
+// Header include
+#include "MicroBenchmark.h"
+
+// File includes
+#include "Includes/RapidJSONIncludes.h"
+
+// Standard library includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+namespace
+{
+	// Upper limit of the calibrated amount of iterations, keeps an empty body from calibrating forever
+	constexpr uint64_t kMaxIterations{ uint64_t{ 1 } << 32 };
+
+	// Values the timed work is written to, volatile so the compiler has to calculate them
+	volatile uint64_t g_IntegerSink{};
+	volatile float g_FloatSink{};
+	const void* volatile g_PointerSink{};
+
+	// Escape a string to be written between quotes in a json file
+	// Parameters:
+	//     value: the string to escape
+	std::string EscapeJson(const std::string& value)
+	{
+		std::string escaped{};
+		escaped.reserve(value.size());
+
+		for (const char character : value)
+		{
+			if (character == '"' || character == '\\')
+				escaped += '\\';
+
+			escaped += character;
+		}
+
+		return escaped;
+	}
+}
+
+void DDM::KeepResult(uint64_t value)
+{
+	g_IntegerSink = value;
+}
+
+void DDM::KeepResult(float value)
+{
+	g_FloatSink = value;
+}
+
+void DDM::KeepResult(const void* pValue)
+{
+	g_PointerSink = pValue;
+}
+
+bool DDM::MicroBenchmark::ParseArguments(int argc, char* argv[], MicroBenchmarkSettings& settings)
+{
+	for (int index{ 1 }; index < argc; ++index)
+	{
+		const std::string argument{ argv[index] };
+
+		// Every argument takes a value
+		if (index + 1 >= argc)
+		{
+			std::cout << "Missing value for benchmark argument " << argument << "\n";
+			return false;
+		}
+
+		const std::string value{ argv[++index] };
+
+		if (argument == "--filter")
+			settings.Filter = value;
+		else if (argument == "--output")
+			settings.OutputFile = value;
+		else if (argument == "--baseline")
+			settings.BaselineFile = value;
+		else if (argument == "--label")
+			settings.Label = value;
+		else if (argument == "--threshold")
+			settings.Threshold = std::max(std::atof(value.c_str()), 0.0);
+		else if (argument == "--samples")
+			settings.Samples = std::max(std::atoi(value.c_str()), 1);
+		else if (argument == "--min-time")
+			settings.MinSampleTimeMs = std::max(std::atof(value.c_str()), 0.0);
+		else
+		{
+			std::cout << "Unknown benchmark argument " << argument << "\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+DDM::MicroBenchmark::MicroBenchmark(const MicroBenchmarkSettings& settings)
+	:m_Settings{ settings }
+{
+}
+
+void DDM::MicroBenchmark::Add(const std::string& name, size_t size, BenchmarkSetup setup)
+{
+	m_Entries.push_back(Entry{ size == 0 ? name : name + "/" + std::to_string(size), size, std::move(setup) });
+}
+
+void DDM::MicroBenchmark::Run()
+{
+	m_Results.clear();
+
+	for (const auto& entry : m_Entries)
+	{
+		if (!m_Settings.Filter.empty() && entry.Name.find(m_Settings.Filter) == std::string::npos)
+			continue;
+
+		m_Results.push_back(Measure(entry));
+
+		const auto& result{ m_Results.back() };
+
+		if (result.IsSkipped)
+		{
+			std::cout << std::left << std::setw(48) << result.Name << " skipped\n";
+			continue;
+		}
+
+		std::cout << std::left << std::setw(48) << result.Name << std::right << std::fixed << std::setprecision(2)
+			<< " median " << std::setw(14) << result.MedianNs << " ns"
+			<< "   min " << std::setw(14) << result.MinNs << " ns"
+			<< "   iterations " << result.Iterations << "\n";
+	}
+
+	std::cout << std::defaultfloat;
+}
+
+bool DDM::MicroBenchmark::WriteJson() const
+{
+	std::ofstream file{ m_Settings.OutputFile };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open benchmark file " << m_Settings.OutputFile << "\n";
+		return false;
+	}
+
+	file << "{\n";
+	file << "\t\"Label\": \"" << EscapeJson(m_Settings.Label) << "\",\n";
+	file << "\t\"Samples\": " << m_Settings.Samples << ",\n";
+	file << "\t\"MinSampleTimeMs\": " << m_Settings.MinSampleTimeMs << ",\n";
+	file << "\t\"Results\": [\n";
+
+	for (size_t index{}; index < m_Results.size(); ++index)
+	{
+		const auto& result{ m_Results[index] };
+
+		file << "\t\t{ \"Name\": \"" << result.Name << "\", \"Size\": " << result.Size
+			<< ", \"Skipped\": " << (result.IsSkipped ? "true" : "false")
+			<< ", \"Iterations\": " << result.Iterations
+			<< ", \"MedianNs\": " << result.MedianNs << ", \"MinNs\": " << result.MinNs << ", \"MeanNs\": " << result.MeanNs << " }"
+			<< (index + 1 < m_Results.size() ? ",\n" : "\n");
+	}
+
+	file << "\t]\n";
+	file << "}\n";
+
+	std::cout << "Benchmark results written to " << m_Settings.OutputFile << "\n";
+
+	return true;
+}
+
+bool DDM::MicroBenchmark::CompareToBaseline() const
+{
+	if (m_Settings.BaselineFile.empty())
+		return true;
+
+	std::ifstream file{ m_Settings.BaselineFile };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open baseline " << m_Settings.BaselineFile << "\n";
+		return false;
+	}
+
+	// Read the whole file and parse it
+	std::stringstream buffer{};
+	buffer << file.rdbuf();
+
+	rapidjson::Document document{};
+	document.Parse(buffer.str().c_str());
+
+	if (document.HasParseError() || !document.IsObject() || !document.HasMember("Results") || !document["Results"].IsArray())
+	{
+		std::cout << "Baseline " << m_Settings.BaselineFile << " is not valid\n";
+		return false;
+	}
+
+	// Median of every benchmark in the baseline, by name
+	std::unordered_map<std::string, double> baselineMedians{};
+
+	for (const auto& result : document["Results"].GetArray())
+	{
+		if (!result.HasMember("Name") || !result.HasMember("MedianNs") || !result["MedianNs"].IsNumber())
+			continue;
+
+		if (result.HasMember("Skipped") && result["Skipped"].IsTrue())
+			continue;
+
+		baselineMedians[result["Name"].GetString()] = result["MedianNs"].GetDouble();
+	}
+
+	if (document.HasMember("Label") && document["Label"].IsString())
+	{
+		std::cout << "\nComparing against baseline " << document["Label"].GetString() << "\n";
+	}
+
+	bool passed{ true };
+
+	std::cout << std::fixed << std::setprecision(1);
+
+	for (const auto& result : m_Results)
+	{
+		const auto it{ baselineMedians.find(result.Name) };
+
+		if (result.IsSkipped || it == baselineMedians.end() || it->second <= 0.0)
+			continue;
+
+		const double change{ (result.MedianNs - it->second) / it->second * 100.0 };
+		const bool isRegression{ change > m_Settings.Threshold };
+
+		std::cout << std::left << std::setw(48) << result.Name << std::right
+			<< std::showpos << std::setw(8) << change << "%" << std::noshowpos
+			<< (isRegression ? "   REGRESSION" : "") << "\n";
+
+		passed = passed && !isRegression;
+	}
+
+	std::cout << std::defaultfloat;
+
+	if (!passed)
+	{
+		std::cout << "Benchmarks got more than " << m_Settings.Threshold << "% slower than the baseline\n";
+	}
+
+	return passed;
+}
+
+DDM::MicroBenchmarkResult DDM::MicroBenchmark::Measure(const Entry& entry) const
+{
+	MicroBenchmarkResult result{};
+	result.Name = entry.Name;
+	result.Size = entry.Size;
+
+	const auto body{ entry.Setup() };
+
+	if (!body)
+	{
+		result.IsSkipped = true;
+		return result;
+	}
+
+	// Run the body and return the elapsed nanoseconds
+	auto time = [&body](uint64_t iterations)
+		{
+			const auto start{ std::chrono::steady_clock::now() };
+			body(iterations);
+			const auto end{ std::chrono::steady_clock::now() };
+
+			return std::chrono::duration<double, std::nano>(end - start).count();
+		};
+
+	// Find an amount of iterations that takes long enough to time, this also warms up the caches
+	const double minSampleNs{ m_Settings.MinSampleTimeMs * 1'000'000.0 };
+
+	uint64_t iterations{ 1 };
+	double elapsed{ time(iterations) };
+
+	while (elapsed < minSampleNs && iterations < kMaxIterations)
+	{
+		// Aim a bit past the minimum, but grow at most tenfold at once since short timings are noisy
+		const double scale{ elapsed > 0.0 ? std::clamp(minSampleNs / elapsed * 1.2, 2.0, 10.0) : 10.0 };
+
+		iterations = std::min(static_cast<uint64_t>(static_cast<double>(iterations) * scale), kMaxIterations);
+		elapsed = time(iterations);
+	}
+
+	std::vector<double> samples(static_cast<size_t>(m_Settings.Samples));
+
+	for (auto& sample : samples)
+	{
+		sample = time(iterations) / static_cast<double>(iterations);
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	result.Iterations = iterations;
+	result.MinNs = samples.front();
+	result.MedianNs = samples.size() % 2 == 0 ? (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2.0 : samples[samples.size() / 2];
+	result.MeanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+
+	return result;
+}
@@ -0,0 +1,153 @@
+// MicroBenchmark.h
+// This class runs cpu microbenchmarks of the engine core, without a window or a gpu
+// Every benchmark is calibrated to an amount of iterations that takes long enough to time reliably,
+// after which a set amount of samples is taken and the time per iteration is summarized
+// The results are written to a json file so they can be kept per commit and compared against a baseline
+
+#ifndef MicroBenchmarkIncluded
+#define MicroBenchmarkIncluded
+
+// Standard library includes
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace DDM
+{
+	// Runs the timed part of a benchmark a requested amount of times
+	using BenchmarkBody = std::function<void(uint64_t iterations)>;
+
+	// Prepares the state of a benchmark and returns the body to time, an empty body skips the benchmark
+	using BenchmarkSetup = std::function<BenchmarkBody()>;
+
+	// Settings of a microbenchmark run, filled in from the command line
+	struct MicroBenchmarkSettings
+	{
+		// Only benchmarks with a name that contains this are run, empty to run all
+		std::string Filter{};
+
+		// Json file the results are written to
+		std::string OutputFile{ "CpuBenchmarks.json" };
+
+		// Json file of an earlier run to compare against, empty to skip the comparison
+		std::string BaselineFile{};
+
+		// Label stored with the results, like the commit they were measured on
+		std::string Label{};
+
+		// Percentage the median of a benchmark may be slower than the baseline before it counts as a regression
+		double Threshold{ 10.0 };
+
+		// Amount of samples taken of every benchmark
+		int Samples{ 10 };
+
+		// Minimum time of a single sample in milliseconds, the amount of iterations is calibrated to reach it
+		double MinSampleTimeMs{ 10.0 };
+	};
+
+	// Timings of a single benchmark
+	struct MicroBenchmarkResult
+	{
+		// Full name of the benchmark, including the size
+		std::string Name{};
+
+		// Amount of objects the benchmark works on, 0 if it doesn't depend on a size
+		size_t Size{};
+
+		// Amount of iterations of every sample
+		uint64_t Iterations{};
+
+		// Nanoseconds per iteration
+		double MedianNs{};
+		double MinNs{};
+		double MeanNs{};
+
+		// True if the setup couldn't prepare the benchmark
+		bool IsSkipped{};
+	};
+
+	// Store a value where the compiler can't remove the calculation of it
+	// Parameters:
+	//     value: the result of the timed work
+	void KeepResult(uint64_t value);
+
+	// Store a value where the compiler can't remove the calculation of it
+	// Parameters:
+	//     value: the result of the timed work
+	void KeepResult(float value);
+
+	// Store a pointer where the compiler can't remove the calculation of it
+	// Parameters:
+	//     pValue: the result of the timed work
+	void KeepResult(const void* pValue);
+
+	class MicroBenchmark final
+	{
+	public:
+		// Read the settings from the command line
+		// Parameters:
+		//     argc: amount of arguments
+		//     argv: the arguments
+		//     settings: reference to the settings that are filled in
+		// Returns false if an argument couldn't be read
+		static bool ParseArguments(int argc, char* argv[], MicroBenchmarkSettings& settings);
+
+		// Constructor
+		// Parameters:
+		//     settings: the settings of the run
+		explicit MicroBenchmark(const MicroBenchmarkSettings& settings);
+
+		// Default destructor
+		~MicroBenchmark() = default;
+
+		// Rule of five
+		MicroBenchmark(const MicroBenchmark& other) = delete;
+		MicroBenchmark(MicroBenchmark&& other) = delete;
+		MicroBenchmark& operator=(const MicroBenchmark& other) = delete;
+		MicroBenchmark& operator=(MicroBenchmark&& other) = delete;
+
+		// Register a benchmark
+		// Parameters:
+		//     name: name of the benchmark, the size is appended to it
+		//     size: amount of objects the benchmark works on, 0 if it doesn't depend on a size
+		//     setup: prepares the state of the benchmark and returns the body to time
+		void Add(const std::string& name, size_t size, BenchmarkSetup setup);
+
+		// Run every registered benchmark that passes the filter and print the results
+		void Run();
+
+		// Write the results to the output file
+		// Returns false if the file couldn't be written
+		bool WriteJson() const;
+
+		// Compare the results against the baseline file and print the difference of every benchmark
+		// Returns false if a benchmark got slower than the threshold allows or the baseline couldn't be read
+		bool CompareToBaseline() const;
+
+	private:
+		// A registered benchmark
+		struct Entry
+		{
+			std::string Name{};
+			size_t Size{};
+			BenchmarkSetup Setup{};
+		};
+
+		// The settings of the run
+		MicroBenchmarkSettings m_Settings{};
+
+		// Every registered benchmark
+		std::vector<Entry> m_Entries{};
+
+		// Results of the benchmarks that ran
+		std::vector<MicroBenchmarkResult> m_Results{};
+
+		// Time a single benchmark
+		// Parameters:
+		//     entry: the benchmark to time
+		MicroBenchmarkResult Measure(const Entry& entry) const;
+	};
+}
+
+#endif // !MicroBenchmarkIncluded
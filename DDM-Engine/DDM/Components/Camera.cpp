@@ -101,6 +101,16 @@ void DDM::Camera::UpdateViewMatrix()
 		m_pTransform = GetTransform();
 	}
 
+	// Only rebuild the view matrix when the transform changed
+	const uint64_t version{ m_pTransform->GetVersion() };
+
+	if (m_ViewTransformVersion == version)
+	{
+		return;
+	}
+
+	m_ViewTransformVersion = version;
+
 	// Create rotation matrix
 	glm::mat4 rotationMatrix = glm::mat4_cast(glm::conjugate(m_pTransform->GetWorldRotation()));
 
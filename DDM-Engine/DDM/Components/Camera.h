@@ -109,7 +109,11 @@ namespace DDM
 		// Pointer to skybox component
 		std::shared_ptr<SkyBoxComponent> m_pSkyBox{};
 
-		std::shared_ptr<Transform> m_pTransform{};
+		// Transform of the owner, not owned since the owner outlives this component
+		Transform* m_pTransform{};
+
+		// Version of the transform the view matrix was built from
+		uint64_t m_ViewTransformVersion{};
 
 		/// <summary>
 		/// Update the view matrix
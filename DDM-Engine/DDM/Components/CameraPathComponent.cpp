@@ -0,0 +1,56 @@
+// CameraPathComponent.cpp
+
+// Header include
+#include "CameraPathComponent.h"
+
+// File includes
+#include "Components/Transform.h"
+
+#include "Engine/CameraPath.h"
+
+#include "Managers/TimeManager.h"
+
+void DDM::CameraPathComponent::Update()
+{
+	if (m_pPath == nullptr)
+		return;
+
+	auto pTransform{ GetTransform() };
+
+	if (m_Mode == Mode::Record)
+	{
+		m_Time += TimeManager::GetInstance().GetDeltaTime();
+
+		// Always store the first point, after that only one point per interval
+		if (m_pPath->IsEmpty() || m_Time - m_LastSampleTime >= m_SampleInterval)
+		{
+			m_pPath->AddPoint(m_Time, pTransform->GetWorldPosition(), pTransform->GetWorldRotation());
+			m_LastSampleTime = m_Time;
+		}
+
+		return;
+	}
+
+	if (m_pPath->IsEmpty())
+		return;
+
+	glm::vec3 position{ pTransform->GetWorldPosition() };
+	glm::quat rotation{ pTransform->GetWorldRotation() };
+
+	m_pPath->Sample(m_Time, position, rotation);
+
+	pTransform->SetWorldPosition(position);
+	pTransform->SetWorldRotation(rotation);
+
+	m_Time += m_PlaybackStep > 0.0f ? m_PlaybackStep : TimeManager::GetInstance().GetDeltaTime();
+}
+
+void DDM::CameraPathComponent::SetPath(std::shared_ptr<CameraPath> pPath, Mode mode)
+{
+	m_pPath = std::move(pPath);
+	m_Mode = mode;
+
+	// Start at the beginning of the path
+	m_Time = 0.0f;
+	m_LastSampleTime = 0.0f;
+}
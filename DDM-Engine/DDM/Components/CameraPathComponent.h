@@ -0,0 +1,83 @@
+// CameraPathComponent.h
+// This component will move the game object it is attached to along a camera path, or record a path while it moves
+
+#ifndef _DDM_CAMERA_PATH_COMPONENT_
+#define _DDM_CAMERA_PATH_COMPONENT_
+
+// Parent include
+#include "BaseClasses/Component.h"
+
+// Standard library includes
+#include <memory>
+
+namespace DDM
+{
+	// Class forward declarations
+	class CameraPath;
+
+	class CameraPathComponent final : public Component
+	{
+	public:
+		// Playback follows the path, record adds the current transform to the path
+		enum class Mode
+		{
+			Playback,
+			Record
+		};
+
+		/// <summary>
+		/// Default constructor
+		/// </summary>
+		CameraPathComponent() = default;
+
+		/// <summary>
+		/// Default destructor
+		/// </summary>
+		~CameraPathComponent() = default;
+
+		/// <summary>
+		/// Update function
+		/// </summary>
+		virtual void Update() override;
+
+		/// <summary>
+		/// Set the path to follow or record to
+		/// </summary>
+		/// <param name="pPath: ">The path, shared so a recording outlives the scene</param>
+		/// <param name="mode: ">Wether to follow or record the path</param>
+		void SetPath(std::shared_ptr<CameraPath> pPath, Mode mode);
+
+		/// <summary>
+		/// Set the time playback advances every frame, so every run sees the same views regardless of frame rate
+		/// </summary>
+		/// <param name="step: ">Time per frame in seconds, 0 to follow the real delta time</param>
+		void SetPlaybackStep(float step) { m_PlaybackStep = step; }
+
+		/// <summary>
+		/// Set the time between two recorded points
+		/// </summary>
+		/// <param name="interval: ">Time in seconds</param>
+		void SetSampleInterval(float interval) { m_SampleInterval = interval; }
+
+	private:
+		// The path that is followed or recorded
+		std::shared_ptr<CameraPath> m_pPath{};
+
+		// Wether the path is followed or recorded
+		Mode m_Mode{ Mode::Playback };
+
+		// Time since the start of the path
+		float m_Time{};
+
+		// Time of the last recorded point
+		float m_LastSampleTime{};
+
+		// Time playback advances every frame, 0 to use the delta time
+		float m_PlaybackStep{ 1.0f / 60.0f };
+
+		// Time between two recorded points
+		float m_SampleInterval{ 0.1f };
+	};
+}
+
+#endif // !_DDM_CAMERA_PATH_COMPONENT_
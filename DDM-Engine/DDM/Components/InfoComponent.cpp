@@ -4,60 +4,20 @@
 #include "InfoComponent.h"
 
 //File includes
+#include "Engine/FramePacer.h"
+#include "Engine/Scene.h"
+
+#include "Managers/SceneManager.h"
+#include "Managers/TelemetryManager.h"
 #include "Managers/TimeManager.h"
-#include "Includes/DXGIIncludes.h"
 #include "Vulkan/VulkanObject.h"
-#include "Vulkan/VulkanWrappers/GPUObject.h"
-
-// Standard library includes
-#include <bitset>
-#include "Psapi.h"
-#include <windows.h>
-#include <iostream>
-
-DDM::InfoComponent::InfoComponent()
-	:Component()
-{
-	// Code taken from:
-	// https://asawicki.info/news_1695_there_is_a_way_to_query_gpu_memory_usage_in_vulkan_-_use_dxgi.html
+#include "Vulkan/VulkanManagers/GpuProfiler.h"
 
-	// Create DXGI factory
-	IDXGIFactory4* dxgiFactory = nullptr;
-	CreateDXGIFactory2(0, IID_PPV_ARGS(&dxgiFactory));
+#include "Utils/AllocationTracker.h"
+#include "Utils/RenderCounters.h"
 
-	// Fetch LUID of vulkan physical device
-	auto vulkanLUID = VulkanObject::GetInstance().GetGPUObject()->GetDeviceLuid();
-
-	// Loop through adapters until one is found that matches the vulkan physical device
-	IDXGIAdapter1* tmpDxgiAdapter = nullptr;
-	UINT adapterIndex = 0;
-	while (dxgiFactory->EnumAdapters1(adapterIndex, &tmpDxgiAdapter) != DXGI_ERROR_NOT_FOUND)
-	{
-		// Get description of current adapter
-		DXGI_ADAPTER_DESC1 desc;
-		tmpDxgiAdapter->GetDesc1(&desc);
-
-		// Check if LUID matches the LUID of the vulkan device
-		if (memcmp(&desc.AdapterLuid, vulkanLUID, VK_LUID_SIZE) == 0)
-		{
-			// If it matches, save current adapter
-			tmpDxgiAdapter->QueryInterface(IID_PPV_ARGS(&m_DxgiAdapter));
-		}
-
-		// Release current adapter and increment index
-		tmpDxgiAdapter->Release();
-		++adapterIndex;
-	}
-
-	// Release factory
-	dxgiFactory->Release();
-}
-
-DDM::InfoComponent::~InfoComponent()
-{
-	// Release adapter
-	m_DxgiAdapter->Release();
-}
+// Standard library includes
+#include <string>
 
 void DDM::InfoComponent::Update()
 {
@@ -79,51 +39,110 @@ void DDM::InfoComponent::OnGUI()
 	// Start tree
 	if (ImGui::TreeNodeEx("Info", flags))
 	{
-		// Text for delta time, vram and memory
-		ImGui::Text(m_DeltaTimeLabel.c_str());
-		ImGui::Text(m_VRamLabel.c_str());
-		ImGui::Text(m_MemoryLabel.c_str());
+		// Text for delta time
+		ImGui::Text("Delta time: %f ms", m_AverageDeltaTimeMS);
 
 		ImGui::TreePop();
 	}
-}
 
-void DDM::InfoComponent::QueryStats()
-{
-	// Update delta time label and reset values
-	m_DeltaTimeLabel = std::string("Delta time: " + std::to_string(m_DeltaTimeMS / m_Frames) + " ms");
+	// Percentiles, histogram and hitches of the rolling window
+	TimeManager::GetInstance().OnGUI();
 
-	m_Frames = 0;
-	m_DeltaTimeMS = 0;
+	// Present mode, framerate limit and input latency
+	FramePacer::GetInstance().OnGUI();
 
-	// Update VRAM label
-	m_VRamLabel = std::string("VRAM usage: " + std::to_string(GetVRAMUsage()) + " MB");
+	// Scenes that are loading in the background
+	for (const auto& pSceneLoad : SceneManager::GetInstance().GetSceneLoads())
+	{
+		ImGui::Text("Loading %s", pSceneLoad->GetName().c_str());
+		ImGui::ProgressBar(pSceneLoad->GetProgress());
+	}
 
-	// Update memory labem
-	m_MemoryLabel = std::string("Memory usage: " + std::to_string(GetMemoryUsage()) + " MB");
-}
+	// Loaded scenes with the phases they take part in, the active scene comes first
+	if (ImGui::TreeNodeEx("Scenes", flags))
+	{
+		const auto& pLoadedScenes{ SceneManager::GetInstance().GetLoadedScenes() };
 
-int DDM::InfoComponent::GetVRAMUsage()
-{
-	// Query video memory info
-	DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
-	m_DxgiAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info);
+		for (const auto& pScene : pLoadedScenes)
+		{
+			ImGui::PushID(pScene.get());
 
-	// Convert usage from bits to megabytes and return
-	return static_cast<int>(info.CurrentUsage / 1024 / 1024);
-}
+			ImGui::Text("%s%s", pScene->GetName().c_str(), pScene == pLoadedScenes.front() ? " (active)" : "");
 
-int DDM::InfoComponent::GetMemoryUsage()
-{
-	// Query memory info
-	PROCESS_MEMORY_COUNTERS_EX pmc{};
-	if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc)))
+			bool isEnabled{ pScene->IsUpdateEnabled() };
+
+			if (ImGui::Checkbox("Update", &isEnabled))
+			{
+				pScene->SetUpdateEnabled(isEnabled);
+			}
+
+			ImGui::SameLine();
+
+			isEnabled = pScene->IsFixedUpdateEnabled();
+
+			if (ImGui::Checkbox("Fixed update", &isEnabled))
+			{
+				pScene->SetFixedUpdateEnabled(isEnabled);
+			}
+
+			ImGui::SameLine();
+
+			isEnabled = pScene->IsRenderEnabled();
+
+			if (ImGui::Checkbox("Render", &isEnabled))
+			{
+				pScene->SetRenderEnabled(isEnabled);
+			}
+
+			ImGui::PopID();
+		}
+
+		ImGui::TreePop();
+	}
+
+	// Render operations of the last frame, a jump in draws or binds means batching broke
+	if (ImGui::TreeNodeEx("Render counters", flags))
+	{
+		for (size_t counter{}; counter < RenderCounters::kCounterCount; ++counter)
+		{
+			const auto renderCounter{ static_cast<RenderCounter>(counter) };
+
+			ImGui::Text("%s: %llu", RenderCounters::GetName(renderCounter), static_cast<unsigned long long>(RenderCounters::GetLastFrame(renderCounter)));
+		}
+
+		ImGui::TreePop();
+	}
+
+	// Heap allocations of the last frame per subsystem, only shown when the tracker is compiled in
+	if (AllocationTracker::IsEnabled() && ImGui::TreeNodeEx("Allocations", flags))
 	{
-		// Convert usage from bits to megabytes and return
-		SIZE_T memUsedBytes = pmc.PrivateUsage;
-		double memUsedMB = memUsedBytes / (1024.0 * 1024.0);
-		return static_cast<int>(memUsedMB);
+		for (size_t tag{}; tag < AllocationTracker::kTagCount; ++tag)
+		{
+			const auto allocationTag{ static_cast<AllocationTag>(tag) };
+
+			ImGui::Text("%s: %llu (%llu bytes)", AllocationTracker::GetName(allocationTag),
+				static_cast<unsigned long long>(AllocationTracker::GetLastFrame(allocationTag)),
+				static_cast<unsigned long long>(AllocationTracker::GetLastFrameBytes(allocationTag)));
+		}
+
+		ImGui::TreePop();
 	}
 
-	return 0;
-}
\ No newline at end of file
+	// Memory use, sampled by the telemetry manager
+	TelemetryManager::GetInstance().OnGUI();
+
+	// Rolling averages of the gpu passes
+	if (auto pGpuProfiler{ VulkanObject::GetInstance().GetGpuProfiler() }; pGpuProfiler != nullptr)
+	{
+		pGpuProfiler->OnGUI();
+	}
+}
+
+void DDM::InfoComponent::QueryStats()
+{
+	// Update delta time and reset values
+	m_AverageDeltaTimeMS = m_DeltaTimeMS / m_Frames;
+
+	m_Frames = 0;
+	m_DeltaTimeMS = 0;
+}
@@ -9,7 +9,8 @@
 #include "BaseClasses/Component.h"
 #include "Includes/ImGuiIncludes.h"
 
-class IDXGIAdapter3;
+// Standard library includes
+#include <cstdint>
 
 namespace DDM
 {
@@ -19,12 +20,12 @@ namespace DDM
 		/// <summary>
 		/// Default constructor
 		/// </summary>
-		InfoComponent();
+		InfoComponent() = default;
 
 		/// <summary>
-		/// Destructor
+		/// Default destructor
 		/// </summary>
-		~InfoComponent();
+		~InfoComponent() = default;
 
 		/// <summary>
 		/// Update function
@@ -37,18 +38,9 @@ namespace DDM
 		virtual void OnGUI() override;
 
 	private:
-		// Label for the delta time text in ImGui
-		std::string m_DeltaTimeLabel{ "" };
+		// Average delta time in ms shown in ImGui, stored as a number so updating it doesn't allocate a string
+		float m_AverageDeltaTimeMS{};
 
-		// Label for the vram text in ImGui
-		std::string m_VRamLabel{ "" };
-
-		// Label for the memory text in ImGui
-		std::string m_MemoryLabel{ "" };
-
-		// DirectX12 adapter
-		IDXGIAdapter3* m_DxgiAdapter{ nullptr };
-	
 		// Amount of frames before updating labels
 		const int m_FramesPerUpdate{ 5 };
 
@@ -62,18 +54,6 @@ namespace DDM
 		/// Query all stats
 		/// </summary>
 		void QueryStats();
-
-		/// <summary>
-		/// Get current VRAM usage
-		/// </summary>
-		/// <returns>Current VRAM usage</returns>
-		int GetVRAMUsage();
-
-		/// <summary>
-		/// Get private memory usage
-		/// </summary>
-		/// <returns>Private memory usage</returns>
-		int GetMemoryUsage();
 	};
 }
 
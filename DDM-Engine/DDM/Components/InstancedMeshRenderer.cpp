@@ -0,0 +1,135 @@
+// InstancedMeshRenderer.cpp
+
+// Header include
+#include "InstancedMeshRenderer.h"
+
+// File includes
+#include "Vulkan/VulkanObject.h"
+#include "Vulkan/VulkanWrappers/Mesh.h"
+
+#include "DataTypes/Materials/Material.h"
+
+#include "Managers/ConfigManager.h"
+
+#include "Utils/ResourceTracker.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Instances are copied straight into the instance buffer
+static_assert(sizeof(DDM::InstanceData) == sizeof(glm::mat4), "instance data must match the layout of a matrix");
+
+DDM::InstancedMeshRenderComponent::InstancedMeshRenderComponent()
+{
+	const std::string pipelineName{ ConfigManager::GetInstance().GetString("InstancedPipelineName") };
+
+	// Only the forward renderer adds the instanced pipeline, the default pipeline ignores the instance buffer and has another layout
+	if (!VulkanObject::GetInstance().HasPipeline(pipelineName))
+	{
+		throw std::runtime_error("Instanced mesh renderers need the \"" + pipelineName + "\" pipeline, which only the forward renderer adds");
+	}
+
+	// The default material doesn't read instance data, use a material with the instanced pipeline
+	m_pMaterial = std::make_shared<Material>(pipelineName);
+
+	// Resize buffer lists to amount of frames
+	auto frames{ VulkanObject::GetInstance().GetMaxFrames() };
+
+	m_InstanceBuffers.resize(frames);
+	m_InstanceMemories.resize(frames);
+	m_InstancesMapped.resize(frames);
+	m_InstanceCapacities.resize(frames);
+}
+
+DDM::InstancedMeshRenderComponent::~InstancedMeshRenderComponent()
+{
+	// Wait until device is idle
+	vkDeviceWaitIdle(VulkanObject::GetInstance().GetDevice());
+
+	for (uint32_t frame{}; frame < m_InstanceBuffers.size(); ++frame)
+	{
+		DestroyInstanceBuffer(frame);
+	}
+}
+
+void DDM::InstancedMeshRenderComponent::Render()
+{
+	// If transparant, don't render in normal pass
+	if (m_IsTransparant)
+		return;
+
+	RenderInstances();
+}
+
+void DDM::InstancedMeshRenderComponent::RenderTransparancy()
+{
+	// If not transparant, don't render in transparancy pass
+	if (!m_IsTransparant)
+		return;
+
+	RenderInstances();
+}
+
+void DDM::InstancedMeshRenderComponent::RenderInstances()
+{
+	// If no mesh or no instances, don't render
+	if (m_pMesh == nullptr || m_Instances.empty())
+		return;
+
+	// Get index of current frame in flight
+	auto frame{ VulkanObject::GetInstance().GetCurrentFrame() };
+
+	// Copy the instances to the buffer of this frame
+	ReserveInstanceBuffer(frame);
+	std::memcpy(m_InstancesMapped[frame], m_Instances.data(), sizeof(InstanceData) * m_Instances.size());
+
+	// Render all instances in a single draw call
+	m_pMesh->RenderInstanced(GetPipeline(), &m_DescriptorSets[frame], m_InstanceBuffers[frame], static_cast<uint32_t>(m_Instances.size()));
+}
+
+void DDM::InstancedMeshRenderComponent::ReserveInstanceBuffer(uint32_t frame)
+{
+	// If the buffer is large enough, return
+	if (m_InstanceCapacities[frame] >= m_Instances.size())
+		return;
+
+	// The fence of this frame was waited on before recording, so the old buffer is no longer in use
+	DestroyInstanceBuffer(frame);
+
+	// Grow by at least half so adding a few instances every frame doesn't recreate the buffer every frame
+	const size_t capacity{ std::max(m_Instances.size(), m_InstanceCapacities[frame] + m_InstanceCapacities[frame] / 2) };
+	const VkDeviceSize bufferSize{ sizeof(InstanceData) * capacity };
+
+	auto& renderer{ VulkanObject::GetInstance() };
+
+	// Create host visible buffer so the instances can be written directly every frame
+	renderer.CreateBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		m_InstanceBuffers[frame], m_InstanceMemories[frame]);
+
+	// Keep the memory mapped for the lifetime of the buffer
+	vkMapMemory(renderer.GetDevice(), m_InstanceMemories[frame], 0, bufferSize, 0, &m_InstancesMapped[frame]);
+
+	m_InstanceCapacities[frame] = capacity;
+}
+
+void DDM::InstancedMeshRenderComponent::DestroyInstanceBuffer(uint32_t frame)
+{
+	// If there is no buffer, return
+	if (m_InstanceBuffers[frame] == VK_NULL_HANDLE)
+		return;
+
+	auto device{ VulkanObject::GetInstance().GetDevice() };
+
+	// Destroy buffer and free memory, freeing the memory also unmaps it
+	vkDestroyBuffer(device, m_InstanceBuffers[frame], nullptr);
+	ResourceTracker::Remove(TrackedResource::Buffers);
+	vkFreeMemory(device, m_InstanceMemories[frame], nullptr);
+	ResourceTracker::UntrackAllocation(m_InstanceMemories[frame]);
+
+	m_InstanceBuffers[frame] = VK_NULL_HANDLE;
+	m_InstanceMemories[frame] = VK_NULL_HANDLE;
+	m_InstancesMapped[frame] = nullptr;
+	m_InstanceCapacities[frame] = 0;
+}
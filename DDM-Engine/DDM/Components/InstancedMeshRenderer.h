@@ -0,0 +1,108 @@
+// InstancedMeshRenderer.h
+// This component will render an attached mesh once for every instance transformation it is given
+// All instances are drawn with a single draw call, the transform of the owner is applied on top of every instance
+
+#ifndef _DDM_INSTANCED_MESH_RENDERER_
+#define _DDM_INSTANCED_MESH_RENDERER_
+
+// Parent include
+#include "MeshRenderer.h"
+
+// File includes
+#include "Includes/GLMIncludes.h"
+
+// Standard library includes
+#include <vector>
+
+namespace DDM
+{
+	class InstancedMeshRenderComponent final : public MeshRenderComponent
+	{
+	public:
+		// Base component, allows looking this component up as a MeshRenderComponent
+		DDM_COMPONENT_SUPER(InstancedMeshRenderComponent, MeshRenderComponent);
+
+		/// <summary>
+		/// Constructor, the material uses the instanced pipeline
+		/// </summary>
+		InstancedMeshRenderComponent();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		virtual ~InstancedMeshRenderComponent();
+
+		// Delete copy and move operations
+		InstancedMeshRenderComponent(const InstancedMeshRenderComponent& other) = delete;
+		InstancedMeshRenderComponent(InstancedMeshRenderComponent&& other) = delete;
+
+		InstancedMeshRenderComponent& operator=(const InstancedMeshRenderComponent& other) = delete;
+		InstancedMeshRenderComponent& operator=(InstancedMeshRenderComponent&& other) = delete;
+
+		/// <summary>
+		/// Remove all instances
+		/// </summary>
+		void ClearInstances() { m_Instances.clear(); }
+
+		/// <summary>
+		/// Add an instance
+		/// </summary>
+		/// <param name="transformation: ">World matrix of the instance</param>
+		void AddInstance(const glm::mat4& transformation) { m_Instances.push_back(transformation); }
+
+		/// <summary>
+		/// Get the list of instances, can be filled directly to avoid a call per instance
+		/// </summary>
+		/// <returns>Reference to the list of instance transformations</returns>
+		std::vector<glm::mat4>& GetInstances() { return m_Instances; }
+
+		/// <summary>
+		/// Render depth, instances have no depth pipeline so they are skipped
+		/// </summary>
+		virtual void RenderDepth() override {}
+
+		/// <summary>
+		/// General render function
+		/// </summary>
+		virtual void Render() override;
+
+		/// <summary>
+		/// Render transparant objects
+		/// </summary>
+		virtual void RenderTransparancy() override;
+
+	private:
+		// Transformation of every instance
+		std::vector<glm::mat4> m_Instances{};
+
+		// Instance buffer per frame in flight
+		std::vector<VkBuffer> m_InstanceBuffers{};
+
+		// Memory of the instance buffers
+		std::vector<VkDeviceMemory> m_InstanceMemories{};
+
+		// Pointers to mapped instance buffers
+		std::vector<void*> m_InstancesMapped{};
+
+		// Amount of instances each buffer can hold
+		std::vector<size_t> m_InstanceCapacities{};
+
+		/// <summary>
+		/// Copy the instances to the buffer of the current frame and draw them
+		/// </summary>
+		void RenderInstances();
+
+		/// <summary>
+		/// Make sure the buffer of a frame can hold all instances
+		/// </summary>
+		/// <param name="frame: ">Index of the frame in flight</param>
+		void ReserveInstanceBuffer(uint32_t frame);
+
+		/// <summary>
+		/// Destroy the instance buffer of a frame
+		/// </summary>
+		/// <param name="frame: ">Index of the frame in flight</param>
+		void DestroyInstanceBuffer(uint32_t frame);
+	};
+}
+#endif // !_DDM_INSTANCED_MESH_RENDERER_
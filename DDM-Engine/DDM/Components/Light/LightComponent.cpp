@@ -101,9 +101,15 @@ void DDM::LightComponent::UpdateBuffer(int frame)
 	// Fetch transform component
 	auto transform = GetTransform();
 
-	// Update direction and position
-	m_BufferObject.direction = transform->GetForward();
-	m_BufferObject.position = transform->GetWorldPosition();
+	// Update direction and position if the transform changed
+	const uint64_t version{ transform->GetVersion() };
+
+	if (m_TransformVersion != version)
+	{
+		m_BufferObject.direction = transform->GetForward();
+		m_BufferObject.position = transform->GetWorldPosition();
+		m_TransformVersion = version;
+	}
 
 	// Update the ubo buffer
 	m_DescriptorObject->UpdateUboBuffer(&m_BufferObject, frame);
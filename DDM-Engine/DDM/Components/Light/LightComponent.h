@@ -99,6 +99,9 @@ namespace DDM
 		// Struct that holds the values of the light
 		Light m_BufferObject{};
 
+		// Version of the transform the direction and position were taken from
+		uint64_t m_TransformVersion{};
+
 		// Pointer to the descriptor object
 		std::unique_ptr<UboDescriptorObject<Light>> m_DescriptorObject{};
 
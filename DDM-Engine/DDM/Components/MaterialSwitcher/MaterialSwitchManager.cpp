@@ -29,6 +29,14 @@ void DDM::MaterialSwitchManager::RegisterKey(std::string& key)
 	
 	// Register key
 	m_AvailableKeys.push_back(key);
+
+	// Registering may move the strings, so every pointer is taken again
+	m_KeyNames.clear();
+
+	for (auto& availableKey : m_AvailableKeys)
+	{
+		m_KeyNames.push_back(availableKey.c_str());
+	}
 }
 
 void DDM::MaterialSwitchManager::RegisterKey(std::string&& key)
@@ -74,16 +82,6 @@ void DDM::MaterialSwitchManager::RegisterMaterialSwitcher(std::shared_ptr<Materi
 
 void DDM::MaterialSwitchManager::OnGUI()
 {
-	// Create a list of c-strings from the available keys
-	auto cStringList = std::vector<const char*>();
-
-	cStringList.reserve(m_AvailableKeys.size());
-
-	for (auto& key : m_AvailableKeys)
-	{
-		cStringList.emplace_back(key.c_str());
-	}
-
 	// Store previous key to check if it changed
 	int prevKey = m_CurrentKey;
 
@@ -92,7 +90,7 @@ void DDM::MaterialSwitchManager::OnGUI()
 	// Create a tree node for the material switcher
 	if (ImGui::TreeNodeEx("Material switcher", flags))
 	{
-		ImGui::ListBox(m_Label.c_str(), &m_CurrentKey, cStringList.data(), static_cast<int>(cStringList.size()));
+		ImGui::ListBox(m_Label.c_str(), &m_CurrentKey, m_KeyNames.data(), static_cast<int>(m_KeyNames.size()));
 		ImGui::TreePop();
 	}
 
@@ -83,6 +83,9 @@ namespace DDM
 		// List of available keys
 		std::vector<std::string> m_AvailableKeys{};
 
+		// The available keys as c-strings for the ImGui list box, rebuilt when a key is registered instead of every frame
+		std::vector<const char*> m_KeyNames{};
+
 		// List of registered material switchers
 		std::vector<std::shared_ptr<MaterialSwitcher>> m_pMaterialSwitchers{};
 
@@ -19,6 +19,9 @@
 
 #include "Managers/ResourceManager.h"
 
+// Standard library includes
+#include <array>
+
 DDM::MeshRenderComponent::MeshRenderComponent()
 {
 	// Create ubo descriptor object
@@ -145,6 +148,8 @@ void DDM::MeshRenderComponent::CreateUniformBuffers()
 	m_Ubos.resize(frames);
 	// Resize dirty flages to amount of frames
 	m_UboChanged.resize(frames);
+	// Resize transform versions to amount of frames, 0 forces the first update
+	m_UboTransformVersions.assign(frames, 0);
 }
 
 void DDM::MeshRenderComponent::CreateDescriptorSets()
@@ -160,8 +165,8 @@ void DDM::MeshRenderComponent::CreateDescriptorSets()
 
 void DDM::MeshRenderComponent::UpdateDescriptorSets()
 {
-	// Create list of descriptor objects and add the objects of the model to it
-	std::vector<DescriptorObject*> descriptors{ m_pUboDescriptorObject.get() };
+	// List of descriptor objects of the model, kept on the stack so updating doesn't allocate
+	std::array<DescriptorObject*, 1> descriptors{ m_pUboDescriptorObject.get() };
 
 	// Update descriptorsets
 	m_pMaterial->UpdateDescriptorSets(m_DescriptorSets, descriptors);
@@ -175,17 +180,15 @@ void DDM::MeshRenderComponent::UpdateUniformBuffer(uint32_t frame)
 	// Get transform
 	auto transform{ GetTransform() };
 
-	// Set up translation matrix
-	glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), transform->GetWorldPosition());
-
-	// Set up rotation matrix
-	glm::mat4 rotationMatrix = glm::mat4_cast(transform->GetWorldRotation());
-
-	// Set up scaling matrix
-	glm::mat4 scalingMatrix = glm::scale(glm::mat4(1.0f), transform->GetWorldScale());
+	// Only copy the model matrix if the transform changed since this ubo was last updated
+	// The render matrix is the world matrix, or the interpolated one for transforms moved in FixedUpdate
+	const uint64_t version{ transform->GetRenderVersion() };
 
-	// Calculate model matrix
-	m_Ubos[frame].model = translationMatrix * rotationMatrix * scalingMatrix;
+	if (m_UboTransformVersions[frame] != version)
+	{
+		m_Ubos[frame].model = transform->GetRenderMatrix();
+		m_UboTransformVersions[frame] = version;
+	}
 
 	// Update the uniform buffer object in the vulkan object
 	VulkanObject::GetInstance().UpdateUniformBuffer(m_Ubos[frame]);
@@ -221,8 +224,8 @@ void DDM::MeshRenderComponent::UpdateDepthDescriptorSets()
 	// Get pointer to the descriptorpool wrapper
 	auto descriptorPool = GetDepthPipeline()->GetDescriptorPool();
 
-	// Create list of descriptor objects and add the objects of the model to it
-	std::vector<DescriptorObject*> descriptors{ m_pUboDescriptorObject.get() };
+	// List of descriptor objects of the model, kept on the stack so updating doesn't allocate
+	std::array<DescriptorObject*, 1> descriptors{ m_pUboDescriptorObject.get() };
 
 
 	// Update descriptorsets
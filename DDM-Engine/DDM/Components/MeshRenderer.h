@@ -105,6 +105,9 @@ namespace DDM
 		// Vector of dirty flags for UBOs
 		std::vector<bool> m_UboChanged{};
 
+		// Version of the transform the model matrix of each UBO was built from
+		std::vector<uint64_t> m_UboTransformVersions{};
+
 		// Pointer to UBO descriptor object
 		std::unique_ptr<DDM::UboDescriptorObject<UniformBufferObject>> m_pUboDescriptorObject{};
 
@@ -15,6 +15,9 @@ namespace DDM
 	class RotatorComponent final : public Component
 	{
 	public:
+		// Update only changes the local rotation of its own object, so it can run in parallel
+		static constexpr bool kThreadSafeUpdate{ true };
+
 		/// <summary>
 		/// Default constructor
 		/// </summary>
@@ -24,6 +24,9 @@ namespace DDM
 	class SkyBoxComponent final : public MeshRenderComponent
 	{
 	public:
+		// Base component, allows looking this component up as a MeshRenderComponent
+		DDM_COMPONENT_SUPER(SkyBoxComponent, MeshRenderComponent);
+
 		/// <summary>
 		/// Default constructor
 		/// </summary>
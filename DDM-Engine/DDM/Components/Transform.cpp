@@ -4,6 +4,8 @@
 #include "Transform.h"
 
 // File includes
+#include "Managers/TransformManager.h"
+
 #include "Includes/GLFWIncludes.h"
 #include "Includes/ImGuiIncludes.h"
 
@@ -14,8 +16,26 @@
 #include <iostream>
 #include <filesystem>
 
+DDM::Transform::Transform()
+	:m_TransformId{ TransformManager::GetInstance().CreateTransform() }
+{
+}
+
+DDM::Transform::~Transform()
+{
+	// Release the entry in the transform manager
+	TransformManager::GetInstance().DestroyTransform(m_TransformId);
+}
+
 void DDM::Transform::OnGUI()
 {
+	auto& transformManager{ TransformManager::GetInstance() };
+
+	// Get the local values from the transform manager
+	glm::vec3& localPosition{ transformManager.GetLocalPosition(m_TransformId) };
+	glm::quat& localRotation{ transformManager.GetLocalRotation(m_TransformId) };
+	glm::vec3& localScale{ transformManager.GetLocalScale(m_TransformId) };
+
 	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Framed;
 
 	// Start a tree node
@@ -25,9 +45,9 @@ void DDM::Transform::OnGUI()
 		if (ImGui::TreeNodeEx("Location", flags))
 		{
 			// Add sliders for all directions
-			ImGui::SliderFloat("x", &m_LocalPosition.x, -10, 10);
-			ImGui::SliderFloat("y", &m_LocalPosition.y, -10, 10);
-			ImGui::SliderFloat("z", &m_LocalPosition.z, -10, 10);
+			ImGui::SliderFloat("x", &localPosition.x, -10, 10);
+			ImGui::SliderFloat("y", &localPosition.y, -10, 10);
+			ImGui::SliderFloat("z", &localPosition.z, -10, 10);
 
 			// End tree node
 			ImGui::TreePop();
@@ -37,7 +57,7 @@ void DDM::Transform::OnGUI()
 		if (ImGui::TreeNodeEx("Rotation", flags))
 		{
 			// Convert quaternion to Euler angles in degrees
-			glm::vec3 rotation =glm::eulerAngles(m_LocalRotation);
+			glm::vec3 rotation =glm::eulerAngles(localRotation);
 
 			// Create sliders for each axis
 			ImGui::SliderAngle("x", &rotation.x);
@@ -45,7 +65,7 @@ void DDM::Transform::OnGUI()
 			ImGui::SliderAngle("z", &rotation.z);
 
 			// Update quaternion with new Euler angles
-			m_LocalRotation = glm::quat(rotation);
+			localRotation = glm::quat(rotation);
 
 			// End tree node
 			ImGui::TreePop();
@@ -55,9 +75,9 @@ void DDM::Transform::OnGUI()
 		if (ImGui::TreeNodeEx("Scale", flags))
 		{
 			// Add slider for each direction
-			ImGui::SliderFloat("x", &m_LocalScale.x, 0.001f, 2.0f);
-			ImGui::SliderFloat("y", &m_LocalScale.y, 0.001f, 2.0f);
-			ImGui::SliderFloat("z", &m_LocalScale.z, 0.001f, 2.0f);
+			ImGui::SliderFloat("x", &localScale.x, 0.001f, 2.0f);
+			ImGui::SliderFloat("y", &localScale.y, 0.001f, 2.0f);
+			ImGui::SliderFloat("z", &localScale.z, 0.001f, 2.0f);
 
 			// End tree node
 			ImGui::TreePop();
@@ -73,6 +93,11 @@ void DDM::Transform::OnGUI()
 	SetScaleDirtyFlag();
 }
 
+const glm::vec3& DDM::Transform::GetLocalPosition() const
+{
+	return TransformManager::GetInstance().GetLocalPosition(m_TransformId);
+}
+
 void DDM::Transform::SetLocalPosition(float x, float y, float z)
 {
 	// Propagate to overloaded function
@@ -82,7 +107,7 @@ void DDM::Transform::SetLocalPosition(float x, float y, float z)
 void DDM::Transform::SetLocalPosition(const glm::vec3& pos)
 {
 	// Set new local position
-	m_LocalPosition = pos;
+	TransformManager::GetInstance().GetLocalPosition(m_TransformId) = pos;
 
 	// Set dirty flag
 	SetPositionDirtyFlag();
@@ -103,7 +128,7 @@ void DDM::Transform::Translate(float x, float y, float z)
 void DDM::Transform::Translate(const glm::vec3& dir)
 {
 	// Set new local position
-	SetLocalPosition(m_LocalPosition + dir);
+	SetLocalPosition(GetLocalPosition() + dir);
 }
 
 void DDM::Transform::Translate(const glm::vec3&& dir)
@@ -114,22 +139,8 @@ void DDM::Transform::Translate(const glm::vec3&& dir)
 
 glm::vec3 DDM::Transform::GetWorldPosition()
 {
-	// Get the parent's position
-	glm::vec3 parentPosition = GetParentPosition();
-
-	// Create the rotation matrix from the quaternion
-	glm::mat4 rotationMatrix = glm::mat4_cast(GetParentRotation());
-
-	// Apply the rotation to the vector using the rotation matrix
-	glm::vec4 rotatedVector = rotationMatrix * glm::vec4(m_LocalPosition, 1.0f);
-
-	// Extract the rotated glm::vec3 from the glm::vec4
-	glm::vec3 finalRotatedVector = glm::vec3(rotatedVector);
-
-	// Calculate the final position after rotation
-	glm::vec3 finalPosition = parentPosition + finalRotatedVector;
-
-	return finalPosition;
+	// Get the cached world position
+	return TransformManager::GetInstance().GetWorldPosition(m_TransformId);
 }
 
 void DDM::Transform::SetWorldPosition(float x, float y, float z)
@@ -141,7 +152,7 @@ void DDM::Transform::SetWorldPosition(float x, float y, float z)
 void DDM::Transform::SetWorldPosition(const glm::vec3& pos)
 {
 	// Set new local position
-	SetLocalPosition(pos - (GetWorldPosition() - m_LocalPosition));
+	SetLocalPosition(pos - (GetWorldPosition() - GetLocalPosition()));
 }
 
 void DDM::Transform::SetWorldPosition(const glm::vec3&& pos)
@@ -152,22 +163,19 @@ void DDM::Transform::SetWorldPosition(const glm::vec3&& pos)
 
 void DDM::Transform::SetPositionDirtyFlag() const
 {
-	// Loop through all children
-	for (auto& pChild : GetOwner()->GetChildren())
-	{
-		// Extract transform and set dirty flag
-		auto transform = pChild->GetTransform();
-		transform->m_PositionDF = true;
+	// Mark this transform as dirty, children are updated by the transform manager
+	TransformManager::GetInstance().SetDirty(m_TransformId);
+}
 
-		// Propagate dirty flag through all children
-		transform->SetPositionDirtyFlag();
-	}
+const glm::quat& DDM::Transform::GetLocalRotation() const
+{
+	return TransformManager::GetInstance().GetLocalRotation(m_TransformId);
 }
 
 const glm::vec3 DDM::Transform::GetLocalRotationEuler() const
 {
 	// Convert rotation to euler angles and return
-	return glm::eulerAngles(m_LocalRotation);
+	return glm::eulerAngles(GetLocalRotation());
 }
 
 void DDM::Transform::SetLocalRotation(float x, float y, float z)
@@ -191,7 +199,7 @@ void DDM::Transform::SetLocalRotation(const glm::vec3&& rot)
 void DDM::Transform::SetLocalRotation(const glm::quat& rot)
 {
 	// Set local rotation
-	m_LocalRotation = rot;
+	TransformManager::GetInstance().GetLocalRotation(m_TransformId) = rot;
 
 	// Set dirty flag for rotation
 	SetRotationDirtyFlag();
@@ -206,7 +214,8 @@ void DDM::Transform::SetLocalRotation(const glm::quat&& rot)
 void DDM::Transform::Rotate(glm::vec3& axis, float angle)
 {
 	// Rotate local rotation around axiss
-	m_LocalRotation = glm::rotate(m_LocalRotation, angle, axis);
+	glm::quat& localRotation{ TransformManager::GetInstance().GetLocalRotation(m_TransformId) };
+	localRotation = glm::rotate(localRotation, angle, axis);
 
 	// Set dirty flag for rotation
 	SetRotationDirtyFlag();
@@ -232,8 +241,8 @@ void DDM::Transform::RotateDeg(glm::vec3&& axis, float angle)
 
 glm::quat DDM::Transform::GetWorldRotation()
 {
-	// Calculate and return world rotation
-	return GetParentRotation() * m_LocalRotation;
+	// Get the cached world rotation
+	return TransformManager::GetInstance().GetWorldRotation(m_TransformId);
 }
 
 void DDM::Transform::SetWorldRotation(float x, float y, float z)
@@ -260,7 +269,7 @@ void DDM::Transform::SetWorldRotation(const glm::vec3&& rot)
 void DDM::Transform::SetWorldRotation(const glm::quat& rot)
 {
 	// Get the parent's world rotation
-	glm::quat parentWorldRotation = GetParentRotation();
+	glm::quat parentWorldRotation = TransformManager::GetInstance().GetParentWorldRotation(m_TransformId);
 
 	// Adjust the local rotation to achieve the desired world rotation
 	glm::quat localRotation = rot * glm::inverse(parentWorldRotation);
@@ -277,13 +286,13 @@ void DDM::Transform::SetWorldRotation(const glm::quat&& rot)
 
 void DDM::Transform::SetRotationDirtyFlag() const
 {
-	// Loop through all children, set dirty flag and propagate
-	for (auto& pChild : GetOwner()->GetChildren())
-	{
-		auto transform = pChild->GetTransform();
-		transform->m_RotationDF = true;
-		transform->SetRotationDirtyFlag();
-	}
+	// Mark this transform as dirty, children are updated by the transform manager
+	TransformManager::GetInstance().SetDirty(m_TransformId);
+}
+
+const glm::vec3& DDM::Transform::GetLocalScale() const
+{
+	return TransformManager::GetInstance().GetLocalScale(m_TransformId);
 }
 
 void DDM::Transform::SetLocalScale(float x, float y, float z)
@@ -295,7 +304,7 @@ void DDM::Transform::SetLocalScale(float x, float y, float z)
 void DDM::Transform::SetLocalScale(const glm::vec3& scale)
 {
 	// Set local scale
-	m_LocalScale = scale;
+	TransformManager::GetInstance().GetLocalScale(m_TransformId) = scale;
 
 	// Set dirty flag
 	SetScaleDirtyFlag();
@@ -309,7 +318,8 @@ void DDM::Transform::SetLocalScale(const glm::vec3&& scale)
 
 glm::vec3 DDM::Transform::GetWorldScale()
 {
-	return GetParentScale() * m_LocalScale;
+	// Get the cached world scale
+	return TransformManager::GetInstance().GetWorldScale(m_TransformId);
 }
 
 void DDM::Transform::SetWorldScale(float x, float y, float z)
@@ -322,7 +332,7 @@ void DDM::Transform::SetWorldScale(float x, float y, float z)
 void DDM::Transform::SetWorldScale(const glm::vec3& scale)
 {
 	// Calculate new local scale and set it
-	SetLocalScale(scale/(GetWorldScale()/m_LocalScale));
+	SetLocalScale(scale/(GetWorldScale()/GetLocalScale()));
 }
 
 void DDM::Transform::SetWorldScale(const glm::vec3&& scale)
@@ -333,57 +343,99 @@ void DDM::Transform::SetWorldScale(const glm::vec3&& scale)
 
 void DDM::Transform::SetScaleDirtyFlag() const
 {
-	// Loop through all children, set dirty flag and propagate
-	for (auto& pChild : GetOwner()->GetChildren())
+	// Mark this transform as dirty, children are updated by the transform manager
+	TransformManager::GetInstance().SetDirty(m_TransformId);
+}
+
+const glm::mat4& DDM::Transform::GetWorldMatrix()
+{
+	// Get the cached world matrix
+	return TransformManager::GetInstance().GetWorldMatrix(m_TransformId);
+}
+
+const glm::mat4& DDM::Transform::GetInverseWorldMatrix()
+{
+	// Get the current version
+	const uint64_t version{ GetVersion() };
+
+	// Only recalculate if the world matrix changed
+	if (m_InverseVersion != version)
 	{
-		auto transform = pChild->GetTransform();
-		transform->m_ScaleDF = true;
-		transform->SetScaleDirtyFlag();
+		m_InverseWorldMatrix = glm::inverse(GetWorldMatrix());
+		m_InverseVersion = version;
 	}
+
+	return m_InverseWorldMatrix;
 }
 
-glm::vec3 DDM::Transform::GetForward()
+const glm::mat3& DDM::Transform::GetNormalMatrix()
 {
-	// Create the rotation matrix from the quaternion
-	glm::mat4 rotationMatrix = glm::mat4_cast(GetWorldRotation());
+	// Get the current version
+	const uint64_t version{ GetVersion() };
 
-	// Apply the rotation to the vector using the rotation matrix
-	glm::vec4 rotatedVector = rotationMatrix * glm::vec4(0.f, 0.f, 1.f, 0.0f);  // Use (0, 0, 1) for the forward vector
+	// Only recalculate if the world matrix changed
+	if (m_NormalVersion != version)
+	{
+		m_NormalMatrix = glm::transpose(glm::inverse(glm::mat3(GetWorldMatrix())));
+		m_NormalVersion = version;
+	}
 
-	// Extract the rotated glm::vec3 from the glm::vec4
-	glm::vec3 finalRotatedVector = glm::vec3(rotatedVector);
+	return m_NormalMatrix;
+}
 
-	return finalRotatedVector;
+uint64_t DDM::Transform::GetVersion()
+{
+	// Get the version from the transform manager
+	return TransformManager::GetInstance().GetVersion(m_TransformId);
 }
 
-glm::vec3 DDM::Transform::GetUp()
+const glm::mat4& DDM::Transform::GetRenderMatrix()
 {
-	// Create the rotation matrix from the quaternion
-	glm::mat4 rotationMatrix = glm::mat4_cast(GetWorldRotation());
+	// Get the render matrix from the transform manager
+	return TransformManager::GetInstance().GetRenderMatrix(m_TransformId);
+}
 
-	// Apply the rotation to the vector using the rotation matrix
-	glm::vec4 rotatedVector = rotationMatrix * glm::vec4(0.f, 1.f, 0.f, 0.0f);  // Use (0, 1, 0) for the up vector
+uint64_t DDM::Transform::GetRenderVersion()
+{
+	// Get the render version from the transform manager
+	return TransformManager::GetInstance().GetRenderVersion(m_TransformId);
+}
+
+void DDM::Transform::SetInterpolated(bool interpolate)
+{
+	TransformManager::GetInstance().SetInterpolated(m_TransformId, interpolate);
+}
 
-	// Extract the rotated glm::vec3 from the glm::vec4
-	glm::vec3 finalRotatedVector = glm::vec3(rotatedVector);
+bool DDM::Transform::IsInterpolated() const
+{
+	return TransformManager::GetInstance().IsInterpolated(m_TransformId);
+}
 
-	return finalRotatedVector;
+void DDM::Transform::ResetInterpolation()
+{
+	TransformManager::GetInstance().ResetInterpolation(m_TransformId);
 }
 
-glm::vec3 DDM::Transform::GetRight()
+glm::vec3 DDM::Transform::GetForward()
 {
-	// Create the rotation matrix from the quaternion
-	glm::mat4 rotationMatrix = glm::mat4_cast(GetWorldRotation());
+	// Rotate (0, 0, 1) by the world rotation
+	return GetWorldRotation() * glm::vec3(0.f, 0.f, 1.f);
+}
 
-	// Apply the rotation to the vector using the rotation matrix
-	glm::vec4 rotatedVector = rotationMatrix * glm::vec4(1.f, 0.f, 0.f, 0.0f);  // Use (1, 0, 0) for the right vector
+glm::vec3 DDM::Transform::GetUp()
+{
+	// Rotate (0, 1, 0) by the world rotation
+	return GetWorldRotation() * glm::vec3(0.f, 1.f, 0.f);
+}
 
-	// Extract the rotated glm::vec3 from the glm::vec4
-	glm::vec3 finalRotatedVector = glm::vec3(rotatedVector);
+glm::vec3 DDM::Transform::GetRight()
+{
+	// Rotate (1, 0, 0) by the world rotation
+	glm::vec3 right = GetWorldRotation() * glm::vec3(1.f, 0.f, 0.f);
 
-	finalRotatedVector.y *= -1;
+	right.y *= -1;
 
-	return finalRotatedVector;
+	return right;
 }
 
 bool DDM::Transform::WriteToFile(std::string& fileName)
@@ -461,59 +513,18 @@ bool DDM::Transform::ReadFromFile(std::string&& fileName)
 	return ReadFromFile(fileName);
 }
 
-const glm::vec3& DDM::Transform::GetParentPosition()
-{
-	// If no owner or parent, set parent world position to 0,0,0
-	if (GetOwner() == nullptr || GetOwner()->GetParent() == nullptr)
-	{
-		m_ParentWorldPosition = glm::vec3{};
-		m_PositionDF = false;
-	}
-	// If Dirty flag is set, save new parent position
-	else if (m_PositionDF)
-	{
-		m_ParentWorldPosition = GetOwner()->GetParent()->GetTransform()->GetWorldPosition();
-		m_PositionDF = false;
-	}
-
-	// return parent position
-	return m_ParentWorldPosition;
-}
-
-const glm::quat& DDM::Transform::GetParentRotation()
+void DDM::Transform::OnParentChanged()
 {
-	// If no owner or parent, set parent world rotation to identity quaternion
-	if (GetOwner() == nullptr || GetOwner()->GetParent() == nullptr)
-	{
-		m_ParentWorldRotation = glm::identity<glm::quat>();;
-		m_RotationDF = false;
-	}
-	// If dirty flag is set, save new parent rotation
-	else if (m_RotationDF)
-	{
-		m_ParentWorldRotation = GetOwner()->GetParent()->GetTransform()->GetWorldRotation();
-		m_RotationDF = false;
-	}
+	// Get the parent object
+	auto pParent{ GetOwner() != nullptr ? GetOwner()->GetParent() : nullptr };
 
-	// Return parent rotation
-	return m_ParentWorldRotation;
-}
-
-const glm::vec3& DDM::Transform::GetParentScale()
-{
-	// If no owner or parent, set parent world scale to 1,1,1
-	if (GetOwner() == nullptr || GetOwner()->GetParent() == nullptr)
+	// Link this transform to the transform of the parent, or make it a root if there is none
+	if (pParent != nullptr && pParent->GetTransform() != nullptr)
 	{
-		m_ParentWorldScale = glm::vec3{ 1, 1, 1 };
-		m_ScaleDF = false;
+		TransformManager::GetInstance().SetParent(m_TransformId, pParent->GetTransform()->m_TransformId);
 	}
-	// If dirty flag is set, save new parent scale
-	else if (m_ScaleDF)
+	else
 	{
-		m_ParentWorldScale = GetOwner()->GetParent()->GetTransform()->GetWorldScale();
-		m_ScaleDF = false;
+		TransformManager::GetInstance().SetParent(m_TransformId, TransformManager::kInvalidId);
 	}
-
-	// Return parent scale
-	return m_ParentWorldScale;
 }
@@ -24,14 +24,14 @@ namespace DDM
 	{
 	public:
 		/// <summary>
-		/// Default constructor
+		/// Constructor, registers the transform in the TransformManager
 		/// </summary>
-		Transform() = default;
+		Transform();
 
 		/// <summary>
-		/// Default destructor
+		/// Destructor, removes the transform from the TransformManager
 		/// </summary>
-		~Transform() = default;
+		~Transform();
 
 		// Rule of five
 		Transform(Transform&) = delete;
@@ -53,7 +53,7 @@ namespace DDM
 		/// Get the local position of the object
 		/// </summary>
 		/// <returns>Reference to local position</returns>
-		const glm::vec3& GetLocalPosition() const { return m_LocalPosition; }
+		const glm::vec3& GetLocalPosition() const;
 
 		/// <summary>
 		/// Set local position
@@ -122,7 +122,7 @@ namespace DDM
 		void SetWorldPosition(const glm::vec3&& pos);
 
 		/// <summary>
-		/// Set the dirty flag for the parent position
+		/// Set the dirty flag for the position
 		/// </summary>
 		void SetPositionDirtyFlag() const;
 
@@ -135,7 +135,7 @@ namespace DDM
 		/// Get the local rotation quaternion
 		/// </summary>
 		/// <returns>Reference to local rotation quaternion</returns>
-		const glm::quat& GetLocalRotation() const { return m_LocalRotation; }
+		const glm::quat& GetLocalRotation() const;
 
 		/// <summary>
 		/// Get local rotation in euler angles
@@ -255,7 +255,7 @@ namespace DDM
 		/// Get local scale
 		/// </summary>
 		/// <returns>reference to local scene</returns>
-		const glm::vec3& GetLocalScale() const { return m_LocalScale; }
+		const glm::vec3& GetLocalScale() const;
 
 		/// <summary>
 		/// Set local scale
@@ -310,6 +310,64 @@ namespace DDM
 		void SetScaleDirtyFlag() const;
 
 
+		// -------------------
+		// Matrices
+		// -------------------
+
+		/// <summary>
+		/// Get the cached world matrix, translation * rotation * scale
+		/// </summary>
+		/// <returns>Reference to the world matrix</returns>
+		const glm::mat4& GetWorldMatrix();
+
+		/// <summary>
+		/// Get the inverse of the world matrix, only recalculated when the world matrix changed
+		/// </summary>
+		/// <returns>Reference to the inverse world matrix</returns>
+		const glm::mat4& GetInverseWorldMatrix();
+
+		/// <summary>
+		/// Get the normal matrix, only recalculated when the world matrix changed
+		/// </summary>
+		/// <returns>Reference to the normal matrix</returns>
+		const glm::mat3& GetNormalMatrix();
+
+		/// <summary>
+		/// Get the version of the world transform, changes every time the local transform or that of an ancestor changes
+		/// </summary>
+		/// <returns>Version of the world transform</returns>
+		uint64_t GetVersion();
+
+		/// <summary>
+		/// Get the matrix the object is rendered with, the world matrix unless the transform is interpolated
+		/// </summary>
+		/// <returns>Reference to the render matrix</returns>
+		const glm::mat4& GetRenderMatrix();
+
+		/// <summary>
+		/// Get the version of the render matrix, changes every frame while an interpolated transform moves
+		/// </summary>
+		/// <returns>Version of the render matrix</returns>
+		uint64_t GetRenderVersion();
+
+		/// <summary>
+		/// Render the object between its last two fixed step states, for objects that are moved in FixedUpdate
+		/// </summary>
+		/// <param name="interpolate: ">true to enable interpolation</param>
+		void SetInterpolated(bool interpolate);
+
+		/// <summary>
+		/// Check if the object is rendered between its last two fixed step states
+		/// </summary>
+		/// <returns>True if the transform is interpolated</returns>
+		bool IsInterpolated() const;
+
+		/// <summary>
+		/// Stop interpolating from the previous fixed step state, call after teleporting an interpolated object
+		/// </summary>
+		void ResetInterpolation();
+
+
 		/// <summary>
 		/// Get the forward direction of the object
 		/// </summary>
@@ -363,63 +421,28 @@ namespace DDM
 		bool ReadFromFile(std::string&& fileName);
 
 	private:
+		// GameObject informs the transform when its parent changes
+		friend class GameObject;
 
-		// -------------------
-		// Position
-		// -------------------
-		
-		// Position relative to parent
-		glm::vec3 m_LocalPosition{};
-
-		// World position of parent
-		glm::vec3 m_ParentWorldPosition{};
-
-		// Position dirty flag
-		bool m_PositionDF{ true };
-
-		// -------------------
-		// Rotation
-		// -------------------
-
-		// Rotation relative to parent
-		glm::quat m_LocalRotation{ glm::identity<glm::quat>() };
-
-		// World rotation of parent
-		glm::quat m_ParentWorldRotation{};
-
-		// Rotation dirty flag
-		bool m_RotationDF{ true };
+		// Id of this transform in the TransformManager
+		uint32_t m_TransformId;
 
-		// -------------------
-		// Scale
-		// -------------------
+		// Cached inverse world matrix
+		glm::mat4 m_InverseWorldMatrix{};
 
-		// Scale relative to parent
-		glm::vec3 m_LocalScale{1, 1, 1};
+		// Version of the world matrix the inverse was calculated for
+		uint64_t m_InverseVersion{};
 
-		// World scale of parent
-		glm::vec3 m_ParentWorldScale{};
+		// Cached normal matrix
+		glm::mat3 m_NormalMatrix{};
 
-		// Scale dirty flag
-		bool m_ScaleDF{ true };
-
-		/// <summary>
-		/// Get parent position
-		/// </summary>
-		/// <returns>Reference to parent position</returns>
-		const glm::vec3& GetParentPosition();
-
-		/// <summary>
-		/// Get parent rotation
-		/// </summary>
-		/// <returns>Reference to parent rotation</returns>
-		const glm::quat& GetParentRotation();
+		// Version of the world matrix the normal matrix was calculated for
+		uint64_t m_NormalVersion{};
 
 		/// <summary>
-		/// Get parent scale
+		/// Update the parent of this transform in the TransformManager to match the owner's parent
 		/// </summary>
-		/// <returns>Reference to parent rotation</returns>
-		const glm::vec3& GetParentScale();
+		void OnParentChanged();
 	};
 }
 #endif // !_DDM_TRANSFORM_
@@ -8,6 +8,8 @@
 // File includes
 #include "Includes/VulkanIncludes.h"
 
+#include "Utils/FrameArena.h"
+
 // Standard libary includes
 #include <vector>
 
@@ -45,11 +47,11 @@ namespace DDM
 		/// Add the descriptor write objets to the list of descriptorWrites
 		/// </summary>
 		/// <param name="descriptorSet: ">current descriptorset connected to this descriptor object</param>
-		/// <param name="descriptorWrites: ">list of descriptorWrites to add to</param>
+		/// <param name="descriptorWrites: ">list of descriptorWrites to add to, allocated from the frame arena</param>
 		/// <param name="binding: ">current binding in the shader files</param>
 		/// <param name="amount: ">amount of elements in the array at this binding</param>
 		/// <param name="index">index of the current frame in flight</param>
-		virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) = 0;
+		virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) = 0;
 
 	protected:
 		// The type of descriptor this object will hold
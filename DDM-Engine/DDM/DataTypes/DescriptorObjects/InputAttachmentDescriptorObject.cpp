@@ -35,7 +35,7 @@ void DDM::InputAttachmentDescriptorObject::ClearImageViews()
 	m_ImageInfos.clear();
 }
 
-void DDM::InputAttachmentDescriptorObject::AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index)
+void DDM::InputAttachmentDescriptorObject::AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index)
 {
 	// Loop through the amount of descriptors at this binding
 	// This amount represents the size of the array if one is used
@@ -4,6 +4,8 @@
 #include "TextureDescriptorObject.h"
 #include "Vulkan/VulkanObject.h"
 
+#include "Managers/ResourceManager.h"
+
 DDM::TextureDescriptorObject::TextureDescriptorObject()
 	// Type of this object is combined image sampler
 	:DescriptorObject(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
@@ -40,8 +42,8 @@ void DDM::TextureDescriptorObject::AddTextures(std::initializer_list<const std::
 
 void DDM::TextureDescriptorObject::AddTexture(const std::string& filePath)
 {
-	// Create new texture
-	m_Textures.push_back(std::make_shared<Image>(filePath));
+	// Load the texture, textures that are in use already are shared
+	m_Textures.push_back(ResourceManager::GetInstance().LoadTexture(filePath));
 
 	// Indicate that image infos should be set up
 	m_AreImageInfosSetup = false;
@@ -63,7 +65,7 @@ size_t DDM::TextureDescriptorObject::GetTextureAmount() const
 	return m_Textures.size();
 }
 
-void DDM::TextureDescriptorObject::AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int /*index*/)
+void DDM::TextureDescriptorObject::AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int /*index*/)
 {
 	// If image infos need to be set up, do so
 	if (!m_AreImageInfosSetup)
@@ -67,7 +67,7 @@ namespace DDM
         /// <param name="binding: ">current binding in the shader files</param>
         /// <param name="amount: ">amount of elements in the array at this binding</param>
         /// <param name="index">index of the current frame in flight</param>
-        virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) override;
+        virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) override;
     private:
         // Indicates wether the image infos are set up
         bool m_AreImageInfosSetup{ true };
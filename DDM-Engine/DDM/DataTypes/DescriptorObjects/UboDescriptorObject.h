@@ -7,6 +7,7 @@
 // File includes
 #include "DescriptorObject.h"
 #include "Vulkan/VulkanObject.h"
+#include "Utils/ResourceTracker.h"
 
 // Standard library includes
 #include <vector>
@@ -37,7 +38,7 @@ namespace DDM
 		/// <param name="binding: ">current binding in the shader files</param>
 		/// <param name="amount: ">amount of elements in the array at this binding</param>
 		/// <param name="index">index of the current frame in flight</param>
-		virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) override;
+		virtual void AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index) override;
 
 		/// <summary>
 		/// Update the buffer of the object
@@ -96,7 +97,7 @@ namespace DDM
 	}
 
 	template<typename T>
-	inline void UboDescriptorObject<T>::AddDescriptorWrite(VkDescriptorSet descriptorSet, std::vector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index)
+	inline void UboDescriptorObject<T>::AddDescriptorWrite(VkDescriptorSet descriptorSet, FrameVector<VkWriteDescriptorSet>& descriptorWrites, int& binding, int amount, int index)
 	{
 		VkWriteDescriptorSet descriptorWrite{};
 
@@ -193,8 +194,10 @@ namespace DDM
 		{
 			// Destroy uboBuffers
 			vkDestroyBuffer(device, m_UboBuffers[i], nullptr);
+			ResourceTracker::Remove(TrackedResource::Buffers);
 			// Free ubo buffer memory
 			vkFreeMemory(device, m_UbosMemory[i], nullptr);
+			ResourceTracker::UntrackAllocation(m_UbosMemory[i]);
 		}
 	}
 }
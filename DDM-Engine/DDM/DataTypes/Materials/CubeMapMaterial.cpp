@@ -7,6 +7,8 @@
 #include "Vulkan/VulkanObject.h"
 #include "Vulkan/VulkanWrappers/DescriptorPoolWrapper.h"
 
+#include "Utils/FrameArena.h"
+
 #include "DataTypes/DescriptorObjects/TextureDescriptorObject.h"
 
 #include "Managers/ConfigManager.h"
@@ -37,7 +39,7 @@ DDM::CubeMapMaterial::CubeMapMaterial(std::string& pipelineName)
 	m_FilePaths.resize(6);
 }
 
-void DDM::CubeMapMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects)
+void DDM::CubeMapMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects)
 {
 	// If cubetexture is not initialized, set it up
 	if (!m_Initialized)
@@ -49,13 +51,7 @@ void DDM::CubeMapMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& de
 	auto descriptorPool = GetDescriptorPool();
 
 	// Create a vector for the descriptor objects
-	std::vector<DescriptorObject*> descriptorObjectList{};
-
-	// Add all the descriptor objects of the model to the list
-	for (auto& descriptorObject : descriptorObjects)
-	{
-		descriptorObjectList.push_back(descriptorObject);
-	}
+	FrameVector<DescriptorObject*> descriptorObjectList(descriptorObjects.begin(), descriptorObjects.end());
 
 	// Add the descriptor object holding the texture
 	descriptorObjectList.push_back(m_pDescriptorObject.get());
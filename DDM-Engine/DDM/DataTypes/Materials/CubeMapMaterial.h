@@ -64,7 +64,7 @@ namespace DDM
 		/// </summary>
 		/// <param name="descriptorSets: ">Vector of the descriptorsets to be updated</param>
 		/// <param name="descriptorObjects: ">Vector of pointers to descriptorobjects in the same order as the shader code</param>
-		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects) override;
+		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects) override;
 
 
 		/// <summary>
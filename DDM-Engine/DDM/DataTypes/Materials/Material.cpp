@@ -6,6 +6,7 @@
 // File includes
 #include "Includes/STBIncludes.h"
 
+#include "Utils/FrameArena.h"
 #include "Utils/Utils.h"
 
 #include "Vulkan/VulkanObject.h"
@@ -47,18 +48,13 @@ void DDM::Material::CreateDescriptorSets(MeshRenderComponent* pModel, std::vecto
 	descriptorPool->CreateDescriptorSets(GetDescriptorLayout(), descriptorSets);
 }
 
-void DDM::Material::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects)
+void DDM::Material::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects)
 {
 	// Get pointer to the descriptorpool wrapper
 	auto descriptorPool = GetDescriptorPool();
 
 	// Create list of descriptor objects and add the objects of the model to it
-	std::vector<DescriptorObject*> descriptorObjectList{};
-
-	for (auto& descriptorObject : descriptorObjects)
-	{
-		descriptorObjectList.push_back(descriptorObject);
-	}
+	FrameVector<DescriptorObject*> descriptorObjectList(descriptorObjects.begin(), descriptorObjects.end());
 
 	// Add the descriptor of the global light object
 	descriptorObjectList.push_back(VulkanObject::GetInstance().GetLightDescriptor());
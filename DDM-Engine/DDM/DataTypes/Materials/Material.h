@@ -9,6 +9,7 @@
 
 // Standard library includes
 #include <iostream>
+#include <span>
 
 namespace DDM
 {
@@ -72,7 +73,7 @@ namespace DDM
 		/// </summary>
 		/// <param name="descriptorSets: ">Reference to the vector holding the descriptorsets that should be updated</param>
 		/// <param name="descriptorObjects: ">List of descriptorobjects to be used to update descrptorsets</param>
-		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects);
+		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects);
 
 		/// <summary>
 		/// Get the descriptorset layout from the pipeline
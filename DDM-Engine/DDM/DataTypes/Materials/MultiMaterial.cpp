@@ -5,6 +5,8 @@
 // File includes
 #include "Vulkan/VulkanWrappers/DescriptorPoolWrapper.h"
 
+#include "Utils/FrameArena.h"
+
 #include "Includes/ImGuiIncludes.h"
 
 #include "Engine/Window.h"
@@ -63,18 +65,13 @@ void DDM::MultiMaterial::OnGUI()
 	}
 }
 
-void DDM::MultiMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects)
+void DDM::MultiMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects)
 {
 	// Get pointer to the descriptorpool wrapper
 	auto descriptorPool = GetDescriptorPool();
 
 	// Create list of descriptor objects and add the objects of the model to it
-	std::vector<DescriptorObject*> descriptorObjectList{};
-
-	for (auto& descriptorObject : descriptorObjects)
-	{
-		descriptorObjectList.push_back(descriptorObject);
-	}
+	FrameVector<DescriptorObject*> descriptorObjectList(descriptorObjects.begin(), descriptorObjects.end());
 
 	// Add the descriptor object of the global light
 	descriptorObjectList.push_back(VulkanObject::GetInstance().GetLightDescriptor());
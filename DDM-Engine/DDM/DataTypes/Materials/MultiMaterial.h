@@ -62,7 +62,7 @@ namespace DDM
 		// Parameters:
 		//     descriptorsets: the descriptorsets that should be updated
 		//     descriptorObjects: a vector of pointers to descriptorobjects in the same order as the shader code
-		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects) override;
+		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects) override;
 
 		/// <summary>
 		/// Add a single diffuse texture
@@ -10,6 +10,7 @@
 #include "Vulkan/VulkanWrappers/DescriptorPoolWrapper.h"
 #include "Vulkan/VulkanWrappers/PipelineWrapper.h"
 
+#include "Utils/FrameArena.h"
 #include "Utils/Utils.h"
 
 #include "Components/MeshRenderer.h"
@@ -47,18 +48,13 @@ void DDM::TexturedMaterial::AddTexture(const std::string&& path)
 	AddTexture(path);
 }
 
-void DDM::TexturedMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects)
+void DDM::TexturedMaterial::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects)
 {
 	// Get pointer to the descriptorpool wrapper
 	auto descriptorPool = GetDescriptorPool();
 
 	// Create list of descriptor objects and add the objects of the model to it
-	std::vector<DescriptorObject*> descriptorObjectList{};
-
-	for (auto& descriptorObject : descriptorObjects)
-	{
-		descriptorObjectList.push_back(descriptorObject);
-	}
+	FrameVector<DescriptorObject*> descriptorObjectList(descriptorObjects.begin(), descriptorObjects.end());
 
 	// Add the descriptor object of the global light
 	descriptorObjectList.push_back(VulkanObject::GetInstance().GetLightDescriptor());
@@ -54,7 +54,7 @@ namespace DDM
 		/// </summary>
 		/// <param name="descriptorSets: ">tDescriptorsets that should be updated</param>
 		/// <param name="descriptorObjects: ">Vector of pointers to descriptorobjects in the same order as the shader code</param>
-		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects) override;
+		virtual void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects) override;
 
 	private:
 		// List of descriptorobjects that hold the textures
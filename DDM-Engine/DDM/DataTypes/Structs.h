@@ -178,6 +178,53 @@ namespace DDM
 		}
 	};
 
+	// Per instance data for instanced rendering
+	// Read from a second vertex binding, used by shaders that have an input at the first instance location
+	struct InstanceData
+	{
+		// Binding the instance buffer is bound to
+		static constexpr uint32_t kBinding{ 1 };
+		// First location after the vertex attributes, a matrix takes 4 locations
+		static constexpr uint32_t kFirstLocation{ 8 };
+
+		// Transformation of the instance
+		glm::mat4 model{ 1.0f };
+
+		// Get vulkan binding description
+		static VkVertexInputBindingDescription getBindingDescription()
+		{
+			// Create binding description
+			VkVertexInputBindingDescription bindingDescription{};
+			// Set binding to the instance binding
+			bindingDescription.binding = kBinding;
+			// Set stride to the size of instance object
+			bindingDescription.stride = sizeof(InstanceData);
+			// Advance once per instance instead of per vertex
+			bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+			// Return binding description
+			return bindingDescription;
+		}
+
+		// Get attribute description of instance
+		static std::vector<VkVertexInputAttributeDescription> getAttributeDescription()
+		{
+			// A matrix is passed as 4 column vectors
+			std::vector<VkVertexInputAttributeDescription> attributeDescriptions(4);
+
+			for (uint32_t column{}; column < attributeDescriptions.size(); ++column)
+			{
+				attributeDescriptions[column].binding = kBinding;
+				attributeDescriptions[column].location = kFirstLocation + column;
+				attributeDescriptions[column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+				attributeDescriptions[column].offset = static_cast<uint32_t>(offsetof(InstanceData, model) + sizeof(glm::vec4) * column);
+			}
+
+			// Return attribute descriptions
+			return attributeDescriptions;
+		}
+	};
+
 	// Uniform buffer object
 		// Needed for transformations in shaders
 	struct UniformBufferObject
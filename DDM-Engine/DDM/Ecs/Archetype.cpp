@@ -0,0 +1,178 @@
+// Archetype.cpp
+
+// Header include
+#include "Archetype.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+DDM::Archetype::Archetype(EcsComponentMask mask)
+	:m_Mask{ mask }
+{
+	m_ColumnIndices.fill(kNoColumn);
+
+	// Create a column for every type in the mask, in order of type id
+	const auto& registry{ EcsTypeDetail::GetTypeRegistry() };
+
+	for (EcsTypeId typeId{}; typeId < kMaxEcsComponentTypes; ++typeId)
+	{
+		if (HasType(typeId))
+		{
+			m_ColumnIndices[typeId] = static_cast<uint8_t>(m_Columns.size());
+			m_Columns.push_back(Column{ registry[typeId] });
+		}
+	}
+
+	CalculateLayout();
+}
+
+DDM::Archetype::~Archetype()
+{
+	// Components are trivially destructible, so the chunks can be freed directly
+	for (auto pChunk : m_pChunks)
+	{
+		::operator delete(pChunk, std::align_val_t{ kEcsChunkAlignment });
+	}
+}
+
+uint32_t DDM::Archetype::GetChunkEntityCount(size_t chunkIndex) const
+{
+	// Every chunk is full except for the last one
+	const size_t firstRow{ chunkIndex * m_ChunkCapacity };
+
+	return static_cast<uint32_t>(std::min<size_t>(m_ChunkCapacity, m_EntityCount - firstRow));
+}
+
+const DDM::Entity* DDM::Archetype::GetEntities(size_t chunkIndex) const
+{
+	// The entity array is always at the start of the chunk
+	return reinterpret_cast<const Entity*>(m_pChunks[chunkIndex]);
+}
+
+void* DDM::Archetype::GetComponent(uint32_t row, EcsTypeId typeId) const
+{
+	const uint8_t columnIndex{ m_ColumnIndices[typeId] };
+
+	if (columnIndex == kNoColumn)
+	{
+		return nullptr;
+	}
+
+	return GetElement(m_Columns[columnIndex], row);
+}
+
+uint32_t DDM::Archetype::AddEntity(Entity entity)
+{
+	const uint32_t row{ m_EntityCount };
+
+	// Allocate a new chunk if the last one is full
+	Reserve(static_cast<size_t>(row) + 1);
+
+	++m_EntityCount;
+
+	// Store the entity and construct its components
+	auto pEntities{ reinterpret_cast<Entity*>(m_pChunks[row / m_ChunkCapacity]) };
+	pEntities[row % m_ChunkCapacity] = entity;
+
+	for (const auto& column : m_Columns)
+	{
+		column.pInfo->construct(GetElement(column, row));
+	}
+
+	return row;
+}
+
+DDM::Entity DDM::Archetype::RemoveEntity(uint32_t row)
+{
+	const uint32_t lastRow{ m_EntityCount - 1 };
+
+	--m_EntityCount;
+
+	// If the removed entity was the last one, nothing has to move
+	if (row == lastRow)
+	{
+		return Entity{};
+	}
+
+	// Move the last entity into the removed row
+	auto pEntities{ reinterpret_cast<Entity*>(m_pChunks[row / m_ChunkCapacity]) };
+	auto pLastEntities{ reinterpret_cast<Entity*>(m_pChunks[lastRow / m_ChunkCapacity]) };
+
+	const Entity movedEntity{ pLastEntities[lastRow % m_ChunkCapacity] };
+	pEntities[row % m_ChunkCapacity] = movedEntity;
+
+	for (const auto& column : m_Columns)
+	{
+		std::memcpy(GetElement(column, row), GetElement(column, lastRow), column.pInfo->size);
+	}
+
+	return movedEntity;
+}
+
+void DDM::Archetype::CopyComponents(uint32_t row, const Archetype& source, uint32_t sourceRow)
+{
+	for (const auto& column : m_Columns)
+	{
+		// Skip types the source doesn't have, they keep their default value
+		const uint8_t sourceColumnIndex{ source.m_ColumnIndices[column.pInfo->id] };
+
+		if (sourceColumnIndex == kNoColumn)
+		{
+			continue;
+		}
+
+		std::memcpy(GetElement(column, row), source.GetElement(source.m_Columns[sourceColumnIndex], sourceRow), column.pInfo->size);
+	}
+}
+
+void DDM::Archetype::Reserve(size_t count)
+{
+	// Allocate chunks until there is room for the requested amount of entities
+	while (m_pChunks.size() * m_ChunkCapacity < count)
+	{
+		m_pChunks.push_back(static_cast<std::byte*>(::operator new(kEcsChunkSize, std::align_val_t{ kEcsChunkAlignment })));
+	}
+}
+
+void DDM::Archetype::CalculateLayout()
+{
+	// Every entity needs its handle and one element of every column
+	size_t rowSize{ sizeof(Entity) };
+
+	for (const auto& column : m_Columns)
+	{
+		rowSize += column.pInfo->size;
+	}
+
+	// Start with the capacity ignoring padding and lower it until all arrays fit
+	m_ChunkCapacity = static_cast<uint32_t>(kEcsChunkSize / rowSize);
+
+	while (m_ChunkCapacity > 0)
+	{
+		size_t offset{ sizeof(Entity) * m_ChunkCapacity };
+
+		for (auto& column : m_Columns)
+		{
+			// Align the start of every array to the alignment of its type
+			offset = (offset + column.pInfo->alignment - 1) / column.pInfo->alignment * column.pInfo->alignment;
+			column.offset = offset;
+			offset += static_cast<size_t>(column.pInfo->size) * m_ChunkCapacity;
+		}
+
+		if (offset <= kEcsChunkSize)
+		{
+			return;
+		}
+
+		--m_ChunkCapacity;
+	}
+
+	throw std::runtime_error("ecs archetype doesn't fit in a single chunk!");
+}
+
+std::byte* DDM::Archetype::GetElement(const Column& column, uint32_t row) const
+{
+	return m_pChunks[row / m_ChunkCapacity] + column.offset + static_cast<size_t>(column.pInfo->size) * (row % m_ChunkCapacity);
+}
@@ -0,0 +1,184 @@
+// Archetype.h
+// This class stores all entities that have exactly the same set of ecs components
+// Entities are stored in fixed size chunks, inside a chunk every component type has its own tightly packed array
+// Entities are kept densely packed, removing one moves the last entity into the hole
+
+#ifndef ArchetypeIncluded
+#define ArchetypeIncluded
+
+// File includes
+#include "EcsTypes.h"
+
+// Standard library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DDM
+{
+	class Archetype final
+	{
+	public:
+		// Column index used for types that are not part of the archetype
+		static constexpr uint8_t kNoColumn{ 0xFF };
+
+		// Constructor
+		// Parameters:
+		//     mask: the mask of the component types stored in this archetype
+		explicit Archetype(EcsComponentMask mask);
+
+		// Destructor, frees all chunks
+		~Archetype();
+
+		// Rule of five
+		Archetype(const Archetype& other) = delete;
+		Archetype(Archetype&& other) = delete;
+		Archetype& operator=(const Archetype& other) = delete;
+		Archetype& operator=(Archetype&& other) = delete;
+
+		// Get the mask of the component types stored in this archetype
+		EcsComponentMask GetMask() const { return m_Mask; }
+
+		// Check if this archetype stores a component type
+		// Parameters:
+		//     typeId: the id of the component type
+		bool HasType(EcsTypeId typeId) const { return (m_Mask >> typeId) & 1; }
+
+		// Get the amount of entities stored in this archetype
+		uint32_t GetEntityCount() const { return m_EntityCount; }
+
+		// Get the maximum amount of entities in a single chunk
+		uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+
+		// Get the amount of chunks that contain entities
+		size_t GetChunkCount() const { return (m_EntityCount + m_ChunkCapacity - 1) / m_ChunkCapacity; }
+
+		// Get the amount of entities in a chunk
+		// Parameters:
+		//     chunkIndex: index of the chunk
+		uint32_t GetChunkEntityCount(size_t chunkIndex) const;
+
+		// Get the entities stored in a chunk
+		// Parameters:
+		//     chunkIndex: index of the chunk
+		const Entity* GetEntities(size_t chunkIndex) const;
+
+		// Get the array of a component type in a chunk
+		// Parameters:
+		//     chunkIndex: index of the chunk
+		// Returns: pointer to the first element, nullptr if the type is not part of this archetype
+		template <class T>
+		T* GetColumn(size_t chunkIndex) const;
+
+		// Get a component of an entity
+		// Parameters:
+		//     row: index of the entity in this archetype
+		//     typeId: id of the component type
+		// Returns: pointer to the component, nullptr if the type is not part of this archetype
+		void* GetComponent(uint32_t row, EcsTypeId typeId) const;
+
+		// Add an entity, all of its components are default constructed
+		// Parameters:
+		//     entity: the entity to add
+		// Returns: the index of the entity in this archetype
+		uint32_t AddEntity(Entity entity);
+
+		// Remove an entity by moving the last entity into its place
+		// Parameters:
+		//     row: index of the entity to remove
+		// Returns: the entity that was moved into the row, an unassigned handle if no entity was moved
+		Entity RemoveEntity(uint32_t row);
+
+		// Copy all components both archetypes have in common from an entity in another archetype
+		// Parameters:
+		//     row: index of the entity in this archetype
+		//     source: the archetype to copy from
+		//     sourceRow: index of the entity in the source archetype
+		void CopyComponents(uint32_t row, const Archetype& source, uint32_t sourceRow);
+
+		// Make sure enough chunks are allocated for an amount of entities
+		// Parameters:
+		//     count: the total amount of entities
+		void Reserve(size_t count);
+
+		// Get the cached archetype that has one more component type than this one, nullptr if not cached yet
+		// Parameters:
+		//     typeId: id of the added component type
+		Archetype* GetAddEdge(EcsTypeId typeId) const { return m_AddEdges[typeId]; }
+
+		// Get the cached archetype that has one less component type than this one, nullptr if not cached yet
+		// Parameters:
+		//     typeId: id of the removed component type
+		Archetype* GetRemoveEdge(EcsTypeId typeId) const { return m_RemoveEdges[typeId]; }
+
+		// Cache the archetype that has one more component type than this one
+		// Parameters:
+		//     typeId: id of the added component type
+		//     pArchetype: the archetype with the added type
+		void SetAddEdge(EcsTypeId typeId, Archetype* pArchetype) { m_AddEdges[typeId] = pArchetype; }
+
+		// Cache the archetype that has one less component type than this one
+		// Parameters:
+		//     typeId: id of the removed component type
+		//     pArchetype: the archetype without the removed type
+		void SetRemoveEdge(EcsTypeId typeId, Archetype* pArchetype) { m_RemoveEdges[typeId] = pArchetype; }
+
+	private:
+		// Column of a single component type
+		struct Column
+		{
+			// Type info of the component
+			const EcsTypeInfo* pInfo{};
+
+			// Offset of the array in every chunk
+			size_t offset{};
+		};
+
+		// Mask of the stored component types
+		EcsComponentMask m_Mask{};
+
+		// Columns of all stored component types, sorted by type id
+		std::vector<Column> m_Columns{};
+
+		// Index into the columns for every type id
+		std::array<uint8_t, kMaxEcsComponentTypes> m_ColumnIndices{};
+
+		// Maximum amount of entities per chunk
+		uint32_t m_ChunkCapacity{};
+
+		// Amount of stored entities
+		uint32_t m_EntityCount{};
+
+		// Allocated chunks, chunks past the last entity are kept for reuse
+		std::vector<std::byte*> m_pChunks{};
+
+		// Archetypes reached by adding or removing a single component type
+		std::array<Archetype*, kMaxEcsComponentTypes> m_AddEdges{};
+		std::array<Archetype*, kMaxEcsComponentTypes> m_RemoveEdges{};
+
+		// Calculate the chunk capacity and the offset of every column
+		void CalculateLayout();
+
+		// Get the address of a component in a chunk
+		// Parameters:
+		//     column: the column of the component type
+		//     row: index of the entity in this archetype
+		std::byte* GetElement(const Column& column, uint32_t row) const;
+	};
+
+	template <class T>
+	inline T* Archetype::GetColumn(size_t chunkIndex) const
+	{
+		const uint8_t columnIndex{ m_ColumnIndices[GetEcsTypeId<T>()] };
+
+		if (columnIndex == kNoColumn)
+		{
+			return nullptr;
+		}
+
+		return reinterpret_cast<T*>(m_pChunks[chunkIndex] + m_Columns[columnIndex].offset);
+	}
+}
+
+#endif // !ArchetypeIncluded
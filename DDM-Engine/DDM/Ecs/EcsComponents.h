@@ -0,0 +1,64 @@
+// EcsComponents.h
+// This file defines the built in ecs components used by the built in systems
+// Components are plain data, the logic lives in the systems in EcsSystems.h
+
+#ifndef EcsComponentsIncluded
+#define EcsComponentsIncluded
+
+// File includes
+#include "Includes/GLMIncludes.h"
+
+// Standard library includes
+#include <cstdint>
+
+namespace DDM
+{
+	// Position of an entity in world space
+	struct EcsPosition final
+	{
+		glm::vec3 value{};
+	};
+
+	// Rotation of an entity in world space
+	struct EcsRotation final
+	{
+		glm::quat value{ 1.f, 0.f, 0.f, 0.f };
+	};
+
+	// Scale of an entity
+	struct EcsScale final
+	{
+		glm::vec3 value{ 1.f, 1.f, 1.f };
+	};
+
+	// Movement of an entity in units per second
+	struct EcsVelocity final
+	{
+		glm::vec3 value{};
+	};
+
+	// Rotation of an entity around an axis
+	struct EcsAngularVelocity final
+	{
+		// Normalized rotation axis
+		glm::vec3 axis{ 0.f, 1.f, 0.f };
+
+		// Rotation speed in radians per second
+		float speed{};
+	};
+
+	// World matrix built from position, rotation and scale
+	struct EcsWorldMatrix final
+	{
+		glm::mat4 value{ 1.f };
+	};
+
+	// Marks an entity to be drawn by a batch of the render system
+	struct EcsMeshInstance final
+	{
+		// Id returned by EcsRenderSystem::AddBatch
+		uint32_t batchId{};
+	};
+}
+
+#endif // !EcsComponentsIncluded
@@ -0,0 +1,206 @@
+// EcsQuery.h
+// This class iterates over all entities that have a set of ecs components
+// Matching archetypes are cached, so only archetypes created since the last run have to be checked
+// Mark a type const to show it is only read, for example EcsQuery<const EcsPosition, EcsWorldMatrix>
+
+#ifndef EcsQueryIncluded
+#define EcsQueryIncluded
+
+// File includes
+#include "EcsWorld.h"
+
+#include "Engine/JobSystem.h"
+
+// Standard library includes
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace DDM
+{
+	template <class... Ts>
+	class EcsQuery final
+	{
+	public:
+		// Default constructor
+		EcsQuery() = default;
+
+		// Default destructor
+		~EcsQuery() = default;
+
+		// Rule of five
+		EcsQuery(const EcsQuery& other) = delete;
+		EcsQuery(EcsQuery&& other) = delete;
+		EcsQuery& operator=(const EcsQuery& other) = delete;
+		EcsQuery& operator=(EcsQuery&& other) = delete;
+
+		// Call a function for every chunk with matching entities
+		// Parameters:
+		//     world: the world to search
+		//     function: called as function(uint32_t count, const Entity* pEntities, Ts*... pComponents)
+		template <class Function>
+		void ForEachChunk(EcsWorld& world, Function&& function);
+
+		// Call a function for every matching entity
+		// Parameters:
+		//     world: the world to search
+		//     function: called as function(Ts&... components)
+		template <class Function>
+		void ForEach(EcsWorld& world, Function&& function);
+
+		// Call a function for every chunk with matching entities, chunks are split over parallel jobs
+		// The function must only write to the components of the chunk it gets
+		// Parameters:
+		//     world: the world to search
+		//     pJobSystem: job system to run the jobs on, nullptr to run on this thread
+		//     function: called as function(uint32_t count, const Entity* pEntities, Ts*... pComponents)
+		template <class Function>
+		void ParallelForEachChunk(EcsWorld& world, JobSystem* pJobSystem, Function&& function);
+
+		// Get the amount of matching entities
+		// Parameters:
+		//     world: the world to search
+		size_t GetEntityCount(EcsWorld& world);
+
+	private:
+		// World the cached archetypes belong to
+		const EcsWorld* m_pWorld{};
+
+		// Archetypes that have all types of the query
+		std::vector<Archetype*> m_pArchetypes{};
+
+		// Amount of archetypes of the world that were already checked
+		size_t m_CheckedArchetypeCount{};
+
+		// List of all matching chunks, reused by parallel iteration
+		std::vector<std::pair<Archetype*, size_t>> m_Chunks{};
+
+		// Check the archetypes created since the last run
+		// Parameters:
+		//     world: the world to search
+		void UpdateMatches(const EcsWorld& world);
+
+		// Call the function for a single chunk
+		// Parameters:
+		//     archetype: the archetype the chunk belongs to
+		//     chunkIndex: index of the chunk
+		//     function: the function to call
+		template <class Function>
+		static void RunChunk(const Archetype& archetype, size_t chunkIndex, Function& function);
+	};
+
+	template <class... Ts>
+	template <class Function>
+	inline void EcsQuery<Ts...>::ForEachChunk(EcsWorld& world, Function&& function)
+	{
+		UpdateMatches(world);
+
+		for (auto pArchetype : m_pArchetypes)
+		{
+			const size_t chunkCount{ pArchetype->GetChunkCount() };
+
+			for (size_t chunkIndex{}; chunkIndex < chunkCount; ++chunkIndex)
+			{
+				RunChunk(*pArchetype, chunkIndex, function);
+			}
+		}
+	}
+
+	template <class... Ts>
+	template <class Function>
+	inline void EcsQuery<Ts...>::ForEach(EcsWorld& world, Function&& function)
+	{
+		ForEachChunk(world, [&function](uint32_t count, const Entity*, Ts*... pComponents)
+			{
+				for (uint32_t index{}; index < count; ++index)
+				{
+					function(pComponents[index]...);
+				}
+			});
+	}
+
+	template <class... Ts>
+	template <class Function>
+	inline void EcsQuery<Ts...>::ParallelForEachChunk(EcsWorld& world, JobSystem* pJobSystem, Function&& function)
+	{
+		if (pJobSystem == nullptr)
+		{
+			ForEachChunk(world, function);
+			return;
+		}
+
+		UpdateMatches(world);
+
+		// Gather all chunks so they can be split evenly over the jobs
+		m_Chunks.clear();
+
+		for (auto pArchetype : m_pArchetypes)
+		{
+			const size_t chunkCount{ pArchetype->GetChunkCount() };
+
+			for (size_t chunkIndex{}; chunkIndex < chunkCount; ++chunkIndex)
+			{
+				m_Chunks.emplace_back(pArchetype, chunkIndex);
+			}
+		}
+
+		// A chunk already holds enough entities to be worth a job on its own
+		pJobSystem->ParallelFor(m_Chunks.size(), 1, [this, &function](size_t begin, size_t end)
+			{
+				for (size_t index{ begin }; index < end; ++index)
+				{
+					RunChunk(*m_Chunks[index].first, m_Chunks[index].second, function);
+				}
+			});
+	}
+
+	template <class... Ts>
+	inline size_t EcsQuery<Ts...>::GetEntityCount(EcsWorld& world)
+	{
+		UpdateMatches(world);
+
+		size_t count{};
+
+		for (auto pArchetype : m_pArchetypes)
+		{
+			count += pArchetype->GetEntityCount();
+		}
+
+		return count;
+	}
+
+	template <class... Ts>
+	inline void EcsQuery<Ts...>::UpdateMatches(const EcsWorld& world)
+	{
+		// If the query is used with another world, start over
+		if (m_pWorld != &world)
+		{
+			m_pWorld = &world;
+			m_pArchetypes.clear();
+			m_CheckedArchetypeCount = 0;
+		}
+
+		const auto& pArchetypes{ world.GetArchetypes() };
+		const EcsComponentMask mask{ GetEcsComponentMask<Ts...>() };
+
+		// Only archetypes created since the last check have to be tested
+		for (; m_CheckedArchetypeCount < pArchetypes.size(); ++m_CheckedArchetypeCount)
+		{
+			auto pArchetype{ pArchetypes[m_CheckedArchetypeCount].get() };
+
+			if ((pArchetype->GetMask() & mask) == mask)
+			{
+				m_pArchetypes.push_back(pArchetype);
+			}
+		}
+	}
+
+	template <class... Ts>
+	template <class Function>
+	inline void EcsQuery<Ts...>::RunChunk(const Archetype& archetype, size_t chunkIndex, Function& function)
+	{
+		function(archetype.GetChunkEntityCount(chunkIndex), archetype.GetEntities(chunkIndex), archetype.template GetColumn<Ts>(chunkIndex)...);
+	}
+}
+
+#endif // !EcsQueryIncluded
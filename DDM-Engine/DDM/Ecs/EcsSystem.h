@@ -0,0 +1,43 @@
+// EcsSystem.h
+// This class serves as the base for any ecs system
+// A system holds the logic that runs over all entities matching one or more queries
+
+#ifndef EcsSystemIncluded
+#define EcsSystemIncluded
+
+namespace DDM
+{
+	// Class forward declarations
+	class EcsWorld;
+	class JobSystem;
+
+	class EcsSystem
+	{
+	public:
+		/// <summary>
+		/// Default constructor
+		/// </summary>
+		EcsSystem() = default;
+
+		/// <summary>
+		/// Default destructor
+		/// </summary>
+		virtual ~EcsSystem() = default;
+
+		// Rule of five
+		EcsSystem(const EcsSystem& other) = delete;
+		EcsSystem(EcsSystem&& other) = delete;
+		EcsSystem& operator=(const EcsSystem& other) = delete;
+		EcsSystem& operator=(EcsSystem&& other) = delete;
+
+		/// <summary>
+		/// Run the system once, called every frame during the update phase
+		/// Entities and components can't be added or removed while the system iterates over a query
+		/// </summary>
+		/// <param name="world: ">The world the system belongs to</param>
+		/// <param name="pJobSystem: ">Job system to split the work over, nullptr to run everything on this thread</param>
+		virtual void Update(EcsWorld& world, JobSystem* pJobSystem) = 0;
+	};
+}
+
+#endif // !EcsSystemIncluded
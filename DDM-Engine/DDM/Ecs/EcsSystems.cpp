@@ -0,0 +1,99 @@
+// EcsSystems.cpp
+
+// Header include
+#include "EcsSystems.h"
+
+// File includes
+#include "Components/InstancedMeshRenderer.h"
+
+#include "Managers/TimeManager.h"
+
+void DDM::EcsMovementSystem::Update(EcsWorld& world, JobSystem* pJobSystem)
+{
+	const float deltaTime{ TimeManager::GetInstance().GetDeltaTime() };
+
+	m_Query.ParallelForEachChunk(world, pJobSystem,
+		[deltaTime](uint32_t count, const Entity*, EcsPosition* pPositions, const EcsVelocity* pVelocities)
+		{
+			for (uint32_t index{}; index < count; ++index)
+			{
+				pPositions[index].value += pVelocities[index].value * deltaTime;
+			}
+		});
+}
+
+void DDM::EcsRotationSystem::Update(EcsWorld& world, JobSystem* pJobSystem)
+{
+	const float deltaTime{ TimeManager::GetInstance().GetDeltaTime() };
+
+	m_Query.ParallelForEachChunk(world, pJobSystem,
+		[deltaTime](uint32_t count, const Entity*, EcsRotation* pRotations, const EcsAngularVelocity* pAngularVelocities)
+		{
+			for (uint32_t index{}; index < count; ++index)
+			{
+				const auto& angularVelocity{ pAngularVelocities[index] };
+				auto& rotation{ pRotations[index].value };
+
+				// Normalize to keep rounding errors from building up over many frames
+				rotation = glm::normalize(glm::angleAxis(angularVelocity.speed * deltaTime, angularVelocity.axis) * rotation);
+			}
+		});
+}
+
+void DDM::EcsTransformSystem::Update(EcsWorld& world, JobSystem* pJobSystem)
+{
+	m_Query.ParallelForEachChunk(world, pJobSystem,
+		[](uint32_t count, const Entity*, const EcsPosition* pPositions, const EcsRotation* pRotations, const EcsScale* pScales, EcsWorldMatrix* pMatrices)
+		{
+			for (uint32_t index{}; index < count; ++index)
+			{
+				const glm::vec3& scale{ pScales[index].value };
+
+				// Build the world matrix as translation * rotation * scale
+				glm::mat4& matrix{ pMatrices[index].value };
+				matrix = glm::mat4_cast(pRotations[index].value);
+				matrix[0] *= scale.x;
+				matrix[1] *= scale.y;
+				matrix[2] *= scale.z;
+				matrix[3] = glm::vec4(pPositions[index].value, 1.f);
+			}
+		});
+}
+
+uint32_t DDM::EcsRenderSystem::AddBatch(InstancedMeshRenderComponent* pRenderer)
+{
+	m_Batches.push_back(pRenderer->GetHandle());
+
+	return static_cast<uint32_t>(m_Batches.size() - 1);
+}
+
+void DDM::EcsRenderSystem::Update(EcsWorld& world, JobSystem*)
+{
+	// Resolve every renderer once and clear the instances of last frame
+	m_pRenderers.resize(m_Batches.size());
+
+	for (size_t batchId{}; batchId < m_Batches.size(); ++batchId)
+	{
+		m_pRenderers[batchId] = Component::Resolve<InstancedMeshRenderComponent>(m_Batches[batchId]);
+
+		if (m_pRenderers[batchId] != nullptr)
+		{
+			m_pRenderers[batchId]->ClearInstances();
+		}
+	}
+
+	// Copy the world matrices to the renderers, these are contiguous so this is a straight copy per chunk
+	m_Query.ForEachChunk(world,
+		[this](uint32_t count, const Entity*, const EcsWorldMatrix* pMatrices, const EcsMeshInstance* pInstances)
+		{
+			for (uint32_t index{}; index < count; ++index)
+			{
+				const uint32_t batchId{ pInstances[index].batchId };
+
+				if (batchId < m_pRenderers.size() && m_pRenderers[batchId] != nullptr)
+				{
+					m_pRenderers[batchId]->AddInstance(pMatrices[index].value);
+				}
+			}
+		});
+}
@@ -0,0 +1,100 @@
+// EcsSystems.h
+// This file defines the built in ecs systems
+// Together they move entities, build their world matrices and hand them to instanced mesh renderers
+
+#ifndef EcsSystemsIncluded
+#define EcsSystemsIncluded
+
+// Parent include
+#include "EcsSystem.h"
+
+// File includes
+#include "EcsComponents.h"
+#include "EcsQuery.h"
+
+#include "BaseClasses/Component.h"
+
+// Standard library includes
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class InstancedMeshRenderComponent;
+
+	class EcsMovementSystem final : public EcsSystem
+	{
+	public:
+		/// <summary>
+		/// Move every entity with a position and velocity
+		/// </summary>
+		/// <param name="world: ">The world the system belongs to</param>
+		/// <param name="pJobSystem: ">Job system to split the work over, nullptr to run everything on this thread</param>
+		virtual void Update(EcsWorld& world, JobSystem* pJobSystem) override;
+
+	private:
+		// Entities that move
+		EcsQuery<EcsPosition, const EcsVelocity> m_Query{};
+	};
+
+	class EcsRotationSystem final : public EcsSystem
+	{
+	public:
+		/// <summary>
+		/// Rotate every entity with a rotation and angular velocity
+		/// </summary>
+		/// <param name="world: ">The world the system belongs to</param>
+		/// <param name="pJobSystem: ">Job system to split the work over, nullptr to run everything on this thread</param>
+		virtual void Update(EcsWorld& world, JobSystem* pJobSystem) override;
+
+	private:
+		// Entities that rotate
+		EcsQuery<EcsRotation, const EcsAngularVelocity> m_Query{};
+	};
+
+	class EcsTransformSystem final : public EcsSystem
+	{
+	public:
+		/// <summary>
+		/// Build the world matrix of every entity with a position, rotation, scale and world matrix
+		/// </summary>
+		/// <param name="world: ">The world the system belongs to</param>
+		/// <param name="pJobSystem: ">Job system to split the work over, nullptr to run everything on this thread</param>
+		virtual void Update(EcsWorld& world, JobSystem* pJobSystem) override;
+
+	private:
+		// Entities that have a world matrix
+		EcsQuery<const EcsPosition, const EcsRotation, const EcsScale, EcsWorldMatrix> m_Query{};
+	};
+
+	class EcsRenderSystem final : public EcsSystem
+	{
+	public:
+		/// <summary>
+		/// Add an instanced mesh renderer that draws all entities with the returned batch id
+		/// The renderer is referenced by handle, a destroyed renderer is skipped
+		/// </summary>
+		/// <param name="pRenderer: ">The renderer that draws the batch</param>
+		/// <returns>Id to store in EcsMeshInstance</returns>
+		uint32_t AddBatch(InstancedMeshRenderComponent* pRenderer);
+
+		/// <summary>
+		/// Copy the world matrix of every mesh instance to the renderer of its batch
+		/// </summary>
+		/// <param name="world: ">The world the system belongs to</param>
+		/// <param name="pJobSystem: ">Not used, filling the instance lists is a single copy per entity</param>
+		virtual void Update(EcsWorld& world, JobSystem* pJobSystem) override;
+
+	private:
+		// Renderer of every batch, indexed by batch id
+		std::vector<ComponentHandle> m_Batches{};
+
+		// Resolved renderers of the current update, reused to avoid allocating every frame
+		std::vector<InstancedMeshRenderComponent*> m_pRenderers{};
+
+		// Entities that are drawn
+		EcsQuery<const EcsWorldMatrix, const EcsMeshInstance> m_Query{};
+	};
+}
+
+#endif // !EcsSystemsIncluded
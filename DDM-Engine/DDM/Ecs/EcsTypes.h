@@ -0,0 +1,167 @@
+// EcsTypes.h
+// This file defines the basic types of the entity component system
+// Ecs components are plain data structs, every type gets a small id so a set of types fits in a bitmask
+
+#ifndef EcsTypesIncluded
+#define EcsTypesIncluded
+
+// File includes
+#include "Utils/SlotTable.h"
+
+// Standard library includes
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace DDM
+{
+	// Tag type used to give entity handles their own type
+	struct EntityTag;
+
+	// Generational handle to an entity, stays invalid after the entity is destroyed
+	using Entity = Handle<EntityTag>;
+
+	// Numeric id of an ecs component type
+	using EcsTypeId = uint32_t;
+
+	// Bitmask with a bit set for every ecs component type in a set
+	using EcsComponentMask = uint64_t;
+
+	// Maximum amount of ecs component types, limited by the size of the mask
+	constexpr uint32_t kMaxEcsComponentTypes{ 64 };
+
+	// Size of a single chunk of entity data in bytes
+	constexpr size_t kEcsChunkSize{ 16 * 1024 };
+
+	// Alignment of a chunk, also the maximum alignment of an ecs component type
+	constexpr size_t kEcsChunkAlignment{ 64 };
+
+	// Information needed to store an ecs component type in a chunk
+	struct EcsTypeInfo final
+	{
+		// Id of the type
+		EcsTypeId id{};
+
+		// Size of the type in bytes
+		uint32_t size{};
+
+		// Alignment of the type in bytes
+		uint32_t alignment{};
+
+		// Construct a default value of the type at a memory location
+		void (*construct)(void* pMemory){};
+	};
+
+	namespace EcsTypeDetail
+	{
+		/// <summary>
+		/// Get the list of all registered ecs component types, indexed by type id
+		/// </summary>
+		/// <returns>Reference to the list</returns>
+		inline std::array<const EcsTypeInfo*, kMaxEcsComponentTypes>& GetTypeRegistry()
+		{
+			static std::array<const EcsTypeInfo*, kMaxEcsComponentTypes> registry{};
+			return registry;
+		}
+
+		/// <summary>
+		/// Hand out the next free ecs type id
+		/// </summary>
+		/// <returns>New ecs type id</returns>
+		inline EcsTypeId NextEcsTypeId()
+		{
+			static std::atomic<EcsTypeId> counter{};
+
+			const EcsTypeId id{ counter.fetch_add(1, std::memory_order_relaxed) };
+
+			if (id >= kMaxEcsComponentTypes)
+			{
+				throw std::runtime_error("too many ecs component types registered!");
+			}
+
+			return id;
+		}
+
+		/// <summary>
+		/// Create the type info of T
+		/// </summary>
+		/// <typeparam name="T">Type of ecs component</typeparam>
+		/// <returns>The type info</returns>
+		template <class T>
+		EcsTypeInfo CreateTypeInfo()
+		{
+			return EcsTypeInfo{ NextEcsTypeId(), static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)),
+				[](void* pMemory) { new (pMemory) T{}; } };
+		}
+
+		/// <summary>
+		/// Add a type info to the registry
+		/// </summary>
+		/// <param name="info: ">The type info, must have a stable address</param>
+		/// <returns>Always true, used to register once through a static</returns>
+		inline bool RegisterTypeInfo(const EcsTypeInfo& info)
+		{
+			GetTypeRegistry()[info.id] = &info;
+			return true;
+		}
+	}
+
+	/// <summary>
+	/// Get the type info of ecs component type T
+	/// Ecs components are copied with memcpy when entities move between archetypes and are never destructed,
+	/// so they have to be trivially copyable and trivially destructible
+	/// </summary>
+	/// <typeparam name="T">Type of ecs component</typeparam>
+	/// <returns>Reference to the type info</returns>
+	template <class T>
+	const EcsTypeInfo& GetEcsTypeInfo()
+	{
+		// Const types share the info of the mutable type, queries use const to mark read only access
+		if constexpr (std::is_const_v<T>)
+		{
+			return GetEcsTypeInfo<std::remove_const_t<T>>();
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+				"Ecs components must be trivially copyable and destructible");
+			static_assert(alignof(T) <= kEcsChunkAlignment, "Ecs component alignment is larger than the chunk alignment");
+
+			static const EcsTypeInfo info{ EcsTypeDetail::CreateTypeInfo<T>() };
+
+			// Register the info the first time it is requested so archetypes can look it up by id
+			static const bool isRegistered{ EcsTypeDetail::RegisterTypeInfo(info) };
+			(void)isRegistered;
+
+			return info;
+		}
+	}
+
+	/// <summary>
+	/// Get the id of ecs component type T
+	/// </summary>
+	/// <typeparam name="T">Type of ecs component</typeparam>
+	/// <returns>Id of the type</returns>
+	template <class T>
+	EcsTypeId GetEcsTypeId()
+	{
+		return GetEcsTypeInfo<T>().id;
+	}
+
+	/// <summary>
+	/// Get the mask of a set of ecs component types
+	/// </summary>
+	/// <typeparam name="Ts">Types of ecs components</typeparam>
+	/// <returns>Mask with the bit of every type set</returns>
+	template <class... Ts>
+	EcsComponentMask GetEcsComponentMask()
+	{
+		return (EcsComponentMask{} | ... | (EcsComponentMask{ 1 } << GetEcsTypeId<Ts>()));
+	}
+}
+
+#endif // !EcsTypesIncluded
@@ -0,0 +1,125 @@
+// EcsWorld.cpp
+
+// Header include
+#include "EcsWorld.h"
+
+void DDM::EcsWorld::DestroyEntity(Entity entity)
+{
+	auto pRecord{ GetRecord(entity) };
+
+	// If the entity doesn't exist, return
+	if (pRecord == nullptr)
+	{
+		return;
+	}
+
+	RemoveFromArchetype(*pRecord);
+
+	// Free the slot and invalidate all handles to it
+	auto& record{ m_Records[entity.index] };
+	record.pArchetype = nullptr;
+	++record.generation;
+
+	m_FreeIndices.push_back(entity.index);
+	--m_EntityCount;
+}
+
+bool DDM::EcsWorld::IsAlive(Entity entity) const
+{
+	return GetRecord(entity) != nullptr;
+}
+
+void DDM::EcsWorld::Update(JobSystem* pJobSystem)
+{
+	for (auto& pSystem : m_pSystems)
+	{
+		pSystem->Update(*this, pJobSystem);
+	}
+}
+
+const DDM::EcsWorld::EntityRecord* DDM::EcsWorld::GetRecord(Entity entity) const
+{
+	if (entity.index >= m_Records.size())
+	{
+		return nullptr;
+	}
+
+	const auto& record{ m_Records[entity.index] };
+
+	if (record.pArchetype == nullptr || record.generation != entity.generation)
+	{
+		return nullptr;
+	}
+
+	return &record;
+}
+
+DDM::Archetype* DDM::EcsWorld::GetOrCreateArchetype(EcsComponentMask mask)
+{
+	// If the archetype already exists, return it
+	if (auto it{ m_pArchetypesByMask.find(mask) }; it != m_pArchetypesByMask.end())
+	{
+		return it->second;
+	}
+
+	// Create the archetype
+	auto pArchetype{ m_pArchetypes.emplace_back(std::make_unique<Archetype>(mask)).get() };
+	m_pArchetypesByMask.emplace(mask, pArchetype);
+
+	return pArchetype;
+}
+
+DDM::Entity DDM::EcsWorld::CreateEntityInArchetype(Archetype* pArchetype)
+{
+	// Reuse a free index if there is one
+	uint32_t index{};
+
+	if (!m_FreeIndices.empty())
+	{
+		index = m_FreeIndices.back();
+		m_FreeIndices.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(m_Records.size());
+		m_Records.emplace_back();
+	}
+
+	auto& record{ m_Records[index] };
+	const Entity entity{ index, record.generation };
+
+	// Store the entity in the archetype
+	record.pArchetype = pArchetype;
+	record.row = pArchetype->AddEntity(entity);
+
+	++m_EntityCount;
+
+	return entity;
+}
+
+void DDM::EcsWorld::MoveEntity(Entity entity, Archetype* pTarget)
+{
+	const EntityRecord oldRecord{ m_Records[entity.index] };
+
+	// Add the entity to the new archetype and copy the components over
+	const uint32_t newRow{ pTarget->AddEntity(entity) };
+	pTarget->CopyComponents(newRow, *oldRecord.pArchetype, oldRecord.row);
+
+	// Remove it from the old archetype
+	RemoveFromArchetype(oldRecord);
+
+	auto& record{ m_Records[entity.index] };
+	record.pArchetype = pTarget;
+	record.row = newRow;
+}
+
+void DDM::EcsWorld::RemoveFromArchetype(const EntityRecord& record)
+{
+	// The last entity of the archetype is moved into the removed row
+	const Entity movedEntity{ record.pArchetype->RemoveEntity(record.row) };
+
+	if (movedEntity.IsAssigned())
+	{
+		m_Records[movedEntity.index].row = record.row;
+	}
+}
@@ -0,0 +1,278 @@
+// EcsWorld.h
+// This class owns all entities, their archetypes and the systems that update them
+// Entities are handles, their components live in the chunks of the archetype matching their set of components
+
+#ifndef EcsWorldIncluded
+#define EcsWorldIncluded
+
+// File includes
+#include "Archetype.h"
+#include "EcsSystem.h"
+#include "EcsTypes.h"
+
+// Standard library includes
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class JobSystem;
+
+	class EcsWorld final
+	{
+	public:
+		// Default constructor
+		EcsWorld() = default;
+
+		// Default destructor
+		~EcsWorld() = default;
+
+		// Rule of five
+		EcsWorld(const EcsWorld& other) = delete;
+		EcsWorld(EcsWorld&& other) = delete;
+		EcsWorld& operator=(const EcsWorld& other) = delete;
+		EcsWorld& operator=(EcsWorld&& other) = delete;
+
+		// Create an entity with a set of components
+		// Parameters:
+		//     components: the initial values of the components
+		template <class... Ts>
+		Entity CreateEntity(const Ts&... components);
+
+		// Destroy an entity and all of its components
+		// Parameters:
+		//     entity: the entity to destroy
+		void DestroyEntity(Entity entity);
+
+		// Check if an entity still exists
+		// Parameters:
+		//     entity: the entity to check
+		bool IsAlive(Entity entity) const;
+
+		// Add a component to an entity, if the entity already has one it is overwritten
+		// Parameters:
+		//     entity: the entity to add the component to
+		//     component: the value of the component
+		template <class T>
+		void AddComponent(Entity entity, const T& component = T{});
+
+		// Remove a component from an entity
+		// Parameters:
+		//     entity: the entity to remove the component from
+		template <class T>
+		void RemoveComponent(Entity entity);
+
+		// Get a component of an entity
+		// Parameters:
+		//     entity: the entity to get the component from
+		// Returns: pointer to the component, nullptr if the entity doesn't exist or has no such component
+		template <class T>
+		T* GetComponent(Entity entity) const;
+
+		// Check if an entity has a component
+		// Parameters:
+		//     entity: the entity to check
+		template <class T>
+		bool HasComponent(Entity entity) const;
+
+		// Reserve memory for a number of entities with a set of components
+		// Parameters:
+		//     count: the amount of entities
+		template <class... Ts>
+		void Reserve(size_t count);
+
+		// Get the amount of entities
+		size_t GetEntityCount() const { return m_EntityCount; }
+
+		// Get all archetypes, archetypes are never removed so the list only grows
+		const std::vector<std::unique_ptr<Archetype>>& GetArchetypes() const { return m_pArchetypes; }
+
+		// Add a system, systems are updated in the order they were added
+		// Parameters:
+		//     args: the arguments passed to the constructor of the system
+		// Returns: pointer to the new system
+		template <class T, class... Args>
+		T* AddSystem(Args&&... args);
+
+		// Update all systems
+		// Parameters:
+		//     pJobSystem: job system the systems can split their work over, can be nullptr
+		void Update(JobSystem* pJobSystem);
+
+	private:
+		// Location of an entity
+		struct EntityRecord
+		{
+			// Archetype the entity is stored in, nullptr if the slot is free
+			Archetype* pArchetype{};
+
+			// Index of the entity in its archetype
+			uint32_t row{};
+
+			// Incremented every time the entity in this slot is destroyed
+			uint32_t generation{};
+		};
+
+		// Location of every entity, indexed by entity index
+		std::vector<EntityRecord> m_Records{};
+
+		// Entity indices that can be reused
+		std::vector<uint32_t> m_FreeIndices{};
+
+		// Amount of living entities
+		size_t m_EntityCount{};
+
+		// All archetypes
+		std::vector<std::unique_ptr<Archetype>> m_pArchetypes{};
+
+		// Map from component mask to archetype
+		std::unordered_map<EcsComponentMask, Archetype*> m_pArchetypesByMask{};
+
+		// All systems in update order
+		std::vector<std::unique_ptr<EcsSystem>> m_pSystems{};
+
+		// Get the record of an entity
+		// Parameters:
+		//     entity: the entity
+		// Returns: pointer to the record, nullptr if the entity doesn't exist
+		const EntityRecord* GetRecord(Entity entity) const;
+
+		// Get the archetype with a component mask, it is created if it doesn't exist yet
+		// Parameters:
+		//     mask: the component mask
+		Archetype* GetOrCreateArchetype(EcsComponentMask mask);
+
+		// Create an entity in an archetype, its components are default constructed
+		// Parameters:
+		//     pArchetype: the archetype to store the entity in
+		Entity CreateEntityInArchetype(Archetype* pArchetype);
+
+		// Move an entity to another archetype, keeping all components both archetypes have in common
+		// Parameters:
+		//     entity: the entity to move
+		//     pTarget: the archetype to move the entity to
+		void MoveEntity(Entity entity, Archetype* pTarget);
+
+		// Remove an entity from its archetype and update the record of the entity that takes its place
+		// Parameters:
+		//     record: the record of the entity
+		void RemoveFromArchetype(const EntityRecord& record);
+	};
+
+	template <class... Ts>
+	inline Entity EcsWorld::CreateEntity(const Ts&... components)
+	{
+		auto pArchetype{ GetOrCreateArchetype(GetEcsComponentMask<Ts...>()) };
+		const Entity entity{ CreateEntityInArchetype(pArchetype) };
+
+		// Copy the initial values into the new row
+		const uint32_t row{ m_Records[entity.index].row };
+		((*static_cast<Ts*>(pArchetype->GetComponent(row, GetEcsTypeId<Ts>())) = components), ...);
+
+		return entity;
+	}
+
+	template <class T>
+	inline void EcsWorld::AddComponent(Entity entity, const T& component)
+	{
+		auto pRecord{ GetRecord(entity) };
+
+		// If the entity doesn't exist, return
+		if (pRecord == nullptr)
+		{
+			return;
+		}
+
+		const EcsTypeId typeId{ GetEcsTypeId<T>() };
+		auto pArchetype{ pRecord->pArchetype };
+
+		// Move the entity to the archetype that has the extra component
+		if (!pArchetype->HasType(typeId))
+		{
+			auto pTarget{ pArchetype->GetAddEdge(typeId) };
+
+			if (pTarget == nullptr)
+			{
+				pTarget = GetOrCreateArchetype(pArchetype->GetMask() | (EcsComponentMask{ 1 } << typeId));
+				pArchetype->SetAddEdge(typeId, pTarget);
+			}
+
+			MoveEntity(entity, pTarget);
+		}
+
+		*GetComponent<T>(entity) = component;
+	}
+
+	template <class T>
+	inline void EcsWorld::RemoveComponent(Entity entity)
+	{
+		auto pRecord{ GetRecord(entity) };
+
+		// If the entity doesn't exist or doesn't have the component, return
+		const EcsTypeId typeId{ GetEcsTypeId<T>() };
+
+		if (pRecord == nullptr || !pRecord->pArchetype->HasType(typeId))
+		{
+			return;
+		}
+
+		auto pArchetype{ pRecord->pArchetype };
+
+		// Move the entity to the archetype without the component
+		auto pTarget{ pArchetype->GetRemoveEdge(typeId) };
+
+		if (pTarget == nullptr)
+		{
+			pTarget = GetOrCreateArchetype(pArchetype->GetMask() & ~(EcsComponentMask{ 1 } << typeId));
+			pArchetype->SetRemoveEdge(typeId, pTarget);
+		}
+
+		MoveEntity(entity, pTarget);
+	}
+
+	template <class T>
+	inline T* EcsWorld::GetComponent(Entity entity) const
+	{
+		auto pRecord{ GetRecord(entity) };
+
+		if (pRecord == nullptr)
+		{
+			return nullptr;
+		}
+
+		return static_cast<T*>(pRecord->pArchetype->GetComponent(pRecord->row, GetEcsTypeId<T>()));
+	}
+
+	template <class T>
+	inline bool EcsWorld::HasComponent(Entity entity) const
+	{
+		auto pRecord{ GetRecord(entity) };
+
+		return pRecord != nullptr && pRecord->pArchetype->HasType(GetEcsTypeId<T>());
+	}
+
+	template <class... Ts>
+	inline void EcsWorld::Reserve(size_t count)
+	{
+		auto pArchetype{ GetOrCreateArchetype(GetEcsComponentMask<Ts...>()) };
+		pArchetype->Reserve(pArchetype->GetEntityCount() + count);
+
+		m_Records.reserve(m_Records.size() + count);
+	}
+
+	template <class T, class... Args>
+	inline T* EcsWorld::AddSystem(Args&&... args)
+	{
+		auto pSystem{ std::make_unique<T>(std::forward<Args>(args)...) };
+		auto pResult{ pSystem.get() };
+
+		m_pSystems.push_back(std::move(pSystem));
+
+		return pResult;
+	}
+}
+
+#endif // !EcsWorldIncluded
@@ -0,0 +1,320 @@
+// BenchmarkRunner.cpp
+
+// Header include
+#include "BenchmarkRunner.h"
+
+// File includes
+#include "Engine/CameraPath.h"
+
+#include "BaseClasses/GameObject.h"
+
+#include "Components/Camera.h"
+#include "Components/CameraPathComponent.h"
+#include "Components/SpectatorMovement.h"
+
+#include "Managers/SceneManager.h"
+#include "Managers/TimeManager.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+bool DDM::BenchmarkRunner::ParseArguments(int argc, char* argv[], BenchmarkSettings& settings)
+{
+	bool isBenchmark{ false };
+
+	for (int index{ 1 }; index < argc; ++index)
+	{
+		const std::string argument{ argv[index] };
+
+		if (argument == "--benchmark")
+		{
+			isBenchmark = true;
+			continue;
+		}
+
+		// Every other argument takes a value
+		if (index + 1 >= argc)
+		{
+			std::cout << "Missing value for benchmark argument " << argument << "\n";
+			break;
+		}
+
+		const std::string value{ argv[++index] };
+
+		if (argument == "--renderer")
+			settings.Renderer = value;
+		else if (argument == "--scene")
+			settings.Scene = value;
+		else if (argument == "--warmup")
+			settings.WarmupFrames = std::max(std::atoi(value.c_str()), 0);
+		else if (argument == "--frames")
+			settings.MeasuredFrames = std::max(std::atoi(value.c_str()), 1);
+		else if (argument == "--path")
+			settings.CameraPathFile = value;
+		else if (argument == "--record")
+			settings.RecordPathFile = value;
+		else if (argument == "--output")
+			settings.OutputFile = value;
+		else
+			std::cout << "Unknown benchmark argument " << argument << "\n";
+	}
+
+	return isBenchmark;
+}
+
+int DDM::BenchmarkRunner::RunPerRenderer(const BenchmarkSettings& settings, const std::string& executable, const std::vector<std::string>& renderers)
+{
+	int result{ EXIT_SUCCESS };
+
+	for (const auto& renderer : renderers)
+	{
+		std::string command{ "\"" + executable + "\" --benchmark --renderer " + renderer
+			+ " --warmup " + std::to_string(settings.WarmupFrames)
+			+ " --frames " + std::to_string(settings.MeasuredFrames) };
+
+		if (!settings.Scene.empty())
+			command += " --scene " + settings.Scene;
+
+		if (!settings.CameraPathFile.empty())
+			command += " --path \"" + settings.CameraPathFile + "\"";
+
+		// Keep the results of every renderer apart
+		if (!settings.OutputFile.empty())
+			command += " --output \"" + settings.OutputFile + "_" + renderer + "\"";
+
+#ifdef _WIN32
+		// cmd strips the outer quotes of a command, so wrap it once more
+		command = "\"" + command + "\"";
+#endif
+
+		std::cout << "Running benchmark for renderer " << renderer << "\n";
+
+		if (std::system(command.c_str()) != 0)
+		{
+			std::cout << "Benchmark for renderer " << renderer << " failed\n";
+			result = EXIT_FAILURE;
+		}
+	}
+
+	return result;
+}
+
+DDM::BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+	:m_Settings{ settings }
+{
+	m_pCameraPath = std::make_shared<CameraPath>();
+
+	if (!m_Settings.CameraPathFile.empty() && m_Settings.RecordPathFile.empty())
+	{
+		m_pCameraPath->Load(m_Settings.CameraPathFile);
+	}
+
+	m_Frames.reserve(static_cast<size_t>(m_Settings.MeasuredFrames));
+}
+
+int DDM::BenchmarkRunner::GetFrameLimit() const
+{
+	// A recording runs until the window is closed
+	if (!m_Settings.RecordPathFile.empty())
+		return 0;
+
+	// The first frame loads the scene and attaches the camera path
+	return 1 + m_Settings.WarmupFrames + m_Settings.MeasuredFrames;
+}
+
+void DDM::BenchmarkRunner::OnFrame(const FrameTimings& timings)
+{
+	// The scene is only active after the first frame started
+	if (m_FrameIndex == 0)
+	{
+		AttachCameraPath();
+	}
+	else if (m_FrameIndex > m_Settings.WarmupFrames && m_Settings.RecordPathFile.empty())
+	{
+		m_Frames.push_back(timings);
+	}
+
+	++m_FrameIndex;
+}
+
+void DDM::BenchmarkRunner::Finish() const
+{
+	if (!m_Settings.RecordPathFile.empty())
+	{
+		if (m_pCameraPath->Save(m_Settings.RecordPathFile))
+		{
+			std::cout << "Recorded camera path of " << m_pCameraPath->GetDuration() << "s to " << m_Settings.RecordPathFile << "\n";
+		}
+
+		return;
+	}
+
+	if (m_Frames.empty())
+	{
+		std::cout << "Benchmark measured no frames\n";
+		return;
+	}
+
+	const std::string outputName{ GetOutputName() };
+
+	WriteCsv(outputName + ".csv");
+	WriteJson(outputName + ".json");
+}
+
+void DDM::BenchmarkRunner::AttachCameraPath()
+{
+	const bool isRecording{ !m_Settings.RecordPathFile.empty() };
+
+	// Nothing to follow
+	if (!isRecording && m_pCameraPath->IsEmpty())
+		return;
+
+	auto pCamera{ SceneManager::GetInstance().GetCamera() };
+
+	if (pCamera == nullptr)
+	{
+		std::cout << "Benchmark scene has no camera, the camera path is not used\n";
+		return;
+	}
+
+	auto pOwner{ pCamera->GetOwner() };
+
+	// The spectator movement would fight the path during playback
+	if (!isRecording)
+	{
+		if (auto pSpectator{ pOwner->GetComponent<SpectatorMovement>() }; pSpectator != nullptr)
+		{
+			pSpectator->SetActive(false);
+		}
+	}
+
+	auto pPathComponent{ pOwner->AddComponent<CameraPathComponent>() };
+	pPathComponent->SetPath(m_pCameraPath, isRecording ? CameraPathComponent::Mode::Record : CameraPathComponent::Mode::Playback);
+}
+
+std::string DDM::BenchmarkRunner::GetOutputName() const
+{
+	if (!m_Settings.OutputFile.empty())
+		return m_Settings.OutputFile;
+
+	return "Benchmark_" + m_Settings.Renderer + "_" + (m_Settings.Scene.empty() ? std::string{ "Default" } : m_Settings.Scene);
+}
+
+void DDM::BenchmarkRunner::WriteCsv(const std::string& fileName) const
+{
+	std::ofstream file{ fileName };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open benchmark file " << fileName << "\n";
+		return;
+	}
+
+	// Header with a column per phase
+	file << "Frame";
+
+	for (size_t phase{}; phase < FrameTimings::kPhaseCount; ++phase)
+	{
+		file << ',' << FrameTimings::GetPhaseName(static_cast<FramePhase>(phase));
+	}
+
+	file << ",Frame";
+
+	// Followed by a column per render counter, so batching regressions show up per frame
+	for (size_t counter{}; counter < RenderCounters::kCounterCount; ++counter)
+	{
+		file << ',' << RenderCounters::GetName(static_cast<RenderCounter>(counter));
+	}
+
+	file << '\n';
+
+	for (size_t frame{}; frame < m_Frames.size(); ++frame)
+	{
+		file << frame;
+
+		for (float phaseTime : m_Frames[frame].PhaseTimes)
+		{
+			file << ',' << phaseTime;
+		}
+
+		file << ',' << m_Frames[frame].FrameTime;
+
+		for (uint64_t count : m_Frames[frame].Counters)
+		{
+			file << ',' << count;
+		}
+
+		file << '\n';
+	}
+}
+
+void DDM::BenchmarkRunner::WriteJson(const std::string& fileName) const
+{
+	std::ofstream file{ fileName };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open benchmark file " << fileName << "\n";
+		return;
+	}
+
+	auto writeSummary = [&file](const char* name, std::vector<float>& times, bool isLast)
+		{
+			const TimeManager::TimeSummary summary{ TimeManager::Summarize(times) };
+
+			file << "\t\t\"" << name << "\": { \"Average\": " << summary.Average
+				<< ", \"Min\": " << summary.Min << ", \"Max\": " << summary.Max
+				<< ", \"P50\": " << summary.P50 << ", \"P90\": " << summary.P90
+				<< ", \"P95\": " << summary.P95 << ", \"P99\": " << summary.P99 << " }"
+				<< (isLast ? "\n" : ",\n");
+		};
+
+	file << "{\n";
+	file << "\t\"Renderer\": \"" << m_Settings.Renderer << "\",\n";
+	file << "\t\"Scene\": \"" << (m_Settings.Scene.empty() ? std::string{ "Default" } : m_Settings.Scene) << "\",\n";
+	file << "\t\"CameraPath\": \"" << m_Settings.CameraPathFile << "\",\n";
+	file << "\t\"WarmupFrames\": " << m_Settings.WarmupFrames << ",\n";
+	file << "\t\"MeasuredFrames\": " << m_Frames.size() << ",\n";
+	file << "\t\"Phases\": {\n";
+
+	// Reused for every phase
+	std::vector<float> times(m_Frames.size());
+
+	for (size_t phase{}; phase < FrameTimings::kPhaseCount; ++phase)
+	{
+		std::transform(m_Frames.begin(), m_Frames.end(), times.begin(),
+			[phase](const FrameTimings& timings) { return timings.PhaseTimes[phase]; });
+
+		writeSummary(FrameTimings::GetPhaseName(static_cast<FramePhase>(phase)), times, false);
+	}
+
+	std::transform(m_Frames.begin(), m_Frames.end(), times.begin(),
+		[](const FrameTimings& timings) { return timings.FrameTime; });
+
+	writeSummary("Frame", times, true);
+
+	file << "\t},\n";
+	file << "\t\"Counters\": {\n";
+
+	// Reused for every counter
+	std::vector<float> counts(m_Frames.size());
+
+	for (size_t counter{}; counter < RenderCounters::kCounterCount; ++counter)
+	{
+		std::transform(m_Frames.begin(), m_Frames.end(), counts.begin(),
+			[counter](const FrameTimings& timings) { return static_cast<float>(timings.Counters[counter]); });
+
+		writeSummary(RenderCounters::GetName(static_cast<RenderCounter>(counter)), counts, counter + 1 == RenderCounters::kCounterCount);
+	}
+
+	file << "\t}\n}\n";
+
+	// Print the most important numbers
+	const TimeManager::TimeSummary frameSummary{ TimeManager::Summarize(times) };
+
+	std::cout << "Benchmark " << m_Settings.Renderer << ": " << m_Frames.size() << " frames, average " << frameSummary.Average
+		<< "ms, P50 " << frameSummary.P50 << "ms, P99 " << frameSummary.P99 << "ms, written to " << fileName << "\n";
+}
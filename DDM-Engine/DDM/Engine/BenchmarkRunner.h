@@ -0,0 +1,122 @@
+// BenchmarkRunner.h
+// This class runs a scripted frame time benchmark
+// It moves the camera along a recorded path, skips a set amount of warm up frames,
+// records the cpu time of every phase of the measured frames and writes them to csv and json files
+
+#ifndef BenchmarkRunnerIncluded
+#define BenchmarkRunnerIncluded
+
+// File includes
+#include "Engine/FrameTimings.h"
+
+// Standard library includes
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class CameraPath;
+
+	// Settings of a single benchmark run, filled in from the command line
+	struct BenchmarkSettings
+	{
+		// Name of the renderer, "All" runs every renderer in its own process
+		std::string Renderer{ "Forward" };
+
+		// Name of the scene loader, empty to use the default scene of the renderer
+		std::string Scene{};
+
+		// Amount of frames that run before measuring starts
+		int WarmupFrames{ 100 };
+
+		// Amount of frames that are measured
+		int MeasuredFrames{ 1000 };
+
+		// Json file with the camera path to follow, empty to keep the camera where the scene put it
+		std::string CameraPathFile{};
+
+		// Json file to record the camera path to, when set nothing is measured and the engine runs until the window closes
+		std::string RecordPathFile{};
+
+		// Output file name without extension, empty to name it after the renderer and scene
+		std::string OutputFile{};
+	};
+
+	class BenchmarkRunner final
+	{
+	public:
+		// Read the benchmark settings from the command line
+		// Parameters:
+		//     argc: amount of arguments
+		//     argv: the arguments
+		//     settings: reference to the settings that are filled in
+		// Returns true if "--benchmark" was passed
+		static bool ParseArguments(int argc, char* argv[], BenchmarkSettings& settings);
+
+		// Run the benchmark once for every renderer, each in its own process since the engine can only be initialized once
+		// Parameters:
+		//     settings: the settings of the benchmark
+		//     executable: path to this executable
+		//     renderers: names of the renderers to run
+		// Returns EXIT_SUCCESS if every run succeeded
+		static int RunPerRenderer(const BenchmarkSettings& settings, const std::string& executable, const std::vector<std::string>& renderers);
+
+		// Constructor
+		// Parameters:
+		//     settings: the settings of the benchmark
+		explicit BenchmarkRunner(const BenchmarkSettings& settings);
+
+		// Default destructor
+		~BenchmarkRunner() = default;
+
+		// Rule of five
+		BenchmarkRunner(const BenchmarkRunner& other) = delete;
+		BenchmarkRunner(BenchmarkRunner&& other) = delete;
+		BenchmarkRunner& operator=(const BenchmarkRunner& other) = delete;
+		BenchmarkRunner& operator=(BenchmarkRunner&& other) = delete;
+
+		// Get the amount of frames the engine has to run, 0 when recording a camera path
+		int GetFrameLimit() const;
+
+		// Called by the engine at the end of every frame
+		// Parameters:
+		//     timings: the time spent in every phase of the frame
+		void OnFrame(const FrameTimings& timings);
+
+		// Write the results, or save the recorded camera path
+		void Finish() const;
+
+	private:
+		// The settings of the benchmark
+		BenchmarkSettings m_Settings{};
+
+		// The camera path that is followed or recorded
+		std::shared_ptr<CameraPath> m_pCameraPath{};
+
+		// Timings of the measured frames
+		std::vector<FrameTimings> m_Frames{};
+
+		// Index of the current frame
+		int m_FrameIndex{};
+
+		// Attach the camera path to the camera of the active scene
+		void AttachCameraPath();
+
+		// Get the output file name without extension
+		std::string GetOutputName() const;
+
+		// Write the timings of every measured frame
+		// Parameters:
+		//     fileName: name of the csv file
+		void WriteCsv(const std::string& fileName) const;
+
+		// Write the summary of the measured frames
+		// Parameters:
+		//     fileName: name of the json file
+		void WriteJson(const std::string& fileName) const;
+	};
+}
+
+#endif // !BenchmarkRunnerIncluded
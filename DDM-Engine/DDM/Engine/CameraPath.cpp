@@ -0,0 +1,119 @@
+// CameraPath.cpp
+
+// Header include
+#include "CameraPath.h"
+
+// File includes
+#include "Includes/RapidJSONIncludes.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool DDM::CameraPath::Load(const std::string& filePath)
+{
+	std::ifstream file{ filePath };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open camera path " << filePath << "\n";
+		return false;
+	}
+
+	// Read the whole file and parse it
+	std::stringstream buffer{};
+	buffer << file.rdbuf();
+
+	rapidjson::Document document{};
+	document.Parse(buffer.str().c_str());
+
+	if (document.HasParseError() || !document.IsObject() || !document.HasMember("Points") || !document["Points"].IsArray())
+	{
+		std::cout << "Camera path " << filePath << " is not valid\n";
+		return false;
+	}
+
+	m_Points.clear();
+
+	for (const auto& point : document["Points"].GetArray())
+	{
+		const auto& position{ point["Position"] };
+		const auto& rotation{ point["Rotation"] };
+
+		// Rotations are stored as w, x, y, z
+		AddPoint(point["Time"].GetFloat(),
+			glm::vec3{ position[0].GetFloat(), position[1].GetFloat(), position[2].GetFloat() },
+			glm::quat{ rotation[0].GetFloat(), rotation[1].GetFloat(), rotation[2].GetFloat(), rotation[3].GetFloat() });
+	}
+
+	return true;
+}
+
+bool DDM::CameraPath::Save(const std::string& filePath) const
+{
+	std::ofstream file{ filePath };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not write camera path " << filePath << "\n";
+		return false;
+	}
+
+	file << "{\n\t\"Points\": [\n";
+
+	for (size_t index{}; index < m_Points.size(); ++index)
+	{
+		const auto& point{ m_Points[index] };
+
+		file << "\t\t{ \"Time\": " << point.Time
+			<< ", \"Position\": [" << point.Position.x << ", " << point.Position.y << ", " << point.Position.z << "]"
+			<< ", \"Rotation\": [" << point.Rotation.w << ", " << point.Rotation.x << ", " << point.Rotation.y << ", " << point.Rotation.z << "] }"
+			<< (index + 1 < m_Points.size() ? ",\n" : "\n");
+	}
+
+	file << "\t]\n}\n";
+
+	return true;
+}
+
+void DDM::CameraPath::AddPoint(float time, const glm::vec3& position, const glm::quat& rotation)
+{
+	m_Points.push_back(CameraPathPoint{ time, position, rotation });
+}
+
+void DDM::CameraPath::Sample(float time, glm::vec3& position, glm::quat& rotation) const
+{
+	if (m_Points.empty())
+		return;
+
+	// Loop the path, a path with a single point stays on that point
+	const float duration{ GetDuration() };
+
+	if (duration > 0.0f)
+	{
+		time = std::fmod(time, duration);
+	}
+
+	// Find the first point after the requested time
+	auto next = std::upper_bound(m_Points.begin(), m_Points.end(), time,
+		[](float value, const CameraPathPoint& point) { return value < point.Time; });
+
+	if (next == m_Points.begin() || next == m_Points.end())
+	{
+		const auto& point{ next == m_Points.end() ? m_Points.back() : m_Points.front() };
+		position = point.Position;
+		rotation = point.Rotation;
+		return;
+	}
+
+	// Interpolate between the surrounding points
+	const auto& previous{ *(next - 1) };
+	const float span{ next->Time - previous.Time };
+	const float alpha{ span > 0.0f ? (time - previous.Time) / span : 0.0f };
+
+	position = glm::mix(previous.Position, next->Position, alpha);
+	rotation = glm::slerp(previous.Rotation, next->Rotation, alpha);
+}
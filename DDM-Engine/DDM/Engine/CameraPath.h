@@ -0,0 +1,80 @@
+// CameraPath.h
+// This class holds a recorded path of camera positions and rotations
+// Paths are stored as json files so a benchmark sees the same views on every run
+
+#ifndef CameraPathIncluded
+#define CameraPathIncluded
+
+// File includes
+#include "Includes/GLMIncludes.h"
+
+// Standard library includes
+#include <string>
+#include <vector>
+
+namespace DDM
+{
+	// A single sample of the camera path
+	struct CameraPathPoint
+	{
+		// Time since the start of the path in seconds
+		float Time{};
+
+		// World position of the camera
+		glm::vec3 Position{};
+
+		// World rotation of the camera
+		glm::quat Rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+	};
+
+	class CameraPath final
+	{
+	public:
+		// Default constructor
+		CameraPath() = default;
+
+		// Default destructor
+		~CameraPath() = default;
+
+		// Load a path from a json file, replaces the current points
+		// Parameters:
+		//     filePath: path to the json file
+		// Returns true if the file was read
+		bool Load(const std::string& filePath);
+
+		// Save the path to a json file
+		// Parameters:
+		//     filePath: path to the json file
+		// Returns true if the file was written
+		bool Save(const std::string& filePath) const;
+
+		// Add a point to the end of the path, points have to be added in order of time
+		// Parameters:
+		//     time: time since the start of the path in seconds
+		//     position: world position of the camera
+		//     rotation: world rotation of the camera
+		void AddPoint(float time, const glm::vec3& position, const glm::quat& rotation);
+
+		// Remove all points
+		void Clear() { m_Points.clear(); }
+
+		// Get the position and rotation at a point in time, the path loops once the end is reached
+		// Parameters:
+		//     time: time since the start of the path in seconds
+		//     position: reference to the interpolated position
+		//     rotation: reference to the interpolated rotation
+		void Sample(float time, glm::vec3& position, glm::quat& rotation) const;
+
+		// Get the time of the last point
+		float GetDuration() const { return m_Points.empty() ? 0.0f : m_Points.back().Time; }
+
+		// Check if the path has no points
+		bool IsEmpty() const { return m_Points.empty(); }
+
+	private:
+		// Points of the path, sorted by time
+		std::vector<CameraPathPoint> m_Points{};
+	};
+}
+
+#endif // !CameraPathIncluded
@@ -0,0 +1,265 @@
+// ComponentScheduler.cpp
+
+// Header include
+#include "ComponentScheduler.h"
+
+// File includes
+#include "BaseClasses/Component.h"
+#include "Engine/JobSystem.h"
+
+// Standard library includes
+#include <algorithm>
+
+namespace
+{
+	/// <summary>
+	/// Call a phase function on all active components in a phase list
+	/// </summary>
+	/// <param name="entries: ">The phase list</param>
+	/// <param name="function: ">Pointer to the member function to call</param>
+	template <class Entries>
+	void RunPhase(const Entries& entries, void (DDM::Component::*function)())
+	{
+		for (const auto& entry : entries)
+		{
+			// Skip unregistered and inactive components
+			auto pComponent{ entry.pComponent };
+
+			if (pComponent != nullptr && pComponent->IsActive() && pComponent->GetOwner()->IsActiveInHierarchy())
+			{
+				(pComponent->*function)();
+			}
+		}
+	}
+
+	/// <summary>
+	/// Call a phase function on all active components in a phase list, split over parallel jobs
+	/// </summary>
+	/// <param name="entries: ">The phase list</param>
+	/// <param name="function: ">Pointer to the member function to call</param>
+	/// <param name="pJobSystem: ">Job system to run the batches on, nullptr to run on this thread</param>
+	template <class Entries>
+	void RunPhaseParallel(const Entries& entries, void (DDM::Component::*function)(), DDM::JobSystem* pJobSystem)
+	{
+		// Amount of components updated in a single job
+		constexpr size_t batchSize{ 64 };
+
+		if (pJobSystem == nullptr)
+		{
+			RunPhase(entries, function);
+			return;
+		}
+
+		pJobSystem->ParallelFor(entries.size(), batchSize, [&entries, function](size_t begin, size_t end)
+			{
+				for (size_t index{ begin }; index < end; ++index)
+				{
+					// Skip unregistered and inactive components
+					auto pComponent{ entries[index].pComponent };
+
+					if (pComponent != nullptr && pComponent->IsActive() && pComponent->GetOwner()->IsActiveInHierarchy())
+					{
+						(pComponent->*function)();
+					}
+				}
+			});
+	}
+}
+
+DDM::ComponentScheduler::~ComponentScheduler()
+{
+	// Detach all components that are still registered so they don't try to unregister later
+	for (auto& registration : m_Registrations)
+	{
+		if (registration.pComponent != nullptr)
+		{
+			registration.pComponent->m_ScheduleId = kInvalidId;
+		}
+	}
+}
+
+void DDM::ComponentScheduler::Register(Component* pComponent, ComponentPhaseMask phases, bool isThreadSafe)
+{
+	// Move Update and FixedUpdate of thread safe components to the parallel lists
+	if (isThreadSafe)
+	{
+		if (phases & (1 << kPhase_UPDATE))
+		{
+			phases = static_cast<ComponentPhaseMask>((phases & ~(1 << kPhase_UPDATE)) | (1 << kPhase_UPDATE_PARALLEL));
+		}
+
+		if (phases & (1 << kPhase_FIXED_UPDATE))
+		{
+			phases = static_cast<ComponentPhaseMask>((phases & ~(1 << kPhase_FIXED_UPDATE)) | (1 << kPhase_FIXED_UPDATE_PARALLEL));
+		}
+	}
+
+	// Components that don't override any phase don't have to be scheduled
+	if (phases == 0 || pComponent->m_ScheduleId != kInvalidId)
+	{
+		return;
+	}
+
+	// Reuse a free registration if there is one
+	uint32_t registrationId{};
+
+	if (!m_FreeRegistrations.empty())
+	{
+		registrationId = m_FreeRegistrations.back();
+		m_FreeRegistrations.pop_back();
+	}
+	else
+	{
+		registrationId = static_cast<uint32_t>(m_Registrations.size());
+		m_Registrations.emplace_back();
+	}
+
+	// Fill in the registration
+	auto& registration{ m_Registrations[registrationId] };
+	registration.pComponent = pComponent;
+	registration.phases = phases;
+	registration.isPending = true;
+
+	// Link the component to its registration
+	pComponent->m_ScheduleId = registrationId;
+
+	// Add it to the phase lists at the start of the next frame
+	m_PendingRegistrations.push_back(registrationId);
+}
+
+void DDM::ComponentScheduler::Unregister(Component* pComponent)
+{
+	const uint32_t registrationId{ pComponent->m_ScheduleId };
+
+	// If component isn't registered, return
+	if (registrationId == kInvalidId)
+	{
+		return;
+	}
+
+	auto& registration{ m_Registrations[registrationId] };
+
+	// Unlink the component
+	pComponent->m_ScheduleId = kInvalidId;
+	registration.pComponent = nullptr;
+
+	// Pending registrations are released when the pending list is processed
+	if (registration.isPending)
+	{
+		return;
+	}
+
+	// Clear the entry in every phase list, the holes are removed at the start of the next frame
+	for (uint32_t phase{}; phase < kPhase_COUNT; ++phase)
+	{
+		if (registration.phases & (1 << phase))
+		{
+			m_Phases[phase][registration.indices[phase]].pComponent = nullptr;
+			m_HasHoles[phase] = true;
+		}
+	}
+
+	FreeRegistration(registrationId);
+}
+
+void DDM::ComponentScheduler::StartFrame()
+{
+	// Remove entries of components that were unregistered
+	for (uint32_t phase{}; phase < kPhase_COUNT; ++phase)
+	{
+		if (m_HasHoles[phase])
+		{
+			CompactPhase(static_cast<ComponentPhase>(phase));
+		}
+	}
+
+	// Add pending components to their phase lists
+	for (auto registrationId : m_PendingRegistrations)
+	{
+		auto& registration{ m_Registrations[registrationId] };
+
+		registration.isPending = false;
+
+		// If the component was unregistered before it was added, release the registration
+		if (registration.pComponent == nullptr)
+		{
+			FreeRegistration(registrationId);
+			continue;
+		}
+
+		for (uint32_t phase{}; phase < kPhase_COUNT; ++phase)
+		{
+			if (registration.phases & (1 << phase))
+			{
+				registration.indices[phase] = static_cast<uint32_t>(m_Phases[phase].size());
+				m_Phases[phase].push_back(PhaseEntry{ registration.pComponent, registrationId });
+			}
+		}
+	}
+
+	// Clear the pending list
+	m_PendingRegistrations.clear();
+}
+
+void DDM::ComponentScheduler::EarlyUpdate()
+{
+	RunPhase(m_Phases[kPhase_EARLY_UPDATE], &Component::EarlyUpdate);
+}
+
+void DDM::ComponentScheduler::Update(JobSystem* pJobSystem)
+{
+	RunPhaseParallel(m_Phases[kPhase_UPDATE_PARALLEL], &Component::Update, pJobSystem);
+	RunPhase(m_Phases[kPhase_UPDATE], &Component::Update);
+}
+
+void DDM::ComponentScheduler::FixedUpdate(JobSystem* pJobSystem)
+{
+	RunPhaseParallel(m_Phases[kPhase_FIXED_UPDATE_PARALLEL], &Component::FixedUpdate, pJobSystem);
+	RunPhase(m_Phases[kPhase_FIXED_UPDATE], &Component::FixedUpdate);
+}
+
+void DDM::ComponentScheduler::LateUpdate()
+{
+	RunPhase(m_Phases[kPhase_LATE_UPDATE], &Component::LateUpdate);
+}
+
+void DDM::ComponentScheduler::RenderDepth() const
+{
+	RunPhase(m_Phases[kPhase_RENDER_DEPTH], &Component::RenderDepth);
+}
+
+void DDM::ComponentScheduler::Render() const
+{
+	RunPhase(m_Phases[kPhase_RENDER], &Component::Render);
+}
+
+void DDM::ComponentScheduler::RenderTransparancy() const
+{
+	RunPhase(m_Phases[kPhase_RENDER_TRANSPARANCY], &Component::RenderTransparancy);
+}
+
+void DDM::ComponentScheduler::FreeRegistration(uint32_t registrationId)
+{
+	// Reset the registration and mark it as free
+	m_Registrations[registrationId] = Registration{};
+	m_FreeRegistrations.push_back(registrationId);
+}
+
+void DDM::ComponentScheduler::CompactPhase(ComponentPhase phase)
+{
+	auto& entries{ m_Phases[phase] };
+
+	// Remove all empty entries while keeping the order of the others
+	entries.erase(std::remove_if(entries.begin(), entries.end(), [](const PhaseEntry& entry)
+		{
+			return entry.pComponent == nullptr;
+		}), entries.end());
+
+	// Update the stored indices of the entries that moved
+	for (uint32_t index{}; index < entries.size(); ++index)
+	{
+		m_Registrations[entries[index].registrationId].indices[phase] = index;
+	}
+
+	m_HasHoles[phase] = false;
+}
@@ -0,0 +1,187 @@
+// ComponentScheduler.h
+// This class keeps a flat list of components for every update and render phase
+// Components are only added to the lists of the phases they override, so each phase is a single loop over relevant components
+
+#ifndef ComponentSchedulerIncluded
+#define ComponentSchedulerIncluded
+
+// Standard library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class Component;
+	class JobSystem;
+
+	// Phases a component can be scheduled in
+	enum ComponentPhase
+	{
+		kPhase_EARLY_UPDATE = 0,
+		kPhase_UPDATE = 1,
+		kPhase_FIXED_UPDATE = 2,
+		kPhase_LATE_UPDATE = 3,
+		kPhase_RENDER_DEPTH = 4,
+		kPhase_RENDER = 5,
+		kPhase_RENDER_TRANSPARANCY = 6,
+		kPhase_UPDATE_PARALLEL = 7,
+		kPhase_FIXED_UPDATE_PARALLEL = 8,
+		kPhase_COUNT = 9
+	};
+
+	// Bitmask of the phases a component overrides
+	using ComponentPhaseMask = uint16_t;
+
+	/// <summary>
+	/// Get the phases component type T overrides, determined at compile time
+	/// Defined in Component.h
+	/// </summary>
+	/// <typeparam name="T">Type of component</typeparam>
+	/// <returns>Bitmask with a bit set for every overridden phase</returns>
+	template <class T>
+	constexpr ComponentPhaseMask GetComponentPhases();
+
+	/// <summary>
+	/// Check if component type T allows its Update and FixedUpdate to run in parallel with other components
+	/// A component opts in by declaring "static constexpr bool kThreadSafeUpdate{ true };"
+	/// Such components may only touch their own state and the local transform of their own object
+	/// </summary>
+	/// <typeparam name="T">Type of component</typeparam>
+	/// <returns>Boolean indicating if the component is thread safe</returns>
+	template <class T>
+	constexpr bool IsThreadSafeComponent()
+	{
+		if constexpr (requires { T::kThreadSafeUpdate; })
+		{
+			return T::kThreadSafeUpdate;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	class ComponentScheduler final
+	{
+	public:
+		// Id used for components that are not scheduled
+		static constexpr uint32_t kInvalidId{ std::numeric_limits<uint32_t>::max() };
+
+		// Default constructor
+		ComponentScheduler() = default;
+
+		// Destructor, detaches all components that are still registered
+		~ComponentScheduler();
+
+		// Rule of five
+		ComponentScheduler(const ComponentScheduler& other) = delete;
+		ComponentScheduler(ComponentScheduler&& other) = delete;
+		ComponentScheduler& operator=(const ComponentScheduler& other) = delete;
+		ComponentScheduler& operator=(ComponentScheduler&& other) = delete;
+
+		// Register a component, it will be added to the phase lists at the start of the next frame
+		// Parameters:
+		//     pComponent: the component to register
+		//     phases: the phases the component overrides
+		//     isThreadSafe: indicates Update and FixedUpdate of the component can run in parallel jobs
+		void Register(Component* pComponent, ComponentPhaseMask phases, bool isThreadSafe = false);
+
+		// Remove a component from all phase lists
+		// Parameters:
+		//     pComponent: the component to remove
+		void Unregister(Component* pComponent);
+
+		// Add all pending components to their phase lists and remove holes left by unregistered components
+		void StartFrame();
+
+		// Call EarlyUpdate on all active components that override it
+		void EarlyUpdate();
+
+		// Call Update on all active components that override it
+		// Thread safe components are updated first in parallel batches, the others after that in registration order
+		// Parameters:
+		//     pJobSystem: job system used for the parallel batches, nullptr to update everything on this thread
+		void Update(JobSystem* pJobSystem = nullptr);
+
+		// Call FixedUpdate on all active components that override it
+		// Thread safe components are updated first in parallel batches, the others after that in registration order
+		// Parameters:
+		//     pJobSystem: job system used for the parallel batches, nullptr to update everything on this thread
+		void FixedUpdate(JobSystem* pJobSystem = nullptr);
+
+		// Call LateUpdate on all active components that override it
+		void LateUpdate();
+
+		// Call RenderDepth on all active components that override it
+		void RenderDepth() const;
+
+		// Call Render on all active components that override it
+		void Render() const;
+
+		// Call RenderTransparancy on all active components that override it
+		void RenderTransparancy() const;
+
+		// Get the amount of components scheduled in a phase
+		// Parameters:
+		//     phase: the phase to check
+		std::size_t GetComponentCount(ComponentPhase phase) const { return m_Phases[phase].size(); }
+
+	private:
+		// Entry in a phase list
+		struct PhaseEntry
+		{
+			// Pointer to the component, nullptr if it was unregistered
+			Component* pComponent{};
+
+			// Id of the registration of the component
+			uint32_t registrationId{};
+		};
+
+		// Registration data of a component
+		struct Registration
+		{
+			// Pointer to the component, nullptr if the slot is free
+			Component* pComponent{};
+
+			// Phases the component is scheduled in
+			ComponentPhaseMask phases{};
+
+			// Indicates the component is not yet added to the phase lists
+			bool isPending{};
+
+			// Index in the list of every phase
+			std::array<uint32_t, kPhase_COUNT> indices{};
+		};
+
+		// List of components for every phase
+		std::array<std::vector<PhaseEntry>, kPhase_COUNT> m_Phases{};
+
+		// Indicates a phase list contains entries of unregistered components
+		std::array<bool, kPhase_COUNT> m_HasHoles{};
+
+		// All registrations, indexed by registration id
+		std::vector<Registration> m_Registrations{};
+
+		// Registration ids that can be reused
+		std::vector<uint32_t> m_FreeRegistrations{};
+
+		// Registration ids that still have to be added to the phase lists
+		std::vector<uint32_t> m_PendingRegistrations{};
+
+		// Release a registration id
+		// Parameters:
+		//     registrationId: the id to release
+		void FreeRegistration(uint32_t registrationId);
+
+		// Remove the entries of unregistered components from a phase list
+		// Parameters:
+		//     phase: the phase to compact
+		void CompactPhase(ComponentPhase phase);
+	};
+}
+
+#endif // !ComponentSchedulerIncluded
@@ -10,23 +10,47 @@
 
 #include "Managers/SceneManager.h"
 #include "Managers/ConfigManager.h"
+#include "Managers/TelemetryManager.h"
 #include "Managers/TimeManager.h"
+#include "Managers/TransformManager.h"
 
 
 #include "Vulkan/VulkanObject.h"
 
 #include "Managers/InputManager.h"
 
+#include "Engine/FramePacer.h"
+#include "Engine/JobSystem.h"
+
+#include "Utils/AllocationTracker.h"
+#include "Utils/FrameArena.h"
+#include "Utils/Profiler.h"
+#include "Utils/RenderCounters.h"
+
 // Standard library includes
+#include <algorithm>
 #include <chrono>
-#include <thread>
+#include <fstream>
+#include <iostream>
 
 DDM::DDMEngine::DDMEngine()
 {
+	// Create the transform manager before any scene so it outlives all transforms
+	TransformManager::GetInstance();
+
+	// Create the job system and hand it to the scene manager
+	m_pJobSystem = std::make_unique<JobSystem>();
+	SceneManager::GetInstance().SetJobSystem(m_pJobSystem.get());
 }
 
 DDM::DDMEngine::~DDMEngine()
 {
+	// Stop using the job system before it is destroyed
+	SceneManager::GetInstance().SetJobSystem(nullptr);
+
+	// Stop sampling the gpu memory before the device is destroyed
+	TelemetryManager::GetInstance().Shutdown();
+
 	VulkanObject::GetInstance().Terminate();
 
 }
@@ -49,10 +73,36 @@ void DDM::DDMEngine::Run(const std::function<void()>& load)
 	auto& time{ TimeManager::GetInstance() };
 	auto& window{ Window::GetInstance() };
 	auto& input{ InputManager::GetInstance() };
+	auto& transformManager{ TransformManager::GetInstance() };
+	auto& telemetry{ TelemetryManager::GetInstance() };
+	auto& framePacer{ FramePacer::GetInstance() };
 
 	// Indicates wether the update loop should continue
 	bool doContinue = true;
 
+	// Without a window the loop runs for a set amount of frames, 0 runs until a script requests to quit
+	const bool headless{ window.IsHeadless() };
+	const int frameLimit{ m_FrameLimit.value_or(headless ? ConfigManager::GetInstance().GetInt("HeadlessFrameCount") : 0) };
+
+	// Amount of frames that have been rendered
+	int frameCount{};
+
+	// Duration of the frames in milliseconds, only recorded when running headless
+	// Written to the timings file in batches of a fixed size, so a run without a frame limit never grows the buffer
+	std::vector<float> frameTimes{};
+	std::ofstream frameTimingsFile{};
+
+	if (headless)
+	{
+		frameTimes.reserve(kFrameTimingsBatchSize);
+		OpenFrameTimings(frameTimingsFile);
+	}
+
+	// Cpu time spent in every phase of the current frame
+	FrameTimings frameTimings{};
+
+	DDM_PROFILE_THREAD("Main");
+
 	// The timestamp of the previous frame
 	auto lastTime = std::chrono::high_resolution_clock::now();
 
@@ -65,18 +115,13 @@ void DDM::DDMEngine::Run(const std::function<void()>& load)
 	// Set the fixed time
 	time.SetFixedTime(fixedTimeStep);
 
-	// Indicates wether desired framerate should be followed
-	constexpr bool followDesiredFramerate = false;
-
-	// Desired framerate
-	constexpr float desiredFrameRate = 144.f;
-
-	// Desired duration of each frame
-	constexpr float desiredFrameDuration = 1000.f / desiredFrameRate;
-
-
 	while (doContinue)
 	{
+		DDM_PROFILE_SCOPE("Frame");
+
+		// Sleep until the next frame should start when the framerate is limited
+		framePacer.WaitForNextFrame();
+
 		// Get timestamp of current frame and calculate delta time
 		const auto currentTime = std::chrono::high_resolution_clock::now();
 		const float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
@@ -84,61 +129,324 @@ void DDM::DDMEngine::Run(const std::function<void()>& load)
 		// Set the deltatime
 		time.SetDeltaTime(deltaTime);
 
-		// Process the input
-		input.ProcessInput();
+		// Timestamp at the start of the current phase
+		auto phaseStart = currentTime;
+
+		// Store the time since the start of the phase and start the next one
+		auto endPhase = [&frameTimings, &phaseStart](FramePhase phase)
+			{
+				const auto phaseEnd = std::chrono::high_resolution_clock::now();
+				frameTimings[phase] = std::chrono::duration<float, std::milli>(phaseEnd - phaseStart).count();
+				phaseStart = phaseEnd;
+			};
+
+		// The frame in flight this frame renders to
+		const auto frameInFlight{ static_cast<uint32_t>(vulkanObject.GetCurrentFrame()) };
+
+		{
+			DDM_PROFILE_SCOPE("Wait");
+
+			// Wait for the gpu before sampling input instead of after it, so the input is as recent as possible
+			vulkanObject.WaitForFrame();
+			framePacer.MarkRetired(frameInFlight);
+		}
+
+		endPhase(FramePhase::Wait);
+
+		{
+			DDM_PROFILE_SCOPE("Input");
+			DDM_ALLOCATION_SCOPE(Input);
+
+			if (!headless)
+			{
+				// Check if window should close
+				doContinue = !glfwWindowShouldClose(window.GetWindowStruct().pWindow);
+
+				// Poll glfw events, the callbacks queue them for the input manager
+				glfwPollEvents();
+			}
+
+			// Process the input, a replay also replaces the delta time with the recorded one
+			input.ProcessInput();
+		}
+
+		framePacer.MarkInputSampled(frameInFlight);
 
 		// Set last time to current time for next frame
 		lastTime = currentTime;
 
 		// Add deltatime to lag
-		lag += deltaTime;
+		lag += time.GetDeltaTime();
 
-		// Check if window should close
-		doContinue = !glfwWindowShouldClose(window.GetWindowStruct().pWindow);
+		// Start or stop a profiler capture
+		if constexpr (Profiler::IsEnabled())
+		{
+			UpdateProfilerCapture(frameCount);
+		}
 
-		// Poll glfw events
-		glfwPollEvents();
+		endPhase(FramePhase::Input);
 
 		// Start the frame, used to initialize objects
 		sceneManager.StartFrame();
 
+		endPhase(FramePhase::StartFrame);
+
+		// Update all world transforms that changed since last frame in one pass
+		transformManager.UpdateWorldTransforms();
+
+		endPhase(FramePhase::Transforms);
+
 		// Call early update
 		sceneManager.EarlyUpdate();
 
-		// Handle the fixed update
-		while (lag >= fixedTimeStep)
+		endPhase(FramePhase::EarlyUpdate);
+
+		// Handle the fixed update, capped so a long frame doesn't cause an even longer one
+		const int maxFixedSteps{ time.GetMaxFixedSteps() };
+		int fixedSteps{};
+
+		while (lag >= fixedTimeStep && (maxFixedSteps == 0 || fixedSteps < maxFixedSteps))
 		{
+			// Keep the state before the step, interpolated transforms are rendered between the two
+			transformManager.StoreFixedStepState();
+
 			sceneManager.FixedUpdate();
 			lag -= fixedTimeStep;
+			++fixedSteps;
+		}
+
+		// Skip the steps that didn't fit, the simulation slows down instead of falling further behind
+		if (lag >= fixedTimeStep)
+		{
+			const auto droppedSteps{ static_cast<uint64_t>(lag / fixedTimeStep) };
+
+			time.AddDroppedFixedSteps(droppedSteps);
+			lag -= static_cast<float>(droppedSteps) * fixedTimeStep;
 		}
 
+		// Rendering happens this far between the last fixed step and the next one
+		time.SetInterpolationAlpha(std::clamp(lag / fixedTimeStep, 0.0f, 1.0f));
+
+		endPhase(FramePhase::FixedUpdate);
+
 		// Call update
 		sceneManager.Update();
 
+		endPhase(FramePhase::Update);
+
 		// Call late update
 		sceneManager.LateUpdate();
 
+		endPhase(FramePhase::LateUpdate);
+
 		// Call post update, used
 		sceneManager.PostUpdate();
 
+		endPhase(FramePhase::PostUpdate);
+
+		// Calculate the rendered transforms of interpolated objects
+		transformManager.UpdateRenderTransforms(time.GetInterpolationAlpha());
+
 		// Render scene
 		vulkanObject.Render();
 
-		// Calculate the duration of the frame so far
-		const auto frameDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - currentTime);
-		
-		// Calculate how long the thread should sleep to keep desired frame duration
-		const auto sleepTime = std::chrono::milliseconds(static_cast<int>(desiredFrameDuration)) - frameDuration;
+		framePacer.MarkPresented(frameInFlight);
+
+		endPhase(FramePhase::Render);
+
+		// Store the render operations of this frame
+		RenderCounters::EndFrame();
+		frameTimings.Counters = RenderCounters::GetLastFrame();
+
+		// Start sampling the memory use, the samples are taken on a background thread
+		telemetry.Update();
 
-		// Only sleep if desired framerate should be followed
-		// and sleeptime  is over 0
-		if (followDesiredFramerate && sleepTime > std::chrono::milliseconds(0))
+		// Store the duration of the frame, before any sleeping
+		frameTimings.FrameTime = std::chrono::duration<float, std::milli>(phaseStart - currentTime).count();
+
+		// Add the frame to the rolling statistics
+		time.AddFrame(frameTimings);
+
+		if (headless)
+		{
+			frameTimes.push_back(frameTimings.FrameTime);
+
+			if (frameTimes.size() == kFrameTimingsBatchSize)
+			{
+				WriteFrameTimings(frameTimingsFile, frameTimes, frameCount + 1 - static_cast<int>(frameTimes.size()));
+				frameTimes.clear();
+			}
+		}
+
+		// Hand the timings to whoever is measuring the run
+		if (m_FrameCallback)
+		{
+			m_FrameCallback(frameTimings);
+		}
+
+		// Stop once the requested amount of frames is rendered
+		++frameCount;
+
+		if (frameLimit > 0 && frameCount >= frameLimit)
 		{
-			// Sleep for the calculated amount of time
-			std::this_thread::sleep_for(sleepTime);
+			doContinue = false;
+		}
+
+		// Stop if a script asked to quit
+		if (sceneManager.IsQuitRequested())
+		{
+			doContinue = false;
+		}
+
+		// Store the heap allocations of this frame and give the memory of the frame arenas back
+		AllocationTracker::EndFrame();
+		FrameArena::EndFrame();
+
+		if constexpr (AllocationTracker::IsEnabled())
+		{
+			CheckAllocations(frameCount);
+		}
+	}
+
+	// Summarize the allocation check, a static scene should not allocate at all once it is warmed up
+	if (m_CheckedFrames > 0)
+	{
+		std::cout << "Allocation check " << (PassedAllocationCheck() ? "passed" : "failed") << ": "
+			<< m_AllocatingFrames << " of " << m_CheckedFrames << " frames allocated after warm up\n";
+	}
+
+	// Write a capture that is still running
+	if (Profiler::IsCapturing())
+	{
+		Profiler::EndCapture(GetTraceFileName());
+	}
+
+	// Output the frame timings of the run
+	if (headless)
+	{
+		WriteFrameTimings(frameTimingsFile, frameTimes, frameCount - static_cast<int>(frameTimes.size()));
+
+		// The same rolling window as the frame statistics, so both report the same percentiles
+		const TimeManager::TimeSummary summary{ time.GetFrameSummary() };
+
+		std::cout << "Frames: " << frameCount << " Last " << time.GetFrameCount() << " frames:"
+			<< " Average: " << summary.Average << "ms"
+			<< " Min: " << summary.Min << "ms"
+			<< " Max: " << summary.Max << "ms"
+			<< " P50: " << summary.P50 << "ms"
+			<< " P95: " << summary.P95 << "ms"
+			<< " P99: " << summary.P99 << "ms\n";
+
+		if (const std::string statsFile{ ConfigManager::GetInstance().GetString("FrameStatsFile") }; !statsFile.empty())
+		{
+			time.ExportStatistics(statsFile);
 		}
 	}
 
 	// Clean up all objects
 	sceneManager.EndProgram();
 }
+
+void DDM::DDMEngine::UpdateProfilerCapture(int frameCount)
+{
+	auto& configManager{ ConfigManager::GetInstance() };
+
+	// Capture the first frames automatically, used to get a trace of a headless run
+	static const int captureFrames{ configManager.GetInt("ProfilerCaptureFrames") };
+
+	if (captureFrames > 0)
+	{
+		if (frameCount == 0)
+		{
+			Profiler::BeginCapture();
+		}
+		else if (frameCount == captureFrames && Profiler::IsCapturing())
+		{
+			Profiler::EndCapture(GetTraceFileName());
+		}
+	}
+
+	// Toggle a capture on demand, the trace is written when the capture stops
+	if (InputManager::GetInstance().GetKeyDown(GLFW_KEY_F9))
+	{
+		if (Profiler::IsCapturing())
+		{
+			Profiler::EndCapture(GetTraceFileName());
+		}
+		else
+		{
+			Profiler::BeginCapture();
+		}
+	}
+}
+
+std::string DDM::DDMEngine::GetTraceFileName()
+{
+	// Every capture gets its own file so earlier traces aren't overwritten
+	return ConfigManager::GetInstance().GetString("ProfilerTraceFile") + "_" + std::to_string(m_TraceCount++) + ".json";
+}
+
+void DDM::DDMEngine::CheckAllocations(int frameCount)
+{
+	// Read once, looking the key up every frame would allocate its string
+	static const int warmupFrames{ ConfigManager::GetInstance().GetInt("AllocationCheckWarmupFrames") };
+
+	// Only the first allocating frames are printed, the summary at the end counts all of them
+	constexpr int maxReports{ 10 };
+
+	if (warmupFrames <= 0 || frameCount <= warmupFrames)
+		return;
+
+	++m_CheckedFrames;
+
+	if (AllocationTracker::GetLastFrameTotal() == 0)
+		return;
+
+	if (m_AllocatingFrames++ >= maxReports)
+		return;
+
+	std::cout << "Frame " << frameCount << " allocated " << AllocationTracker::GetLastFrameTotal() << " times:";
+
+	for (size_t tag{}; tag < AllocationTracker::kTagCount; ++tag)
+	{
+		const auto allocationTag{ static_cast<AllocationTag>(tag) };
+
+		if (const uint64_t allocations{ AllocationTracker::GetLastFrame(allocationTag) }; allocations > 0)
+		{
+			std::cout << ' ' << AllocationTracker::GetName(allocationTag) << ' ' << allocations
+				<< " (" << AllocationTracker::GetLastFrameBytes(allocationTag) << " bytes)";
+		}
+	}
+
+	std::cout << '\n';
+}
+
+void DDM::DDMEngine::OpenFrameTimings(std::ofstream& file) const
+{
+	// Every frame is written to the timings file so it can be compared between runs
+	const std::string fileName{ ConfigManager::GetInstance().GetString("FrameTimingsFile") };
+
+	if (fileName.empty())
+		return;
+
+	file.open(fileName);
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open frame timings file " << fileName << "\n";
+		return;
+	}
+
+	file << "Frame,FrameTimeMs\n";
+}
+
+void DDM::DDMEngine::WriteFrameTimings(std::ofstream& file, const std::vector<float>& frameTimes, int firstFrame) const
+{
+	if (!file.is_open())
+		return;
+
+	for (size_t frame{}; frame < frameTimes.size(); ++frame)
+	{
+		file << firstFrame + static_cast<int>(frame) << ',' << frameTimes[frame] << '\n';
+	}
+}
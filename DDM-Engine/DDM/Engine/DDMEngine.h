@@ -6,15 +6,23 @@
 
 // File includes
 #include "Includes/GLFWIncludes.h"
+#include "Engine/FrameTimings.h"
 #include "Vulkan/VulkanObject.h"
 #include "Engine/Window.h"
 
 // Standard library includes
 #include <string>
+#include <fstream>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace DDM
 {
+	// Class forward declarations
+	class JobSystem;
+
 	class DDMEngine
 	{
 	public:
@@ -41,6 +49,24 @@ namespace DDM
 		/// <param name="load: ">Reference to the sceneloader function</param>
 		void Run(const std::function<void()>& load);
 
+		/// <summary>
+		/// Set a function that is called at the end of every frame with the time spent in every phase
+		/// </summary>
+		/// <param name="callback: ">The function to call, empty to stop calling it</param>
+		void SetFrameCallback(std::function<void(const FrameTimings&)> callback) { m_FrameCallback = std::move(callback); }
+
+		/// <summary>
+		/// Stop the update loop after a set amount of frames, overrides "HeadlessFrameCount" from the config file
+		/// </summary>
+		/// <param name="frameLimit: ">Amount of frames to run, 0 to run until the window closes or a script requests to quit</param>
+		void SetFrameLimit(int frameLimit) { m_FrameLimit = frameLimit; }
+
+		/// <summary>
+		/// Check if no frame allocated on the heap after warming up, always true when the check is disabled
+		/// </summary>
+		/// <returns>Boolean indicating wether the last run passed the allocation check</returns>
+		bool PassedAllocationCheck() const { return m_AllocatingFrames == 0; }
+
 		// Rule of 5
 		DDMEngine(const DDMEngine& other) = delete;
 		DDMEngine(DDMEngine&& other) = delete;
@@ -50,6 +76,59 @@ namespace DDM
 	private:
 		// Indicates wether engine is initialized
 		bool m_Initialized = false;
+
+		// Job system used to spread work over multiple threads
+		std::unique_ptr<JobSystem> m_pJobSystem{};
+
+		// Function called at the end of every frame with the timings of that frame
+		std::function<void(const FrameTimings&)> m_FrameCallback{};
+
+		// Amount of frames to run, when not set the config file decides
+		std::optional<int> m_FrameLimit{};
+
+		// Amount of profiler traces written, used to name the trace files
+		int m_TraceCount{};
+
+		// Amount of frames after warm up that were checked for heap allocations
+		int m_CheckedFrames{};
+
+		// Amount of checked frames that allocated on the heap
+		int m_AllocatingFrames{};
+
+		// Amount of frame times a headless run keeps before it appends them to the timings file
+		static constexpr size_t kFrameTimingsBatchSize{ 1024 };
+
+		/// <summary>
+		/// Start or stop a profiler capture, on the first frames set with "ProfilerCaptureFrames" or when F9 is pressed
+		/// </summary>
+		/// <param name="frameCount: ">Amount of frames rendered so far</param>
+		void UpdateProfilerCapture(int frameCount);
+
+		/// <summary>
+		/// Get the name of the next trace file, based on "ProfilerTraceFile" from the config file
+		/// </summary>
+		/// <returns>Name of the json file</returns>
+		std::string GetTraceFileName();
+
+		/// <summary>
+		/// Report the heap allocations of the last frame, every frame after "AllocationCheckWarmupFrames" from the config file should have none
+		/// </summary>
+		/// <param name="frameCount: ">Amount of frames rendered so far</param>
+		void CheckAllocations(int frameCount);
+
+		/// <summary>
+		/// Open the file set with "FrameTimingsFile" and write its header
+		/// </summary>
+		/// <param name="file: ">The file to open, stays closed when no file is set</param>
+		void OpenFrameTimings(std::ofstream& file) const;
+
+		/// <summary>
+		/// Append a batch of frame times of a headless run to the timings file
+		/// </summary>
+		/// <param name="file: ">The timings file, nothing is written when it isn't open</param>
+		/// <param name="frameTimes: ">Duration of every frame of the batch in milliseconds</param>
+		/// <param name="firstFrame: ">Index of the first frame of the batch</param>
+		void WriteFrameTimings(std::ofstream& file, const std::vector<float>& frameTimes, int firstFrame) const;
 	};
 
 	template <class T>
@@ -8,18 +8,21 @@
 #include "Components/MeshRenderer.h"
 #include "DataTypes/Materials/MultiMaterial.h"
 
+#include "Utils/Profiler.h"
+
 DDM::DDMModelLoader::DDMModelLoader()
 {
-	m_pModelLoader = std::make_unique<DDMML::DDMModelLoader>();
 }
 
 void DDM::DDMModelLoader::LoadModel(const std::string& filename, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
 {
+	DDM_PROFILE_FUNCTION();
+
 	std::vector<DDMML::Vertex> ddmVertices{};
 
 	auto mesh = std::make_unique<DDMML::Mesh>();
 
-	m_pModelLoader->LoadModel(filename, mesh.get());
+	GetModelLoader().LoadModel(filename, mesh.get());
 
 	auto& ddmmlVertices = mesh->GetVertices();
 	auto& ddmmlIndices = mesh->GetIndices();
@@ -33,22 +36,32 @@ void DDM::DDMModelLoader::LoadModel(const std::string& filename, std::vector<Ver
 
 DDM::GameObject* DDM::DDMModelLoader::LoadModel(const std::string& filename, GameObject* pParent)
 {
+	DDM_PROFILE_FUNCTION();
+
 	auto pDDMMLMesh{ std::make_unique<DDMML::Mesh>() };
 
-	m_pModelLoader->LoadModel(filename, pDDMMLMesh.get());
+	GetModelLoader().LoadModel(filename, pDDMMLMesh.get());
 
 	return SetupModel(pDDMMLMesh.get(), pParent);
 }
 
 void DDM::DDMModelLoader::LoadModel(const std::string& fileName, std::unique_ptr<DDMML::Mesh>& mesh)
 {
-	m_pModelLoader->LoadModel(fileName, mesh.get());
+	DDM_PROFILE_FUNCTION();
+
+	GetModelLoader().LoadModel(fileName, mesh.get());
 }
 
 void DDM::DDMModelLoader::LoadTexturedScene(const std::string& path, GameObject* pParent)
 {
+	DDM_PROFILE_FUNCTION();
+
 	auto pMeshes = std::vector<std::unique_ptr<DDMML::Mesh>>{};
-	m_pModelLoader->LoadScene(path, pMeshes);
+	GetModelLoader().LoadScene(path, pMeshes);
+
+	// Reserve memory for all objects up front
+	pParent->ReserveChildren(pMeshes.size());
+
 	for (auto& mesh : pMeshes)
 	{
 		auto pObject = SetupModel(mesh.get(), pParent);
@@ -57,7 +70,9 @@ void DDM::DDMModelLoader::LoadTexturedScene(const std::string& path, GameObject*
 
 void DDM::DDMModelLoader::LoadScene(const std::string& path, std::vector<std::unique_ptr<DDMML::Mesh>>& pMeshes)
 {
-	m_pModelLoader->LoadScene(path, pMeshes);
+	DDM_PROFILE_FUNCTION();
+
+	GetModelLoader().LoadScene(path, pMeshes);
 }
 
 void DDM::DDMModelLoader::ConvertVertices(const std::vector<DDMML::Vertex>& ddmmlVertices, std::vector<Vertex>& vertices)
@@ -99,3 +114,11 @@ DDM::GameObject* DDM::DDMModelLoader::SetupModel(DDMML::Mesh* pDDMMLMesh, GameOb
 
 	return pObject;
 }
+
+DDMML::DDMModelLoader& DDM::DDMModelLoader::GetModelLoader()
+{
+	// Scenes are loaded on background threads, every thread gets its own loader
+	thread_local DDMML::DDMModelLoader modelLoader{};
+
+	return modelLoader;
+}
@@ -20,6 +20,7 @@ namespace DDM
 {
 	class GameObject;
 
+	// Every function can be called from any thread, each thread loads with its own library loader
 	class DDMModelLoader final : public Singleton<DDMModelLoader>
 	{
 	public:
@@ -71,7 +72,11 @@ namespace DDM
 		void ConvertVertices(const std::vector<DDMML::Vertex>& ddmmlVertices, std::vector<Vertex>& vertices);
 
 	private:
-		std::unique_ptr<DDMML::DDMModelLoader> m_pModelLoader;
+		/// <summary>
+		/// Get the model loader of the calling thread, the library loader isn't safe to share between threads
+		/// </summary>
+		/// <returns>Reference to the loader of this thread</returns>
+		static DDMML::DDMModelLoader& GetModelLoader();
 
 		/// <summary>
 		/// Converts a single DDMML mesh to a render object
@@ -0,0 +1,173 @@
+// FramePacer.cpp
+
+// Header include
+#include "FramePacer.h"
+
+// File includes
+#include "Includes/ImGuiIncludes.h"
+
+#include "Managers/ConfigManager.h"
+
+// Standard library includes
+#include <algorithm>
+#include <thread>
+
+DDM::FramePacer::FramePacer()
+{
+	auto& configManager{ ConfigManager::GetInstance() };
+
+	m_FramesInFlight = static_cast<uint32_t>(std::clamp(configManager.GetInt("MaxFrames"), 1, static_cast<int>(kMaxFramesInFlight)));
+	m_PresentMode = ParsePresentMode(configManager.GetString("PresentMode"));
+	m_SpinTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(std::max(configManager.GetFloat("FrameSpinMs"), 0.0f)));
+
+	SetTargetFrameRate(configManager.GetFloat("TargetFrameRate"));
+}
+
+void DDM::FramePacer::WaitForNextFrame()
+{
+	if (m_TargetFrameRate <= 0.0f)
+		return;
+
+	const auto sleepEnd{ m_NextFrameTime - m_SpinTime };
+
+	// Sleep most of the way, the os may wake the thread up to a few milliseconds late
+	if (sleepEnd > Clock::now())
+	{
+		std::this_thread::sleep_until(sleepEnd);
+	}
+
+	// Spin the rest of the way
+	while (Clock::now() < m_NextFrameTime)
+	{
+		std::this_thread::yield();
+	}
+
+	const auto now{ Clock::now() };
+
+	m_NextFrameTime += m_FramePeriod;
+
+	// After a slow frame start counting from now, catching up would run several frames back to back
+	if (m_NextFrameTime < now)
+	{
+		m_NextFrameTime = now + m_FramePeriod;
+	}
+}
+
+void DDM::FramePacer::SetTargetFrameRate(float frameRate)
+{
+	m_TargetFrameRate = std::max(frameRate, 0.0f);
+
+	if (m_TargetFrameRate > 0.0f)
+	{
+		m_FramePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / m_TargetFrameRate));
+	}
+
+	// Start the new rate with the next frame
+	m_NextFrameTime = Clock::now();
+}
+
+void DDM::FramePacer::MarkInputSampled(uint32_t frame)
+{
+	m_InputTimes[frame] = Clock::now();
+	m_Presented[frame] = false;
+}
+
+void DDM::FramePacer::MarkPresented(uint32_t frame)
+{
+	AddLatency(m_PresentLatencies, std::chrono::duration<float, std::milli>(Clock::now() - m_InputTimes[frame]).count());
+
+	m_Presented[frame] = true;
+}
+
+void DDM::FramePacer::MarkRetired(uint32_t frame)
+{
+	// Frames in flight that weren't used yet have nothing to retire
+	if (!m_Presented[frame])
+		return;
+
+	AddLatency(m_RetireLatencies, std::chrono::duration<float, std::milli>(Clock::now() - m_InputTimes[frame]).count());
+
+	m_Presented[frame] = false;
+}
+
+const char* DDM::FramePacer::GetPresentModeName(PresentMode presentMode)
+{
+	constexpr std::array<const char*, static_cast<size_t>(PresentMode::Count)> names{ "Fifo", "Mailbox", "Immediate" };
+
+	return names[static_cast<size_t>(presentMode)];
+}
+
+void DDM::FramePacer::OnGUI()
+{
+	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Framed;
+
+	if (ImGui::TreeNodeEx("Frame pacing", flags))
+	{
+		// Present mode, changing it recreates the swapchain
+		int presentMode{ static_cast<int>(m_PresentMode) };
+
+		if (ImGui::Combo("Present mode", &presentMode, "Fifo\0Mailbox\0Immediate\0"))
+		{
+			SetPresentMode(static_cast<PresentMode>(presentMode));
+		}
+
+		ImGui::Text("Active present mode: %s", GetPresentModeName(m_ActivePresentMode));
+
+		float targetFrameRate{ m_TargetFrameRate };
+
+		if (ImGui::DragFloat("Target fps (0 is unlimited)", &targetFrameRate, 1.0f, 0.0f, 1000.0f, "%.0f"))
+		{
+			SetTargetFrameRate(targetFrameRate);
+		}
+
+		ImGui::Text("Frames in flight: %u", m_FramesInFlight);
+
+		const LatencySummary presentLatency{ GetPresentLatency() };
+		const LatencySummary retireLatency{ GetRetireLatency() };
+
+		ImGui::Text("Input to present: %.2f ms (max %.2f ms)", presentLatency.Average, presentLatency.Max);
+		ImGui::Text("Input to gpu done: %.2f ms (max %.2f ms)", retireLatency.Average, retireLatency.Max);
+
+		ImGui::TreePop();
+	}
+}
+
+void DDM::FramePacer::AddLatency(LatencyHistory& history, float latency)
+{
+	history.Values[history.Index] = latency;
+	history.Index = (history.Index + 1) % kLatencyHistorySize;
+	history.Count = std::min(history.Count + 1, kLatencyHistorySize);
+}
+
+DDM::FramePacer::LatencySummary DDM::FramePacer::Summarize(const LatencyHistory& history)
+{
+	LatencySummary summary{};
+
+	if (history.Count == 0)
+		return summary;
+
+	float total{};
+
+	for (size_t index{}; index < history.Count; ++index)
+	{
+		total += history.Values[index];
+		summary.Max = std::max(summary.Max, history.Values[index]);
+	}
+
+	summary.Average = total / static_cast<float>(history.Count);
+
+	return summary;
+}
+
+DDM::PresentMode DDM::FramePacer::ParsePresentMode(const std::string& name)
+{
+	for (size_t presentMode{}; presentMode < static_cast<size_t>(PresentMode::Count); ++presentMode)
+	{
+		if (name == GetPresentModeName(static_cast<PresentMode>(presentMode)))
+		{
+			return static_cast<PresentMode>(presentMode);
+		}
+	}
+
+	return PresentMode::Mailbox;
+}
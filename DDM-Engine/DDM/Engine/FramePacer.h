@@ -0,0 +1,177 @@
+// FramePacer.h
+// This singleton decides when a frame starts and how frames are presented
+// It limits the framerate by sleeping until shortly before the next frame and spinning the rest of the way,
+// holds the present mode the swapchain should use and measures the time from sampling input to presenting the frame
+
+#ifndef FramePacerIncluded
+#define FramePacerIncluded
+
+// File includes
+#include "Singleton.h"
+
+// Standard library includes
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace DDM
+{
+	// Present modes that can be requested, the swapchain falls back to Fifo when the requested one isn't supported
+	enum class PresentMode : uint8_t
+	{
+		// Wait for vertical blank, never tears, highest latency
+		Fifo,
+
+		// Replace the queued image at vertical blank, never tears, lower latency
+		Mailbox,
+
+		// Present right away, can tear, lowest latency
+		Immediate,
+
+		Count
+	};
+
+	class FramePacer final : public Singleton<FramePacer>
+	{
+	public:
+		// Amount of frames the latency averages are taken over
+		static constexpr size_t kLatencyHistorySize{ 128 };
+
+		// Maximum amount of frames in flight
+		static constexpr uint32_t kMaxFramesInFlight{ 3 };
+
+		// Summary of the latencies in the rolling window, in milliseconds
+		struct LatencySummary
+		{
+			float Average{};
+			float Max{};
+		};
+
+		// Sleep and spin until the next frame should start, returns right away when there is no target framerate
+		void WaitForNextFrame();
+
+		// Get the target framerate, 0 when it isn't limited
+		float GetTargetFrameRate() const { return m_TargetFrameRate; }
+
+		// Set the target framerate
+		// Parameters:
+		//     frameRate: frames per second, 0 to stop limiting
+		void SetTargetFrameRate(float frameRate);
+
+		// Get the present mode the swapchain should use
+		PresentMode GetPresentMode() const { return m_PresentMode; }
+
+		// Request a different present mode, the swapchain is recreated at the end of the frame
+		// Parameters:
+		//     presentMode: the requested present mode
+		void SetPresentMode(PresentMode presentMode) { m_PresentMode = presentMode; }
+
+		// Get the present mode the swapchain actually uses
+		PresentMode GetActivePresentMode() const { return m_ActivePresentMode; }
+
+		// Store the present mode the swapchain was created with, called by the swapchain
+		// Parameters:
+		//     presentMode: the present mode in use
+		void SetActivePresentMode(PresentMode presentMode) { m_ActivePresentMode = presentMode; }
+
+		// Get the amount of frames in flight read from the config file, between 1 and kMaxFramesInFlight
+		uint32_t GetFramesInFlight() const { return m_FramesInFlight; }
+
+		// Store the moment the input of a frame was sampled
+		// Parameters:
+		//     frame: index of the frame in flight
+		void MarkInputSampled(uint32_t frame);
+
+		// Store the moment a frame was handed to the presentation engine
+		// Parameters:
+		//     frame: index of the frame in flight
+		void MarkPresented(uint32_t frame);
+
+		// Store the moment the gpu was found done with the previous use of a frame in flight
+		// Parameters:
+		//     frame: index of the frame in flight
+		void MarkRetired(uint32_t frame);
+
+		// Get the time from sampling input to presenting, in the rolling window
+		LatencySummary GetPresentLatency() const { return Summarize(m_PresentLatencies); }
+
+		// Get the time from sampling input until the gpu was found done with the frame, in the rolling window
+		// This is an upper bound, a frame is only checked when its frame in flight is reused
+		LatencySummary GetRetireLatency() const { return Summarize(m_RetireLatencies); }
+
+		// Get the name of a present mode, as used in the config file
+		// Parameters:
+		//     presentMode: the requested present mode
+		static const char* GetPresentModeName(PresentMode presentMode);
+
+		// Draw the pacing settings and latencies
+		void OnGUI();
+
+	private:
+		friend class Singleton<FramePacer>;
+		FramePacer();
+
+		using Clock = std::chrono::steady_clock;
+
+		// Latencies of the rolling window in milliseconds
+		struct LatencyHistory
+		{
+			std::array<float, kLatencyHistorySize> Values{};
+
+			// Index the next value is written to
+			size_t Index{};
+
+			// Amount of values in the window
+			size_t Count{};
+		};
+
+		// Target framerate, 0 when it isn't limited
+		float m_TargetFrameRate{};
+
+		// Duration of a frame at the target framerate
+		Clock::duration m_FramePeriod{};
+
+		// Time before the deadline the limiter stops sleeping and starts spinning, covers the coarse sleep of the os
+		Clock::duration m_SpinTime{};
+
+		// Moment the next frame should start
+		Clock::time_point m_NextFrameTime{};
+
+		// Requested present mode
+		PresentMode m_PresentMode{ PresentMode::Mailbox };
+
+		// Present mode of the swapchain
+		PresentMode m_ActivePresentMode{ PresentMode::Fifo };
+
+		// Amount of frames in flight
+		uint32_t m_FramesInFlight{ 2 };
+
+		// Moment the input of every frame in flight was sampled, empty for frames that weren't presented
+		std::array<Clock::time_point, kMaxFramesInFlight> m_InputTimes{};
+
+		// Indicates the frame in flight was presented since its input was sampled
+		std::array<bool, kMaxFramesInFlight> m_Presented{};
+
+		LatencyHistory m_PresentLatencies{};
+		LatencyHistory m_RetireLatencies{};
+
+		// Add a latency to a rolling window
+		// Parameters:
+		//     history: the rolling window
+		//     latency: the latency in milliseconds
+		static void AddLatency(LatencyHistory& history, float latency);
+
+		// Summarize a rolling window
+		// Parameters:
+		//     history: the rolling window
+		static LatencySummary Summarize(const LatencyHistory& history);
+
+		// Get a present mode from its name, Mailbox when the name isn't known
+		// Parameters:
+		//     name: the name of the present mode
+		static PresentMode ParsePresentMode(const std::string& name);
+	};
+}
+
+#endif // !FramePacerIncluded
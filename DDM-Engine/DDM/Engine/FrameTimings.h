@@ -0,0 +1,72 @@
+// FrameTimings.h
+// This file holds the cpu time spent in every phase of a single frame of the engine loop and the render operations it issued
+// The engine fills one every frame and hands it to the frame callback, used by the benchmark harness
+
+#ifndef FrameTimingsIncluded
+#define FrameTimingsIncluded
+
+// File includes
+#include "Utils/RenderCounters.h"
+
+// Standard library includes
+#include <array>
+#include <cstdint>
+
+namespace DDM
+{
+	// Phases of the engine loop, in the order they run
+	enum class FramePhase : uint8_t
+	{
+		Wait,
+		Input,
+		StartFrame,
+		Transforms,
+		EarlyUpdate,
+		FixedUpdate,
+		Update,
+		LateUpdate,
+		PostUpdate,
+		Render,
+		Count
+	};
+
+	struct FrameTimings
+	{
+		// Amount of phases
+		static constexpr size_t kPhaseCount{ static_cast<size_t>(FramePhase::Count) };
+
+		// Time spent in every phase in milliseconds
+		std::array<float, kPhaseCount> PhaseTimes{};
+
+		// Time of the whole frame in milliseconds, without the sleep that limits the framerate
+		float FrameTime{};
+
+		// Draw calls, binds and descriptor updates recorded during the frame
+		RenderCounters::Values Counters{};
+
+		// Get the time spent in a phase
+		// Parameters:
+		//     phase: the requested phase
+		float& operator[](FramePhase phase) { return PhaseTimes[static_cast<size_t>(phase)]; }
+
+		// Get the time spent in a phase
+		// Parameters:
+		//     phase: the requested phase
+		float operator[](FramePhase phase) const { return PhaseTimes[static_cast<size_t>(phase)]; }
+
+		// Get the name of a phase, used as column name in the benchmark output
+		// Parameters:
+		//     phase: the requested phase
+		static constexpr const char* GetPhaseName(FramePhase phase)
+		{
+			constexpr std::array<const char*, kPhaseCount> names
+			{
+				"Wait", "Input", "StartFrame", "Transforms", "EarlyUpdate", "FixedUpdate", "Update", "LateUpdate", "PostUpdate", "Render"
+			};
+
+			return names[static_cast<size_t>(phase)];
+		}
+	};
+}
+
+#endif // !FrameTimingsIncluded
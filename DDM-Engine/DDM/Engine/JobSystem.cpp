@@ -0,0 +1,508 @@
+// JobSystem.cpp
+
+// Header include
+#include "JobSystem.h"
+
+// File includes
+#include "Utils/Profiler.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstring>
+
+static_assert((DDM::JobSystem::kJobCapacity & (DDM::JobSystem::kJobCapacity - 1)) == 0, "The job capacity has to be a power of two");
+static_assert((DDM::JobSystem::kDequeCapacity & (DDM::JobSystem::kDequeCapacity - 1)) == 0, "The deque capacity has to be a power of two");
+static_assert(std::is_trivially_copyable_v<DDM::QueuedJob> && sizeof(DDM::QueuedJob) % sizeof(uint64_t) == 0,
+	"Queued jobs are copied to the deques as words");
+
+namespace
+{
+	// Job system the calling thread is a worker of, nullptr for threads that are not workers
+	thread_local const DDM::JobSystem* t_pJobSystem{};
+
+	// Index of the calling worker and its deque
+	thread_local uint32_t t_WorkerIndex{};
+
+	// Amount of words a queued job is stored in
+	constexpr size_t kJobWords{ sizeof(DDM::QueuedJob) / sizeof(uint64_t) };
+}
+
+DDM::JobSystem::JobSystem(uint32_t workerCount)
+{
+	// Default to one worker per hardware thread, minus the main thread
+	if (workerCount == 0)
+	{
+		const uint32_t hardwareThreads{ std::thread::hardware_concurrency() };
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	// Every slot starts out writable for the first pass over the ring
+	m_pJobSlots = std::make_unique<JobSlot[]>(kJobCapacity);
+
+	for (size_t index{}; index < kJobCapacity; ++index)
+	{
+		m_pJobSlots[index].sequence.store(index, std::memory_order_relaxed);
+	}
+
+	m_WorkerCount = workerCount;
+	m_pDeques = std::make_unique<WorkerDeque[]>(workerCount);
+
+	// Start the workers
+	m_Workers.reserve(workerCount);
+
+	for (uint32_t index{}; index < workerCount; ++index)
+	{
+		m_Workers.emplace_back(&JobSystem::WorkerLoop, this, index);
+	}
+}
+
+DDM::JobSystem::~JobSystem()
+{
+	// Finish all remaining jobs on this thread
+	while (TryRunJob())
+	{
+	}
+
+	// Stop the workers
+	{
+		std::lock_guard lock{ m_WakeMutex };
+		m_IsRunning = false;
+	}
+
+	m_WakeCondition.notify_all();
+
+	for (auto& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+void DDM::JobSystem::Submit(Job job, JobCounter* pCounter, JobCounter* pDependency)
+{
+	// Track the job in the counter
+	if (pCounter != nullptr)
+	{
+		pCounter->m_Count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// If the job depends on unfinished work, store it as a continuation of the dependency
+	if (pDependency != nullptr)
+	{
+		std::unique_lock lock{ pDependency->m_Mutex };
+
+		if (!pDependency->IsDone())
+		{
+			if (pDependency->m_ContinuationCount < JobCounter::kContinuationCapacity)
+			{
+				pDependency->m_Continuations[pDependency->m_ContinuationCount++] = QueuedJob{ job, pCounter };
+				return;
+			}
+
+			// The list of continuations is full, help finishing the dependency instead of growing the list
+			lock.unlock();
+			Wait(*pDependency);
+		}
+	}
+
+	// Queue the job
+	Enqueue(QueuedJob{ job, pCounter });
+}
+
+void DDM::JobSystem::Wait(JobCounter& counter)
+{
+	// Help running jobs until the counter reaches zero
+	while (!counter.IsDone())
+	{
+		if (!TryRunJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Make sure the thread that finished the last job is done using the counter
+	std::lock_guard lock{ counter.m_Mutex };
+}
+
+void DDM::JobSystem::RunBatches(size_t count, size_t batchSize, BatchFunction pBatch, const void* pFunction)
+{
+	batchSize = std::max<size_t>(batchSize, 1);
+
+	// If everything fits in a single batch, run it on this thread
+	if (count <= batchSize || m_WorkerCount == 0)
+	{
+		if (count > 0)
+		{
+			pBatch(pFunction, 0, count);
+		}
+		return;
+	}
+
+	// Queue a job for every batch
+	JobCounter counter{};
+
+	for (size_t begin{}; begin < count; begin += batchSize)
+	{
+		const size_t end{ std::min(begin + batchSize, count) };
+
+		Submit([pBatch, pFunction, begin, end]() { pBatch(pFunction, begin, end); }, &counter);
+	}
+
+	// Wait for all batches, this thread helps out
+	Wait(counter);
+}
+
+void DDM::JobSystem::WorkerLoop(uint32_t workerIndex)
+{
+	DDM_PROFILE_THREAD("Worker");
+
+	t_pJobSystem = this;
+	t_WorkerIndex = workerIndex;
+
+	while (true)
+	{
+		// Run jobs as long as there are any
+		if (TryRunJob())
+		{
+			continue;
+		}
+
+		// Sleep until new jobs are queued or the job system stops
+		std::unique_lock lock{ m_WakeMutex };
+
+		if (!m_IsRunning && m_QueuedJobs.load() == 0)
+		{
+			break;
+		}
+
+		// Announce the sleep before checking for jobs, a job queued after the check sees it and takes the mutex to wake this worker
+		m_SleepingWorkers.fetch_add(1);
+
+		m_WakeCondition.wait(lock, [this]()
+			{
+				return m_QueuedJobs.load() > 0 || !m_IsRunning;
+			});
+
+		m_SleepingWorkers.fetch_sub(1);
+	}
+
+	t_pJobSystem = nullptr;
+}
+
+void DDM::JobSystem::Enqueue(const QueuedJob& queued)
+{
+	// Count the job before it is pushed, so the count never drops below the amount of queued jobs
+	m_QueuedJobs.fetch_add(1);
+
+	// Workers keep their own jobs in their deque, other threads and full deques use the shared ring
+	const bool isPushed{ (t_pJobSystem == this && PushLocal(m_pDeques[t_WorkerIndex], queued)) || TryPush(queued) };
+
+	// Running out of room means the workers are far behind, running the job here keeps it moving without growing anything
+	if (!isPushed)
+	{
+		m_QueuedJobs.fetch_sub(1);
+
+		QueuedJob inlineJob{ queued };
+		RunJob(inlineJob.job, inlineJob.pCounter);
+		return;
+	}
+
+	// Only take the mutex when a worker is asleep, holding it while notifying makes sure a worker that is about to sleep sees the job
+	if (m_SleepingWorkers.load() > 0)
+	{
+		{
+			std::lock_guard lock{ m_WakeMutex };
+		}
+
+		m_WakeCondition.notify_one();
+	}
+}
+
+bool DDM::JobSystem::TryPush(const QueuedJob& queued)
+{
+	size_t position{ m_WritePosition.load(std::memory_order_relaxed) };
+	JobSlot* pSlot{};
+
+	while (true)
+	{
+		pSlot = &m_pJobSlots[position & (kJobCapacity - 1)];
+
+		const size_t sequence{ pSlot->sequence.load(std::memory_order_acquire) };
+		const intptr_t difference{ static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position) };
+
+		// The slot is free for this position, claim it
+		if (difference == 0)
+		{
+			if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		// The slot still holds a job from the previous pass, the ring is full
+		else if (difference < 0)
+		{
+			return false;
+		}
+		// Another thread claimed this position first
+		else
+		{
+			position = m_WritePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	pSlot->queued = queued;
+
+	// Publish the job to the readers
+	pSlot->sequence.store(position + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool DDM::JobSystem::TryPop(QueuedJob& queued)
+{
+	size_t position{ m_ReadPosition.load(std::memory_order_relaxed) };
+	JobSlot* pSlot{};
+
+	while (true)
+	{
+		pSlot = &m_pJobSlots[position & (kJobCapacity - 1)];
+
+		const size_t sequence{ pSlot->sequence.load(std::memory_order_acquire) };
+		const intptr_t difference{ static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) };
+
+		// The slot holds the job for this position, claim it
+		if (difference == 0)
+		{
+			if (m_ReadPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		// No job was published at this position yet, the ring is empty
+		else if (difference < 0)
+		{
+			return false;
+		}
+		// Another thread took this job first
+		else
+		{
+			position = m_ReadPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	queued = pSlot->queued;
+
+	// Hand the slot back to the writers for the next pass over the ring
+	pSlot->sequence.store(position + kJobCapacity, std::memory_order_release);
+
+	return true;
+}
+
+bool DDM::JobSystem::PushLocal(WorkerDeque& deque, const QueuedJob& queued)
+{
+	const int64_t bottom{ deque.bottom.load(std::memory_order_relaxed) };
+	const int64_t top{ deque.top.load(std::memory_order_acquire) };
+
+	// The deque is full
+	if (bottom - top >= static_cast<int64_t>(kDequeCapacity))
+	{
+		return false;
+	}
+
+	uint64_t words[kJobWords]{};
+	std::memcpy(words, &queued, sizeof(QueuedJob));
+
+	auto& slot{ deque.pSlots[bottom & (kDequeCapacity - 1)] };
+
+	for (size_t word{}; word < kJobWords; ++word)
+	{
+		slot.words[word].store(words[word], std::memory_order_relaxed);
+	}
+
+	// Publish the job to the thieves
+	deque.bottom.store(bottom + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool DDM::JobSystem::PopLocal(WorkerDeque& deque, QueuedJob& queued)
+{
+	// Reserve the bottom job before looking at the top, the fence orders the two against a thief doing the opposite
+	const int64_t bottom{ deque.bottom.load(std::memory_order_relaxed) - 1 };
+	deque.bottom.store(bottom, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	int64_t top{ deque.top.load(std::memory_order_relaxed) };
+
+	// The deque is empty, undo the reservation
+	if (top > bottom)
+	{
+		deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	uint64_t words[kJobWords]{};
+
+	auto& slot{ deque.pSlots[bottom & (kDequeCapacity - 1)] };
+
+	for (size_t word{}; word < kJobWords; ++word)
+	{
+		words[word] = slot.words[word].load(std::memory_order_relaxed);
+	}
+
+	std::memcpy(&queued, words, sizeof(QueuedJob));
+
+	// More jobs are left, no thief can reach this one
+	if (top < bottom)
+	{
+		return true;
+	}
+
+	// This is the last job, a thief may be taking it at the same time
+	const bool isTaken{ deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) };
+
+	deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+
+	return isTaken;
+}
+
+bool DDM::JobSystem::Steal(WorkerDeque& deque, QueuedJob& queued)
+{
+	int64_t top{ deque.top.load(std::memory_order_acquire) };
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	const int64_t bottom{ deque.bottom.load(std::memory_order_acquire) };
+
+	// The deque is empty
+	if (top >= bottom)
+	{
+		return false;
+	}
+
+	// The owner can overwrite the slot while it is read, the copy is only used when the top didn't move in the meantime
+	uint64_t words[kJobWords]{};
+
+	auto& slot{ deque.pSlots[top & (kDequeCapacity - 1)] };
+
+	for (size_t word{}; word < kJobWords; ++word)
+	{
+		words[word] = slot.words[word].load(std::memory_order_relaxed);
+	}
+
+	if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	std::memcpy(&queued, words, sizeof(QueuedJob));
+
+	return true;
+}
+
+bool DDM::JobSystem::TryTakeJob(QueuedJob& queued)
+{
+	const bool isWorker{ t_pJobSystem == this };
+
+	// The newest own job first, its data is most likely still in the cache
+	if (isWorker && PopLocal(m_pDeques[t_WorkerIndex], queued))
+	{
+		return true;
+	}
+
+	if (TryPop(queued))
+	{
+		return true;
+	}
+
+	// Steal from the other workers, every worker starts at its neighbour so thieves spread out
+	const uint32_t workerCount{ GetWorkerCount() };
+	const uint32_t firstVictim{ isWorker ? t_WorkerIndex + 1 : 0 };
+
+	for (uint32_t offset{}; offset < workerCount; ++offset)
+	{
+		const uint32_t victim{ (firstVictim + offset) % workerCount };
+
+		if (isWorker && victim == t_WorkerIndex)
+		{
+			continue;
+		}
+
+		if (Steal(m_pDeques[victim], queued))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool DDM::JobSystem::TryRunJob()
+{
+	QueuedJob queued{};
+
+	// If no job was found, return false
+	if (!TryTakeJob(queued))
+	{
+		return false;
+	}
+
+	m_QueuedJobs.fetch_sub(1);
+
+	RunJob(queued.job, queued.pCounter);
+
+	return true;
+}
+
+void DDM::JobSystem::RunJob(Job& job, JobCounter* pCounter)
+{
+	// Run the job and signal its counter
+	{
+		DDM_PROFILE_SCOPE("Job");
+		job();
+	}
+
+	Signal(pCounter);
+}
+
+void DDM::JobSystem::Signal(JobCounter* pCounter)
+{
+	if (pCounter == nullptr)
+	{
+		return;
+	}
+
+	// Jobs that are not the last only decrement, a waiting thread can't destroy the counter while it stays above zero
+	uint32_t count{ pCounter->m_Count.load(std::memory_order_relaxed) };
+
+	while (count > 1)
+	{
+		if (pCounter->m_Count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	// The last job decrements under the lock, so waiting threads can't destroy the counter while it is still in use
+	std::array<QueuedJob, JobCounter::kContinuationCapacity> continuations{};
+	uint32_t continuationCount{};
+
+	{
+		std::lock_guard lock{ pCounter->m_Mutex };
+
+		// A job could have been added since the count was read, only the job that reaches zero takes the continuations
+		if (pCounter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			continuationCount = pCounter->m_ContinuationCount;
+			std::copy_n(pCounter->m_Continuations.begin(), continuationCount, continuations.begin());
+
+			pCounter->m_ContinuationCount = 0;
+		}
+	}
+
+	// Queue all jobs that were waiting for this counter
+	for (uint32_t index{}; index < continuationCount; ++index)
+	{
+		Enqueue(continuations[index]);
+	}
+}
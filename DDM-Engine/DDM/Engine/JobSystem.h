@@ -0,0 +1,343 @@
+// JobSystem.h
+// This class runs jobs on a pool of worker threads
+// Every worker owns a deque of jobs, it pushes and pops its own jobs at the bottom and idle threads steal the oldest jobs from the top
+// Threads that are not workers, like the main thread, queue their jobs in a shared ring that every thread takes from
+// The deques and the ring have a fixed capacity and take no locks, a job that doesn't fit runs on the thread that queued it
+// Counters only take their mutex to store a continuation and when their last job finishes, queueing a job never allocates
+// Idle workers sleep on a condition variable until a job is queued
+
+#ifndef _DDM_JOB_SYSTEM_
+#define _DDM_JOB_SYSTEM_
+
+// Standard library includes
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace DDM
+{
+	// A unit of work, the callable is stored inside the job so creating and copying one never allocates
+	class Job final
+	{
+	public:
+		// Amount of bytes a callable can capture
+		static constexpr size_t kStorageSize{ 48 };
+
+		/// <summary>
+		/// Default constructor, creates an empty job
+		/// </summary>
+		Job() = default;
+
+		/// <summary>
+		/// Constructor, stores a callable in the job
+		/// The callable is copied as raw memory, so it can only capture pointers, references and plain values
+		/// </summary>
+		/// <typeparam name="Function">Type of the callable</typeparam>
+		/// <param name="function: ">The callable, called without arguments</param>
+		template <class Function>
+			requires (!std::is_same_v<std::decay_t<Function>, Job>)
+		Job(Function function)
+		{
+			static_assert(sizeof(Function) <= kStorageSize, "Job captures too much, capture a pointer to the data instead");
+			static_assert(alignof(Function) <= alignof(std::max_align_t), "Job captures an over aligned type");
+			static_assert(std::is_trivially_copyable_v<Function> && std::is_trivially_destructible_v<Function>,
+				"Job captures a type that owns resources, capture a pointer to it instead");
+
+			::new (static_cast<void*>(m_Storage)) Function(function);
+
+			m_pInvoke = [](void* pStorage) { (*static_cast<Function*>(pStorage))(); };
+		}
+
+		/// <summary>
+		/// Run the job
+		/// </summary>
+		void operator()() { m_pInvoke(m_Storage); }
+
+		/// <summary>
+		/// Check if the job holds a callable
+		/// </summary>
+		/// <returns>Boolean indicating the job can be run</returns>
+		explicit operator bool() const { return m_pInvoke != nullptr; }
+
+	private:
+		// Calls the stored callable
+		void (*m_pInvoke)(void* pStorage) {};
+
+		// Memory the callable is stored in
+		alignas(std::max_align_t) std::byte m_Storage[kStorageSize]{};
+	};
+
+	// Class forward declarations
+	class JobCounter;
+
+	// A job together with the counter it signals when it finishes
+	struct QueuedJob
+	{
+		Job job{};
+
+		JobCounter* pCounter{};
+	};
+
+	class JobCounter final
+	{
+	public:
+		// Amount of jobs that can wait for this counter at the same time
+		static constexpr size_t kContinuationCapacity{ 16 };
+
+		/// <summary>
+		/// Default constructor
+		/// </summary>
+		JobCounter() = default;
+
+		/// <summary>
+		/// Default destructor
+		/// </summary>
+		~JobCounter() = default;
+
+		// Rule of five
+		JobCounter(const JobCounter& other) = delete;
+		JobCounter(JobCounter&& other) = delete;
+		JobCounter& operator=(const JobCounter& other) = delete;
+		JobCounter& operator=(JobCounter&& other) = delete;
+
+		/// <summary>
+		/// Check if all jobs tracked by this counter are finished
+		/// </summary>
+		/// <returns>Boolean indicating if all jobs are finished</returns>
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+
+		// Amount of unfinished jobs
+		std::atomic<uint32_t> m_Count{};
+
+		// Mutex protecting the list of continuations
+		std::mutex m_Mutex{};
+
+		// Jobs waiting for this counter to reach zero, with the counter they signal
+		std::array<QueuedJob, kContinuationCapacity> m_Continuations{};
+
+		// Amount of jobs in the list of continuations
+		uint32_t m_ContinuationCount{};
+	};
+
+	class JobSystem final
+	{
+	public:
+		// Amount of jobs the shared ring can hold, a power of two
+		static constexpr size_t kJobCapacity{ 4096 };
+
+		// Amount of jobs the deque of a worker can hold, a power of two
+		static constexpr size_t kDequeCapacity{ 1024 };
+
+		/// <summary>
+		/// Constructor, starts the worker threads
+		/// </summary>
+		/// <param name="workerCount: ">Amount of worker threads, 0 uses one less than the amount of hardware threads</param>
+		explicit JobSystem(uint32_t workerCount = 0);
+
+		/// <summary>
+		/// Destructor, finishes all queued jobs and stops the worker threads
+		/// </summary>
+		~JobSystem();
+
+		// Rule of five
+		JobSystem(const JobSystem& other) = delete;
+		JobSystem(JobSystem&& other) = delete;
+		JobSystem& operator=(const JobSystem& other) = delete;
+		JobSystem& operator=(JobSystem&& other) = delete;
+
+		/// <summary>
+		/// Queue a job, when there is no room for it the job runs on the calling thread instead
+		/// When the dependency already has the maximum amount of continuations, the calling thread helps finishing it first
+		/// </summary>
+		/// <param name="job: ">The job to run</param>
+		/// <param name="pCounter: ">Counter that is incremented now and decremented when the job finished, can be nullptr</param>
+		/// <param name="pDependency: ">Counter that has to reach zero before the job can start, can be nullptr</param>
+		void Submit(Job job, JobCounter* pCounter = nullptr, JobCounter* pDependency = nullptr);
+
+		/// <summary>
+		/// Wait until a counter reaches zero, the calling thread runs queued jobs while waiting
+		/// </summary>
+		/// <param name="counter: ">The counter to wait for</param>
+		void Wait(JobCounter& counter);
+
+		/// <summary>
+		/// Call a function for all indices in [0, count) split over batches, returns when all batches are done
+		/// The function is only referenced by the jobs, nothing is copied or allocated
+		/// </summary>
+		/// <typeparam name="Function">Type of the function</typeparam>
+		/// <param name="count: ">Amount of indices</param>
+		/// <param name="batchSize: ">Amount of indices per job</param>
+		/// <param name="function: ">Function called with the begin and end index of every batch</param>
+		template <class Function>
+		void ParallelFor(size_t count, size_t batchSize, const Function& function)
+		{
+			RunBatches(count, batchSize, [](const void* pFunction, size_t begin, size_t end)
+				{
+					(*static_cast<const Function*>(pFunction))(begin, end);
+				}, &function);
+		}
+
+		/// <summary>
+		/// Get the amount of worker threads, the main thread not included
+		/// </summary>
+		/// <returns>Amount of worker threads</returns>
+		uint32_t GetWorkerCount() const { return m_WorkerCount; }
+
+	private:
+		// Function that runs a single batch of a parallel for
+		using BatchFunction = void (*)(const void* pFunction, size_t begin, size_t end);
+
+		// Slot in the shared ring, the sequence tells whether the slot can be written or read
+		struct JobSlot
+		{
+			std::atomic<size_t> sequence{};
+
+			QueuedJob queued{};
+		};
+
+		// Slot in the deque of a worker, stored as atomic words because a thief can read a slot while the owner overwrites it
+		struct DequeSlot
+		{
+			std::array<std::atomic<uint64_t>, sizeof(QueuedJob) / sizeof(uint64_t)> words{};
+		};
+
+		// Deque of a single worker, only the owner moves the bottom, thieves move the top
+		struct WorkerDeque
+		{
+			alignas(64) std::atomic<int64_t> top{};
+
+			alignas(64) std::atomic<int64_t> bottom{};
+
+			std::unique_ptr<DequeSlot[]> pSlots{ std::make_unique<DequeSlot[]>(kDequeCapacity) };
+		};
+
+		// Ring of jobs queued by threads that are not workers, allocated once
+		std::unique_ptr<JobSlot[]> m_pJobSlots{};
+
+		// Position the next job is written to, every thread that queues a job moves it forward
+		alignas(64) std::atomic<size_t> m_WritePosition{};
+
+		// Position the next job is taken from, every thread that takes a job moves it forward
+		alignas(64) std::atomic<size_t> m_ReadPosition{};
+
+		// Deque of every worker, in the order of the workers
+		std::unique_ptr<WorkerDeque[]> m_pDeques{};
+
+		// Amount of queued jobs that have not been taken yet
+		alignas(64) std::atomic<uint32_t> m_QueuedJobs{};
+
+		// Amount of workers that are sleeping or about to, jobs only take the wake mutex when there are any
+		std::atomic<uint32_t> m_SleepingWorkers{};
+
+		// Amount of workers, set before the first worker starts so the workers can read it while the others are started
+		uint32_t m_WorkerCount{};
+
+		// Worker threads
+		std::vector<std::thread> m_Workers{};
+
+		// Indicates the worker threads should keep running
+		std::atomic<bool> m_IsRunning{ true };
+
+		// Used to put idle workers to sleep
+		std::mutex m_WakeMutex{};
+		std::condition_variable m_WakeCondition{};
+
+		/// <summary>
+		/// Main loop of a worker thread
+		/// </summary>
+		/// <param name="workerIndex: ">Index of the worker and its deque</param>
+		void WorkerLoop(uint32_t workerIndex);
+
+		/// <summary>
+		/// Split a range over jobs and wait for all of them
+		/// </summary>
+		/// <param name="count: ">Amount of indices</param>
+		/// <param name="batchSize: ">Amount of indices per job</param>
+		/// <param name="pBatch: ">Function that runs a batch</param>
+		/// <param name="pFunction: ">Pointer to the function of the caller, passed to every batch</param>
+		void RunBatches(size_t count, size_t batchSize, BatchFunction pBatch, const void* pFunction);
+
+		/// <summary>
+		/// Add a job to the deque of the calling worker or to the shared ring and wake a worker, the job runs right away when there is no room
+		/// </summary>
+		/// <param name="queued: ">The job and the counter it signals</param>
+		void Enqueue(const QueuedJob& queued);
+
+		/// <summary>
+		/// Write a job to the shared ring
+		/// </summary>
+		/// <param name="queued: ">The job and the counter it signals</param>
+		/// <returns>Boolean indicating there was room for the job</returns>
+		bool TryPush(const QueuedJob& queued);
+
+		/// <summary>
+		/// Take the oldest job from the shared ring
+		/// </summary>
+		/// <param name="queued: ">Set to the job and the counter it signals</param>
+		/// <returns>Boolean indicating a job was taken</returns>
+		bool TryPop(QueuedJob& queued);
+
+		/// <summary>
+		/// Push a job to the bottom of a deque, only called by the worker that owns it
+		/// </summary>
+		/// <param name="deque: ">The deque of the calling worker</param>
+		/// <param name="queued: ">The job and the counter it signals</param>
+		/// <returns>Boolean indicating there was room for the job</returns>
+		bool PushLocal(WorkerDeque& deque, const QueuedJob& queued);
+
+		/// <summary>
+		/// Pop the newest job from the bottom of a deque, only called by the worker that owns it
+		/// </summary>
+		/// <param name="deque: ">The deque of the calling worker</param>
+		/// <param name="queued: ">Set to the job and the counter it signals</param>
+		/// <returns>Boolean indicating a job was taken</returns>
+		bool PopLocal(WorkerDeque& deque, QueuedJob& queued);
+
+		/// <summary>
+		/// Steal the oldest job from the top of the deque of another worker
+		/// </summary>
+		/// <param name="deque: ">The deque to steal from</param>
+		/// <param name="queued: ">Set to the job and the counter it signals</param>
+		/// <returns>Boolean indicating a job was taken</returns>
+		bool Steal(WorkerDeque& deque, QueuedJob& queued);
+
+		/// <summary>
+		/// Take a job from the own deque, the shared ring or the deque of another worker, in that order
+		/// </summary>
+		/// <param name="queued: ">Set to the job and the counter it signals</param>
+		/// <returns>Boolean indicating a job was taken</returns>
+		bool TryTakeJob(QueuedJob& queued);
+
+		/// <summary>
+		/// Take a job and run it
+		/// </summary>
+		/// <returns>Boolean indicating if a job was run</returns>
+		bool TryRunJob();
+
+		/// <summary>
+		/// Run a job and signal its counter
+		/// </summary>
+		/// <param name="job: ">The job</param>
+		/// <param name="pCounter: ">The counter the job signals, can be nullptr</param>
+		void RunJob(Job& job, JobCounter* pCounter);
+
+		/// <summary>
+		/// Decrement a counter and queue its continuations if it reached zero
+		/// </summary>
+		/// <param name="pCounter: ">The counter, can be nullptr</param>
+		void Signal(JobCounter* pCounter);
+	};
+}
+
+#endif // !_DDM_JOB_SYSTEM_
@@ -6,31 +6,167 @@
 // File includes
 #include "BaseClasses/GameObject.h"
 
+#include "Engine/ComponentScheduler.h"
+
+#include "Ecs/EcsWorld.h"
+
 #include "Components/Camera.h"
 #include "Components/Light/LightComponent.h"
 #include "Components/Transform.h"
 
 unsigned int DDM::Scene::m_IdCounter = 0;
 
-DDM::Scene::Scene(const std::string& name) : m_Name(name)
+DDM::Scene::Scene(const std::string& name, bool createDefaultLight) : m_Name(name)
 {
+	m_pScheduler = std::make_unique<ComponentScheduler>();
+
+	// All objects created under the root are scheduled by this scene
 	m_pSceneRoot = std::make_unique<GameObject>("Scene Root");
+	m_pSceneRoot->m_pScheduler = m_pScheduler.get();
+	m_pSceneRoot->m_pScene = this;
 	m_pSceneRoot->Init();
 
 	m_pDefaultCamera = std::make_unique<GameObject>("Default Camera");
 	m_pDefaultCamera->Init();
 	m_pDefaultCameraComponent = m_pDefaultCamera->AddComponent<Camera>();
 
-	m_pDefaultLight = std::make_unique<GameObject>("Default Light");
-	m_pDefaultLight->Init();
-	m_pDefaultLightComponent = m_pDefaultLight->AddComponent<LightComponent>();
+	// The default light owns a uniform buffer, scenes created without a gpu skip it
+	if (createDefaultLight)
+	{
+		m_pDefaultLight = std::make_unique<GameObject>("Default Light");
+		m_pDefaultLight->Init();
+		m_pDefaultLightComponent = m_pDefaultLight->AddComponent<LightComponent>();
+	}
 }
 
+DDM::Scene::~Scene() = default;
+
 DDM::GameObject* DDM::Scene::CreateGameObject(const std::string& name)
 {
 	return m_pSceneRoot->CreateNewObject(name);
 }
 
+void DDM::Scene::ReserveGameObjects(size_t count)
+{
+	m_pSceneRoot->ReserveChildren(count);
+}
+
+DDM::GameObject* DDM::Scene::FindGameObject(const std::string& name) const
+{
+	const auto& pObjects{ FindInIndex(m_ObjectsByName, name) };
+
+	return pObjects.empty() ? nullptr : pObjects.front();
+}
+
+const std::vector<DDM::GameObject*>& DDM::Scene::FindGameObjects(const std::string& name) const
+{
+	return FindInIndex(m_ObjectsByName, name);
+}
+
+const std::vector<DDM::GameObject*>& DDM::Scene::FindGameObjectsWithTag(const std::string& tag) const
+{
+	return FindInIndex(m_ObjectsByTag, tag);
+}
+
+void DDM::Scene::RegisterGameObject(GameObject* pGameObject)
+{
+	pGameObject->m_pScene = this;
+
+	// Add the object to the back of both lists and remember where it is stored
+	auto& pNamedObjects{ m_ObjectsByName[pGameObject->GetNameId()] };
+	pGameObject->m_NameIndexSlot = static_cast<uint32_t>(pNamedObjects.size());
+	pNamedObjects.push_back(pGameObject);
+
+	auto& pTaggedObjects{ m_ObjectsByTag[pGameObject->GetTagId()] };
+	pGameObject->m_TagIndexSlot = static_cast<uint32_t>(pTaggedObjects.size());
+	pTaggedObjects.push_back(pGameObject);
+}
+
+void DDM::Scene::UnregisterGameObject(GameObject* pGameObject)
+{
+	// Remove the object from a list by moving the last object into its slot
+	auto removeFromList = [pGameObject](std::vector<GameObject*>& pObjects, uint32_t slot, uint32_t GameObject::* pSlotMember)
+		{
+			// The scene root is never added to the index
+			if (slot >= pObjects.size() || pObjects[slot] != pGameObject)
+			{
+				return;
+			}
+
+			GameObject* pLast{ pObjects.back() };
+			pObjects[slot] = pLast;
+			pLast->*pSlotMember = slot;
+			pObjects.pop_back();
+		};
+
+	if (auto it{ m_ObjectsByName.find(pGameObject->GetNameId()) }; it != m_ObjectsByName.end())
+	{
+		removeFromList(it->second, pGameObject->m_NameIndexSlot, &GameObject::m_NameIndexSlot);
+	}
+
+	if (auto it{ m_ObjectsByTag.find(pGameObject->GetTagId()) }; it != m_ObjectsByTag.end())
+	{
+		removeFromList(it->second, pGameObject->m_TagIndexSlot, &GameObject::m_TagIndexSlot);
+	}
+
+	// Clear the entries in the structural change lists, the lists are cleared after they are processed
+	if (pGameObject->m_NewChildrenListSlot != GameObject::m_NotListed)
+	{
+		m_pObjectsWithNewChildren[pGameObject->m_NewChildrenListSlot] = nullptr;
+		pGameObject->m_NewChildrenListSlot = GameObject::m_NotListed;
+	}
+
+	if (pGameObject->m_DestroyedListSlot != GameObject::m_NotListed)
+	{
+		m_pObjectsWithDestroyed[pGameObject->m_DestroyedListSlot] = nullptr;
+		pGameObject->m_DestroyedListSlot = GameObject::m_NotListed;
+	}
+
+	pGameObject->m_pScene = nullptr;
+}
+
+void DDM::Scene::MarkNewChildren(GameObject* pGameObject)
+{
+	// If object is already in the list, return
+	if (pGameObject->m_NewChildrenListSlot != GameObject::m_NotListed)
+	{
+		return;
+	}
+
+	pGameObject->m_NewChildrenListSlot = static_cast<uint32_t>(m_pObjectsWithNewChildren.size());
+	m_pObjectsWithNewChildren.push_back(pGameObject);
+}
+
+void DDM::Scene::MarkDestroyed(GameObject* pGameObject)
+{
+	// If object is already in the list, return
+	if (pGameObject->m_DestroyedListSlot != GameObject::m_NotListed)
+	{
+		return;
+	}
+
+	pGameObject->m_DestroyedListSlot = static_cast<uint32_t>(m_pObjectsWithDestroyed.size());
+	m_pObjectsWithDestroyed.push_back(pGameObject);
+}
+
+const std::vector<DDM::GameObject*>& DDM::Scene::FindInIndex(const std::unordered_map<NameId, std::vector<GameObject*>>& index,
+	const std::string& name)
+{
+	static const std::vector<GameObject*> empty{};
+
+	// Names that were never interned can't belong to any object
+	const NameId id{ NameRegistry::GetInstance().Find(name) };
+
+	if (id == NameRegistry::kInvalidNameId)
+	{
+		return empty;
+	}
+
+	auto it{ index.find(id) };
+
+	return it != index.end() ? it->second : empty;
+}
+
 void DDM::Scene::OnSceneLoad()
 {
 	m_pSceneRoot->OnSceneLoad();
@@ -43,32 +179,75 @@ void DDM::Scene::OnSceneUnload()
 
 void DDM::Scene::StartFrame()
 {
-	m_pSceneRoot->StartFrame();
+	// Add the children created since the last frame, only objects that created children are visited
+	for (auto pGameObject : m_pObjectsWithNewChildren)
+	{
+		if (pGameObject != nullptr)
+		{
+			pGameObject->m_NewChildrenListSlot = GameObject::m_NotListed;
+			pGameObject->AddNewChildren();
+		}
+	}
+
+	m_pObjectsWithNewChildren.clear();
+
+	// Add the components of new objects to the phase lists
+	m_pScheduler->StartFrame();
 }
 
 void DDM::Scene::EarlyUpdate()
 {
-	m_pSceneRoot->EarlyUpdate();
+	m_pScheduler->EarlyUpdate();
 }
 
-void DDM::Scene::Update()
+DDM::EcsWorld* DDM::Scene::GetEcsWorld()
 {
-	m_pSceneRoot->Update();
+	if (m_pEcsWorld == nullptr)
+	{
+		m_pEcsWorld = std::make_unique<EcsWorld>();
+	}
+
+	return m_pEcsWorld.get();
 }
 
-void DDM::Scene::FixedUpdate()
+void DDM::Scene::Update(JobSystem* pJobSystem)
 {
-	m_pSceneRoot->FixedUpdate();
+	m_pScheduler->Update(pJobSystem);
+
+	// Ecs systems run after the components so they see this frame's changes
+	if (m_pEcsWorld != nullptr)
+	{
+		m_pEcsWorld->Update(pJobSystem);
+	}
+}
+
+void DDM::Scene::FixedUpdate(JobSystem* pJobSystem)
+{
+	m_pScheduler->FixedUpdate(pJobSystem);
 }
 
 void DDM::Scene::LateUpdate()
 {
-	m_pSceneRoot->LateUpdate();
+	m_pScheduler->LateUpdate();
 }
 
 void DDM::Scene::PostUpdate()
 {
-	m_pSceneRoot->PostUpdate();
+	// Remove destroyed components and children, only objects that had something destroyed are visited
+	// Index based since objects can be added to the list while it is processed
+	for (size_t index{}; index < m_pObjectsWithDestroyed.size(); ++index)
+	{
+		if (auto pGameObject{ m_pObjectsWithDestroyed[index] }; pGameObject != nullptr)
+		{
+			pGameObject->m_DestroyedListSlot = GameObject::m_NotListed;
+			pGameObject->RemoveDestroyed(m_pDestroyedObjects);
+		}
+	}
+
+	m_pObjectsWithDestroyed.clear();
+
+	// Destroy all removed objects in one batch
+	m_pDestroyedObjects.clear();
 }
 
 void DDM::Scene::RenderSkyBox()
@@ -79,17 +258,17 @@ void DDM::Scene::RenderSkyBox()
 
 void DDM::Scene::RenderDepth() const
 {
-	m_pSceneRoot->RenderDepth();
+	m_pScheduler->RenderDepth();
 }
 
 void DDM::Scene::Render() const
 {
-	m_pSceneRoot->Render();
+	m_pScheduler->Render();
 }
 
 void DDM::Scene::RenderTransparancy() const
 {
-	m_pSceneRoot->RenderTransparancy();
+	m_pScheduler->RenderTransparancy();
 }
 
 void DDM::Scene::OngGUI() const
@@ -99,28 +278,28 @@ void DDM::Scene::OngGUI() const
 
 void DDM::Scene::SetCamera(std::shared_ptr<Camera> pCamera)
 {
-	m_pActiveCamera = pCamera;
+	m_pActiveCamera = std::move(pCamera);
 }
 
-const std::shared_ptr<DDM::Camera> DDM::Scene::GetCamera() const
+DDM::Camera* DDM::Scene::GetCamera() const
 {
 	if (m_pActiveCamera != nullptr)
-		return m_pActiveCamera;
+		return m_pActiveCamera.get();
 
-	return m_pDefaultCameraComponent;
+	return m_pDefaultCameraComponent.get();
 }
 
 void DDM::Scene::SetLight(std::shared_ptr<LightComponent> pLight)
 {
-	m_pActiveLight = pLight;
+	m_pActiveLight = std::move(pLight);
 }
 
-const std::shared_ptr<DDM::LightComponent> DDM::Scene::GetLight() const
+DDM::LightComponent* DDM::Scene::GetLight() const
 {
 	if (m_pActiveLight != nullptr)
-		return m_pActiveLight;
+		return m_pActiveLight.get();
 
-	return m_pDefaultLightComponent;
+	return m_pDefaultLightComponent.get();
 }
 
 DDM::GameObject* DDM::Scene::GetSceneRoot()
@@ -2,19 +2,30 @@
 #define SceneIncluded
 
 // File includes
+#include "Managers/NameRegistry.h"
 #include "Managers/SceneManager.h"
 
+// Standard library includes
+#include <unordered_map>
+#include <vector>
+
 namespace DDM
 {
 	class GameObject;
 	class Camera;
 	class LightComponent;
+	class ComponentScheduler;
+	class JobSystem;
+	class EcsWorld;
 
 	class Scene final
 	{
-		friend std::shared_ptr<Scene> SceneManager::CreateScene(const std::string& name);
+		friend std::shared_ptr<Scene> SceneManager::CreateScene(const std::string& name, bool createDefaultLight);
+
+		// Game objects add and remove themselves from the name and tag index and the structural change lists
+		friend class GameObject;
 	public:
-		~Scene() = default;
+		~Scene();
 		Scene(const Scene& other) = delete;
 		Scene(Scene&& other) = delete;
 		Scene& operator=(const Scene& other) = delete;
@@ -24,17 +35,48 @@ namespace DDM
 
 		GameObject* CreateGameObject(const std::string& name = "unNamed");
 
+		// Reserve memory for a number of game objects that will be created directly under the scene root
+		// Parameters:
+		//     count: the amount of game objects
+		void ReserveGameObjects(size_t count);
+
+		// Find a game object in this scene by name
+		// Parameters:
+		//     name: the name of the game object
+		// Returns: pointer to an object with this name, nullptr if there is none
+		GameObject* FindGameObject(const std::string& name) const;
+
+		// Find all game objects in this scene with a name
+		// Parameters:
+		//     name: the name of the game objects
+		const std::vector<GameObject*>& FindGameObjects(const std::string& name) const;
+
+		// Find all game objects in this scene with a tag
+		// Parameters:
+		//     tag: the tag of the game objects
+		const std::vector<GameObject*>& FindGameObjectsWithTag(const std::string& tag) const;
+
 		void OnSceneLoad();
 
 		void OnSceneUnload();
 
 		void StartFrame();
 
+		// Get the ecs world of this scene, it is created the first time it is requested
+		// Its systems are updated after the components in the update phase
+		EcsWorld* GetEcsWorld();
+
 		void EarlyUpdate();
 
-		void Update();
+		// Update all components
+		// Parameters:
+		//     pJobSystem: job system used to update thread safe components in parallel, can be nullptr
+		void Update(JobSystem* pJobSystem = nullptr);
 
-		void FixedUpdate();
+		// Fixed update all components
+		// Parameters:
+		//     pJobSystem: job system used to update thread safe components in parallel, can be nullptr
+		void FixedUpdate(JobSystem* pJobSystem = nullptr);
 
 		void LateUpdate();
 
@@ -53,22 +95,77 @@ namespace DDM
 
 		void SetCamera(std::shared_ptr<Camera> pCamera);
 
-		const std::shared_ptr<Camera> GetCamera() const;
+		// Get the active camera, the scene keeps ownership
+		Camera* GetCamera() const;
 
 		void SetLight(std::shared_ptr<LightComponent> pLight);
 
-		const std::shared_ptr<LightComponent> GetLight() const;
+		// Get the active global light, the scene keeps ownership
+		// nullptr for a scene created without a default light that has no light set
+		LightComponent* GetLight() const;
 
 		GameObject* GetSceneRoot();
 
+		// Check if the early, regular and late update of this scene run while it is loaded
+		bool IsUpdateEnabled() const { return m_UpdateEnabled; }
+
+		// Turn the early, regular and late update of this scene on or off, the scene stays loaded
+		// Parameters:
+		//     isEnabled: indicates the scene should be updated
+		void SetUpdateEnabled(bool isEnabled) { m_UpdateEnabled = isEnabled; }
+
+		// Check if the fixed update of this scene runs while it is loaded
+		bool IsFixedUpdateEnabled() const { return m_FixedUpdateEnabled; }
+
+		// Turn the fixed update of this scene on or off, the scene stays loaded
+		// Parameters:
+		//     isEnabled: indicates the scene should take fixed steps
+		void SetFixedUpdateEnabled(bool isEnabled) { m_FixedUpdateEnabled = isEnabled; }
+
+		// Check if this scene is rendered while it is loaded
+		bool IsRenderEnabled() const { return m_RenderEnabled; }
+
+		// Turn rendering of this scene on or off, the scene stays loaded
+		// Parameters:
+		//     isEnabled: indicates the scene should be rendered
+		void SetRenderEnabled(bool isEnabled) { m_RenderEnabled = isEnabled; }
+
 	private:
 
-		explicit Scene(const std::string& name);
+		// Constructor
+		// Parameters:
+		//     name: the name of the scene
+		//     createDefaultLight: indicates the default light is created, it owns gpu buffers
+		Scene(const std::string& name, bool createDefaultLight);
 
 		std::string m_Name;
 
 		static unsigned int m_IdCounter;
 
+		// Indicates which phases run while the scene is loaded
+		bool m_UpdateEnabled{ true };
+		bool m_FixedUpdateEnabled{ true };
+		bool m_RenderEnabled{ true };
+
+		// Scheduler for the components in this scene, declared before the root so it outlives all objects
+		std::unique_ptr<ComponentScheduler> m_pScheduler{};
+
+		// Entity component system of this scene, nullptr until it is requested
+		std::unique_ptr<EcsWorld> m_pEcsWorld{};
+
+		// Objects indexed by name and tag id, declared before the root so objects can still unregister while it is destroyed
+		std::unordered_map<NameId, std::vector<GameObject*>> m_ObjectsByName{};
+		std::unordered_map<NameId, std::vector<GameObject*>> m_ObjectsByTag{};
+
+		// Objects that created children since the last frame, only these are visited in StartFrame
+		std::vector<GameObject*> m_pObjectsWithNewChildren{};
+
+		// Objects that had a component or child destroyed this frame, only these are visited in PostUpdate
+		std::vector<GameObject*> m_pObjectsWithDestroyed{};
+
+		// Objects removed in PostUpdate, destroyed together once all removals are done
+		std::vector<std::unique_ptr<GameObject>> m_pDestroyedObjects{};
+
 		std::unique_ptr<GameObject> m_pSceneRoot{};
 
 		std::shared_ptr<Camera> m_pActiveCamera{};
@@ -79,8 +176,36 @@ namespace DDM
 
 		std::shared_ptr<LightComponent> m_pActiveLight{};
 
+		// Only created when the scene was created with a default light
 		std::unique_ptr<GameObject> m_pDefaultLight{};
 		std::shared_ptr<LightComponent> m_pDefaultLightComponent{};
+
+		// Add a game object to the name and tag index
+		// Parameters:
+		//     pGameObject: the object to add
+		void RegisterGameObject(GameObject* pGameObject);
+
+		// Remove a game object from the name and tag index and the structural change lists
+		// Parameters:
+		//     pGameObject: the object to remove
+		void UnregisterGameObject(GameObject* pGameObject);
+
+		// Add a game object to the list of objects with children to add
+		// Parameters:
+		//     pGameObject: the object that created children
+		void MarkNewChildren(GameObject* pGameObject);
+
+		// Add a game object to the list of objects with destroyed components or children
+		// Parameters:
+		//     pGameObject: the object that has something to remove
+		void MarkDestroyed(GameObject* pGameObject);
+
+		// Find the list of objects stored under an id in an index
+		// Parameters:
+		//     index: the index to search
+		//     name: the name or tag to look up
+		static const std::vector<GameObject*>& FindInIndex(const std::unordered_map<NameId, std::vector<GameObject*>>& index,
+			const std::string& name);
 	};
 }
 
@@ -0,0 +1,210 @@
+// SceneLoad.cpp
+
+// Header include
+#include "SceneLoad.h"
+
+// File includes
+#include "DDMModelLoader.h"
+#include "Scene.h"
+
+#include "Managers/ResourceManager.h"
+
+#include "Vulkan/VulkanManagers/ImageManager/STBImage.h"
+
+#include "Utils/Profiler.h"
+
+// Standard library includes
+#include <algorithm>
+#include <iostream>
+
+DDM::SceneLoad::SceneLoad(const std::string& name, SceneResources resources, SceneBuildFunction build, SceneLoadMode loadMode, uint32_t threadCount)
+	:m_Name{ name },
+	m_Resources{ std::move(resources) },
+	m_Build{ std::move(build) },
+	m_LoadMode{ loadMode }
+{
+	// Every resource has its own slot, so the threads never write to the same element
+	m_DecodedMeshes.resize(m_Resources.Meshes.size());
+	m_pDecodedTextures.resize(m_Resources.Textures.size());
+
+	m_ReadyResources.reserve(GetResourceCount());
+
+	// No more threads than resources
+	const size_t count{ std::min(static_cast<size_t>(std::max(threadCount, 1u)), GetResourceCount()) };
+
+	for (size_t index{}; index < count; ++index)
+	{
+		m_Threads.emplace_back(&SceneLoad::DecodeLoop, this);
+	}
+}
+
+DDM::SceneLoad::~SceneLoad()
+{
+	StopThreads();
+}
+
+bool DDM::SceneLoad::UploadResources(Clock::duration budget)
+{
+	DDM_PROFILE_FUNCTION();
+
+	const auto start{ Clock::now() };
+
+	std::vector<size_t> readyResources{};
+
+	{
+		std::lock_guard lock{ m_ReadyMutex };
+		readyResources.swap(m_ReadyResources);
+	}
+
+	size_t uploaded{};
+
+	// Upload until the budget is spent, the rest waits for the next frame
+	for (; uploaded < readyResources.size(); ++uploaded)
+	{
+		if (uploaded > 0 && Clock::now() - start >= budget)
+			break;
+
+		Upload(readyResources[uploaded]);
+	}
+
+	// Hand the resources that didn't fit back, in front of the ones decoded in the meantime
+	if (uploaded < readyResources.size())
+	{
+		std::lock_guard lock{ m_ReadyMutex };
+		m_ReadyResources.insert(m_ReadyResources.begin(), readyResources.begin() + uploaded, readyResources.end());
+	}
+
+	return m_UploadedCount == GetResourceCount();
+}
+
+void DDM::SceneLoad::Build(std::shared_ptr<Scene> pScene)
+{
+	DDM_PROFILE_FUNCTION();
+
+	// Every resource was decoded, the threads are done
+	StopThreads();
+
+	if (m_Build)
+	{
+		m_Build(pScene.get());
+	}
+
+	m_pScene = pScene;
+
+	// The scene holds the resources it uses, the rest can be released
+	m_pMeshes.clear();
+	m_pTextures.clear();
+	m_DecodedMeshes.clear();
+	m_pDecodedTextures.clear();
+}
+
+float DDM::SceneLoad::GetProgress() const
+{
+	if (IsDone())
+		return 1.0f;
+
+	// Every resource is decoded and uploaded, building the scene is the last step
+	const size_t steps{ GetResourceCount() * 2 + 1 };
+
+	return static_cast<float>(m_DecodedCount.load(std::memory_order_relaxed) + m_UploadedCount) / static_cast<float>(steps);
+}
+
+void DDM::SceneLoad::DecodeLoop()
+{
+	DDM_PROFILE_THREAD("SceneStreaming");
+
+	while (!m_Cancelled.load(std::memory_order_relaxed))
+	{
+		const size_t index{ m_NextResource.fetch_add(1, std::memory_order_relaxed) };
+
+		if (index >= GetResourceCount())
+			return;
+
+		Decode(index);
+
+		m_DecodedCount.fetch_add(1, std::memory_order_relaxed);
+
+		std::lock_guard lock{ m_ReadyMutex };
+		m_ReadyResources.push_back(index);
+	}
+}
+
+void DDM::SceneLoad::Decode(size_t index)
+{
+	DDM_PROFILE_FUNCTION();
+
+	const size_t meshCount{ m_Resources.Meshes.size() };
+
+	if (index < meshCount)
+	{
+		auto& decodedMesh{ m_DecodedMeshes[index] };
+
+		try
+		{
+			DDMModelLoader::GetInstance().LoadModel(m_Resources.Meshes[index], decodedMesh.Vertices, decodedMesh.Indices);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Exception caught: " << e.what() << std::endl;
+			decodedMesh.Failed = true;
+		}
+
+		return;
+	}
+
+	try
+	{
+		// Falls back to the default texture when the file can't be read
+		m_pDecodedTextures[index - meshCount] = std::make_unique<STBImage>(m_Resources.Textures[index - meshCount]);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Exception caught: " << e.what() << std::endl;
+	}
+}
+
+void DDM::SceneLoad::Upload(size_t index)
+{
+	DDM_PROFILE_FUNCTION();
+
+	auto& resourceManager{ ResourceManager::GetInstance() };
+
+	const size_t meshCount{ m_Resources.Meshes.size() };
+
+	if (index < meshCount)
+	{
+		auto& decodedMesh{ m_DecodedMeshes[index] };
+
+		// Meshes that failed are left to the build function, which gets the default mesh for them
+		if (!decodedMesh.Failed)
+		{
+			m_pMeshes.push_back(resourceManager.AddMesh(m_Resources.Meshes[index], decodedMesh.Vertices, decodedMesh.Indices));
+		}
+
+		// The vertices are on the gpu now
+		decodedMesh = DecodedMesh{};
+	}
+	else if (auto& pImage{ m_pDecodedTextures[index - meshCount] }; pImage != nullptr)
+	{
+		m_pTextures.push_back(resourceManager.AddTexture(m_Resources.Textures[index - meshCount], *pImage));
+
+		pImage.reset();
+	}
+
+	++m_UploadedCount;
+}
+
+void DDM::SceneLoad::StopThreads()
+{
+	m_Cancelled.store(true, std::memory_order_relaxed);
+
+	for (auto& thread : m_Threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+
+	m_Threads.clear();
+}
@@ -0,0 +1,213 @@
+// SceneLoad.h
+// This class loads the resources of a scene in the background
+// Worker threads read and decode the meshes and textures, the main thread uploads them to the gpu a few at a time every frame
+// and builds the scene once everything is uploaded, so loading a scene never stalls a frame on file io
+
+#ifndef _DDM_SCENE_LOAD_
+#define _DDM_SCENE_LOAD_
+
+// File includes
+#include "DataTypes/Structs.h"
+
+// Standard library includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class Scene;
+	class Mesh;
+	class Image;
+	class STBImage;
+
+	// Files a scene needs, loaded before the scene is built
+	struct SceneResources
+	{
+		// File paths of the meshes
+		std::vector<std::string> Meshes{};
+
+		// File paths of the textures
+		std::vector<std::string> Textures{};
+	};
+
+	// What happens with a scene once it is built
+	enum class SceneLoadMode : uint8_t
+	{
+		// The scene is only created, it can be loaded later
+		Inactive,
+
+		// The scene replaces the active scene, additive scenes stay loaded
+		Single,
+
+		// The scene is loaded next to the scenes that are loaded already
+		Additive
+	};
+
+	// Function that fills a scene once its resources are loaded
+	using SceneBuildFunction = std::function<void(Scene*)>;
+
+	class SceneLoad final
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/// <summary>
+		/// Constructor, starts decoding the resources right away
+		/// </summary>
+		/// <param name="name: ">Name of the scene that will be created</param>
+		/// <param name="resources: ">Files the scene needs</param>
+		/// <param name="build: ">Function that fills the scene, runs on the main thread</param>
+		/// <param name="loadMode: ">What happens with the scene once it is built</param>
+		/// <param name="threadCount: ">Amount of threads that decode resources, at least 1</param>
+		SceneLoad(const std::string& name, SceneResources resources, SceneBuildFunction build, SceneLoadMode loadMode, uint32_t threadCount);
+
+		/// <summary>
+		/// Destructor, stops and joins the decoding threads
+		/// </summary>
+		~SceneLoad();
+
+		// Rule of five
+		SceneLoad(const SceneLoad& other) = delete;
+		SceneLoad(SceneLoad&& other) = delete;
+		SceneLoad& operator=(const SceneLoad& other) = delete;
+		SceneLoad& operator=(SceneLoad&& other) = delete;
+
+		/// <summary>
+		/// Upload decoded resources to the gpu until the budget is spent, at least one resource is uploaded when one is ready
+		/// </summary>
+		/// <param name="budget: ">Time the uploads can take this frame</param>
+		/// <returns>Boolean indicating every resource is uploaded and the scene can be built</returns>
+		bool UploadResources(Clock::duration budget);
+
+		/// <summary>
+		/// Fill the scene with the build function and release the loaded resources, the scene keeps what it uses
+		/// </summary>
+		/// <param name="pScene: ">The scene to fill</param>
+		void Build(std::shared_ptr<Scene> pScene);
+
+		/// <summary>
+		/// Get the progress of the load
+		/// </summary>
+		/// <returns>Progress between 0 and 1, 1 when the scene is built</returns>
+		float GetProgress() const;
+
+		/// <summary>
+		/// Check if the scene is built
+		/// </summary>
+		/// <returns>Boolean indicating the scene is built</returns>
+		bool IsDone() const { return m_pScene != nullptr; }
+
+		/// <summary>
+		/// Get what happens with the scene once it is built
+		/// </summary>
+		/// <returns>The load mode of the scene</returns>
+		SceneLoadMode GetLoadMode() const { return m_LoadMode; }
+
+		/// <summary>
+		/// Get the name of the scene
+		/// </summary>
+		/// <returns>Name of the scene</returns>
+		const std::string& GetName() const { return m_Name; }
+
+		/// <summary>
+		/// Get the built scene
+		/// </summary>
+		/// <returns>Pointer to the scene, nullptr while the scene isn't built</returns>
+		std::shared_ptr<Scene> GetScene() const { return m_pScene; }
+
+	private:
+		// A mesh read from its file
+		struct DecodedMesh
+		{
+			std::vector<Vertex> Vertices{};
+			std::vector<uint32_t> Indices{};
+
+			// Indicates the file couldn't be loaded, the default mesh is used instead
+			bool Failed{};
+		};
+
+		// Name of the scene
+		std::string m_Name{};
+
+		// Files the scene needs
+		SceneResources m_Resources{};
+
+		// Function that fills the scene
+		SceneBuildFunction m_Build{};
+
+		// What happens with the scene once it is built
+		SceneLoadMode m_LoadMode{};
+
+		// Decoded meshes, in the order of the mesh paths
+		std::vector<DecodedMesh> m_DecodedMeshes{};
+
+		// Decoded textures, in the order of the texture paths, nullptr when the file couldn't be loaded
+		std::vector<std::unique_ptr<STBImage>> m_pDecodedTextures{};
+
+		// Uploaded resources, kept alive until the scene is built
+		std::vector<std::shared_ptr<Mesh>> m_pMeshes{};
+		std::vector<std::shared_ptr<Image>> m_pTextures{};
+
+		// Guards the list of decoded resources that are ready to upload
+		std::mutex m_ReadyMutex{};
+
+		// Indices of the decoded resources that are ready to upload, meshes first and textures after them
+		std::vector<size_t> m_ReadyResources{};
+
+		// Index of the next resource a thread decodes
+		std::atomic<size_t> m_NextResource{};
+
+		// Amount of decoded resources
+		std::atomic<size_t> m_DecodedCount{};
+
+		// Amount of uploaded resources, only used on the main thread
+		size_t m_UploadedCount{};
+
+		// Indicates the decoding threads should stop
+		std::atomic<bool> m_Cancelled{};
+
+		// Threads that decode the resources
+		std::vector<std::thread> m_Threads{};
+
+		// The built scene
+		std::shared_ptr<Scene> m_pScene{};
+
+		/// <summary>
+		/// Get the amount of resources of the scene
+		/// </summary>
+		/// <returns>Amount of meshes and textures</returns>
+		size_t GetResourceCount() const { return m_Resources.Meshes.size() + m_Resources.Textures.size(); }
+
+		/// <summary>
+		/// Decode resources until every resource is taken or the load is cancelled, runs on the decoding threads
+		/// </summary>
+		void DecodeLoop();
+
+		/// <summary>
+		/// Read and decode a single resource
+		/// </summary>
+		/// <param name="index: ">Index of the resource, meshes first and textures after them</param>
+		void Decode(size_t index);
+
+		/// <summary>
+		/// Upload a single decoded resource to the gpu
+		/// </summary>
+		/// <param name="index: ">Index of the resource, meshes first and textures after them</param>
+		void Upload(size_t index);
+
+		/// <summary>
+		/// Stop and join the decoding threads
+		/// </summary>
+		void StopThreads();
+	};
+}
+
+#endif // !_DDM_SCENE_LOAD_
@@ -0,0 +1,171 @@
+// LoadEcsBenchmarkScene.h
+// This file is used to load in a single scene
+// In this case a grid of rotating cubes to compare the ecs to game objects
+// Both versions show the same cubes doing the same work, compare the frame times in the info component
+
+// File includes
+#include "Managers/ResourceManager.h"
+#include "Managers/SceneManager.h"
+
+#include "Engine/Scene.h"
+
+#include "BaseClasses/GameObject.h"
+
+#include "Components/Camera.h"
+#include "Components/InfoComponent.h"
+#include "Components/InstancedMeshRenderer.h"
+#include "Components/Light/LightComponent.h"
+#include "Components/MeshRenderer.h"
+#include "Components/Rotator.h"
+#include "Components/SpectatorMovement.h"
+#include "Components/Transform.h"
+
+#include "Ecs/EcsSystems.h"
+#include "Ecs/EcsWorld.h"
+
+// Standard library includes
+#include <cmath>
+
+namespace LoadEcsBenchmarkScene
+{
+	// Amount of rotating cubes
+	constexpr int kObjectCount{ 100'000 };
+
+	// Distance between neighbouring cubes
+	constexpr float kSpacing{ 2.f };
+
+	// Scale of every cube
+	constexpr float kScale{ 0.5f };
+
+	// Rotation speed of every cube in degrees per second
+	constexpr float kRotationSpeed{ 50.f };
+
+	void SetupScene(DDM::Scene* scene);
+
+	void SetupEcsCubes(DDM::Scene* scene);
+
+	void SetupGameObjectCubes(DDM::Scene* scene);
+
+	glm::vec3 GetCubePosition(int index);
+
+	glm::vec3 GetCubeAxis(int index);
+
+	void LoadEcsScene()
+	{
+		auto scene = DDM::SceneManager::GetInstance().CreateScene("EcsBenchmark");
+		DDM::SceneManager::GetInstance().SetActiveScene(scene);
+
+		SetupEcsCubes(scene.get());
+
+		SetupScene(scene.get());
+	}
+
+	void LoadGameObjectScene()
+	{
+		auto scene = DDM::SceneManager::GetInstance().CreateScene("GameObjectBenchmark");
+		DDM::SceneManager::GetInstance().SetActiveScene(scene);
+
+		SetupGameObjectCubes(scene.get());
+
+		SetupScene(scene.get());
+	}
+
+	void SetupEcsCubes(DDM::Scene* scene)
+	{
+		// A single renderer draws every cube
+		auto pCubes{ scene->CreateGameObject("EcsCubes") };
+
+		auto pRenderer{ pCubes->AddComponent<DDM::InstancedMeshRenderComponent>() };
+		pRenderer->SetMesh(DDM::ResourceManager::GetInstance().LoadMesh("resources/DefaultResources/cube.obj"));
+
+		// Systems run in the order they are added
+		auto pWorld{ scene->GetEcsWorld() };
+		pWorld->AddSystem<DDM::EcsRotationSystem>();
+		pWorld->AddSystem<DDM::EcsTransformSystem>();
+
+		auto pRenderSystem{ pWorld->AddSystem<DDM::EcsRenderSystem>() };
+		const uint32_t batchId{ pRenderSystem->AddBatch(pRenderer.get()) };
+
+		pWorld->Reserve<DDM::EcsPosition, DDM::EcsRotation, DDM::EcsScale, DDM::EcsAngularVelocity, DDM::EcsWorldMatrix, DDM::EcsMeshInstance>(kObjectCount);
+
+		for (int index{}; index < kObjectCount; ++index)
+		{
+			pWorld->CreateEntity(
+				DDM::EcsPosition{ GetCubePosition(index) },
+				DDM::EcsRotation{},
+				DDM::EcsScale{ glm::vec3{ kScale } },
+				DDM::EcsAngularVelocity{ GetCubeAxis(index), glm::radians(kRotationSpeed) },
+				DDM::EcsWorldMatrix{},
+				DDM::EcsMeshInstance{ batchId });
+		}
+	}
+
+	void SetupGameObjectCubes(DDM::Scene* scene)
+	{
+		auto pMesh{ DDM::ResourceManager::GetInstance().LoadMesh("resources/DefaultResources/cube.obj") };
+
+		scene->ReserveGameObjects(kObjectCount);
+
+		for (int index{}; index < kObjectCount; ++index)
+		{
+			auto pCube{ scene->CreateGameObject("Cube") };
+
+			auto pRenderer{ pCube->AddComponent<DDM::MeshRenderComponent>() };
+			pRenderer->SetMesh(pMesh);
+
+			auto pRotator{ pCube->AddComponent<DDM::RotatorComponent>() };
+			pRotator->SetRotAxis(GetCubeAxis(index));
+			pRotator->SetRotSpeed(kRotationSpeed);
+
+			auto pTransform{ pCube->GetTransform() };
+			pTransform->SetLocalPosition(GetCubePosition(index));
+			pTransform->SetLocalScale(kScale, kScale, kScale);
+		}
+	}
+
+	void SetupScene(DDM::Scene* scene)
+	{
+		auto pInfoObject{ scene->CreateGameObject("InfoComponent") };
+		pInfoObject->SetShowImGui(true);
+
+		auto pInfoComponent{ pInfoObject->AddComponent<DDM::InfoComponent>() };
+		pInfoComponent->SetShowImGui(true);
+
+		// Place the camera in front of the grid, the first cube is on the near side
+		auto pCamera{ scene->CreateGameObject("Camera") };
+		pCamera->AddComponent<DDM::SpectatorMovement>();
+
+		auto pCameraComponent{ pCamera->AddComponent<DDM::Camera>() };
+		pCamera->GetTransform()->SetLocalPosition(0.f, 0.f, GetCubePosition(0).z * 1.5f);
+
+		scene->SetCamera(pCameraComponent);
+
+		auto pLight{ scene->CreateGameObject("Light") };
+
+		auto pLightComponent{ pLight->AddComponent<DDM::LightComponent>() };
+		pLight->GetTransform()->SetLocalRotation(glm::vec3(glm::radians(45.f), glm::radians(45.f), 0.0f));
+
+		scene->SetLight(pLightComponent);
+	}
+
+	glm::vec3 GetCubePosition(int index)
+	{
+		// Cubes are placed in a cube shaped grid around the origin
+		static const int gridSize{ static_cast<int>(std::ceil(std::cbrt(static_cast<float>(kObjectCount)))) };
+		const float offset{ (gridSize - 1) * kSpacing * 0.5f };
+
+		const int x{ index % gridSize };
+		const int y{ (index / gridSize) % gridSize };
+		const int z{ index / (gridSize * gridSize) };
+
+		return glm::vec3{ x * kSpacing - offset, y * kSpacing - offset, z * kSpacing - offset };
+	}
+
+	glm::vec3 GetCubeAxis(int index)
+	{
+		// Give every cube its own axis without using random numbers, so both versions match
+		const float angle{ static_cast<float>(index) };
+
+		return glm::normalize(glm::vec3{ std::sin(angle), 1.f, std::cos(angle) });
+	}
+}
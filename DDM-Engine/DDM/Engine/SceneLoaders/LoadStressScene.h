@@ -0,0 +1,350 @@
+// LoadStressScene.h
+// This file is used to load in a single scene
+// In this case a generated scene to test how the engine scales with the size of the world
+// The amount of objects, depth of the hierarchy, fraction of moving objects and the amount of unique meshes, materials and lights
+// are read from the config file, the same seed always generates the same scene
+// The random values are taken straight from the mt19937 output, the standard distributions differ between standard libraries
+// LoadSceneAsync streams the meshes in the background and shows a loading scene in the meantime
+
+// File includes
+#include "DataTypes/Materials/Material.h"
+
+#include "Managers/ConfigManager.h"
+#include "Managers/ResourceManager.h"
+#include "Managers/SceneManager.h"
+#include "Managers/TransformManager.h"
+
+#include "Engine/Scene.h"
+
+#include "BaseClasses/GameObject.h"
+
+#include "Components/Camera.h"
+#include "Components/InfoComponent.h"
+#include "Components/Light/LightComponent.h"
+#include "Components/MeshRenderer.h"
+#include "Components/Rotator.h"
+#include "Components/SpectatorMovement.h"
+#include "Components/Transform.h"
+
+// Standard library includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace LoadStressScene
+{
+	// Distance between neighbouring hierarchies
+	constexpr float kSpacing{ 3.f };
+
+	// Distance of every child from its parent in world units
+	constexpr float kChildOffset{ 1.2f };
+
+	// Size of every child relative to its parent
+	constexpr float kChildScale{ 0.8f };
+
+	// A mesh the generated objects can use
+	struct StressMesh
+	{
+		const char* Path{};
+
+		// Scale that makes the mesh about one unit big
+		float Scale{};
+	};
+
+	// Every mesh the generator can choose from, the amount of unique meshes is clamped to this list
+	constexpr std::array<StressMesh, 6> kMeshes
+	{
+		StressMesh{ "resources/DefaultResources/cube.obj", 1.f },
+		StressMesh{ "resources/DefaultResources/error.obj", 0.5f },
+		StressMesh{ "Resources/Models/Gear.obj", 0.33f },
+		StressMesh{ "Resources/Models/viking_room.obj", 0.75f },
+		StressMesh{ "Resources/Models/Car.obj", 0.2f },
+		StressMesh{ "Resources/Models/vehicle.obj", 0.03f }
+	};
+
+	// Parameters of the generated scene
+	struct StressSettings
+	{
+		// Total amount of generated objects
+		int ObjectCount{ 10'000 };
+
+		// Amount of objects from the root to the deepest child of every hierarchy, 1 keeps the scene flat
+		int Depth{ 4 };
+
+		// Fraction of the objects that rotate every frame
+		float DynamicFraction{ 0.1f };
+
+		// Amount of unique meshes
+		int MeshCount{ 4 };
+
+		// Amount of unique materials
+		int MaterialCount{ 8 };
+
+		// Amount of lights, the first one lights the scene
+		int LightCount{ 4 };
+
+		// Seed of the random generator
+		int Seed{ 1234 };
+	};
+
+	StressSettings ReadSettings();
+
+	float RandomUnit(std::mt19937& random);
+
+	float RandomSigned(std::mt19937& random);
+
+	int RandomIndex(std::mt19937& random, int count);
+
+	void SetupObjects(DDM::Scene* scene, const StressSettings& settings, std::mt19937& random);
+
+	void SetupLights(DDM::Scene* scene, const StressSettings& settings, std::mt19937& random);
+
+	void SetupScene(DDM::Scene* scene, const StressSettings& settings);
+
+	int GetHierarchyCount(const StressSettings& settings);
+
+	float GetGridExtent(const StressSettings& settings);
+
+	DDM::SceneResources GetResources(const StressSettings& settings);
+
+	void Build(DDM::Scene* scene, const StressSettings& settings);
+
+	void LoadScene()
+	{
+		auto scene = DDM::SceneManager::GetInstance().CreateScene("Stress");
+		DDM::SceneManager::GetInstance().SetActiveScene(scene);
+
+		Build(scene.get(), ReadSettings());
+	}
+
+	void LoadSceneAsync()
+	{
+		// Small scene that is shown while the stress scene loads
+		auto loadingScene = DDM::SceneManager::GetInstance().CreateScene("Loading");
+		DDM::SceneManager::GetInstance().SetActiveScene(loadingScene);
+
+		auto pInfoObject{ loadingScene->CreateGameObject("InfoComponent") };
+		pInfoObject->SetShowImGui(true);
+
+		auto pInfoComponent{ pInfoObject->AddComponent<DDM::InfoComponent>() };
+		pInfoComponent->SetShowImGui(true);
+
+		auto pCamera{ loadingScene->CreateGameObject("Camera") };
+		loadingScene->SetCamera(pCamera->AddComponent<DDM::Camera>());
+
+		const StressSettings settings{ ReadSettings() };
+
+		DDM::SceneManager::GetInstance().LoadSceneAsync("Stress", GetResources(settings),
+			[settings](DDM::Scene* scene) { Build(scene, settings); });
+	}
+
+	DDM::SceneResources GetResources(const StressSettings& settings)
+	{
+		DDM::SceneResources resources{};
+
+		for (int index{}; index < settings.MeshCount; ++index)
+		{
+			resources.Meshes.emplace_back(kMeshes[index].Path);
+		}
+
+		return resources;
+	}
+
+	void Build(DDM::Scene* scene, const StressSettings& settings)
+	{
+		std::mt19937 random{ static_cast<std::mt19937::result_type>(settings.Seed) };
+
+		SetupObjects(scene, settings, random);
+
+		SetupLights(scene, settings, random);
+
+		SetupScene(scene, settings);
+	}
+
+	StressSettings ReadSettings()
+	{
+		auto& configManager{ DDM::ConfigManager::GetInstance() };
+
+		StressSettings settings{};
+		settings.ObjectCount = std::max(configManager.GetInt("StressObjectCount"), 1);
+		settings.Depth = std::max(configManager.GetInt("StressHierarchyDepth"), 1);
+		settings.DynamicFraction = std::clamp(configManager.GetFloat("StressDynamicFraction"), 0.f, 1.f);
+		settings.MeshCount = std::clamp(configManager.GetInt("StressMeshCount"), 1, static_cast<int>(kMeshes.size()));
+		settings.MaterialCount = std::max(configManager.GetInt("StressMaterialCount"), 1);
+		settings.LightCount = std::max(configManager.GetInt("StressLightCount"), 1);
+		settings.Seed = configManager.GetInt("StressSeed");
+
+		return settings;
+	}
+
+	float RandomUnit(std::mt19937& random)
+	{
+		// The top 24 bits fill the mantissa of a float exactly, so the result is in [0, 1)
+		return static_cast<float>(random() >> 8) * (1.f / 16'777'216.f);
+	}
+
+	float RandomSigned(std::mt19937& random)
+	{
+		return RandomUnit(random) * 2.f - 1.f;
+	}
+
+	int RandomIndex(std::mt19937& random, int count)
+	{
+		// Scale the 32 bit output to [0, count), the bias is far too small to matter for a few meshes and materials
+		return static_cast<int>((static_cast<uint64_t>(random()) * static_cast<uint64_t>(count)) >> 32);
+	}
+
+	void SetupObjects(DDM::Scene* scene, const StressSettings& settings, std::mt19937& random)
+	{
+		auto& resourceManager{ DDM::ResourceManager::GetInstance() };
+
+		std::vector<std::shared_ptr<DDM::Mesh>> pMeshes{};
+
+		for (int index{}; index < settings.MeshCount; ++index)
+		{
+			pMeshes.push_back(resourceManager.LoadMesh(kMeshes[index].Path));
+		}
+
+		std::vector<std::shared_ptr<DDM::Material>> pMaterials{};
+
+		for (int index{}; index < settings.MaterialCount; ++index)
+		{
+			pMaterials.push_back(std::make_shared<DDM::Material>());
+		}
+
+		const int hierarchyCount{ GetHierarchyCount(settings) };
+
+		scene->ReserveGameObjects(static_cast<size_t>(hierarchyCount));
+		DDM::GameObject::ReservePool(static_cast<size_t>(settings.ObjectCount));
+		DDM::TransformManager::GetInstance().Reserve(static_cast<size_t>(settings.ObjectCount));
+
+		// Hierarchies are placed in a square grid around the origin
+		const int gridSize{ static_cast<int>(std::ceil(std::sqrt(static_cast<float>(hierarchyCount)))) };
+		const float offset{ (gridSize - 1) * kSpacing * 0.5f };
+
+		int objectIndex{};
+
+		for (int hierarchy{}; hierarchy < hierarchyCount; ++hierarchy)
+		{
+			DDM::GameObject* pParent{ scene->GetSceneRoot() };
+
+			// Mesh scale and world scale of the parent, children are sized and spaced in world units
+			float parentMeshScale{ 1.f };
+			float parentWorldScale{ 1.f };
+
+			// Every object is a child of the one before it, the last hierarchy may be cut short
+			for (int depth{}; depth < settings.Depth && objectIndex < settings.ObjectCount; ++depth, ++objectIndex)
+			{
+				auto pObject{ pParent->CreateNewObject("StressObject") };
+
+				const int meshIndex{ RandomIndex(random, settings.MeshCount) };
+				const int materialIndex{ RandomIndex(random, settings.MaterialCount) };
+
+				auto pRenderer{ pObject->AddComponent<DDM::MeshRenderComponent>() };
+				pRenderer->SetMesh(pMeshes[meshIndex]);
+				pRenderer->SetMaterial(pMaterials[materialIndex]);
+
+				const float meshScale{ kMeshes[meshIndex].Scale };
+				const float worldScale{ depth == 0 ? meshScale : parentWorldScale / parentMeshScale * kChildScale * meshScale };
+
+				auto pTransform{ pObject->GetTransform() };
+				pTransform->SetLocalScale(glm::vec3{ worldScale / parentWorldScale });
+
+				if (depth == 0)
+				{
+					const float x{ (hierarchy % gridSize) * kSpacing - offset };
+					const float z{ (hierarchy / gridSize) * kSpacing - offset };
+
+					pTransform->SetLocalPosition(x, 0.f, z);
+				}
+				else
+				{
+					// Separate draws, the order function arguments are evaluated in differs between compilers
+					const float x{ RandomSigned(random) * kChildOffset };
+					const float z{ RandomSigned(random) * kChildOffset };
+
+					pTransform->SetLocalPosition(glm::vec3{ x, kChildOffset, z } / parentWorldScale);
+				}
+
+				if (RandomUnit(random) < settings.DynamicFraction)
+				{
+					const float axisX{ RandomSigned(random) };
+					const float axisZ{ RandomSigned(random) };
+					const float speed{ 10.f + RandomUnit(random) * 90.f };
+
+					auto pRotator{ pObject->AddComponent<DDM::RotatorComponent>() };
+					pRotator->SetRotAxis(glm::normalize(glm::vec3{ axisX, 1.f, axisZ }));
+					pRotator->SetRotSpeed(speed);
+				}
+
+				pParent = pObject;
+				parentMeshScale = meshScale;
+				parentWorldScale = worldScale;
+			}
+		}
+	}
+
+	void SetupLights(DDM::Scene* scene, const StressSettings& settings, std::mt19937& random)
+	{
+		const float extent{ GetGridExtent(settings) };
+
+		for (int index{}; index < settings.LightCount; ++index)
+		{
+			auto pLight{ scene->CreateGameObject("StressLight") };
+
+			auto pLightComponent{ pLight->AddComponent<DDM::LightComponent>() };
+
+			auto pLightTransform{ pLight->GetTransform() };
+			pLightTransform->SetLocalRotation(glm::vec3(glm::radians(45.f), glm::radians(45.f), 0.0f));
+
+			// The first light is the directional light of the scene, the others are point lights spread over the grid
+			if (index == 0)
+			{
+				scene->SetLight(pLightComponent);
+				continue;
+			}
+
+			pLightComponent->SetType(DDM::LightType::Point);
+			// Values in a braced list are evaluated from left to right, unlike function arguments
+			pLightComponent->SetColor(glm::vec3{ RandomUnit(random), RandomUnit(random), RandomUnit(random) });
+			pLightComponent->SetRange(kSpacing * 4.f);
+
+			const float x{ (RandomUnit(random) - 0.5f) * extent };
+			const float z{ (RandomUnit(random) - 0.5f) * extent };
+
+			pLightTransform->SetLocalPosition(x, kSpacing, z);
+		}
+	}
+
+	void SetupScene(DDM::Scene* scene, const StressSettings& settings)
+	{
+		auto pInfoObject{ scene->CreateGameObject("InfoComponent") };
+		pInfoObject->SetShowImGui(true);
+
+		auto pInfoComponent{ pInfoObject->AddComponent<DDM::InfoComponent>() };
+		pInfoComponent->SetShowImGui(true);
+
+		// Place the camera above the near edge of the grid
+		auto pCamera{ scene->CreateGameObject("Camera") };
+		pCamera->AddComponent<DDM::SpectatorMovement>();
+
+		auto pCameraComponent{ pCamera->AddComponent<DDM::Camera>() };
+		pCamera->GetTransform()->SetLocalPosition(0.f, kSpacing * 4.f, -GetGridExtent(settings) * 0.6f);
+
+		scene->SetCamera(pCameraComponent);
+	}
+
+	int GetHierarchyCount(const StressSettings& settings)
+	{
+		return (settings.ObjectCount + settings.Depth - 1) / settings.Depth;
+	}
+
+	float GetGridExtent(const StressSettings& settings)
+	{
+		return std::ceil(std::sqrt(static_cast<float>(GetHierarchyCount(settings)))) * kSpacing;
+	}
+}
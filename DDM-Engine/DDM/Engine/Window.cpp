@@ -17,12 +17,23 @@ DDM::Window::Window()
 	// Set the height of the window
 	m_Window.Height = ConfigManager::GetInstance().GetInt("WindowHeight");
 
+	// Check if the engine should run without a window
+	m_Headless = ConfigManager::GetInstance().GetBool("Headless");
+
+	// In headless mode glfw is never initialized, the window size is only used for the offscreen images
+	if (m_Headless)
+		return;
+
 	// Initialize the window
 	InitWindow();
 }
 
 DDM::Window::~Window()
 {
+	// Glfw was never initialized in headless mode
+	if (m_Headless)
+		return;
+
 	// Destroy the window
 	glfwDestroyWindow(m_Window.pWindow);
 
@@ -40,6 +40,10 @@ namespace DDM
 		// Get a reference to the windowstruct object
 		WindowStruct& GetWindowStruct() { return m_Window; }
 
+		// Check if the engine runs without a window, set with "Headless" in the config file
+		// In headless mode no glfw window is created and pWindow stays nullptr
+		bool IsHeadless() const { return m_Headless; }
+
 		// Set the FrameBufferResized variable
 		void SetFrameBufferResized(bool value);
 
@@ -54,6 +58,9 @@ namespace DDM
 		// The window struct object
 		WindowStruct m_Window{};
 
+		// Indicates the engine runs without a window
+		bool m_Headless{ false };
+
 		// Function that will initialize the glfw window
 		void InitWindow();
 
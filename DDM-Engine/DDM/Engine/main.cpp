@@ -1,10 +1,15 @@
 // File includes
 #include "DDMEngine.h"
+#include "BenchmarkRunner.h"
+
+#include "Managers/ConfigManager.h"
 
 #include "SceneLoaders/LoadModelLoaderScene.h"
 #include "SceneLoaders/LoadTestScene.h"
 #include "SceneLoaders/LoadDeferredScene.h"
 #include "SceneLoaders/LoadAOScene.h"
+#include "SceneLoaders/LoadEcsBenchmarkScene.h"
+#include "SceneLoaders/LoadStressScene.h"
 
 #include "Vulkan/Renderers/ForwardRenderer.h"
 #include "Vulkan/Renderers/DeferredRenderer.h"
@@ -12,20 +17,161 @@
 #include "Vulkan/Renderers/AORenderers/HBAORenderer.h"
 #include "Vulkan/Renderers/AORenderers/GTAORenderer.h"
 
+// Standard library includes
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 enum
 {
 	activeRendererForward = 0,
 	activeRendererDeffered = 1,
 	activeRendererSSAO = 2,
 	activeRendererHBAO = 3,
-	activeRendererGTAO = 4
+	activeRendererGTAO = 4,
+	activeRendererEcsBenchmark = 5,
+	activeRendererGameObjectBenchmark = 6
 };
 
-int main()
+// Renderers that can be benchmarked, by name
+const std::vector<std::string> benchmarkRenderers{ "Forward", "Deferred", "SSAO", "HBAO", "GTAO" };
+
+// Initialize the engine with a renderer chosen by name
+// Parameters:
+//     engine: the engine to initialize
+//     renderer: name of the renderer
+// Returns false if the renderer doesn't exist
+bool InitRenderer(DDM::DDMEngine& engine, const std::string& renderer)
+{
+	if (renderer == "Forward")
+		engine.Init<DDM::ForwardRenderer>();
+	else if (renderer == "Deferred")
+		engine.Init<DDM::DeferredRenderer>();
+	else if (renderer == "SSAO")
+		engine.Init<DDM::SSAORenderer>();
+	else if (renderer == "HBAO")
+		engine.Init<DDM::HBAORenderer>();
+	else if (renderer == "GTAO")
+		engine.Init<DDM::GTAORenderer>();
+	else
+		return false;
+
+	return true;
+}
+
+// Get a scene loader by name
+// Parameters:
+//     scene: name of the scene loader, empty for the scene the renderer uses by default
+//     renderer: name of the renderer
+std::function<void()> GetSceneLoader(const std::string& scene, const std::string& renderer)
+{
+	static const std::unordered_map<std::string, std::function<void()>> sceneLoaders
+	{
+		{ "LoadTestScene", LoadTestScene::loadTestScene },
+		{ "LoadModelLoaderScene", LoadModelLoaderScene::LoadModelLoaderScene },
+		{ "LoadDeferredScene", LoadDeferredScene::LoadScene },
+		{ "LoadAOScene", LoadAOScene::LoadScene },
+		{ "LoadEcsBenchmarkScene", LoadEcsBenchmarkScene::LoadEcsScene },
+		{ "LoadGameObjectBenchmarkScene", LoadEcsBenchmarkScene::LoadGameObjectScene },
+		{ "LoadStressScene", LoadStressScene::LoadScene },
+		{ "LoadStressSceneAsync", LoadStressScene::LoadSceneAsync }
+	};
+
+	if (scene.empty())
+	{
+		// Same scenes as the normal startup uses for every renderer
+		if (renderer == "Forward")
+			return LoadTestScene::loadTestScene;
+		if (renderer == "Deferred")
+			return LoadDeferredScene::LoadScene;
+
+		return LoadAOScene::LoadScene;
+	}
+
+	if (auto it{ sceneLoaders.find(scene) }; it != sceneLoaders.end())
+	{
+		return it->second;
+	}
+
+	return {};
+}
+
+// Get the scene loader chosen with "StartupScene" in the config file
+// Parameters:
+//     defaultLoader: the scene loader to use when the config file doesn't choose one
+std::function<void()> GetStartupSceneLoader(const std::function<void()>& defaultLoader)
+{
+	const std::string scene{ DDM::ConfigManager::GetInstance().GetString("StartupScene") };
+
+	if (scene.empty())
+		return defaultLoader;
+
+	auto load{ GetSceneLoader(scene, {}) };
+
+	if (!load)
+	{
+		std::cout << "Unknown startup scene " << scene << ", loading the default scene\n";
+		return defaultLoader;
+	}
+
+	return load;
+}
+
+// Run the benchmark harness
+// Parameters:
+//     settings: the settings read from the command line
+//     executable: path to this executable
+int RunBenchmark(const DDM::BenchmarkSettings& settings, const std::string& executable)
+{
+	// Every renderer needs a fresh engine, so each one runs in its own process
+	if (settings.Renderer == "All")
+	{
+		return DDM::BenchmarkRunner::RunPerRenderer(settings, executable, benchmarkRenderers);
+	}
+
+	auto load{ GetSceneLoader(settings.Scene, settings.Renderer) };
+
+	if (!load)
+	{
+		std::cout << "Unknown scene loader " << settings.Scene << "\n";
+		return EXIT_FAILURE;
+	}
+
+	DDM::DDMEngine engine{};
+
+	if (!InitRenderer(engine, settings.Renderer))
+	{
+		std::cout << "Unknown renderer " << settings.Renderer << "\n";
+		return EXIT_FAILURE;
+	}
+
+	DDM::BenchmarkRunner runner{ settings };
+
+	engine.SetFrameLimit(runner.GetFrameLimit());
+	engine.SetFrameCallback([&runner](const DDM::FrameTimings& timings) { runner.OnFrame(timings); });
+
+	engine.Run(load);
+
+	runner.Finish();
+
+	// Fails the run when the allocation check is enabled and a frame allocated after warming up
+	return engine.PassedAllocationCheck() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[])
 {
 	// Seed random number generator
 	srand(static_cast<uint16_t>(time(NULL)));
 
+	// Run the benchmark instead of the normal startup when "--benchmark" is passed
+	DDM::BenchmarkSettings benchmarkSettings{};
+
+	if (DDM::BenchmarkRunner::ParseArguments(argc, argv, benchmarkSettings))
+	{
+		return RunBenchmark(benchmarkSettings, argv[0]);
+	}
+
 	// Create the engine object and run it with the load function
 	DDM::DDMEngine engine{};
 
@@ -35,30 +181,37 @@ int main()
 	{
 	case activeRendererForward:
 		engine.Init<DDM::ForwardRenderer>();
-		engine.Run(LoadTestScene::loadTestScene);
+		engine.Run(GetStartupSceneLoader(LoadTestScene::loadTestScene));
 		//engine.Run(LoadModelLoaderScene::LoadModelLoaderScene);
 		break;
 	case activeRendererDeffered:
 		engine.Init<DDM::DeferredRenderer>();
-		engine.Run(LoadDeferredScene::LoadScene);
+		engine.Run(GetStartupSceneLoader(LoadDeferredScene::LoadScene));
 		break;
 	case activeRendererSSAO:
 		engine.Init<DDM::SSAORenderer>();
-		engine.Run(LoadAOScene::LoadScene);
+		engine.Run(GetStartupSceneLoader(LoadAOScene::LoadScene));
 		break;
 	case activeRendererHBAO:
 		engine.Init<DDM::HBAORenderer>();
-		engine.Run(LoadAOScene::LoadScene);
+		engine.Run(GetStartupSceneLoader(LoadAOScene::LoadScene));
 		break;
 	case activeRendererGTAO:
 		engine.Init<DDM::GTAORenderer>();
-		engine.Run(LoadAOScene::LoadScene);
+		engine.Run(GetStartupSceneLoader(LoadAOScene::LoadScene));
+		break;
+	case activeRendererEcsBenchmark:
+		engine.Init<DDM::ForwardRenderer>();
+		engine.Run(GetStartupSceneLoader(LoadEcsBenchmarkScene::LoadEcsScene));
+		break;
+	case activeRendererGameObjectBenchmark:
+		engine.Init<DDM::ForwardRenderer>();
+		engine.Run(GetStartupSceneLoader(LoadEcsBenchmarkScene::LoadGameObjectScene));
 		break;
 	default:
 		break;
 	}
 
-	
-	
-	return EXIT_SUCCESS;
+	// Fails the run when the allocation check is enabled and a frame allocated after warming up
+	return engine.PassedAllocationCheck() ? EXIT_SUCCESS : EXIT_FAILURE;
 } 
\ No newline at end of file
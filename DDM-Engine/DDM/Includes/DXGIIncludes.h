@@ -1,9 +0,0 @@
-// DXGIIncludes.h
-#ifndef _DXGI_INCLUDES_
-#define _DXGI_INCLUDES_
-
-// File includes
-#include <dxgi1_4.h>
-#include <atlbase.h>
-
-#endif // !_DXGI_INCLUDES_
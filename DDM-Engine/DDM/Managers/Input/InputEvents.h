@@ -0,0 +1,100 @@
+// InputEvents.h
+// This file contains the input events the glfw callbacks produce and the ring buffer they are queued in
+// Every event that happens between two frames is kept, so a key that is pressed and released before the next frame is still seen
+
+#ifndef InputEventsIncluded
+#define InputEventsIncluded
+
+// Standard library includes
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace DDM
+{
+	// Every kind of input event
+	enum class InputEventType : uint8_t
+	{
+		Key,
+		MouseButton,
+		CursorPosition,
+		Scroll
+	};
+
+	// A single input event, stored as is in input recordings
+	struct InputEvent
+	{
+		// Glfw time in seconds the event was received at
+		double Time{};
+
+		// Cursor position for cursor events, scroll offset for scroll events
+		float X{};
+		float Y{};
+
+		// Glfw key or mouse button
+		int32_t Code{};
+
+		// GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+		int32_t Action{};
+
+		InputEventType Type{};
+	};
+
+	// Recordings write the events as raw bytes
+	static_assert(std::is_trivially_copyable_v<InputEvent>);
+
+	// Fixed size ring buffer of input events, filled by the glfw callbacks and emptied once per frame
+	class InputEventQueue final
+	{
+	public:
+		// Amount of events that fit in the queue, has to be a power of two
+		static constexpr size_t kCapacity{ 1024 };
+
+		// Add an event, dropped when the queue is full
+		// Parameters:
+		//     event: the event to add
+		void Push(const InputEvent& event)
+		{
+			if (m_Tail - m_Head == kCapacity)
+			{
+				++m_DroppedCount;
+				return;
+			}
+
+			m_Events[m_Tail & (kCapacity - 1)] = event;
+			++m_Tail;
+		}
+
+		// Move every queued event to the back of a list, oldest first
+		// Parameters:
+		//     events: the list the events are added to
+		void Drain(std::vector<InputEvent>& events)
+		{
+			for (; m_Head != m_Tail; ++m_Head)
+			{
+				events.push_back(m_Events[m_Head & (kCapacity - 1)]);
+			}
+		}
+
+		// Remove every queued event
+		void Clear() { m_Head = m_Tail; }
+
+		// Get the amount of events that were dropped because the queue was full
+		uint64_t GetDroppedCount() const { return m_DroppedCount; }
+
+	private:
+		std::array<InputEvent, kCapacity> m_Events{};
+
+		// Index of the oldest event, wraps with the capacity
+		uint64_t m_Head{};
+
+		// Index the next event is written to, wraps with the capacity
+		uint64_t m_Tail{};
+
+		uint64_t m_DroppedCount{};
+	};
+}
+
+#endif // !InputEventsIncluded
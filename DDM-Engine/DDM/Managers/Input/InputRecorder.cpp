@@ -0,0 +1,149 @@
+// InputRecorder.cpp
+
+// Header include
+#include "InputRecorder.h"
+
+// Standard library includes
+#include <algorithm>
+#include <iostream>
+
+bool DDM::InputRecorder::BeginRecording(const std::string& fileName)
+{
+	Stop();
+
+	m_OutputFile.open(fileName, std::ios::binary | std::ios::trunc);
+
+	if (!m_OutputFile.is_open())
+	{
+		std::cout << "Could not open input recording " << fileName << "\n";
+		return false;
+	}
+
+	m_OutputFile.write(kMagic, sizeof(kMagic));
+	m_OutputFile.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+
+	m_IsRecording = true;
+
+	std::cout << "Recording input to " << fileName << "\n";
+
+	return true;
+}
+
+bool DDM::InputRecorder::BeginReplay(const std::string& fileName)
+{
+	Stop();
+
+	m_InputFile.open(fileName, std::ios::binary);
+
+	if (!m_InputFile.is_open())
+	{
+		std::cout << "Could not open input recording " << fileName << "\n";
+		return false;
+	}
+
+	char magic[sizeof(kMagic)]{};
+	uint32_t version{};
+
+	m_InputFile.read(magic, sizeof(magic));
+	m_InputFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+	if (!m_InputFile || !std::equal(std::begin(magic), std::end(magic), std::begin(kMagic)) || version != kVersion)
+	{
+		std::cout << "Input recording " << fileName << " is not valid\n";
+		m_InputFile.close();
+		return false;
+	}
+
+	m_IsReplaying = true;
+
+	std::cout << "Replaying input from " << fileName << "\n";
+
+	return true;
+}
+
+void DDM::InputRecorder::Stop()
+{
+	if (m_IsRecording)
+	{
+		m_OutputFile.close();
+		std::cout << "Recorded " << m_FrameCount << " frames of input\n";
+	}
+
+	if (m_IsReplaying)
+	{
+		m_InputFile.close();
+		std::cout << "Replayed " << m_FrameCount << " frames of input\n";
+	}
+
+	m_IsRecording = false;
+	m_IsReplaying = false;
+	m_FrameCount = 0;
+}
+
+void DDM::InputRecorder::RecordFrame(float deltaTime, std::span<const InputEvent> events)
+{
+	if (!m_IsRecording)
+		return;
+
+	const auto eventCount{ static_cast<uint32_t>(events.size()) };
+
+	m_OutputFile.write(reinterpret_cast<const char*>(&deltaTime), sizeof(deltaTime));
+	m_OutputFile.write(reinterpret_cast<const char*>(&eventCount), sizeof(eventCount));
+	m_OutputFile.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size_bytes()));
+
+	++m_FrameCount;
+}
+
+bool DDM::InputRecorder::ReplayFrame(float& deltaTime, std::vector<InputEvent>& events)
+{
+	if (!m_IsReplaying)
+		return false;
+
+	m_InputFile.read(reinterpret_cast<char*>(&deltaTime), sizeof(deltaTime));
+
+	// Running out of data right at the start of a frame is the normal end of a recording
+	if (!m_InputFile)
+	{
+		if (m_InputFile.gcount() != 0)
+			std::cout << "Input recording is cut off in frame " << m_FrameCount << "\n";
+
+		Stop();
+		return false;
+	}
+
+	uint32_t eventCount{};
+	m_InputFile.read(reinterpret_cast<char*>(&eventCount), sizeof(eventCount));
+
+	if (!m_InputFile)
+	{
+		std::cout << "Input recording is cut off in frame " << m_FrameCount << "\n";
+		Stop();
+		return false;
+	}
+
+	// The queue never holds more events than this, so a larger count means the file is corrupt
+	if (eventCount > InputEventQueue::kCapacity)
+	{
+		std::cout << "Input recording has " << eventCount << " events in frame " << m_FrameCount << ", more than the " << InputEventQueue::kCapacity << " a frame can have\n";
+		Stop();
+		return false;
+	}
+
+	const size_t first{ events.size() };
+	events.resize(first + eventCount);
+
+	m_InputFile.read(reinterpret_cast<char*>(events.data() + first), static_cast<std::streamsize>(eventCount * sizeof(InputEvent)));
+
+	// A recording that was cut off halfway through a frame ends before that frame
+	if (!m_InputFile)
+	{
+		std::cout << "Input recording is cut off in frame " << m_FrameCount << "\n";
+		events.resize(first);
+		Stop();
+		return false;
+	}
+
+	++m_FrameCount;
+
+	return true;
+}
@@ -0,0 +1,89 @@
+// InputRecorder.h
+// This class records the input events and delta time of every frame to a file and plays them back
+// The events and delta times are stored as raw bytes, so a replay gives every frame exactly the same input and delta time as the recording
+// Recordings are only meant to be replayed by a build for the same platform
+
+#ifndef InputRecorderIncluded
+#define InputRecorderIncluded
+
+// File includes
+#include "InputEvents.h"
+
+// Standard library includes
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace DDM
+{
+	class InputRecorder final
+	{
+	public:
+		// Default constructor
+		InputRecorder() = default;
+
+		// Default destructor
+		~InputRecorder() = default;
+
+		// Rule of five
+		InputRecorder(const InputRecorder& other) = delete;
+		InputRecorder(InputRecorder&& other) = delete;
+		InputRecorder& operator=(const InputRecorder& other) = delete;
+		InputRecorder& operator=(InputRecorder&& other) = delete;
+
+		// Start writing every frame to a file
+		// Parameters:
+		//     fileName: name of the recording
+		// Returns false if the file couldn't be opened
+		bool BeginRecording(const std::string& fileName);
+
+		// Start reading the frames from a file
+		// Parameters:
+		//     fileName: name of the recording
+		// Returns false if the file couldn't be opened or isn't a recording
+		bool BeginReplay(const std::string& fileName);
+
+		// Stop recording or replaying
+		void Stop();
+
+		// Check if frames are being written
+		bool IsRecording() const { return m_IsRecording; }
+
+		// Check if frames are being read
+		bool IsReplaying() const { return m_IsReplaying; }
+
+		// Write a frame to the recording
+		// Parameters:
+		//     deltaTime: the delta time of the frame
+		//     events: the input events of the frame
+		void RecordFrame(float deltaTime, std::span<const InputEvent> events);
+
+		// Read the next frame of the replay, the replay stops after the last frame or at the first frame that can't be read
+		// Parameters:
+		//     deltaTime: reference to the delta time that is filled in
+		//     events: reference to the list the events of the frame are added to
+		// Returns false if there were no frames left or the frame was not valid
+		bool ReplayFrame(float& deltaTime, std::vector<InputEvent>& events);
+
+		// Get the amount of frames recorded or replayed so far
+		uint64_t GetFrameCount() const { return m_FrameCount; }
+
+	private:
+		// Written at the start of every recording, followed by the version
+		static constexpr char kMagic[8]{ 'D', 'D', 'M', 'I', 'N', 'P', 'U', 'T' };
+
+		// Changes whenever the layout of a frame or event changes
+		static constexpr uint32_t kVersion{ 1 };
+
+		std::ofstream m_OutputFile{};
+		std::ifstream m_InputFile{};
+
+		bool m_IsRecording{};
+		bool m_IsReplaying{};
+
+		uint64_t m_FrameCount{};
+	};
+}
+
+#endif // !InputRecorderIncluded
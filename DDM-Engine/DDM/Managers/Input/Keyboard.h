@@ -25,9 +25,9 @@ namespace DDM
 		Keyboard& operator=(const Keyboard& other) = delete;
 		Keyboard& operator=(Keyboard&& other) = delete;
 
-		void Update()
+		void Update(std::span<const InputEvent> events)
 		{
-			m_pImpl->Update();
+			m_pImpl->Update(events);
 		}
 
 		bool IsPressed(int button)
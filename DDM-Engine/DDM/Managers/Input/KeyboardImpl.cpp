@@ -3,48 +3,31 @@
 // Header include
 #include "KeyBoardImpl.h"
 
-// File includes
-#include "Includes/GLFWIncludes.h"
-
-#include "Engine/Window.h"
-
-// Standard library includes
-#include <algorithm>
-#include <functional>
-#include <iostream>
-
-DDM::KeyBoardImpl::KeyBoardImpl()
-{
-	m_Pressed.resize(GLFW_KEY_LAST+1);
-
-	m_Down.resize(m_Pressed.size());
-
-	m_Up.resize(m_Pressed.size());
-}
-
-void DDM::KeyBoardImpl::Update()
+void DDM::KeyBoardImpl::Update(std::span<const InputEvent> events)
 {
-	auto window = DDM::Window::GetInstance().GetWindowStruct().pWindow;
-
-	std::vector<bool> currentState;
-	currentState.resize(m_Pressed.size());
+	// Edges only last a single frame
+	m_Down.reset();
+	m_Up.reset();
 
-	for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; ++key)
+	for (const auto& event : events)
 	{
-		currentState[key] = glfwGetKey(window, key) == GLFW_PRESS;
+		// Keys glfw doesn't know are reported as GLFW_KEY_UNKNOWN
+		if (event.Type != InputEventType::Key || event.Code < 0 || event.Code >= static_cast<int32_t>(kKeyCount))
+			continue;
+
+		const auto key{ static_cast<size_t>(event.Code) };
+
+		if (event.Action == GLFW_PRESS && !m_Pressed[key])
+		{
+			m_Down[key] = true;
+			m_Pressed[key] = true;
+		}
+		else if (event.Action == GLFW_RELEASE && m_Pressed[key])
+		{
+			m_Up[key] = true;
+			m_Pressed[key] = false;
+		}
 	}
-
-	std::vector<bool> changes;
-	changes.resize(m_Pressed.size());
-
-	std::transform(currentState.begin(), currentState.end(), m_Pressed.begin(), changes.begin(), std::bit_xor<bool>());
-
-	std::transform(changes.begin(), changes.end(), currentState.begin(), m_Down.begin(), std::bit_and<bool>());
-
-	std::transform(changes.begin(), changes.end(), currentState.begin(), m_Up.begin(), [](bool first, bool second)
-		{return std::bit_and<bool>()(first, !second); });
-
-	m_Pressed = std::move(currentState);
 }
 
 bool DDM::KeyBoardImpl::IsPressed(int button)
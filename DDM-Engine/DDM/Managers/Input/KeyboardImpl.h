@@ -1,11 +1,18 @@
 // KeyboardImpl.h
 // This class will manage the input events from glfw
+// The state of every key is derived from the key events of the frame, so a tap between two frames is both down and up in the next one
 
 #ifndef KeyboardImplIncluded
 #define KeyboardImplIncluded
 
+// File includes
+#include "InputEvents.h"
+
+#include "Includes/GLFWIncludes.h"
+
 // Standard library includes
-#include <vector>
+#include <bitset>
+#include <span>
 
 namespace DDM
 {
@@ -13,7 +20,7 @@ namespace DDM
 	{
 	public:
 
-		KeyBoardImpl();
+		KeyBoardImpl() = default;
 		~KeyBoardImpl() = default;
 
 		KeyBoardImpl(const KeyBoardImpl& other) = delete;
@@ -22,7 +29,10 @@ namespace DDM
 		KeyBoardImpl& operator=(const KeyBoardImpl& other) = delete;
 		KeyBoardImpl& operator=(KeyBoardImpl&& other) = delete;
 
-		void Update();
+		// Apply the key events of a frame
+		// Parameters:
+		//     events: every input event of the frame, oldest first
+		void Update(std::span<const InputEvent> events);
 
 		bool IsPressed(int button);
 
@@ -31,9 +41,11 @@ namespace DDM
 		bool IsDown(int button);
 
 	private:
-		std::vector<bool> m_Pressed;
-		std::vector<bool> m_Up;
-		std::vector<bool> m_Down;
+		static constexpr size_t kKeyCount{ GLFW_KEY_LAST + 1 };
+
+		std::bitset<kKeyCount> m_Pressed{};
+		std::bitset<kKeyCount> m_Up{};
+		std::bitset<kKeyCount> m_Down{};
 	};
 }
-#endif // !KeyboardImplIncluded
\ No newline at end of file
+#endif // !KeyboardImplIncluded
@@ -15,9 +15,9 @@ DDM::Mouse::~Mouse()
 {
 }
 
-void DDM::Mouse::Update()
+void DDM::Mouse::Update(std::span<const InputEvent> events)
 {
-	m_pImpl->Update();
+	m_pImpl->Update(events);
 }
 
 bool DDM::Mouse::IsPressed(int button)
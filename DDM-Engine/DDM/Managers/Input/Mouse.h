@@ -4,10 +4,13 @@
 #define MouseIncluded
 
 // File includes
+#include "InputEvents.h"
+
 #include "Includes/GLMIncludes.h"
 
 // Standard library includes
 #include <memory>
+#include <span>
 
 namespace DDM
 {
@@ -27,7 +30,7 @@ namespace DDM
 		Mouse& operator=(const Mouse& other) = delete;
 		Mouse& operator=(Mouse&& other) = delete;
 
-		void Update();
+		void Update(std::span<const InputEvent> events);
 
 		bool IsPressed(int button);
 
@@ -3,70 +3,51 @@
 // Header include
 #include "MouseImpl.h"
 
-// File includes
-#include "Includes/GLFWIncludes.h"
-
-#include "Engine/Window.h"
-
-// Standard library includes
-#include <algorithm>
-#include <functional>
-#include <iostream>
-
-std::queue<glm::vec2> DDM::MouseImpl::m_MouseScroll = std::queue<glm::vec2>();
-
-DDM::MouseImpl::MouseImpl()
+void DDM::MouseImpl::Update(std::span<const InputEvent> events)
 {
-	m_Pressed.resize(GLFW_MOUSE_BUTTON_LAST + 1);
-
-	m_Down.resize(m_Pressed.size());
-
-	m_Up.resize(m_Pressed.size());
-
-	glfwSetScrollCallback(Window::GetInstance().GetWindowStruct().pWindow, DDM::MouseImpl::MouseScrollCallback);
-}
+	// Edges and scrolling only last a single frame
+	m_Down.reset();
+	m_Up.reset();
 
-void DDM::MouseImpl::Update()
-{
-	auto window = DDM::Window::GetInstance().GetWindowStruct().pWindow;
+	m_ScrollDelta = glm::vec2{};
 
-	std::vector<bool> currentState;
-	currentState.resize(m_Pressed.size());
+	const glm::vec2 previousPos{ m_MousePos };
 
-	for (int key = GLFW_MOUSE_BUTTON_1; key <= GLFW_MOUSE_BUTTON_LAST; ++key)
+	for (const auto& event : events)
 	{
-		currentState[key] = glfwGetMouseButton(window, key) == GLFW_PRESS;
+		switch (event.Type)
+		{
+		case InputEventType::MouseButton:
+		{
+			if (event.Code < 0 || event.Code >= static_cast<int32_t>(kButtonCount))
+				break;
+
+			const auto button{ static_cast<size_t>(event.Code) };
+
+			if (event.Action == GLFW_PRESS && !m_Pressed[button])
+			{
+				m_Down[button] = true;
+				m_Pressed[button] = true;
+			}
+			else if (event.Action == GLFW_RELEASE && m_Pressed[button])
+			{
+				m_Up[button] = true;
+				m_Pressed[button] = false;
+			}
+			break;
+		}
+		case InputEventType::CursorPosition:
+			m_MousePos = glm::vec2{ event.X, event.Y };
+			break;
+		case InputEventType::Scroll:
+			m_ScrollDelta += glm::vec2{ event.X, event.Y };
+			break;
+		default:
+			break;
+		}
 	}
 
-	std::vector<bool> changes;
-	changes.resize(m_Pressed.size());
-
-	std::transform(currentState.begin(), currentState.end(), m_Pressed.begin(), changes.begin(), std::bit_xor<bool>());
-
-	std::transform(changes.begin(), changes.end(), currentState.begin(), m_Down.begin(), std::bit_and<bool>());
-
-	std::transform(changes.begin(), changes.end(), currentState.begin(), m_Up.begin(), [](bool first, bool second)
-		{return std::bit_and<bool>()(first, !second); });
-
-	m_Pressed = std::move(currentState);
-
-	double x{};
-	double y{};
-
-	glfwGetCursorPos(window, &x, &y);
-
-	
-
-	m_MouseDelta.x = static_cast<float>(x - m_MousePos.x);
-	m_MouseDelta.y = static_cast<float>(y - m_MousePos.y);
-
-	m_MousePos.x = static_cast<float>(x);
-	m_MousePos.y = static_cast<float>(y);
-
-	if (!m_MouseScroll.empty())
-	{
-		m_MouseScroll.pop();
-	}
+	m_MouseDelta = m_MousePos - previousPos;
 }
 
 bool DDM::MouseImpl::IsPressed(int button)
@@ -83,16 +64,3 @@ bool DDM::MouseImpl::IsDown(int button)
 {
 	return m_Down[button];
 }
-
-const glm::vec2& DDM::MouseImpl::GetScrollDelta()
-{
-	if (m_MouseScroll.empty())
-		return m_EmptyVec;
-
-	return m_MouseScroll.front();
-}
-
-void DDM::MouseImpl::MouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
-{
-	m_MouseScroll.push(glm::vec2(xoffset, yoffset));
-}
\ No newline at end of file
@@ -1,18 +1,19 @@
 // MouseImplImpl.h
 // This class will manage the input events from glfw
+// Buttons are handled like keys, the cursor position and scroll offset are taken from the events of the frame
 
 #ifndef MouseImplIncluded
 #define MouseImplIncluded
 
 // Fil includes
+#include "InputEvents.h"
+
+#include "Includes/GLFWIncludes.h"
 #include "Includes/GLMIncludes.h"
 
 // Standard library includes
-#include <vector>
-#include <queue>
-
-
-struct GLFWwindow;
+#include <bitset>
+#include <span>
 
 namespace DDM
 {
@@ -20,7 +21,7 @@ namespace DDM
 	{
 	public:
 
-		MouseImpl();
+		MouseImpl() = default;
 		~MouseImpl() = default;
 
 		MouseImpl(const MouseImpl& other) = delete;
@@ -29,7 +30,10 @@ namespace DDM
 		MouseImpl& operator=(const MouseImpl& other) = delete;
 		MouseImpl& operator=(MouseImpl&& other) = delete;
 
-		void Update();
+		// Apply the mouse events of a frame
+		// Parameters:
+		//     events: every input event of the frame, oldest first
+		void Update(std::span<const InputEvent> events);
 
 		bool IsPressed(int button);
 
@@ -41,21 +45,20 @@ namespace DDM
 		 
 		const glm::vec2& GetMouseDelta() { return m_MouseDelta; }
 		 
-		const glm::vec2& GetScrollDelta();
+		const glm::vec2& GetScrollDelta() { return m_ScrollDelta; }
 
 	private:
-		std::vector<bool> m_Pressed;
-		std::vector<bool> m_Up;
-		std::vector<bool> m_Down;
+		static constexpr size_t kButtonCount{ GLFW_MOUSE_BUTTON_LAST + 1 };
+
+		std::bitset<kButtonCount> m_Pressed{};
+		std::bitset<kButtonCount> m_Up{};
+		std::bitset<kButtonCount> m_Down{};
 
 		glm::vec2 m_MousePos{};
 		glm::vec2 m_MouseDelta{};
 
-		static std::queue<glm::vec2> m_MouseScroll;
-
-		const glm::vec2 m_EmptyVec{};
-
-		static void MouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+		// Sum of the scroll offsets of the frame
+		glm::vec2 m_ScrollDelta{};
 	};
 }
 #endif // !MouseImplIncluded
\ No newline at end of file
@@ -8,24 +8,75 @@
 
 #include "Engine/Window.h"
 
+#include "Managers/ConfigManager.h"
+#include "Managers/TimeManager.h"
+
 #include "Input/Keyboard.h"
 #include "Input/Mouse.h"
 
+GLFWkeyfun DDM::InputManager::m_PreviousKeyCallback{};
+GLFWmousebuttonfun DDM::InputManager::m_PreviousMouseButtonCallback{};
+GLFWcursorposfun DDM::InputManager::m_PreviousCursorPosCallback{};
+GLFWscrollfun DDM::InputManager::m_PreviousScrollCallback{};
+
 DDM::InputManager::InputManager()
 {
     m_pKeyboard = std::make_unique<Keyboard>();
 
     m_pMouse = std::make_unique<Mouse>();
+
+    // A frame never holds more events than the queue
+    m_FrameEvents.reserve(InputEventQueue::kCapacity);
+
+    // There is no window to get events from when running headless, a replay still works
+    if (!Window::GetInstance().IsHeadless())
+    {
+        InstallCallbacks();
+    }
+
+    auto& configManager{ ConfigManager::GetInstance() };
+
+    // Replaying takes priority, so a replay is never recorded over
+    if (const std::string replayFile{ configManager.GetString("InputReplayFile") }; !replayFile.empty())
+    {
+        m_Recorder.BeginReplay(replayFile);
+    }
+    else if (const std::string recordFile{ configManager.GetString("InputRecordFile") }; !recordFile.empty())
+    {
+        m_Recorder.BeginRecording(recordFile);
+    }
 }
 
 DDM::InputManager::~InputManager()
 {
+    m_Recorder.Stop();
 }
 
 void DDM::InputManager::ProcessInput()
 {
-    m_pKeyboard->Update();
-    m_pMouse->Update();
+    m_FrameEvents.clear();
+
+    if (m_Recorder.IsReplaying())
+    {
+        // The window is ignored while replaying
+        m_EventQueue.Clear();
+
+        float deltaTime{};
+
+        if (m_Recorder.ReplayFrame(deltaTime, m_FrameEvents))
+        {
+            TimeManager::GetInstance().SetDeltaTime(deltaTime);
+        }
+    }
+    else
+    {
+        m_EventQueue.Drain(m_FrameEvents);
+
+        m_Recorder.RecordFrame(TimeManager::GetInstance().GetDeltaTime(), m_FrameEvents);
+    }
+
+    m_pKeyboard->Update(m_FrameEvents);
+    m_pMouse->Update(m_FrameEvents);
 }
 
 bool DDM::InputManager::GetKeyPressed(int key)
@@ -72,3 +123,62 @@ const glm::vec2& DDM::InputManager::GetScrollDelta()
 {
     return m_pMouse->GetScrollDelta();
 }
+
+void DDM::InputManager::InstallCallbacks()
+{
+    auto pWindow{ Window::GetInstance().GetWindowStruct().pWindow };
+
+    // ImGui installs its own callbacks, keep them so it still gets every event
+    m_PreviousKeyCallback = glfwSetKeyCallback(pWindow, KeyCallback);
+    m_PreviousMouseButtonCallback = glfwSetMouseButtonCallback(pWindow, MouseButtonCallback);
+    m_PreviousCursorPosCallback = glfwSetCursorPosCallback(pWindow, CursorPosCallback);
+    m_PreviousScrollCallback = glfwSetScrollCallback(pWindow, ScrollCallback);
+
+    // The cursor only sends events when it moves, start from where it is now
+    double x{};
+    double y{};
+
+    glfwGetCursorPos(pWindow, &x, &y);
+
+    m_EventQueue.Push(InputEvent{ .Time = glfwGetTime(), .X = static_cast<float>(x), .Y = static_cast<float>(y), .Type = InputEventType::CursorPosition });
+}
+
+void DDM::InputManager::KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    GetInstance().m_EventQueue.Push(InputEvent{ .Time = glfwGetTime(), .Code = key, .Action = action, .Type = InputEventType::Key });
+
+    if (m_PreviousKeyCallback != nullptr)
+    {
+        m_PreviousKeyCallback(window, key, scancode, action, mods);
+    }
+}
+
+void DDM::InputManager::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    GetInstance().m_EventQueue.Push(InputEvent{ .Time = glfwGetTime(), .Code = button, .Action = action, .Type = InputEventType::MouseButton });
+
+    if (m_PreviousMouseButtonCallback != nullptr)
+    {
+        m_PreviousMouseButtonCallback(window, button, action, mods);
+    }
+}
+
+void DDM::InputManager::CursorPosCallback(GLFWwindow* window, double x, double y)
+{
+    GetInstance().m_EventQueue.Push(InputEvent{ .Time = glfwGetTime(), .X = static_cast<float>(x), .Y = static_cast<float>(y), .Type = InputEventType::CursorPosition });
+
+    if (m_PreviousCursorPosCallback != nullptr)
+    {
+        m_PreviousCursorPosCallback(window, x, y);
+    }
+}
+
+void DDM::InputManager::ScrollCallback(GLFWwindow* window, double xOffset, double yOffset)
+{
+    GetInstance().m_EventQueue.Push(InputEvent{ .Time = glfwGetTime(), .X = static_cast<float>(xOffset), .Y = static_cast<float>(yOffset), .Type = InputEventType::Scroll });
+
+    if (m_PreviousScrollCallback != nullptr)
+    {
+        m_PreviousScrollCallback(window, xOffset, yOffset);
+    }
+}
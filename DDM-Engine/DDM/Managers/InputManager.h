@@ -1,14 +1,23 @@
+// InputManager.h
+// This singleton will manage the keyboard and mouse
+// The glfw callbacks queue every input event, once per frame the queued events are applied to the keyboard and mouse
+// The events of every frame can be recorded together with the delta time and replayed, set with "InputRecordFile" and "InputReplayFile" in the config file
+
 #ifndef InputManagerIncluded
 #define InputManagerIncluded
 
 // Fileincludes
 #include "Engine/Singleton.h"
 
+#include "Managers/Input/InputEvents.h"
+#include "Managers/Input/InputRecorder.h"
+
 #include "Includes/GLFWIncludes.h"
 #include "Includes/GLMIncludes.h"
 
 // Standard library includes
 #include <memory>
+#include <vector>
 
 namespace DDM
 {
@@ -21,6 +30,8 @@ namespace DDM
 	public:
 		virtual ~InputManager();
 
+		// Apply the input events since the last frame, or the events of the next frame of the replay
+		// While replaying the delta time of the time manager is replaced with the recorded one
 		void ProcessInput();
 
 		bool GetKeyPressed(int key);
@@ -40,6 +51,15 @@ namespace DDM
 		const glm::vec2& GetMouseDelta();
 
 		const glm::vec2& GetScrollDelta();
+
+		// Check if the input is read from a recording instead of the window
+		bool IsReplaying() const { return m_Recorder.IsReplaying(); }
+
+		// Check if the input is written to a recording
+		bool IsRecording() const { return m_Recorder.IsRecording(); }
+
+		// Get the amount of events that were lost because too many happened in a single frame
+		uint64_t GetDroppedEventCount() const { return m_EventQueue.GetDroppedCount(); }
 	private:
 		friend class Singleton<InputManager>;
 		InputManager();
@@ -47,6 +67,31 @@ namespace DDM
 		std::unique_ptr<Keyboard> m_pKeyboard{};
 
 		std::unique_ptr<Mouse> m_pMouse{};
+
+		// Events received from glfw since the last frame
+		InputEventQueue m_EventQueue{};
+
+		// Events of the current frame, reused every frame
+		std::vector<InputEvent> m_FrameEvents{};
+
+		InputRecorder m_Recorder{};
+
+		// Callbacks that were installed before this manager, every event is passed on to them
+		static GLFWkeyfun m_PreviousKeyCallback;
+		static GLFWmousebuttonfun m_PreviousMouseButtonCallback;
+		static GLFWcursorposfun m_PreviousCursorPosCallback;
+		static GLFWscrollfun m_PreviousScrollCallback;
+
+		// Install the glfw callbacks that queue the input events
+		void InstallCallbacks();
+
+		static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+		static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+
+		static void CursorPosCallback(GLFWwindow* window, double x, double y);
+
+		static void ScrollCallback(GLFWwindow* window, double xOffset, double yOffset);
 	};
 }
 #endif // !InputManagerIncluded
@@ -0,0 +1,32 @@
+// NameRegistry.cpp
+
+// Header include
+#include "NameRegistry.h"
+
+DDM::NameId DDM::NameRegistry::Intern(std::string_view name)
+{
+	// If the string is already interned, return its id
+	if (auto it{ m_Ids.find(name) }; it != m_Ids.end())
+	{
+		return it->second;
+	}
+
+	// Store the string and give it the next id
+	const NameId id{ static_cast<NameId>(m_Names.size()) };
+	const std::string& storedName{ m_Names.emplace_back(name) };
+
+	m_Ids.emplace(std::string_view{ storedName }, id);
+
+	return id;
+}
+
+DDM::NameId DDM::NameRegistry::Find(std::string_view name) const
+{
+	// Look up the string
+	if (auto it{ m_Ids.find(name) }; it != m_Ids.end())
+	{
+		return it->second;
+	}
+
+	return kInvalidNameId;
+}
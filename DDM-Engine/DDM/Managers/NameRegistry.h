@@ -0,0 +1,58 @@
+// NameRegistry.h
+// This singleton interns strings, every unique string gets a small numeric id
+// Comparing and hashing ids is much cheaper than comparing and hashing strings
+
+#ifndef NameRegistryIncluded
+#define NameRegistryIncluded
+
+// File includes
+#include "Engine/Singleton.h"
+
+// Standard library includes
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace DDM
+{
+	// Numeric id of an interned string
+	using NameId = uint32_t;
+
+	class NameRegistry final : public Singleton<NameRegistry>
+	{
+	public:
+		// Id returned when looking up a string that was never interned
+		static constexpr NameId kInvalidNameId{ std::numeric_limits<NameId>::max() };
+
+		// Get the id of a string, the string is added if it wasn't interned yet
+		// Parameters:
+		//     name: the string to intern
+		NameId Intern(std::string_view name);
+
+		// Get the id of a string without adding it
+		// Parameters:
+		//     name: the string to look up
+		// Returns: the id of the string, kInvalidNameId if it was never interned
+		NameId Find(std::string_view name) const;
+
+		// Get the string belonging to an id
+		// Parameters:
+		//     id: the id of the string
+		const std::string& GetName(NameId id) const { return m_Names[id]; }
+
+	private:
+		friend class Singleton<NameRegistry>;
+		NameRegistry() = default;
+
+		// All interned strings, a deque keeps them at a stable address so the map keys stay valid
+		std::deque<std::string> m_Names{};
+
+		// Map from string to id
+		std::unordered_map<std::string_view, NameId> m_Ids{};
+	};
+}
+
+#endif // !NameRegistryIncluded
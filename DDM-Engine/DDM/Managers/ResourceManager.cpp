@@ -5,6 +5,7 @@
 
 // File includes
 #include "Vulkan/VulkanObject.h"
+#include "Vulkan/VulkanWrappers/Image.h"
 
 #include "Managers/ConfigManager.h"
 
@@ -24,6 +25,12 @@ std::shared_ptr<DDM::Mesh> DDM::ResourceManager::LoadMesh(std::string&& filePath
 
 std::shared_ptr<DDM::Mesh> DDM::ResourceManager::LoadMesh(std::string& filePath)
 {
+	// Share the mesh if a background scene load added it and it is still in use
+	if (auto pMesh{ FindStreamed(m_pStreamedMeshes, filePath) }; pMesh != nullptr)
+	{
+		return pMesh;
+	}
+
 	std::shared_ptr<DDM::Mesh> pMesh{};
 
 	try
@@ -39,6 +46,35 @@ std::shared_ptr<DDM::Mesh> DDM::ResourceManager::LoadMesh(std::string& filePath)
 	}
 }
 
+std::shared_ptr<DDM::Mesh> DDM::ResourceManager::AddMesh(const std::string& filePath, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	auto pMesh{ std::shared_ptr<DDM::Mesh>(new DDM::Mesh(vertices, indices)) };
+
+	AddStreamed(m_pStreamedMeshes, filePath, pMesh);
+
+	return pMesh;
+}
+
+std::shared_ptr<DDM::Image> DDM::ResourceManager::LoadTexture(const std::string& filePath)
+{
+	// Share the texture if a background scene load added it and it is still in use
+	if (auto pTexture{ FindStreamed(m_pStreamedTextures, filePath) }; pTexture != nullptr)
+	{
+		return pTexture;
+	}
+
+	return std::make_shared<Image>(filePath);
+}
+
+std::shared_ptr<DDM::Image> DDM::ResourceManager::AddTexture(const std::string& filePath, STBImage& image)
+{
+	auto pTexture{ std::make_shared<Image>(image) };
+
+	AddStreamed(m_pStreamedTextures, filePath, pTexture);
+
+	return pTexture;
+}
+
 std::shared_ptr<DDM::Material> DDM::ResourceManager::GetDefaultMaterial() const
 {
 	return m_pDefaultMaterial;
@@ -48,3 +84,31 @@ std::shared_ptr<DDM::Mesh> DDM::ResourceManager::CreateMesh(const std::string& f
 {
 	return std::shared_ptr<DDM::Mesh>(new DDM::Mesh(filePath));
 }
+
+template<typename T>
+std::shared_ptr<T> DDM::ResourceManager::FindStreamed(std::unordered_map<std::string, std::weak_ptr<T>>& resources, const std::string& filePath)
+{
+	auto it{ resources.find(filePath) };
+
+	if (it == resources.end())
+		return nullptr;
+
+	auto pResource{ it->second.lock() };
+
+	// The resource was released, the entry is of no use anymore
+	if (pResource == nullptr)
+	{
+		resources.erase(it);
+	}
+
+	return pResource;
+}
+
+template<typename T>
+void DDM::ResourceManager::AddStreamed(std::unordered_map<std::string, std::weak_ptr<T>>& resources, const std::string& filePath, const std::shared_ptr<T>& pResource)
+{
+	// Entries of files that aren't loaded again would otherwise stay forever
+	std::erase_if(resources, [](const auto& resource) { return resource.second.expired(); });
+
+	resources[filePath] = pResource;
+}
@@ -1,5 +1,7 @@
 // ResourceManager.h
 // This class will serve as a singleton that allocates and loads resources like 3D models and textures
+// Every load creates a new resource, except for files that were loaded by a background scene load and are still in use,
+// those are shared so the scene that was streamed in doesn't read its files a second time
 #ifndef ResourceManagerIncluded
 #define ResourceManagerIncluded
 
@@ -10,10 +12,14 @@
 // Standard library includes
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace DDM
 {
 	class Material;
+	class Image;
+	class STBImage;
 
 	class ResourceManager final : public Singleton<ResourceManager>
 	{
@@ -21,6 +27,24 @@ namespace DDM
 		std::shared_ptr<DDM::Mesh> LoadMesh(std::string&& filePath);
 		std::shared_ptr<DDM::Mesh> LoadMesh(std::string& filePath);
 
+		// Create a mesh from a model file that was read already, used when scenes are loaded in the background
+		// Parameters:
+		//     filePath: path of the model file, later loads of this file return the same mesh while it is in use
+		//     vertices: the vertices of the model
+		//     indices: the indices of the model
+		std::shared_ptr<DDM::Mesh> AddMesh(const std::string& filePath, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Load a texture
+		// Parameters:
+		//     filePath: path to the image file
+		std::shared_ptr<Image> LoadTexture(const std::string& filePath);
+
+		// Create a texture from an image file that was decoded already, used when scenes are loaded in the background
+		// Parameters:
+		//     filePath: path of the image file, later loads of this file return the same texture while it is in use
+		//     image: the decoded image
+		std::shared_ptr<Image> AddTexture(const std::string& filePath, STBImage& image);
+
 		std::shared_ptr<Material> GetDefaultMaterial() const;
 
 	private:
@@ -32,8 +56,29 @@ namespace DDM
 
 		std::shared_ptr<Material> m_pDefaultMaterial{};
 
+		// Meshes added by background scene loads by file path, released when nothing uses them anymore
+		std::unordered_map<std::string, std::weak_ptr<DDM::Mesh>> m_pStreamedMeshes{};
+
+		// Textures added by background scene loads by file path, released when nothing uses them anymore
+		std::unordered_map<std::string, std::weak_ptr<Image>> m_pStreamedTextures{};
+
 		// Factory method to create Mesh instances
 		std::shared_ptr<Mesh> CreateMesh(const std::string& filePath);
+
+		// Get a resource that was added by a background scene load, erases the entry when the resource was released
+		// Parameters:
+		//     resources: the streamed resources of this type
+		//     filePath: path of the file
+		template<typename T>
+		static std::shared_ptr<T> FindStreamed(std::unordered_map<std::string, std::weak_ptr<T>>& resources, const std::string& filePath);
+
+		// Add a resource that was created by a background scene load, erases the entries of resources that were released
+		// Parameters:
+		//     resources: the streamed resources of this type
+		//     filePath: path of the file
+		//     pResource: the created resource
+		template<typename T>
+		static void AddStreamed(std::unordered_map<std::string, std::weak_ptr<T>>& resources, const std::string& filePath, const std::shared_ptr<T>& pResource);
 	};
 
 }
@@ -11,45 +11,149 @@
 #include "Components/Camera.h"
 #include "Components/Light/LightComponent.h"
 
+#include "Managers/ConfigManager.h"
+
+#include "Utils/AllocationTracker.h"
+#include "Utils/Profiler.h"
+
+// Standard library includes
+#include <algorithm>
+#include <chrono>
+
 void DDM::SceneManager::EndProgram()
 {
-    if (m_ActiveScene != nullptr)
+    // Stop the loading scenes before the resources they use are destroyed
+    m_pSceneLoads.clear();
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->OnSceneUnload();
+        pScene->OnSceneUnload();
     }
 
+    m_pLoadedScenes.clear();
+    m_pScenesToLoad.clear();
+    m_pScenesToUnload.clear();
+
     m_pScenes.clear();
+    m_pScenesByName.clear();
     m_ActiveScene = nullptr;
+    m_NextActiveScene = nullptr;
 }
 
-std::shared_ptr<DDM::Scene> DDM::SceneManager::CreateScene(const std::string& name)
+std::shared_ptr<DDM::Scene> DDM::SceneManager::CreateScene(const std::string& name, bool createDefaultLight)
 {
-    const auto& scene = std::shared_ptr<DDM::Scene>(new Scene(name));
+    const auto& scene = std::shared_ptr<DDM::Scene>(new Scene(name, createDefaultLight));
     m_pScenes.push_back(scene);
 
+    // Index the scene by name, the first scene created with a name keeps it
+    m_pScenesByName.emplace(NameRegistry::GetInstance().Intern(name), scene);
+
     return scene;
 }
 
+std::shared_ptr<DDM::SceneLoad> DDM::SceneManager::LoadSceneAsync(const std::string& name, SceneResources resources, SceneBuildFunction build, SceneLoadMode loadMode)
+{
+    const uint32_t threadCount{ static_cast<uint32_t>(std::max(ConfigManager::GetInstance().GetInt("SceneStreamingThreads"), 1)) };
+
+    auto pSceneLoad{ std::make_shared<SceneLoad>(name, std::move(resources), std::move(build), loadMode, threadCount) };
+    m_pSceneLoads.push_back(pSceneLoad);
+
+    return pSceneLoad;
+}
+
 void DDM::SceneManager::DeleteScene(const std::string& name)
 {
     auto scene = GetScene(name);
 
     if (scene != nullptr)
     {
+        // A loaded scene stays alive until it is unloaded, its objects are destroyed when the last reference is released
+        UnloadScene(scene);
+
         m_pScenes.erase(std::remove(m_pScenes.begin(), m_pScenes.end(), scene), m_pScenes.end());
+        m_pScenesByName.erase(NameRegistry::GetInstance().Find(name));
+
+        // If another scene has the same name, index that one instead
+        for (auto& pScene : m_pScenes)
+        {
+            if (pScene->GetName() == name)
+            {
+                m_pScenesByName.emplace(NameRegistry::GetInstance().Find(name), pScene);
+                break;
+            }
+        }
     }
 }
 
 std::shared_ptr<DDM::Scene> DDM::SceneManager::GetScene(const std::string& name)
 {
-    for (auto& scene : m_pScenes)
+    // Names that were never interned can't belong to a scene
+    const NameId id{ NameRegistry::GetInstance().Find(name) };
+
+    if (id == NameRegistry::kInvalidNameId)
     {
-        if (scene->GetName() == name)
-        {
-            return scene;
-        }
+        return nullptr;
     }
-    return nullptr;
+
+    auto it{ m_pScenesByName.find(id) };
+
+    if (it == m_pScenesByName.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+void DDM::SceneManager::LoadSceneAdditive(std::shared_ptr<Scene> scene)
+{
+    if (scene == nullptr)
+        return;
+
+    // A later load cancels an earlier unload
+    m_pScenesToUnload.erase(std::remove(m_pScenesToUnload.begin(), m_pScenesToUnload.end(), scene), m_pScenesToUnload.end());
+
+    if (std::find(m_pScenesToLoad.begin(), m_pScenesToLoad.end(), scene) == m_pScenesToLoad.end())
+    {
+        m_pScenesToLoad.push_back(std::move(scene));
+    }
+}
+
+void DDM::SceneManager::LoadSceneAdditive(const std::string& name)
+{
+    LoadSceneAdditive(GetScene(name));
+}
+
+void DDM::SceneManager::UnloadScene(std::shared_ptr<Scene> scene)
+{
+    if (scene == nullptr)
+        return;
+
+    // A later unload cancels an earlier load
+    m_pScenesToLoad.erase(std::remove(m_pScenesToLoad.begin(), m_pScenesToLoad.end(), scene), m_pScenesToLoad.end());
+
+    if (m_NextActiveScene == scene)
+    {
+        m_NextActiveScene = nullptr;
+    }
+
+    // A scene that isn't loaded only had its pending load cancelled, it isn't kept alive any longer
+    if (IsSceneLoaded(scene.get()) &&
+        std::find(m_pScenesToUnload.begin(), m_pScenesToUnload.end(), scene) == m_pScenesToUnload.end())
+    {
+        m_pScenesToUnload.push_back(std::move(scene));
+    }
+}
+
+void DDM::SceneManager::UnloadScene(const std::string& name)
+{
+    UnloadScene(GetScene(name));
+}
+
+bool DDM::SceneManager::IsSceneLoaded(const Scene* scene) const
+{
+    return std::any_of(m_pLoadedScenes.begin(), m_pLoadedScenes.end(),
+        [scene](const std::shared_ptr<Scene>& pScene) { return pScene.get() == scene; });
 }
 
 void DDM::SceneManager::NextScene()
@@ -96,18 +200,20 @@ void DDM::SceneManager::PreviousScene()
 
 void DDM::SceneManager::SetActiveScene(std::shared_ptr<Scene> scene)
 {
+    if (scene != nullptr)
+    {
+        // A later activation cancels an earlier unload
+        m_pScenesToUnload.erase(std::remove(m_pScenesToUnload.begin(), m_pScenesToUnload.end(), scene), m_pScenesToUnload.end());
+    }
+
     m_NextActiveScene = scene;
 }
 
 void DDM::SceneManager::SetActiveScene(const std::string& name)
 {
-    for (auto& scene : m_pScenes)
+    if (auto scene{ GetScene(name) }; scene != nullptr)
     {
-        if (scene->GetName() == name)
-        {
-            SetActiveScene(scene);
-            return;
-        }
+        SetActiveScene(scene);
     }
 }
 
@@ -118,74 +224,106 @@ std::shared_ptr<DDM::Scene> DDM::SceneManager::GetActiveScene()
 
 void DDM::SceneManager::StartFrame()
 {
-    if (m_NextActiveScene != nullptr)
-    {
-        if (m_ActiveScene != nullptr)
-        {
-            m_ActiveScene->OnSceneUnload();
-        }
-        m_ActiveScene = m_NextActiveScene;
-        m_ActiveScene->OnSceneLoad();
-        m_NextActiveScene = nullptr;
-    }
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
 
+    // Scenes that finish loading are activated this same frame
+    UpdateSceneLoads();
 
-    if (m_ActiveScene != nullptr)
+    UpdateLoadedScenes();
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->StartFrame();
+        pScene->StartFrame();
     }
 }
 
 void DDM::SceneManager::EarlyUpdate()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->EarlyUpdate();
+        if (pScene->IsUpdateEnabled())
+        {
+            pScene->EarlyUpdate();
+        }
     }
 }
 
 void DDM::SceneManager::Update()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->Update();
+        if (pScene->IsUpdateEnabled())
+        {
+            pScene->Update(m_pJobSystem);
+        }
     }
 }
 
 void DDM::SceneManager::FixedUpdate()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->FixedUpdate();
+        if (pScene->IsFixedUpdateEnabled())
+        {
+            pScene->FixedUpdate(m_pJobSystem);
+        }
     }
 }
 
 void DDM::SceneManager::LateUpdate()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->LateUpdate();
+        if (pScene->IsUpdateEnabled())
+        {
+            pScene->LateUpdate();
+        }
     }
 }
 
 void DDM::SceneManager::PostUpdate()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Scene);
+
+    // Destroyed objects are removed from every loaded scene, also the ones that aren't updated
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->PostUpdate();
+        pScene->PostUpdate();
     }
 }
 
 void DDM::SceneManager::OnGui()
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+    DDM_ALLOCATION_SCOPE(Gui);
+
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->OngGUI();
+        if (pScene->IsRenderEnabled())
+        {
+            pScene->OngGUI();
+        }
     }
 }
 
 void DDM::SceneManager::RenderSkybox()
 {
+    DDM_PROFILE_FUNCTION();
+
     if (m_ActiveScene != nullptr)
     {
         m_ActiveScene->RenderSkyBox();
@@ -194,29 +332,47 @@ void DDM::SceneManager::RenderSkybox()
 
 void DDM::SceneManager::RenderDepth() const
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+
+    // Every loaded scene draws into the same pass
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->RenderDepth();
+        if (pScene->IsRenderEnabled())
+        {
+            pScene->RenderDepth();
+        }
     }
 }
 
 void DDM::SceneManager::Render() const
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+
+    // Every loaded scene draws into the same pass
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->Render();
+        if (pScene->IsRenderEnabled())
+        {
+            pScene->Render();
+        }
     }
 }
 
 void DDM::SceneManager::RenderTransparancy() const
 {
-    if (m_ActiveScene != nullptr)
+    DDM_PROFILE_FUNCTION();
+
+    // Every loaded scene draws into the same pass
+    for (auto& pScene : m_pLoadedScenes)
     {
-        m_ActiveScene->RenderTransparancy();
+        if (pScene->IsRenderEnabled())
+        {
+            pScene->RenderTransparancy();
+        }
     }
 }
 
-const std::shared_ptr<DDM::Camera> DDM::SceneManager::GetCamera() const
+DDM::Camera* DDM::SceneManager::GetCamera() const
 {
     if (m_ActiveScene != nullptr)
     {
@@ -230,7 +386,7 @@ const std::shared_ptr<DDM::Camera> DDM::SceneManager::GetCamera() const
     return nullptr;
 }
 
-const std::shared_ptr<DDM::LightComponent> DDM::SceneManager::GetGlobalLight() const
+DDM::LightComponent* DDM::SceneManager::GetGlobalLight() const
 {
     if (m_ActiveScene != nullptr)
     {
@@ -241,5 +397,125 @@ const std::shared_ptr<DDM::LightComponent> DDM::SceneManager::GetGlobalLight() c
         return m_NextActiveScene->GetLight();
     }
 
-    return std::shared_ptr<LightComponent>();
+    return nullptr;
+}
+
+void DDM::SceneManager::UpdateSceneLoads()
+{
+    if (m_pSceneLoads.empty())
+        return;
+
+    DDM_PROFILE_FUNCTION();
+
+    // Time the uploads can take every frame, shared by all loading scenes
+    const auto budget{ std::chrono::duration_cast<SceneLoad::Clock::duration>(
+        std::chrono::duration<float, std::milli>(std::max(ConfigManager::GetInstance().GetFloat("SceneUploadBudgetMs"), 0.0f))) };
+
+    const auto start{ SceneLoad::Clock::now() };
+
+    // Indexed, a build function can start loading another scene
+    for (size_t index{}; index < m_pSceneLoads.size(); ++index)
+    {
+        auto pSceneLoad{ m_pSceneLoads[index] };
+
+        if (pSceneLoad->IsDone())
+            continue;
+
+        const auto elapsed{ SceneLoad::Clock::now() - start };
+
+        // Every load gets to upload at least one resource, so a load always moves forward
+        if (!pSceneLoad->UploadResources(elapsed < budget ? budget - elapsed : SceneLoad::Clock::duration{}))
+            continue;
+
+        auto pScene{ CreateScene(pSceneLoad->GetName()) };
+        pSceneLoad->Build(pScene);
+
+        switch (pSceneLoad->GetLoadMode())
+        {
+        case SceneLoadMode::Single:
+            SetActiveScene(pScene);
+            break;
+        case SceneLoadMode::Additive:
+            LoadSceneAdditive(pScene);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Forget the loads that are done, whoever started them can still hold on to them
+    m_pSceneLoads.erase(std::remove_if(m_pSceneLoads.begin(), m_pSceneLoads.end(),
+        [](const std::shared_ptr<SceneLoad>& pSceneLoad) { return pSceneLoad->IsDone(); }), m_pSceneLoads.end());
+}
+
+void DDM::SceneManager::UpdateLoadedScenes()
+{
+    for (auto& pScene : m_pScenesToUnload)
+    {
+        RemoveLoadedScene(pScene);
+    }
+
+    m_pScenesToUnload.clear();
+
+    if (m_NextActiveScene != nullptr)
+    {
+        // The previous active scene is replaced, unless it stays loaded as an additive scene
+        if (m_ActiveScene != nullptr && m_ActiveScene != m_NextActiveScene &&
+            std::find(m_pScenesToLoad.begin(), m_pScenesToLoad.end(), m_ActiveScene) == m_pScenesToLoad.end())
+        {
+            RemoveLoadedScene(m_ActiveScene);
+        }
+
+        auto it{ std::find(m_pLoadedScenes.begin(), m_pLoadedScenes.end(), m_NextActiveScene) };
+
+        if (it == m_pLoadedScenes.end())
+        {
+            m_pLoadedScenes.insert(m_pLoadedScenes.begin(), m_NextActiveScene);
+            m_NextActiveScene->OnSceneLoad();
+        }
+        else
+        {
+            // A scene that was loaded additively only moves to the front
+            std::rotate(m_pLoadedScenes.begin(), it, it + 1);
+        }
+
+        m_ActiveScene = m_NextActiveScene;
+        m_NextActiveScene = nullptr;
+    }
+
+    for (auto& pScene : m_pScenesToLoad)
+    {
+        if (!IsSceneLoaded(pScene.get()))
+        {
+            m_pLoadedScenes.push_back(pScene);
+            pScene->OnSceneLoad();
+        }
+    }
+
+    m_pScenesToLoad.clear();
+
+    // Without an active scene the first loaded scene provides the camera and light
+    if (m_ActiveScene == nullptr && !m_pLoadedScenes.empty())
+    {
+        m_ActiveScene = m_pLoadedScenes.front();
+    }
+}
+
+void DDM::SceneManager::RemoveLoadedScene(const std::shared_ptr<Scene>& scene)
+{
+    auto it{ std::find(m_pLoadedScenes.begin(), m_pLoadedScenes.end(), scene) };
+
+    if (it == m_pLoadedScenes.end())
+        return;
+
+    // Keep the scene alive while it unloads, the list may hold the last reference
+    auto pScene{ *it };
+
+    m_pLoadedScenes.erase(it);
+    pScene->OnSceneUnload();
+
+    if (m_ActiveScene == pScene)
+    {
+        m_ActiveScene = nullptr;
+    }
 }
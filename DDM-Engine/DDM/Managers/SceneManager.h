@@ -1,5 +1,7 @@
 // SceneManager.h
 // This singleton will hold, manage and handle all scenes
+// Next to the active scene, other scenes can be loaded additively, every loaded scene is updated and rendered
+// unless its flags turn that off, the active scene provides the camera, global light and skybox
 
 
 #ifndef SceneManagerIncluded
@@ -7,10 +9,14 @@
 
 // File includes
 #include "Engine/Singleton.h"
+#include "Engine/SceneLoad.h"
+
+#include "Managers/NameRegistry.h"
 
 // Standard library includes
 #include <memory>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 namespace DDM
@@ -19,6 +25,7 @@ namespace DDM
 	class Scene;
 	class Camera;
 	class LightComponent;
+	class JobSystem;
 
 	class SceneManager : public Singleton<SceneManager>
 	{
@@ -29,25 +36,72 @@ namespace DDM
 		// Create a new scene
 		// Parameters:
 		//     name: the name of the new scene
-		std::shared_ptr<Scene> CreateScene(const std::string& name);
+		//     createDefaultLight: indicates the scene creates its default light, false keeps creation free of gpu resources
+		//         for headless tools like the cpu benchmarks, such a scene needs a light before it is rendered
+		std::shared_ptr<Scene> CreateScene(const std::string& name, bool createDefaultLight = true);
+
+		// Load a scene in the background, the resources are read on worker threads and uploaded a few every frame
+		// Once everything is uploaded the scene is created and built at the start of a frame, and activated that same frame
+		// Parameters:
+		//     name: the name of the new scene
+		//     resources: the meshes and textures the scene needs, the build function gets them from the resource manager
+		//     build: function that fills the scene, runs on the main thread
+		//     loadMode: what happens with the scene once it is built, replaces the active scene by default
+		std::shared_ptr<SceneLoad> LoadSceneAsync(const std::string& name, SceneResources resources, SceneBuildFunction build,
+			SceneLoadMode loadMode = SceneLoadMode::Single);
+
+		// Get the scenes that are loading in the background
+		const std::vector<std::shared_ptr<SceneLoad>>& GetSceneLoads() const { return m_pSceneLoads; }
 
 		// Get a pointer to a scene
 		// Parameters:
 		//     name: the name of the requested scene
 		std::shared_ptr<Scene> GetScene(const std::string& name);
 
-		// Delete a scene
+		// Delete a scene, it is unloaded at the start of the next frame if it is loaded
+		// Its objects are destroyed once nothing holds the scene anymore
 		// Parameters:
 		//     name: the name of the scene to be deleted
 		void DeleteScene(const std::string& name);
 
+		// Load a scene next to the loaded scenes at the start of the next frame
+		// Parameters:
+		//     scene: pointer to the scene
+		void LoadSceneAdditive(std::shared_ptr<Scene> scene);
+
+		// Load a scene next to the loaded scenes at the start of the next frame
+		// Parameters:
+		//     name: the name of the scene
+		void LoadSceneAdditive(const std::string& name);
+
+		// Unload a scene at the start of the next frame, it is no longer updated or rendered
+		// The scene and its objects are kept so it can be loaded again, use DeleteScene to destroy it
+		// When the active scene is unloaded, the first additive scene becomes the active scene
+		// Parameters:
+		//     scene: pointer to the scene
+		void UnloadScene(std::shared_ptr<Scene> scene);
+
+		// Unload a scene at the start of the next frame, the scene itself is kept so it can be loaded again
+		// Parameters:
+		//     name: the name of the scene
+		void UnloadScene(const std::string& name);
+
+		// Check if a scene is loaded, either as the active scene or additively
+		// Parameters:
+		//     scene: pointer to the scene
+		bool IsSceneLoaded(const Scene* scene) const;
+
+		// Get every loaded scene, the active scene comes first
+		const std::vector<std::shared_ptr<Scene>>& GetLoadedScenes() const { return m_pLoadedScenes; }
+
 		// Go to the next scene
 		void NextScene();
 
 		// Go to the previous scene
 		void PreviousScene();
 
-		// Set a specific scene active
+		// Set a specific scene active, it replaces the active scene at the start of the next frame
+		// Scenes that were loaded additively stay loaded
 		// Parameters:
 		//     name: the name of the requested scene
 		void SetActiveScene(const std::string& name);
@@ -65,6 +119,20 @@ namespace DDM
 		//     name: name of the requested scene
 		void SetActiveScene(std::string& name);
 
+		// Set the job system used to update thread safe components in parallel
+		// Parameters:
+		//     pJobSystem: pointer to the job system, nullptr to update everything on the main thread
+		void SetJobSystem(JobSystem* pJobSystem) { m_pJobSystem = pJobSystem; }
+
+		// Get the job system, can be nullptr
+		JobSystem* GetJobSystem() const { return m_pJobSystem; }
+
+		// Ask the engine to stop after the current frame, used by scripts to end a headless run
+		void RequestQuit() { m_QuitRequested = true; }
+
+		// Check if a script asked the engine to stop
+		bool IsQuitRequested() const { return m_QuitRequested; }
+
 		// Function that sets up the next frame
 		void StartFrame();
 
@@ -97,11 +165,11 @@ namespace DDM
 		// Render transparant object
 		void RenderTransparancy() const;
 
-		// Get a pointer to the active camera
-		const std::shared_ptr<Camera> GetCamera() const;
+		// Get a non owning pointer to the active camera, called every frame so no shared pointer is copied
+		Camera* GetCamera() const;
 
-		// Get a pointer to the active global light
-		const std::shared_ptr<LightComponent> GetGlobalLight() const;
+		// Get a non owning pointer to the active global light, called every frame so no shared pointer is copied
+		LightComponent* GetGlobalLight() const;
 
 	private:
 		// Default constructor
@@ -111,11 +179,43 @@ namespace DDM
 		// Vector of all the loaded scenes
 		std::vector<std::shared_ptr<Scene>> m_pScenes{};
 
+		// Map from the interned name of a scene to the scene, used for lookups by name
+		std::unordered_map<NameId, std::shared_ptr<Scene>> m_pScenesByName{};
+
 		// Pointer to the current active scene
 		std::shared_ptr<Scene> m_ActiveScene{};
 
 		// Pointer to the next active scene
 		std::shared_ptr<Scene> m_NextActiveScene{};
+
+		// Every loaded scene, the active scene comes first
+		std::vector<std::shared_ptr<Scene>> m_pLoadedScenes{};
+
+		// Scenes that will be loaded additively at the start of the next frame
+		std::vector<std::shared_ptr<Scene>> m_pScenesToLoad{};
+
+		// Scenes that will be unloaded at the start of the next frame
+		std::vector<std::shared_ptr<Scene>> m_pScenesToUnload{};
+
+		// Scenes that are loading in the background
+		std::vector<std::shared_ptr<SceneLoad>> m_pSceneLoads{};
+
+		// Job system used for parallel component updates, owned by the engine
+		JobSystem* m_pJobSystem{};
+
+		// Upload the resources of the loading scenes and build the ones that are done
+		void UpdateSceneLoads();
+
+		// Apply the requested unloads, active scene change and additive loads
+		void UpdateLoadedScenes();
+
+		// Call OnSceneUnload on a loaded scene and remove it from the loaded scenes, its objects stay alive
+		// Parameters:
+		//     scene: pointer to the scene
+		void RemoveLoadedScene(const std::shared_ptr<Scene>& scene);
+
+		// Indicates a script asked the engine to stop
+		bool m_QuitRequested{ false };
 	};
 }
 #endif // !SceneManagerIncluded
\ No newline at end of file
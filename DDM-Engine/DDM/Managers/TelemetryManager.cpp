@@ -0,0 +1,345 @@
+// TelemetryManager.cpp
+
+// Header include
+#include "TelemetryManager.h"
+
+// File includes
+#include "Includes/ImGuiIncludes.h"
+
+#include "Managers/ConfigManager.h"
+
+#include "Utils/Profiler.h"
+
+#include "Vulkan/VulkanObject.h"
+#include "Vulkan/VulkanWrappers/GPUObject.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Convert bytes to megabytes
+	// Parameters:
+	//     bytes: the amount of bytes
+	double ToMegabytes(uint64_t bytes)
+	{
+		return static_cast<double>(bytes) / (1024.0 * 1024.0);
+	}
+}
+
+DDM::TelemetryManager::~TelemetryManager()
+{
+	Shutdown();
+}
+
+void DDM::TelemetryManager::Update()
+{
+	// The sampling thread does the rest, the frame only pays for this check
+	if (!m_IsInitialized)
+	{
+		Initialize();
+	}
+}
+
+void DDM::TelemetryManager::TakeSample()
+{
+	if (!m_IsInitialized)
+	{
+		Initialize();
+	}
+
+	{
+		std::lock_guard lock{ m_WakeMutex };
+		m_IsSampleRequested = true;
+	}
+
+	m_WakeCondition.notify_one();
+}
+
+void DDM::TelemetryManager::Shutdown()
+{
+	{
+		std::lock_guard lock{ m_WakeMutex };
+		m_IsRunning = false;
+	}
+
+	m_WakeCondition.notify_one();
+
+	if (m_SamplingThread.joinable())
+	{
+		m_SamplingThread.join();
+	}
+}
+
+DDM::TelemetryManager::MemorySample DDM::TelemetryManager::GetLastSample() const
+{
+	std::lock_guard lock{ m_SampleMutex };
+	return m_LastSample;
+}
+
+void DDM::TelemetryManager::OnGUI()
+{
+	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Framed;
+
+	// Start tree
+	if (ImGui::TreeNodeEx("Memory", flags))
+	{
+		// Drawn under the lock instead of from a copy, the sampling thread only holds it for a swap
+		std::lock_guard lock{ m_SampleMutex };
+
+		ImGui::Text("Resident: %.1f MB", ToMegabytes(m_LastSample.ResidentBytes));
+		ImGui::Text("Private: %.1f MB", ToMegabytes(m_LastSample.PrivateBytes));
+
+		ImGui::Separator();
+
+		ImGui::Text(m_LastSample.IsBudgetSupported ? "Gpu heaps (memory budget)" : "Gpu heaps (engine allocations)");
+
+		for (size_t heap{}; heap < m_LastSample.Heaps.size(); ++heap)
+		{
+			const auto& usage{ m_LastSample.Heaps[heap] };
+
+			ImGui::Text("Heap %zu%s: %.1f / %.1f MB", heap, usage.IsDeviceLocal ? " (device local)" : "",
+				ToMegabytes(usage.Usage), ToMegabytes(usage.Budget));
+		}
+
+		ImGui::Separator();
+
+		for (size_t resource{}; resource < ResourceTracker::kResourceCount; ++resource)
+		{
+			ImGui::Text("%s: %lld", ResourceTracker::GetName(static_cast<TrackedResource>(resource)), static_cast<long long>(m_LastSample.Resources[resource]));
+		}
+
+		ImGui::Text("Allocations: %llu", static_cast<unsigned long long>(m_LastSample.Allocations));
+
+		ImGui::TreePop();
+	}
+}
+
+void DDM::TelemetryManager::Initialize()
+{
+	m_IsInitialized = true;
+
+	auto pGPUObject{ VulkanObject::GetInstance().GetGPUObject() };
+
+	m_PhysicalDevice = pGPUObject->GetPhysicalDevice();
+
+	vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_MemoryProperties);
+	m_IsBudgetSupported = pGPUObject->SupportsMemoryBudget();
+
+	m_Interval = ConfigManager::GetInstance().GetFloat("TelemetryInterval");
+
+	m_StartTime = std::chrono::steady_clock::now();
+
+	OpenLogFile();
+
+	// Everything the sampling thread reads is set, start it
+	m_IsRunning = true;
+	m_SamplingThread = std::thread{ &TelemetryManager::SampleLoop, this };
+}
+
+void DDM::TelemetryManager::OpenLogFile()
+{
+	// An empty file name keeps the telemetry in memory only
+	const std::string fileName{ ConfigManager::GetInstance().GetString("TelemetryLogFile") };
+
+	if (fileName.empty())
+		return;
+
+	m_LogFile.open(fileName);
+
+	if (!m_LogFile.is_open())
+	{
+		std::cout << "Could not open telemetry file " << fileName << "\n";
+		return;
+	}
+
+	m_LogFile << "Time,ResidentMB,PrivateMB";
+
+	for (uint32_t heap{}; heap < m_MemoryProperties.memoryHeapCount; ++heap)
+	{
+		m_LogFile << ",Heap" << heap << "UsageMB,Heap" << heap << "BudgetMB";
+	}
+
+	for (size_t resource{}; resource < ResourceTracker::kResourceCount; ++resource)
+	{
+		m_LogFile << ',' << ResourceTracker::GetName(static_cast<TrackedResource>(resource));
+	}
+
+	m_LogFile << ",Allocations\n";
+}
+
+void DDM::TelemetryManager::SampleLoop()
+{
+	DDM_PROFILE_THREAD("Telemetry");
+
+	// Sampling is never urgent, keep it from taking time away from the frame
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#else
+	// On linux the nice value belongs to the calling thread only
+	setpriority(PRIO_PROCESS, 0, 10);
+#endif
+
+	// Filled by this thread and swapped with the last sample, so both lists of heaps are reused instead of allocated every interval
+	MemorySample sample{};
+
+	const auto interval{ std::chrono::duration<float>(m_Interval) };
+
+	std::unique_lock lock{ m_WakeMutex };
+
+	while (m_IsRunning)
+	{
+		m_IsSampleRequested = false;
+
+		lock.unlock();
+
+		Sample(sample);
+
+		if (m_LogFile.is_open())
+		{
+			WriteSample(sample);
+		}
+
+		{
+			std::lock_guard sampleLock{ m_SampleMutex };
+			std::swap(sample, m_LastSample);
+		}
+
+		lock.lock();
+
+		// Sleep until the interval passed, a sample is requested or the thread is stopped
+		m_WakeCondition.wait_for(lock, interval, [this]()
+			{
+				return !m_IsRunning || m_IsSampleRequested;
+			});
+	}
+}
+
+void DDM::TelemetryManager::Sample(MemorySample& sample) const
+{
+	sample.Time = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_StartTime).count();
+
+	SampleHeaps(sample);
+	SampleProcess(sample);
+
+	for (size_t resource{}; resource < ResourceTracker::kResourceCount; ++resource)
+	{
+		sample.Resources[resource] = ResourceTracker::GetCount(static_cast<TrackedResource>(resource));
+	}
+
+	sample.Allocations = ResourceTracker::GetAllocationCount();
+}
+
+void DDM::TelemetryManager::SampleHeaps(MemorySample& sample) const
+{
+	const uint32_t heapCount{ m_MemoryProperties.memoryHeapCount };
+
+	sample.Heaps.resize(heapCount);
+	sample.IsBudgetSupported = m_IsBudgetSupported;
+
+	for (uint32_t heap{}; heap < heapCount; ++heap)
+	{
+		sample.Heaps[heap] = HeapUsage{};
+		sample.Heaps[heap].Size = m_MemoryProperties.memoryHeaps[heap].size;
+		sample.Heaps[heap].IsDeviceLocal = (m_MemoryProperties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+	}
+
+	if (m_IsBudgetSupported)
+	{
+		// The budget includes the memory of other processes, usage only counts this one
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+		budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+		VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+		memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+		memoryProperties.pNext = &budgetProperties;
+
+		vkGetPhysicalDeviceMemoryProperties2(m_PhysicalDevice, &memoryProperties);
+
+		for (uint32_t heap{}; heap < heapCount; ++heap)
+		{
+			sample.Heaps[heap].Usage = budgetProperties.heapUsage[heap];
+			sample.Heaps[heap].Budget = budgetProperties.heapBudget[heap];
+		}
+
+		return;
+	}
+
+	// Without the extension the usage is what the engine allocated itself and the budget is the heap size
+	for (uint32_t type{}; type < m_MemoryProperties.memoryTypeCount; ++type)
+	{
+		sample.Heaps[m_MemoryProperties.memoryTypes[type].heapIndex].Usage += ResourceTracker::GetAllocatedBytes(type);
+	}
+
+	for (auto& heap : sample.Heaps)
+	{
+		heap.Budget = heap.Size;
+	}
+}
+
+void DDM::TelemetryManager::SampleProcess(MemorySample& sample) const
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS_EX counters{};
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters)))
+	{
+		sample.ResidentBytes = counters.WorkingSetSize;
+		sample.PrivateBytes = counters.PrivateUsage;
+	}
+#else
+	// statm holds the total, resident and shared size in pages, read with stdio because a file stream allocates its buffer
+	std::FILE* pStatm{ std::fopen("/proc/self/statm", "r") };
+
+	if (pStatm == nullptr)
+		return;
+
+	unsigned long long totalPages{};
+	unsigned long long residentPages{};
+	unsigned long long sharedPages{};
+
+	const bool isRead{ std::fscanf(pStatm, "%llu %llu %llu", &totalPages, &residentPages, &sharedPages) == 3 };
+
+	std::fclose(pStatm);
+
+	if (isRead)
+	{
+		const uint64_t pageSize{ static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) };
+
+		sample.ResidentBytes = residentPages * pageSize;
+		sample.PrivateBytes = (residentPages - std::min(sharedPages, residentPages)) * pageSize;
+	}
+#endif
+}
+
+void DDM::TelemetryManager::WriteSample(const MemorySample& sample)
+{
+	m_LogFile << sample.Time << ',' << ToMegabytes(sample.ResidentBytes) << ',' << ToMegabytes(sample.PrivateBytes);
+
+	for (const auto& heap : sample.Heaps)
+	{
+		m_LogFile << ',' << ToMegabytes(heap.Usage) << ',' << ToMegabytes(heap.Budget);
+	}
+
+	for (int64_t count : sample.Resources)
+	{
+		m_LogFile << ',' << count;
+	}
+
+	// Flushed every sample so the log survives a crash, which is when it is most useful
+	m_LogFile << ',' << sample.Allocations << std::endl;
+}
@@ -0,0 +1,158 @@
+// TelemetryManager.h
+// This singleton samples the memory use of the engine at a fixed interval instead of every frame
+// Sampling and writing the log happen on a low priority background thread, so reading from the driver and the operating system never stalls a frame
+// Gpu heap usage and budget come from VK_EXT_memory_budget, or from the memory the engine tracks itself when it is missing
+// Process memory comes from the operating system and the amount of live vulkan objects from the resource tracker
+
+#ifndef TelemetryManagerIncluded
+#define TelemetryManagerIncluded
+
+// File includes
+#include "Engine/Singleton.h"
+#include "Includes/VulkanIncludes.h"
+
+#include "Utils/ResourceTracker.h"
+
+// Standard library includes
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DDM
+{
+	class TelemetryManager final : public Singleton<TelemetryManager>
+	{
+	public:
+		// Usage of a single memory heap in bytes
+		struct HeapUsage
+		{
+			uint64_t Usage{};
+			uint64_t Budget{};
+			uint64_t Size{};
+			bool IsDeviceLocal{ false };
+		};
+
+		// The memory use at a single moment
+		struct MemorySample
+		{
+			// Seconds since the first sample
+			float Time{};
+
+			// Usage of every memory heap
+			std::vector<HeapUsage> Heaps{};
+
+			// Indicates the heap usage comes from VK_EXT_memory_budget instead of the tracked allocations
+			bool IsBudgetSupported{ false };
+
+			// Bytes of the process that are resident in physical memory
+			uint64_t ResidentBytes{};
+
+			// Bytes of the process that are not shared with other processes
+			uint64_t PrivateBytes{};
+
+			// Amount of live objects of every tracked kind
+			std::array<int64_t, ResourceTracker::kResourceCount> Resources{};
+
+			// Amount of live device memory allocations
+			uint64_t Allocations{};
+		};
+
+		// Destructor, stops the sampling thread
+		virtual ~TelemetryManager();
+
+		// Start the sampling thread on the first call, called once per frame by the engine loop
+		void Update();
+
+		// Let the sampling thread take a sample right away instead of at the end of the interval
+		void TakeSample();
+
+		// Stop the sampling thread, has to happen before the vulkan device is destroyed
+		void Shutdown();
+
+		// Get a copy of the most recent sample
+		MemorySample GetLastSample() const;
+
+		// Draw the most recent sample
+		void OnGUI();
+
+	private:
+		friend class Singleton<TelemetryManager>;
+		TelemetryManager() = default;
+
+		// The physical device the memory is sampled from
+		VkPhysicalDevice m_PhysicalDevice{ VK_NULL_HANDLE };
+
+		// Memory properties of the physical device
+		VkPhysicalDeviceMemoryProperties m_MemoryProperties{};
+
+		// Indicates the memory properties were read
+		bool m_IsInitialized{ false };
+
+		// Indicates VK_EXT_memory_budget is enabled on the device
+		bool m_IsBudgetSupported{ false };
+
+		// Seconds between samples
+		float m_Interval{ 0.5f };
+
+		// Time of the first sample
+		std::chrono::steady_clock::time_point m_StartTime{};
+
+		// Guards the most recent sample, the sampling thread only holds it to swap in a new sample
+		mutable std::mutex m_SampleMutex{};
+
+		// The most recent sample
+		MemorySample m_LastSample{};
+
+		// File every sample is written to, only open when a log file is configured, only used by the sampling thread once it runs
+		std::ofstream m_LogFile{};
+
+		// Thread that takes the samples
+		std::thread m_SamplingThread{};
+
+		// Wakes the sampling thread early, guards the two flags below
+		std::mutex m_WakeMutex{};
+		std::condition_variable m_WakeCondition{};
+
+		// Indicates the sampling thread should keep running
+		bool m_IsRunning{ false };
+
+		// Indicates a sample was requested before the end of the interval
+		bool m_IsSampleRequested{ false };
+
+		// Read the memory properties, open the log file and start the sampling thread
+		void Initialize();
+
+		// Open the log file and write its header
+		void OpenLogFile();
+
+		// Take a sample every interval until the thread is stopped, runs on the sampling thread
+		void SampleLoop();
+
+		// Fill in a sample
+		// Parameters:
+		//     sample: the sample to fill in, its list of heaps is reused
+		void Sample(MemorySample& sample) const;
+
+		// Fill in the usage of every heap
+		// Parameters:
+		//     sample: the sample to fill in
+		void SampleHeaps(MemorySample& sample) const;
+
+		// Fill in the memory of the process
+		// Parameters:
+		//     sample: the sample to fill in
+		void SampleProcess(MemorySample& sample) const;
+
+		// Write a sample to the log file
+		// Parameters:
+		//     sample: the sample to write
+		void WriteSample(const MemorySample& sample);
+	};
+}
+
+#endif // !TelemetryManagerIncluded
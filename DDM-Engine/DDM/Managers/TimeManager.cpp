@@ -3,11 +3,290 @@
 // Header include
 #include "TimeManager.h"
 
+// File includes
+#include "Includes/ImGuiIncludes.h"
+
+#include "Managers/ConfigManager.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+DDM::TimeManager::TimeManager()
+{
+    m_FrameHistory.resize(kHistorySize);
+    m_PhaseHistory.resize(kHistorySize);
+    m_SortedTimes.reserve(kHistorySize);
+
+    // Thresholds that are missing from the config file are 0, which disables them
+    auto& configManager{ ConfigManager::GetInstance() };
+
+    m_FrameBudget = configManager.GetFloat("FrameBudgetMs");
+    m_HitchThreshold = configManager.GetFloat("HitchThresholdMs");
+    m_HitchFactor = configManager.GetFloat("HitchFactor");
+    m_MaxFixedSteps = std::max(configManager.GetInt("MaxFixedStepsPerFrame"), 0);
+}
+
 void DDM::TimeManager::SetDeltaTime(float dt)
 {
     // Set delta time
     m_DeltaTime = dt;
+}
+
+void DDM::TimeManager::AddFrame(const FrameTimings& timings)
+{
+    // Compare against the window before this frame is part of it
+    DetectHitch(timings);
+
+    if (m_FrameBudget > 0.0f && timings.FrameTime > m_FrameBudget)
+    {
+        ++m_FramesOverBudget;
+    }
+
+    // Remove the oldest frame once the window is full
+    if (m_HistoryCount == kHistorySize)
+    {
+        const float oldestTime{ m_FrameHistory[m_HistoryIndex] };
+
+        m_FrameTimeSum -= oldestTime;
+        m_Histogram[GetBucket(oldestTime)] -= 1.0f;
+    }
+    else
+    {
+        ++m_HistoryCount;
+    }
+
+    m_FrameHistory[m_HistoryIndex] = timings.FrameTime;
+    m_PhaseHistory[m_HistoryIndex] = timings.PhaseTimes;
+
+    m_FrameTimeSum += timings.FrameTime;
+    m_Histogram[GetBucket(timings.FrameTime)] += 1.0f;
+
+    m_HistoryIndex = (m_HistoryIndex + 1) % kHistorySize;
+    ++m_FrameCount;
+
+    // Calculate the amount of frames per second over the window
+    const double averageTime{ m_FrameTimeSum / static_cast<double>(m_HistoryCount) };
+    m_Fps = averageTime > 0.0 ? static_cast<float>(1000.0 / averageTime) : 0.0f;
+}
+
+DDM::TimeManager::TimeSummary DDM::TimeManager::GetFrameSummary() const
+{
+    m_SortedTimes.assign(m_FrameHistory.begin(), m_FrameHistory.begin() + m_HistoryCount);
+
+    return Summarize(m_SortedTimes);
+}
+
+DDM::TimeManager::TimeSummary DDM::TimeManager::GetPhaseSummary(FramePhase phase) const
+{
+    m_SortedTimes.resize(m_HistoryCount);
+
+    std::transform(m_PhaseHistory.begin(), m_PhaseHistory.begin() + m_HistoryCount, m_SortedTimes.begin(),
+        [phase](const auto& phaseTimes) { return phaseTimes[static_cast<size_t>(phase)]; });
+
+    return Summarize(m_SortedTimes);
+}
+
+std::vector<DDM::TimeManager::Hitch> DDM::TimeManager::GetRecentHitches() const
+{
+    const size_t hitchCount{ static_cast<size_t>(std::min<uint64_t>(m_HitchCount, kMaxHitches)) };
+
+    std::vector<Hitch> hitches{};
+    hitches.reserve(hitchCount);
+
+    // The oldest hitch is the one that gets overwritten next
+    const size_t first{ static_cast<size_t>(m_HitchCount - hitchCount) };
+
+    for (size_t index{}; index < hitchCount; ++index)
+    {
+        hitches.push_back(m_Hitches[(first + index) % kMaxHitches]);
+    }
+
+    return hitches;
+}
+
+bool DDM::TimeManager::IsWithinBudget() const
+{
+    if (m_FrameBudget <= 0.0f || m_HistoryCount == 0)
+        return true;
+
+    return GetFrameSummary().P99 <= m_FrameBudget;
+}
+
+bool DDM::TimeManager::ExportStatistics(const std::string& fileName) const
+{
+    std::ofstream file{ fileName };
+
+    if (!file.is_open())
+    {
+        std::cout << "Could not open frame statistics file " << fileName << "\n";
+        return false;
+    }
+
+    auto writeSummary = [&file](const char* name, const TimeSummary& summary, bool isLast)
+        {
+            file << "\t\t\"" << name << "\": { \"Average\": " << summary.Average
+                << ", \"Min\": " << summary.Min << ", \"Max\": " << summary.Max
+                << ", \"P50\": " << summary.P50 << ", \"P95\": " << summary.P95
+                << ", \"P99\": " << summary.P99 << " }" << (isLast ? "\n" : ",\n");
+        };
+
+    file << "{\n";
+    file << "\t\"Frames\": " << m_HistoryCount << ",\n";
+    file << "\t\"FrameBudget\": " << m_FrameBudget << ",\n";
+    file << "\t\"FramesOverBudget\": " << m_FramesOverBudget << ",\n";
+    file << "\t\"WithinBudget\": " << (IsWithinBudget() ? "true" : "false") << ",\n";
+    file << "\t\"Phases\": {\n";
+
+    for (size_t phase{}; phase < FrameTimings::kPhaseCount; ++phase)
+    {
+        writeSummary(FrameTimings::GetPhaseName(static_cast<FramePhase>(phase)), GetPhaseSummary(static_cast<FramePhase>(phase)), false);
+    }
+
+    writeSummary("Frame", GetFrameSummary(), true);
+
+    file << "\t},\n";
+
+    // Every bucket starts at its index times the bucket width
+    file << "\t\"HistogramBucketWidth\": " << kHistogramBucketWidth << ",\n";
+    file << "\t\"Histogram\": [";
+
+    for (size_t bucket{}; bucket < kHistogramBuckets; ++bucket)
+    {
+        file << (bucket == 0 ? "" : ", ") << static_cast<int>(m_Histogram[bucket]);
+    }
+
+    file << "],\n";
+    file << "\t\"HitchCount\": " << m_HitchCount << ",\n";
+    file << "\t\"Hitches\": [\n";
+
+    const auto hitches{ GetRecentHitches() };
+
+    for (size_t index{}; index < hitches.size(); ++index)
+    {
+        const auto& hitch{ hitches[index] };
+
+        file << "\t\t{ \"Frame\": " << hitch.Frame << ", \"FrameTime\": " << hitch.FrameTime
+            << ", \"WorstPhase\": \"" << FrameTimings::GetPhaseName(hitch.WorstPhase) << "\", \"WorstPhaseTime\": " << hitch.WorstPhaseTime << " }"
+            << (index + 1 == hitches.size() ? "\n" : ",\n");
+    }
+
+    file << "\t]\n}\n";
+
+    std::cout << "Wrote frame statistics of " << m_HistoryCount << " frames to " << fileName << "\n";
+
+    return true;
+}
+
+void DDM::TimeManager::OnGUI()
+{
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Framed;
+
+    // Start tree
+    if (ImGui::TreeNodeEx("Frame times", flags))
+    {
+        const TimeSummary summary{ GetFrameSummary() };
+
+        ImGui::Text("Fps: %.1f", m_Fps);
+        ImGui::Text("P50: %.2f ms P95: %.2f ms P99: %.2f ms Max: %.2f ms", summary.P50, summary.P95, summary.P99, summary.Max);
+
+        ImGui::PlotHistogram("##FrameTimes", m_Histogram.data(), static_cast<int>(kHistogramBuckets), 0, "Frame times (0.5 ms buckets)", 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+        if (m_FrameBudget > 0.0f)
+        {
+            ImGui::Text("Budget %.2f ms: %s, %llu frames over", m_FrameBudget, IsWithinBudget() ? "met" : "missed", static_cast<unsigned long long>(m_FramesOverBudget));
+        }
+
+        ImGui::Text("Hitches: %llu", static_cast<unsigned long long>(m_HitchCount));
+        ImGui::Text("Dropped fixed steps: %llu", static_cast<unsigned long long>(m_DroppedFixedSteps));
+
+        if (ImGui::TreeNode("Phases"))
+        {
+            for (size_t phase{}; phase < FrameTimings::kPhaseCount; ++phase)
+            {
+                const TimeSummary phaseSummary{ GetPhaseSummary(static_cast<FramePhase>(phase)) };
+
+                ImGui::Text("%s: %.3f ms (P99 %.3f ms)", FrameTimings::GetPhaseName(static_cast<FramePhase>(phase)), phaseSummary.Average, phaseSummary.P99);
+            }
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::Button("Export"))
+        {
+            ExportStatistics(ConfigManager::GetInstance().GetString("FrameStatsFile"));
+        }
+
+        ImGui::TreePop();
+    }
+}
+
+size_t DDM::TimeManager::GetBucket(float frameTime)
+{
+    const size_t bucket{ static_cast<size_t>(std::max(frameTime, 0.0f) / kHistogramBucketWidth) };
+
+    return std::min(bucket, kHistogramBuckets - 1);
+}
+
+void DDM::TimeManager::DetectHitch(const FrameTimings& timings)
+{
+    bool isHitch{ m_HitchThreshold > 0.0f && timings.FrameTime > m_HitchThreshold };
+
+    // Relative to the average, so a scene that is slow all the time doesn't count every frame
+    if (m_HitchFactor > 0.0f && m_HistoryCount > 0)
+    {
+        const double averageTime{ m_FrameTimeSum / static_cast<double>(m_HistoryCount) };
+
+        isHitch |= timings.FrameTime > averageTime * m_HitchFactor;
+    }
+
+    if (!isHitch)
+        return;
+
+    const auto worstPhase{ std::max_element(timings.PhaseTimes.begin(), timings.PhaseTimes.end()) };
+
+    auto& hitch{ m_Hitches[m_HitchCount % kMaxHitches] };
+    hitch.Frame = m_FrameCount;
+    hitch.FrameTime = timings.FrameTime;
+    hitch.WorstPhase = static_cast<FramePhase>(std::distance(timings.PhaseTimes.begin(), worstPhase));
+    hitch.WorstPhaseTime = *worstPhase;
+
+    ++m_HitchCount;
+}
+
+DDM::TimeManager::TimeSummary DDM::TimeManager::Summarize(std::vector<float>& times)
+{
+    TimeSummary summary{};
+
+    if (times.empty())
+        return summary;
+
+    std::sort(times.begin(), times.end());
+
+    // Nearest rank percentile
+    auto percentile = [&times](float fraction)
+        {
+            const size_t rank{ static_cast<size_t>(std::ceil(fraction * static_cast<float>(times.size()))) };
+            return times[std::clamp<size_t>(rank, 1, times.size()) - 1];
+        };
+
+    double total{};
+
+    for (float time : times)
+    {
+        total += time;
+    }
+
+    summary.Average = static_cast<float>(total / static_cast<double>(times.size()));
+    summary.Min = times.front();
+    summary.Max = times.back();
+    summary.P50 = percentile(0.50f);
+    summary.P90 = percentile(0.90f);
+    summary.P95 = percentile(0.95f);
+    summary.P99 = percentile(0.99f);
 
-    // Calculate the amount of frames per second
-    m_Fps = static_cast<int>(1.0f / dt);
-}
\ No newline at end of file
+    return summary;
+}
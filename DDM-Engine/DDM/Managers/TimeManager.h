@@ -1,17 +1,71 @@
 // TimeManager.h
 // This singleton will store and manage all information about time
+// Besides the delta time it keeps a rolling window of frame and phase times to get percentiles, a histogram and hitches,
+// so a frame time budget can be checked instead of eyeballing an average
 
 #ifndef TimeManagerIncluded
 #define TimeManagerIncluded
 
 // File includes
 #include "Engine/Singleton.h"
+#include "Engine/FrameTimings.h"
+
+// Standard library includes
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 namespace DDM
 {
 	class TimeManager final : public Singleton<TimeManager>
 	{
 	public:
+		// Amount of frames in the rolling window
+		static constexpr size_t kHistorySize{ 512 };
+
+		// Amount of histogram buckets, the last one holds every frame that is slower
+		static constexpr size_t kHistogramBuckets{ 80 };
+
+		// Width of a histogram bucket in milliseconds
+		static constexpr float kHistogramBucketWidth{ 0.5f };
+
+		// Amount of recent hitches that are kept
+		static constexpr size_t kMaxHitches{ 32 };
+
+		// Summary of a list of times in milliseconds
+		struct TimeSummary
+		{
+			float Average{};
+			float Min{};
+			float Max{};
+			float P50{};
+			float P90{};
+			float P95{};
+			float P99{};
+		};
+
+		// A frame that took much longer than the frames around it
+		struct Hitch
+		{
+			// Index of the frame since the start of the program
+			uint64_t Frame{};
+
+			// Duration of the frame in milliseconds
+			float FrameTime{};
+
+			// The phase that took the longest
+			FramePhase WorstPhase{};
+
+			// Duration of the worst phase in milliseconds
+			float WorstPhaseTime{};
+		};
+
+		// Summarize a list of times, percentiles use the nearest rank, every frame time summary of the engine goes through this
+		// Parameters:
+		//     times: the times, sorted in place
+		static TimeSummary Summarize(std::vector<float>& times);
+
 		// Set the delta time of this frame
 		// Parameters:
 		//     dt: the current value of delta time
@@ -22,8 +76,8 @@ namespace DDM
 
 		float GetDeltaTimeMS() const { return m_DeltaTime * 1000; }
 
-		// Get the current amount of frames per second
-		int GetFps() const { return m_Fps; }
+		// Get the amount of frames per second, averaged over the rolling window
+		float GetFps() const { return m_Fps; }
 
 		// Set the fixed time step
 		// Parameters:
@@ -33,20 +87,153 @@ namespace DDM
 		// Get the value of the fixed time step
 		float GetFixedTime() const { return m_FixedTime; }
 
+		// Set the fraction of a fixed step that passed since the last fixed step, set once per frame by the engine loop
+		// Parameters:
+		//     alpha: the fraction, between 0 and 1
+		void SetInterpolationAlpha(float alpha) { m_InterpolationAlpha = alpha; }
+
+		// Get the fraction of a fixed step that passed since the last fixed step, used to render between the last two fixed steps
+		float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
+		// Get the maximum amount of fixed steps in a single frame, 0 when there is no maximum
+		int GetMaxFixedSteps() const { return m_MaxFixedSteps; }
+
+		// Set the maximum amount of fixed steps in a single frame
+		// Parameters:
+		//     maxSteps: the maximum, 0 to disable it
+		void SetMaxFixedSteps(int maxSteps) { m_MaxFixedSteps = maxSteps; }
+
+		// Add fixed steps that were skipped because a frame needed more than the maximum
+		// Parameters:
+		//     steps: the amount of skipped steps
+		void AddDroppedFixedSteps(uint64_t steps) { m_DroppedFixedSteps += steps; }
+
+		// Get the amount of fixed steps skipped since the start of the program
+		uint64_t GetDroppedFixedSteps() const { return m_DroppedFixedSteps; }
+
+		// Add the timings of a finished frame to the rolling window, called once per frame by the engine loop
+		// Parameters:
+		//     timings: the time spent in every phase of the frame
+		void AddFrame(const FrameTimings& timings);
+
+		// Get the summary of the frame times in the rolling window
+		TimeSummary GetFrameSummary() const;
+
+		// Get the summary of the times of a phase in the rolling window
+		// Parameters:
+		//     phase: the requested phase
+		TimeSummary GetPhaseSummary(FramePhase phase) const;
+
+		// Get the histogram of the frame times in the rolling window
+		const std::array<float, kHistogramBuckets>& GetHistogram() const { return m_Histogram; }
+
+		// Get the amount of frames in the rolling window
+		size_t GetFrameCount() const { return m_HistoryCount; }
+
+		// Get the amount of hitches since the start of the program
+		uint64_t GetHitchCount() const { return m_HitchCount; }
+
+		// Get the most recent hitches, oldest first
+		std::vector<Hitch> GetRecentHitches() const;
+
+		// Get the frame time budget in milliseconds, 0 when there is none
+		float GetFrameBudget() const { return m_FrameBudget; }
+
+		// Set the frame time budget
+		// Parameters:
+		//     budget: the budget in milliseconds, 0 to disable it
+		void SetFrameBudget(float budget) { m_FrameBudget = budget; }
+
+		// Get the amount of frames over budget since the start of the program
+		uint64_t GetFramesOverBudget() const { return m_FramesOverBudget; }
+
+		// Check if the 99th percentile of the rolling window fits in the budget
+		bool IsWithinBudget() const;
+
+		// Write the summaries, histogram and recent hitches to a json file
+		// Parameters:
+		//     fileName: name of the file
+		// Returns true if the file was written
+		bool ExportStatistics(const std::string& fileName) const;
+
+		// Draw the frame time statistics
+		void OnGUI();
+
 	private:
 		friend class Singleton<TimeManager>;
-		TimeManager() = default;
+		TimeManager();
 
-		// Frames per second of current frame
-		int m_Fps = 0;
+		// Frames per second, averaged over the rolling window
+		float m_Fps = 0;
 
 		// Delta time of current frame
 		float m_DeltaTime = 0;
 
 		// Fixed time step
 		float m_FixedTime = 0.2f;
+
+		// Fraction of a fixed step that passed since the last fixed step
+		float m_InterpolationAlpha{};
+
+		// Maximum amount of fixed steps in a single frame, 0 when there is no maximum
+		int m_MaxFixedSteps{};
+
+		// Amount of fixed steps skipped since the start of the program
+		uint64_t m_DroppedFixedSteps{};
+
+		// Frame times of the rolling window
+		std::vector<float> m_FrameHistory{};
+
+		// Phase times of the rolling window
+		std::vector<std::array<float, FrameTimings::kPhaseCount>> m_PhaseHistory{};
+
+		// Index the next frame is written to
+		size_t m_HistoryIndex{};
+
+		// Amount of frames in the rolling window
+		size_t m_HistoryCount{};
+
+		// Sum of the frame times in the rolling window
+		double m_FrameTimeSum{};
+
+		// Amount of frames per bucket in the rolling window, floats so it can be plotted directly
+		std::array<float, kHistogramBuckets> m_Histogram{};
+
+		// Amount of frames since the start of the program
+		uint64_t m_FrameCount{};
+
+		// A frame slower than this is a hitch, in milliseconds, 0 to disable
+		float m_HitchThreshold{};
+
+		// A frame slower than this many times the rolling average is a hitch, 0 to disable
+		float m_HitchFactor{};
+
+		// The most recent hitches
+		std::array<Hitch, kMaxHitches> m_Hitches{};
+
+		// Amount of hitches since the start of the program
+		uint64_t m_HitchCount{};
+
+		// Frame time budget in milliseconds, 0 when there is none
+		float m_FrameBudget{};
+
+		// Amount of frames over budget since the start of the program
+		uint64_t m_FramesOverBudget{};
+
+		// Reused buffer to sort the times of the rolling window
+		mutable std::vector<float> m_SortedTimes{};
+
+		// Get the histogram bucket of a frame time
+		// Parameters:
+		//     frameTime: the frame time in milliseconds
+		static size_t GetBucket(float frameTime);
+
+		// Check if a frame is a hitch and store it
+		// Parameters:
+		//     timings: the timings of the frame
+		void DetectHitch(const FrameTimings& timings);
 	};
 }
 
 
-#endif // !TimeManagerIncluded
\ No newline at end of file
+#endif // !TimeManagerIncluded
@@ -0,0 +1,545 @@
+// TransformManager.cpp
+
+// Header include
+#include "TransformManager.h"
+
+// File includes
+#include "Utils/Profiler.h"
+
+// Standard library includes
+#include <algorithm>
+
+uint32_t DDM::TransformManager::CreateTransform()
+{
+	// Reuse a free id if there is one, otherwise create a new one
+	uint32_t id{};
+
+	if (!m_FreeIds.empty())
+	{
+		id = m_FreeIds.back();
+		m_FreeIds.pop_back();
+	}
+	else
+	{
+		id = static_cast<uint32_t>(m_IdToIndex.size());
+		m_IdToIndex.push_back(kInvalidId);
+	}
+
+	// New entries are always added at the back, a root entry is always correctly sorted there
+	const uint32_t index{ static_cast<uint32_t>(m_IndexToId.size()) };
+
+	m_LocalPositions.emplace_back(0.f, 0.f, 0.f);
+	m_LocalRotations.push_back(glm::identity<glm::quat>());
+	m_LocalScales.emplace_back(1.f, 1.f, 1.f);
+
+	m_WorldPositions.emplace_back(0.f, 0.f, 0.f);
+	m_WorldRotations.push_back(glm::identity<glm::quat>());
+	m_WorldScales.emplace_back(1.f, 1.f, 1.f);
+	m_WorldMatrices.emplace_back(1.f);
+	m_Versions.push_back(0);
+
+	m_InterpolateFlags.push_back(0);
+	m_PreviousPositions.emplace_back(0.f, 0.f, 0.f);
+	m_PreviousRotations.push_back(glm::identity<glm::quat>());
+	m_PreviousScales.emplace_back(1.f, 1.f, 1.f);
+	m_RenderMatrices.emplace_back(1.f);
+	m_RenderVersions.push_back(0);
+
+	m_ParentIndices.push_back(kInvalidId);
+	m_DirtyFlags.push_back(0);
+	m_IndexToId.push_back(id);
+
+	m_IdToIndex[id] = index;
+
+	// Mark the new entry as dirty
+	SetDirty(id);
+
+	return id;
+}
+
+void DDM::TransformManager::DestroyTransform(uint32_t id)
+{
+	const uint32_t index{ m_IdToIndex[id] };
+
+	// Leave the slot in place as a dead entry, it is compacted away before the next update
+	m_IndexToId[index] = kInvalidId;
+	m_ParentIndices[index] = kInvalidId;
+	m_DirtyFlags[index] = 0;
+
+	if (m_InterpolateFlags[index] != 0)
+	{
+		m_InterpolateFlags[index] = 0;
+		--m_InterpolatedCount;
+	}
+
+	// Release the id
+	m_IdToIndex[id] = kInvalidId;
+	m_FreeIds.push_back(id);
+
+	// Request compaction from this slot on
+	m_FirstUnsortedIndex = std::min(m_FirstUnsortedIndex, index);
+}
+
+void DDM::TransformManager::SetParent(uint32_t id, uint32_t parentId)
+{
+	const uint32_t index{ m_IdToIndex[id] };
+	const uint32_t parentIndex{ parentId == kInvalidId ? kInvalidId : m_IdToIndex[parentId] };
+
+	m_ParentIndices[index] = parentIndex;
+
+	// If the parent now comes after the child, the child has to move behind it
+	if (parentIndex != kInvalidId && parentIndex > index)
+	{
+		m_FirstUnsortedIndex = std::min(m_FirstUnsortedIndex, index);
+	}
+
+	// The world transform depends on the new parent
+	SetDirty(id);
+}
+
+void DDM::TransformManager::SetDirty(uint32_t id)
+{
+	const uint32_t index{ m_IdToIndex[id] };
+
+	// Set the flag and keep track of the lowest dirty index, descendants are handled during the update
+	m_DirtyFlags[index] = 1;
+
+	// Lower the first dirty index atomically, so transforms can be changed from parallel jobs
+	uint32_t firstDirtyIndex{ m_FirstDirtyIndex.load(std::memory_order_relaxed) };
+
+	while (index < firstDirtyIndex && !m_FirstDirtyIndex.compare_exchange_weak(firstDirtyIndex, index, std::memory_order_relaxed))
+	{
+	}
+}
+
+const glm::vec3& DDM::TransformManager::GetWorldPosition(uint32_t id)
+{
+	EnsureUpdated();
+	return m_WorldPositions[m_IdToIndex[id]];
+}
+
+const glm::quat& DDM::TransformManager::GetWorldRotation(uint32_t id)
+{
+	EnsureUpdated();
+	return m_WorldRotations[m_IdToIndex[id]];
+}
+
+const glm::vec3& DDM::TransformManager::GetWorldScale(uint32_t id)
+{
+	EnsureUpdated();
+	return m_WorldScales[m_IdToIndex[id]];
+}
+
+const glm::mat4& DDM::TransformManager::GetWorldMatrix(uint32_t id)
+{
+	EnsureUpdated();
+	return m_WorldMatrices[m_IdToIndex[id]];
+}
+
+uint64_t DDM::TransformManager::GetVersion(uint32_t id)
+{
+	EnsureUpdated();
+	return m_Versions[m_IdToIndex[id]];
+}
+
+void DDM::TransformManager::SetInterpolated(uint32_t id, bool interpolate)
+{
+	const uint32_t index{ m_IdToIndex[id] };
+
+	if ((m_InterpolateFlags[index] != 0) == interpolate)
+	{
+		return;
+	}
+
+	m_InterpolateFlags[index] = interpolate ? 1 : 0;
+
+	if (interpolate)
+	{
+		++m_InterpolatedCount;
+
+		// Start from the current state, otherwise the entry would slide in from wherever it was last interpolated
+		ResetInterpolation(id);
+	}
+	else
+	{
+		--m_InterpolatedCount;
+	}
+}
+
+void DDM::TransformManager::ResetInterpolation(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t index{ m_IdToIndex[id] };
+
+	m_PreviousPositions[index] = m_WorldPositions[index];
+	m_PreviousRotations[index] = m_WorldRotations[index];
+	m_PreviousScales[index] = m_WorldScales[index];
+}
+
+void DDM::TransformManager::StoreFixedStepState()
+{
+	if (m_InterpolatedCount == 0)
+	{
+		return;
+	}
+
+	DDM_PROFILE_FUNCTION();
+
+	EnsureUpdated();
+
+	const size_t count{ m_IndexToId.size() };
+
+	for (size_t index{}; index < count; ++index)
+	{
+		if (m_InterpolateFlags[index] == 0)
+		{
+			continue;
+		}
+
+		m_PreviousPositions[index] = m_WorldPositions[index];
+		m_PreviousRotations[index] = m_WorldRotations[index];
+		m_PreviousScales[index] = m_WorldScales[index];
+	}
+}
+
+void DDM::TransformManager::UpdateRenderTransforms(float alpha)
+{
+	if (m_InterpolatedCount == 0)
+	{
+		return;
+	}
+
+	DDM_PROFILE_FUNCTION();
+
+	EnsureUpdated();
+
+	const size_t count{ m_IndexToId.size() };
+
+	for (size_t index{}; index < count; ++index)
+	{
+		if (m_InterpolateFlags[index] == 0)
+		{
+			continue;
+		}
+
+		// An entry that didn't move during the last fixed step is rendered with its world matrix
+		if (m_PreviousPositions[index] == m_WorldPositions[index] &&
+			m_PreviousRotations[index] == m_WorldRotations[index] &&
+			m_PreviousScales[index] == m_WorldScales[index])
+		{
+			m_RenderMatrices[index] = m_WorldMatrices[index];
+			m_RenderVersions[index] = m_Versions[index];
+			continue;
+		}
+
+		const glm::vec3 position{ glm::mix(m_PreviousPositions[index], m_WorldPositions[index], alpha) };
+		const glm::quat rotation{ glm::slerp(m_PreviousRotations[index], m_WorldRotations[index], alpha) };
+		const glm::vec3 scale{ glm::mix(m_PreviousScales[index], m_WorldScales[index], alpha) };
+
+		// Build the matrix the same way as the world matrix
+		glm::mat4& matrix{ m_RenderMatrices[index] };
+		matrix = glm::mat4_cast(rotation);
+		matrix[0] *= scale.x;
+		matrix[1] *= scale.y;
+		matrix[2] *= scale.z;
+		matrix[3] = glm::vec4(position, 1.f);
+
+		// The matrix changes every frame, so it gets a new version every frame
+		m_RenderVersions[index] = ++m_VersionCounter;
+	}
+}
+
+const glm::mat4& DDM::TransformManager::GetRenderMatrix(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t index{ m_IdToIndex[id] };
+
+	return m_InterpolateFlags[index] != 0 ? m_RenderMatrices[index] : m_WorldMatrices[index];
+}
+
+uint64_t DDM::TransformManager::GetRenderVersion(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t index{ m_IdToIndex[id] };
+
+	return m_InterpolateFlags[index] != 0 ? m_RenderVersions[index] : m_Versions[index];
+}
+
+glm::vec3 DDM::TransformManager::GetParentWorldPosition(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t parentIndex{ m_ParentIndices[m_IdToIndex[id]] };
+
+	// If there is no parent, return origin
+	if (parentIndex == kInvalidId)
+	{
+		return glm::vec3{};
+	}
+
+	return m_WorldPositions[parentIndex];
+}
+
+glm::quat DDM::TransformManager::GetParentWorldRotation(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t parentIndex{ m_ParentIndices[m_IdToIndex[id]] };
+
+	// If there is no parent, return identity
+	if (parentIndex == kInvalidId)
+	{
+		return glm::identity<glm::quat>();
+	}
+
+	return m_WorldRotations[parentIndex];
+}
+
+glm::vec3 DDM::TransformManager::GetParentWorldScale(uint32_t id)
+{
+	EnsureUpdated();
+
+	const uint32_t parentIndex{ m_ParentIndices[m_IdToIndex[id]] };
+
+	// If there is no parent, return 1, 1, 1
+	if (parentIndex == kInvalidId)
+	{
+		return glm::vec3{ 1, 1, 1 };
+	}
+
+	return m_WorldScales[parentIndex];
+}
+
+void DDM::TransformManager::UpdateWorldTransforms()
+{
+	DDM_PROFILE_FUNCTION();
+
+	// Restore parent before child order if needed
+	if (m_FirstUnsortedIndex != kInvalidId)
+	{
+		SortHierarchy();
+	}
+
+	// If nothing changed, there is nothing to do
+	if (m_FirstDirtyIndex == kInvalidId)
+	{
+		return;
+	}
+
+	const uint32_t count{ static_cast<uint32_t>(m_IndexToId.size()) };
+	const uint32_t firstDirtyIndex{ m_FirstDirtyIndex.load(std::memory_order_relaxed) };
+
+	// Every parent comes before its children, so a single pass starting at the first dirty entry is enough
+	for (uint32_t index{ firstDirtyIndex }; index < count; ++index)
+	{
+		const uint32_t parentIndex{ m_ParentIndices[index] };
+
+		// An entry is recalculated when it changed itself or when its parent was recalculated during this pass
+		if (m_DirtyFlags[index] == 0)
+		{
+			if (parentIndex == kInvalidId || m_DirtyFlags[parentIndex] == 0)
+			{
+				continue;
+			}
+
+			// Propagate the flag so the children of this entry get recalculated too
+			m_DirtyFlags[index] = 1;
+		}
+
+		if (parentIndex == kInvalidId)
+		{
+			// Root entries have their local transform as world transform
+			m_WorldPositions[index] = m_LocalPositions[index];
+			m_WorldRotations[index] = m_LocalRotations[index];
+			m_WorldScales[index] = m_LocalScales[index];
+		}
+		else
+		{
+			// Position is rotated by the parent rotation and offset by the parent position
+			m_WorldPositions[index] = m_WorldPositions[parentIndex] + m_WorldRotations[parentIndex] * m_LocalPositions[index];
+
+			// Rotation and scale are combined with those of the parent
+			m_WorldRotations[index] = m_WorldRotations[parentIndex] * m_LocalRotations[index];
+			m_WorldScales[index] = m_WorldScales[parentIndex] * m_LocalScales[index];
+		}
+
+		// Build the world matrix as translation * rotation * scale
+		glm::mat4& matrix{ m_WorldMatrices[index] };
+		matrix = glm::mat4_cast(m_WorldRotations[index]);
+		matrix[0] *= m_WorldScales[index].x;
+		matrix[1] *= m_WorldScales[index].y;
+		matrix[2] *= m_WorldScales[index].z;
+		matrix[3] = glm::vec4(m_WorldPositions[index], 1.f);
+
+		// Hand out a new version
+		m_Versions[index] = ++m_VersionCounter;
+	}
+
+	// Clear all dirty flags
+	std::fill(m_DirtyFlags.begin() + firstDirtyIndex, m_DirtyFlags.end(), static_cast<uint8_t>(0));
+	m_FirstDirtyIndex = kInvalidId;
+}
+
+void DDM::TransformManager::Reserve(size_t count)
+{
+	m_LocalPositions.reserve(count);
+	m_LocalRotations.reserve(count);
+	m_LocalScales.reserve(count);
+
+	m_WorldPositions.reserve(count);
+	m_WorldRotations.reserve(count);
+	m_WorldScales.reserve(count);
+	m_WorldMatrices.reserve(count);
+	m_Versions.reserve(count);
+
+	m_InterpolateFlags.reserve(count);
+	m_PreviousPositions.reserve(count);
+	m_PreviousRotations.reserve(count);
+	m_PreviousScales.reserve(count);
+	m_RenderMatrices.reserve(count);
+	m_RenderVersions.reserve(count);
+
+	m_ParentIndices.reserve(count);
+	m_DirtyFlags.reserve(count);
+	m_IndexToId.reserve(count);
+	m_IdToIndex.reserve(count);
+}
+
+void DDM::TransformManager::SortHierarchy()
+{
+	const uint32_t count{ static_cast<uint32_t>(m_IndexToId.size()) };
+	const uint32_t firstIndex{ m_FirstUnsortedIndex };
+	const uint32_t rangeSize{ count - firstIndex };
+
+	// Find the entries that have to move behind their parent, and their descendants
+	// Entries before the first unsorted index are in order, and descendants always come after their ancestor,
+	// so a single pass sees every parent before its children, except for the parents that are behind them
+	m_SortMoved.assign(rangeSize, static_cast<uint8_t>(0));
+	m_SortOrder.clear();
+
+	for (uint32_t index{ firstIndex }; index < count; ++index)
+	{
+		if (m_IndexToId[index] == kInvalidId)
+		{
+			continue;
+		}
+
+		uint32_t& parentIndex{ m_ParentIndices[index] };
+
+		// A destroyed parent turns its children into roots, their world transform changes
+		if (parentIndex != kInvalidId && m_IndexToId[parentIndex] == kInvalidId)
+		{
+			parentIndex = kInvalidId;
+			m_DirtyFlags[index] = 1;
+		}
+
+		if (parentIndex != kInvalidId && parentIndex >= firstIndex &&
+			(parentIndex > index || m_SortMoved[parentIndex - firstIndex] != 0))
+		{
+			m_SortMoved[index - firstIndex] = 1;
+			m_SortOrder.push_back(index);
+		}
+	}
+
+	// Order the moved entries by their depth below the first moved ancestor, keeping the current order for equal depths
+	if (!m_SortOrder.empty())
+	{
+		m_SortDepths.assign(rangeSize, kInvalidId);
+
+		for (auto index : m_SortOrder)
+		{
+			// Walk up until leaving the moved entries or reaching an entry with a known depth
+			// The walk is capped to protect against cycles
+			uint32_t depth{};
+			uint32_t current{ m_ParentIndices[index] };
+
+			while (m_SortMoved[current - firstIndex] != 0 && m_SortDepths[current - firstIndex] == kInvalidId && depth <= rangeSize)
+			{
+				++depth;
+				current = m_ParentIndices[current];
+			}
+
+			if (m_SortMoved[current - firstIndex] != 0 && m_SortDepths[current - firstIndex] != kInvalidId)
+			{
+				depth += m_SortDepths[current - firstIndex] + 1;
+			}
+
+			m_SortDepths[index - firstIndex] = depth;
+		}
+
+		std::stable_sort(m_SortOrder.begin(), m_SortOrder.end(),
+			[this, firstIndex](uint32_t a, uint32_t b) { return m_SortDepths[a - firstIndex] < m_SortDepths[b - firstIndex]; });
+	}
+
+	// Map the old indices to the new ones, the entries that stay keep their order and the moved ones go to the back
+	m_SortRemap.assign(rangeSize, kInvalidId);
+
+	uint32_t newIndex{ firstIndex };
+
+	for (uint32_t index{ firstIndex }; index < count; ++index)
+	{
+		if (m_IndexToId[index] != kInvalidId && m_SortMoved[index - firstIndex] == 0)
+		{
+			m_SortRemap[index - firstIndex] = newIndex++;
+		}
+	}
+
+	for (auto index : m_SortOrder)
+	{
+		m_SortRemap[index - firstIndex] = newIndex++;
+	}
+
+	// Reorder all arrays, moved entries take their state along so they aren't recalculated unless they were dirty
+	ApplySortOrder(m_LocalPositions, m_SortVec3s);
+	ApplySortOrder(m_LocalRotations, m_SortQuats);
+	ApplySortOrder(m_LocalScales, m_SortVec3s);
+
+	ApplySortOrder(m_WorldPositions, m_SortVec3s);
+	ApplySortOrder(m_WorldRotations, m_SortQuats);
+	ApplySortOrder(m_WorldScales, m_SortVec3s);
+	ApplySortOrder(m_WorldMatrices, m_SortMatrices);
+	ApplySortOrder(m_Versions, m_SortVersions);
+
+	ApplySortOrder(m_InterpolateFlags, m_SortFlags);
+	ApplySortOrder(m_PreviousPositions, m_SortVec3s);
+	ApplySortOrder(m_PreviousRotations, m_SortQuats);
+	ApplySortOrder(m_PreviousScales, m_SortVec3s);
+	ApplySortOrder(m_RenderMatrices, m_SortMatrices);
+	ApplySortOrder(m_RenderVersions, m_SortVersions);
+
+	ApplySortOrder(m_ParentIndices, m_SortIndices);
+	ApplySortOrder(m_DirtyFlags, m_SortFlags);
+	ApplySortOrder(m_IndexToId, m_SortIndices);
+
+	// Remap the parent indices and ids of the entries that changed place, entries before the range kept their index
+	const uint32_t newCount{ static_cast<uint32_t>(m_IndexToId.size()) };
+	uint32_t firstDirtyIndex{ kInvalidId };
+
+	for (uint32_t index{ firstIndex }; index < newCount; ++index)
+	{
+		uint32_t& parentIndex{ m_ParentIndices[index] };
+
+		if (parentIndex != kInvalidId && parentIndex >= firstIndex)
+		{
+			parentIndex = m_SortRemap[parentIndex - firstIndex];
+		}
+
+		m_IdToIndex[m_IndexToId[index]] = index;
+
+		if (firstDirtyIndex == kInvalidId && m_DirtyFlags[index] != 0)
+		{
+			firstDirtyIndex = index;
+		}
+	}
+
+	// Entries before the range are still dirty at the same index, the ones in the range may have moved
+	if (m_FirstDirtyIndex.load(std::memory_order_relaxed) >= firstIndex)
+	{
+		m_FirstDirtyIndex = firstDirtyIndex;
+	}
+
+	m_FirstUnsortedIndex = kInvalidId;
+}
@@ -0,0 +1,315 @@
+// TransformManager.h
+// This singleton will store the local and world transform data of every transform component
+// All data lives in contiguous arrays sorted so that every parent comes before its children,
+// which allows all world transforms to be updated in a single linear pass
+// Entries that are interpolated also keep their world transform from before the last fixed step,
+// so they can be rendered between the last two fixed steps instead of jumping from step to step
+
+#ifndef TransformManagerIncluded
+#define TransformManagerIncluded
+
+// File includes
+#include "Engine/Singleton.h"
+#include "Includes/GLMIncludes.h"
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace DDM
+{
+	class TransformManager final : public Singleton<TransformManager>
+	{
+	public:
+		// Value used for invalid ids and indices
+		static constexpr uint32_t kInvalidId{ std::numeric_limits<uint32_t>::max() };
+
+		// Create a new transform entry without a parent
+		// Returns: the stable id of the new entry
+		uint32_t CreateTransform();
+
+		// Destroy a transform entry, its slot is compacted away on the next update
+		// Parameters:
+		//     id: the id of the entry to destroy
+		void DestroyTransform(uint32_t id);
+
+		// Set the parent of a transform entry
+		// Parameters:
+		//     id: the id of the entry
+		//     parentId: the id of the new parent, kInvalidId for no parent
+		void SetParent(uint32_t id, uint32_t parentId);
+
+		// Mark a transform entry as changed, its world transform and those of all its descendants will be recalculated
+		// Can be called from jobs, as long as no two jobs mark the same entry
+		// Parameters:
+		//     id: the id of the changed entry
+		void SetDirty(uint32_t id);
+
+		// Get the local position of an entry
+		// Parameters:
+		//     id: the id of the entry
+		glm::vec3& GetLocalPosition(uint32_t id) { return m_LocalPositions[m_IdToIndex[id]]; }
+
+		// Get the local rotation of an entry
+		// Parameters:
+		//     id: the id of the entry
+		glm::quat& GetLocalRotation(uint32_t id) { return m_LocalRotations[m_IdToIndex[id]]; }
+
+		// Get the local scale of an entry
+		// Parameters:
+		//     id: the id of the entry
+		glm::vec3& GetLocalScale(uint32_t id) { return m_LocalScales[m_IdToIndex[id]]; }
+
+		// Get the world position of an entry, updates the world transforms if needed
+		// Parameters:
+		//     id: the id of the entry
+		const glm::vec3& GetWorldPosition(uint32_t id);
+
+		// Get the world rotation of an entry, updates the world transforms if needed
+		// Parameters:
+		//     id: the id of the entry
+		const glm::quat& GetWorldRotation(uint32_t id);
+
+		// Get the world scale of an entry, updates the world transforms if needed
+		// Parameters:
+		//     id: the id of the entry
+		const glm::vec3& GetWorldScale(uint32_t id);
+
+		// Get the world matrix of an entry, updates the world transforms if needed
+		// Parameters:
+		//     id: the id of the entry
+		const glm::mat4& GetWorldMatrix(uint32_t id);
+
+		// Get the version of the world transform of an entry, updates the world transforms if needed
+		// The version changes every time the world transform is recalculated
+		// Parameters:
+		//     id: the id of the entry
+		uint64_t GetVersion(uint32_t id);
+
+		// Get the world position of the parent of an entry, origin if it has no parent
+		// Parameters:
+		//     id: the id of the entry
+		glm::vec3 GetParentWorldPosition(uint32_t id);
+
+		// Get the world rotation of the parent of an entry, identity if it has no parent
+		// Parameters:
+		//     id: the id of the entry
+		glm::quat GetParentWorldRotation(uint32_t id);
+
+		// Get the world scale of the parent of an entry, 1 if it has no parent
+		// Parameters:
+		//     id: the id of the entry
+		glm::vec3 GetParentWorldScale(uint32_t id);
+
+		// Recalculate the world transforms of all dirty entries and their descendants in one pass
+		void UpdateWorldTransforms();
+
+		// Enable or disable interpolation of the rendered transform of an entry
+		// Parameters:
+		//     id: the id of the entry
+		//     interpolate: true to render the entry between its last two fixed step states
+		void SetInterpolated(uint32_t id, bool interpolate);
+
+		// Check if the rendered transform of an entry is interpolated
+		// Parameters:
+		//     id: the id of the entry
+		bool IsInterpolated(uint32_t id) const { return m_InterpolateFlags[m_IdToIndex[id]] != 0; }
+
+		// Make the previous fixed step state of an entry equal to its current one, so a teleport isn't interpolated
+		// Parameters:
+		//     id: the id of the entry
+		void ResetInterpolation(uint32_t id);
+
+		// Store the world transform of every interpolated entry as its previous state, called before every fixed step
+		void StoreFixedStepState();
+
+		// Calculate the rendered matrix of every interpolated entry, called once per frame before rendering
+		// Parameters:
+		//     alpha: fraction of a fixed step that passed since the last fixed step
+		void UpdateRenderTransforms(float alpha);
+
+		// Get the matrix an entry is rendered with, the world matrix unless the entry is interpolated
+		// Parameters:
+		//     id: the id of the entry
+		const glm::mat4& GetRenderMatrix(uint32_t id);
+
+		// Get the version of the rendered matrix of an entry, the world version unless the entry is interpolated
+		// Parameters:
+		//     id: the id of the entry
+		uint64_t GetRenderVersion(uint32_t id);
+
+		// Reserve memory for a number of entries
+		// Parameters:
+		//     count: the amount of entries to reserve memory for
+		void Reserve(size_t count);
+
+		// Get the amount of slots currently in use, including destroyed slots that are not compacted yet
+		size_t GetTransformCount() const { return m_IndexToId.size(); }
+
+	private:
+		friend class Singleton<TransformManager>;
+		TransformManager() = default;
+
+		// -------------------
+		// Local transform
+		// -------------------
+
+		// Positions relative to the parent
+		std::vector<glm::vec3> m_LocalPositions{};
+
+		// Rotations relative to the parent
+		std::vector<glm::quat> m_LocalRotations{};
+
+		// Scales relative to the parent
+		std::vector<glm::vec3> m_LocalScales{};
+
+		// -------------------
+		// World transform
+		// -------------------
+
+		// Cached world positions
+		std::vector<glm::vec3> m_WorldPositions{};
+
+		// Cached world rotations
+		std::vector<glm::quat> m_WorldRotations{};
+
+		// Cached world scales
+		std::vector<glm::vec3> m_WorldScales{};
+
+		// Cached world matrices
+		std::vector<glm::mat4> m_WorldMatrices{};
+
+		// Version of the world transform of every entry
+		std::vector<uint64_t> m_Versions{};
+
+		// -------------------
+		// Interpolation
+		// -------------------
+
+		// Interpolation flag for every entry
+		std::vector<uint8_t> m_InterpolateFlags{};
+
+		// World positions before the last fixed step
+		std::vector<glm::vec3> m_PreviousPositions{};
+
+		// World rotations before the last fixed step
+		std::vector<glm::quat> m_PreviousRotations{};
+
+		// World scales before the last fixed step
+		std::vector<glm::vec3> m_PreviousScales{};
+
+		// Rendered matrices of the interpolated entries
+		std::vector<glm::mat4> m_RenderMatrices{};
+
+		// Version of the rendered matrix of the interpolated entries
+		std::vector<uint64_t> m_RenderVersions{};
+
+		// Amount of interpolated entries, the interpolation passes are skipped when there are none
+		size_t m_InterpolatedCount{};
+
+		// Last version that was handed out, 0 is never used so it can indicate an invalid version
+		uint64_t m_VersionCounter{};
+
+		// -------------------
+		// Hierarchy
+		// -------------------
+
+		// Index of the parent of every entry, always lower than the index of the entry itself once sorted
+		std::vector<uint32_t> m_ParentIndices{};
+
+		// Dirty flag for every entry
+		std::vector<uint8_t> m_DirtyFlags{};
+
+		// Id of the entry at every index, kInvalidId for destroyed entries
+		std::vector<uint32_t> m_IndexToId{};
+
+		// Index of the entry for every id
+		std::vector<uint32_t> m_IdToIndex{};
+
+		// Ids that can be reused
+		std::vector<uint32_t> m_FreeIds{};
+
+		// Lowest index that is dirty, kInvalidId if nothing is dirty
+		std::atomic<uint32_t> m_FirstDirtyIndex{ kInvalidId };
+
+		// Lowest index that was destroyed or got a parent behind it, kInvalidId if the arrays are in order
+		// Everything before it is untouched when the order is restored
+		uint32_t m_FirstUnsortedIndex{ kInvalidId };
+
+		// Scratch buffers used while restoring the order, kept so restoring doesn't allocate
+		// Depth of the moved entries below the first moved ancestor
+		std::vector<uint32_t> m_SortDepths{};
+
+		// Indices of the entries that move behind their parent, parents before children
+		std::vector<uint32_t> m_SortOrder{};
+
+		// New index of every entry from the first unsorted index on, kInvalidId for destroyed entries
+		std::vector<uint32_t> m_SortRemap{};
+
+		// Indicates an entry moves behind its parent, from the first unsorted index on
+		std::vector<uint8_t> m_SortMoved{};
+
+		// Values of the moved entries while the other entries are compacted
+		std::vector<glm::vec3> m_SortVec3s{};
+		std::vector<glm::quat> m_SortQuats{};
+		std::vector<glm::mat4> m_SortMatrices{};
+		std::vector<uint64_t> m_SortVersions{};
+		std::vector<uint32_t> m_SortIndices{};
+		std::vector<uint8_t> m_SortFlags{};
+
+		// Update the world transforms if anything changed
+		void EnsureUpdated()
+		{
+			if (m_FirstUnsortedIndex != kInvalidId || m_FirstDirtyIndex != kInvalidId)
+			{
+				UpdateWorldTransforms();
+			}
+		}
+
+		// Remove destroyed entries and move entries behind their parent when it comes after them
+		// Only the entries from the first unsorted index on are touched, entries keep their dirty flag and version
+		void SortHierarchy();
+
+		// Apply the new order to an array, the entries that stay slide down over the removed slots in place
+		// and the moved entries are placed at the back
+		// Parameters:
+		//     values: the array to reorder
+		//     scratch: buffer that holds the moved entries while the others slide down
+		template <class T>
+		void ApplySortOrder(std::vector<T>& values, std::vector<T>& scratch) const;
+	};
+
+	template<class T>
+	inline void TransformManager::ApplySortOrder(std::vector<T>& values, std::vector<T>& scratch) const
+	{
+		// Set the moved entries aside, the entries that stay may overwrite their slots
+		scratch.clear();
+
+		for (auto oldIndex : m_SortOrder)
+		{
+			scratch.push_back(values[oldIndex]);
+		}
+
+		// Slide the entries that stay down, new indices are never higher than old ones so this works in place
+		const uint32_t count{ static_cast<uint32_t>(values.size()) };
+		uint32_t keptCount{ m_FirstUnsortedIndex };
+
+		for (uint32_t index{ m_FirstUnsortedIndex }; index < count; ++index)
+		{
+			const uint32_t offset{ index - m_FirstUnsortedIndex };
+
+			if (m_SortRemap[offset] != kInvalidId && m_SortMoved[offset] == 0)
+			{
+				values[keptCount++] = values[index];
+			}
+		}
+
+		// Put the moved entries behind the others, the capacity is left untouched
+		values.resize(keptCount);
+		values.insert(values.end(), scratch.begin(), scratch.end());
+	}
+}
+
+#endif // !TransformManagerIncluded
@@ -0,0 +1,174 @@
+// AllocationTracker.cpp
+// Replaces the global operator new and delete to count allocations, only when DDM_TRACK_ALLOCATIONS is defined
+// The replacements forward to malloc and free, memory from the aligned versions needs its own free function on windows
+
+// Header include
+#include "AllocationTracker.h"
+
+#ifdef DDM_TRACK_ALLOCATIONS
+
+// Standard library includes
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Allocate and count memory
+	// Parameters:
+	//     size: size of the allocation in bytes
+	// Returns nullptr when out of memory
+	void* AllocateTracked(size_t size) noexcept
+	{
+		DDM::AllocationTracker::Record(size);
+
+		// malloc may return nullptr for a size of 0, operator new may not
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	// Allocate and count aligned memory
+	// Parameters:
+	//     size: size of the allocation in bytes
+	//     alignment: the required alignment
+	// Returns nullptr when out of memory
+	void* AllocateTrackedAligned(size_t size, std::align_val_t alignment) noexcept
+	{
+		DDM::AllocationTracker::Record(size);
+
+		const auto alignmentValue{ static_cast<size_t>(alignment) };
+
+#ifdef _WIN32
+		return _aligned_malloc(size == 0 ? 1 : size, alignmentValue);
+#else
+		// aligned_alloc needs the size to be a multiple of the alignment
+		const size_t alignedSize{ ((size == 0 ? 1 : size) + alignmentValue - 1) & ~(alignmentValue - 1) };
+
+		return std::aligned_alloc(alignmentValue, alignedSize);
+#endif
+	}
+
+	// Free aligned memory
+	// Parameters:
+	//     pMemory: memory allocated by AllocateTrackedAligned
+	void FreeAligned(void* pMemory) noexcept
+	{
+#ifdef _WIN32
+		_aligned_free(pMemory);
+#else
+		std::free(pMemory);
+#endif
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (void* pMemory{ AllocateTracked(size) })
+		return pMemory;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size)
+{
+	if (void* pMemory{ AllocateTracked(size) })
+		return pMemory;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	if (void* pMemory{ AllocateTrackedAligned(size, alignment) })
+		return pMemory;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	if (void* pMemory{ AllocateTrackedAligned(size, alignment) })
+		return pMemory;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateTrackedAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateTrackedAligned(size, alignment);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete(void* pMemory, size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete(void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+#endif
@@ -0,0 +1,198 @@
+// AllocationTracker.h
+// This file counts the heap allocations made every frame, grouped by the subsystem that made them
+// The global operator new is replaced to count every allocation under the tag of the innermost allocation scope of the thread
+// Once a scene is loaded and warmed up a frame should not allocate at all, the engine loop can check this every frame
+// Counting is only compiled in when DDM_TRACK_ALLOCATIONS is defined, otherwise operator new is left alone and the scope macro expands to nothing
+
+#ifndef AllocationTrackerIncluded
+#define AllocationTrackerIncluded
+
+// Standard library includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace DDM
+{
+	// Every subsystem allocations are counted for
+	enum class AllocationTag : uint8_t
+	{
+		Untagged,
+		Input,
+		Scene,
+		Render,
+		Descriptors,
+		Gui,
+		Count
+	};
+
+	namespace AllocationTracker
+	{
+		// Amount of tags
+		constexpr size_t kTagCount{ static_cast<size_t>(AllocationTag::Count) };
+
+		// The amount of allocations of every tag
+		using Values = std::array<uint64_t, kTagCount>;
+
+		namespace Detail
+		{
+			// Tag of the innermost allocation scope of the thread
+			inline thread_local AllocationTag t_CurrentTag{ AllocationTag::Untagged };
+
+			// Allocations of the current frame
+			inline std::array<std::atomic<uint64_t>, kTagCount> g_FrameAllocations{};
+
+			// Allocated bytes of the current frame
+			inline std::array<std::atomic<uint64_t>, kTagCount> g_FrameBytes{};
+
+			// Allocations of the last finished frame
+			inline std::array<std::atomic<uint64_t>, kTagCount> g_LastFrameAllocations{};
+
+			// Allocated bytes of the last finished frame
+			inline std::array<std::atomic<uint64_t>, kTagCount> g_LastFrameBytes{};
+		}
+
+		// Count an allocation under the tag of the calling thread, called by operator new
+		// Parameters:
+		//     size: size of the allocation in bytes
+		inline void Record(size_t size)
+		{
+			const auto tag{ static_cast<size_t>(Detail::t_CurrentTag) };
+
+			Detail::g_FrameAllocations[tag].fetch_add(1, std::memory_order_relaxed);
+			Detail::g_FrameBytes[tag].fetch_add(size, std::memory_order_relaxed);
+		}
+
+		// Finish the current frame, called once per frame by the engine loop
+		inline void EndFrame()
+		{
+			for (size_t index{}; index < kTagCount; ++index)
+			{
+				Detail::g_LastFrameAllocations[index].store(Detail::g_FrameAllocations[index].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+				Detail::g_LastFrameBytes[index].store(Detail::g_FrameBytes[index].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		// Get the amount of allocations of a tag in the last finished frame
+		// Parameters:
+		//     tag: the requested tag
+		inline uint64_t GetLastFrame(AllocationTag tag)
+		{
+			return Detail::g_LastFrameAllocations[static_cast<size_t>(tag)].load(std::memory_order_relaxed);
+		}
+
+		// Get the amount of bytes allocated under a tag in the last finished frame
+		// Parameters:
+		//     tag: the requested tag
+		inline uint64_t GetLastFrameBytes(AllocationTag tag)
+		{
+			return Detail::g_LastFrameBytes[static_cast<size_t>(tag)].load(std::memory_order_relaxed);
+		}
+
+		// Get the amount of allocations of every tag in the last finished frame
+		inline Values GetLastFrame()
+		{
+			Values values{};
+
+			for (size_t index{}; index < kTagCount; ++index)
+			{
+				values[index] = Detail::g_LastFrameAllocations[index].load(std::memory_order_relaxed);
+			}
+
+			return values;
+		}
+
+		// Get the amount of allocations of all tags together in the last finished frame
+		inline uint64_t GetLastFrameTotal()
+		{
+			uint64_t total{};
+
+			for (const auto& allocations : Detail::g_LastFrameAllocations)
+			{
+				total += allocations.load(std::memory_order_relaxed);
+			}
+
+			return total;
+		}
+
+		// Get the display name of a tag
+		// Parameters:
+		//     tag: the requested tag
+		constexpr const char* GetName(AllocationTag tag)
+		{
+			switch (tag)
+			{
+			case AllocationTag::Untagged:
+				return "Untagged";
+			case AllocationTag::Input:
+				return "Input";
+			case AllocationTag::Scene:
+				return "Scene";
+			case AllocationTag::Render:
+				return "Render";
+			case AllocationTag::Descriptors:
+				return "Descriptors";
+			case AllocationTag::Gui:
+				return "Gui";
+			default:
+				return "Unknown";
+			}
+		}
+
+		// Check if the allocation counting is compiled in
+		constexpr bool IsEnabled()
+		{
+#ifdef DDM_TRACK_ALLOCATIONS
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		// Counts the allocations of the calling thread under a tag until it is destroyed
+		class Scope final
+		{
+		public:
+			// Constructor
+			// Parameters:
+			//     tag: the tag allocations are counted under
+			explicit Scope(AllocationTag tag)
+				:m_PreviousTag{ Detail::t_CurrentTag }
+			{
+				Detail::t_CurrentTag = tag;
+			}
+
+			// Destructor
+			~Scope()
+			{
+				Detail::t_CurrentTag = m_PreviousTag;
+			}
+
+			// Rule of five
+			Scope(const Scope& other) = delete;
+			Scope(Scope&& other) = delete;
+			Scope& operator=(const Scope& other) = delete;
+			Scope& operator=(Scope&& other) = delete;
+
+		private:
+			// Tag of the enclosing scope, restored when this one ends
+			AllocationTag m_PreviousTag{};
+		};
+	}
+}
+
+#ifdef DDM_TRACK_ALLOCATIONS
+
+#define DDM_ALLOCATION_CONCAT_INNER(a, b) a##b
+#define DDM_ALLOCATION_CONCAT(a, b) DDM_ALLOCATION_CONCAT_INNER(a, b)
+
+// Count the allocations until the end of the current scope under a tag
+#define DDM_ALLOCATION_SCOPE(tag) ::DDM::AllocationTracker::Scope DDM_ALLOCATION_CONCAT(ddmAllocationScope, __LINE__){ ::DDM::AllocationTag::tag }
+
+#else
+
+#define DDM_ALLOCATION_SCOPE(tag)
+
+#endif
+
+#endif // !AllocationTrackerIncluded
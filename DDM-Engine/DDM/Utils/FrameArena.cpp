@@ -0,0 +1,112 @@
+// FrameArena.cpp
+
+// Header include
+#include "FrameArena.h"
+
+// Standard library includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace
+{
+	// Size of the first block of every arena
+	constexpr size_t kInitialCapacity{ 64 * 1024 };
+
+	// Index of the current frame, an arena that belongs to an older frame starts over
+	std::atomic<uint64_t> g_Frame{};
+
+	// The arena of a single thread
+	struct Arena
+	{
+		// Block that is reused every frame
+		std::unique_ptr<std::byte[]> Memory{};
+
+		// Size of the block
+		size_t Capacity{};
+
+		// Amount of bytes used this frame
+		size_t Offset{};
+
+		// Blocks allocated this frame because the main block was full
+		std::vector<std::unique_ptr<std::byte[]>> Overflow{};
+
+		// Amount of bytes in the overflow blocks
+		size_t OverflowBytes{};
+
+		// Frame the arena was last used in
+		uint64_t Frame{};
+	};
+
+	thread_local Arena t_Arena{};
+
+	// Start the arena over for the current frame
+	// Parameters:
+	//     arena: the arena of the calling thread
+	void Reset(Arena& arena)
+	{
+		// Grow the main block to fit everything of the frame that overflowed, so the next frames fit in it
+		if (!arena.Overflow.empty() || arena.Memory == nullptr)
+		{
+			arena.Capacity = std::max(arena.Capacity + arena.OverflowBytes, kInitialCapacity);
+			arena.Memory = std::make_unique_for_overwrite<std::byte[]>(arena.Capacity);
+
+			arena.Overflow.clear();
+			arena.OverflowBytes = 0;
+		}
+
+		arena.Offset = 0;
+		arena.Frame = g_Frame.load(std::memory_order_relaxed);
+	}
+}
+
+void* DDM::FrameArena::Allocate(size_t size, size_t alignment)
+{
+	auto& arena{ t_Arena };
+
+	if (arena.Memory == nullptr || arena.Frame != g_Frame.load(std::memory_order_relaxed))
+	{
+		Reset(arena);
+	}
+
+	const auto base{ reinterpret_cast<uintptr_t>(arena.Memory.get()) };
+	const size_t alignedOffset{ ((base + arena.Offset + alignment - 1) & ~(alignment - 1)) - base };
+
+	if (alignedOffset + size <= arena.Capacity)
+	{
+		arena.Offset = alignedOffset + size;
+		return arena.Memory.get() + alignedOffset;
+	}
+
+	// Doesn't fit anymore, use a separate block for this frame and grow the main block when the frame is over
+	const size_t blockSize{ size + alignment };
+
+	arena.Overflow.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize));
+	arena.OverflowBytes += blockSize;
+
+	void* pMemory{ arena.Overflow.back().get() };
+	size_t space{ blockSize };
+
+	return std::align(alignment, size, pMemory, space);
+}
+
+void DDM::FrameArena::EndFrame()
+{
+	g_Frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t DDM::FrameArena::GetUsedBytes()
+{
+	const auto& arena{ t_Arena };
+
+	if (arena.Frame != g_Frame.load(std::memory_order_relaxed))
+		return 0;
+
+	return arena.Offset + arena.OverflowBytes;
+}
+
+size_t DDM::FrameArena::GetCapacity()
+{
+	return t_Arena.Capacity;
+}
@@ -0,0 +1,67 @@
+// FrameArena.h
+// This file contains a linear allocator for data that only lives for a single frame, like lists of descriptor writes
+// Allocating bumps an offset in a block that is reused every frame and freeing does nothing, so the heap is never touched once it is warmed up
+// Every thread has its own arena, which starts over the first time it allocates after the engine loop finished a frame
+// Memory from the arena may never be kept past the end of the frame it was allocated in
+
+#ifndef FrameArenaIncluded
+#define FrameArenaIncluded
+
+// Standard library includes
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace DDM
+{
+	namespace FrameArena
+	{
+		// Allocate memory that stays valid until the end of the current frame
+		// Parameters:
+		//     size: the amount of bytes
+		//     alignment: the required alignment, has to be a power of two
+		void* Allocate(size_t size, size_t alignment);
+
+		// Finish the current frame, every arena starts over the next time it allocates, called once per frame by the engine loop
+		void EndFrame();
+
+		// Get the amount of bytes the calling thread allocated from its arena this frame
+		size_t GetUsedBytes();
+
+		// Get the amount of bytes reserved by the arena of the calling thread
+		size_t GetCapacity();
+	}
+
+	// Standard library allocator that allocates from the frame arena, not final because containers derive from their allocator
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator() = default;
+
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+		// Allocate memory for an amount of objects
+		// Parameters:
+		//     count: the amount of objects
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameArena::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		// The memory is given back when the frame ends
+		void deallocate(T*, size_t) noexcept {}
+
+		template<typename U>
+		bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+	};
+
+	// Vector that allocates from the frame arena, may never be kept past the end of the frame
+	template<typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T>>;
+}
+
+#endif // !FrameArenaIncluded
@@ -0,0 +1,205 @@
+// PoolAllocator.h
+// This file defines a slab pool that hands out fixed size blocks with stable addresses
+// and a standard allocator that uses it, so objects of the same type are stored close together
+// Defining DDM_DISABLE_POOLS turns every block into a separate heap allocation, to measure what the pools save
+
+#ifndef PoolAllocatorIncluded
+#define PoolAllocatorIncluded
+
+// Standard library includes
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace DDM
+{
+	template <size_t BlockSize, size_t BlockAlignment>
+	class SlabPool final
+	{
+	public:
+		/// <summary>
+		/// Get the pool for this block size and alignment
+		/// The pool is intentionally never destroyed, objects owned by other singletons may still be released after static destruction
+		/// </summary>
+		/// <returns>Reference to the pool</returns>
+		static SlabPool& GetInstance()
+		{
+			static SlabPool* pPool{ new SlabPool{} };
+			return *pPool;
+		}
+
+		// Rule of five
+		SlabPool(const SlabPool& other) = delete;
+		SlabPool(SlabPool&& other) = delete;
+		SlabPool& operator=(const SlabPool& other) = delete;
+		SlabPool& operator=(SlabPool&& other) = delete;
+
+		/// <summary>
+		/// Get a free block, a new slab is created if there is none
+		/// Not thread safe, pooled objects have to be created and destroyed on the main thread
+		/// </summary>
+		/// <returns>Pointer to the block</returns>
+		void* Allocate()
+		{
+#ifdef DDM_DISABLE_POOLS
+			return ::operator new(m_BlockSize, std::align_val_t{ m_Alignment });
+#else
+			// Add a new slab if all blocks are in use
+			if (m_pFreeList == nullptr)
+			{
+				AddSlab(m_BlocksPerSlab);
+			}
+
+			// Take the first free block
+			FreeBlock* pBlock{ m_pFreeList };
+			m_pFreeList = pBlock->pNext;
+			--m_FreeCount;
+
+			return pBlock;
+#endif
+		}
+
+		/// <summary>
+		/// Return a block to the pool
+		/// </summary>
+		/// <param name="pMemory: ">Pointer to the block</param>
+		void Deallocate(void* pMemory)
+		{
+#ifdef DDM_DISABLE_POOLS
+			::operator delete(pMemory, std::align_val_t{ m_Alignment });
+#else
+			// Push the block to the front of the free list
+			FreeBlock* pBlock{ static_cast<FreeBlock*>(pMemory) };
+			pBlock->pNext = m_pFreeList;
+			m_pFreeList = pBlock;
+			++m_FreeCount;
+#endif
+		}
+
+		/// <summary>
+		/// Make sure a number of blocks can be allocated without creating new slabs
+		/// All missing blocks are added in a single contiguous slab
+		/// </summary>
+		/// <param name="count: ">Amount of blocks to reserve</param>
+		void Reserve(size_t count)
+		{
+#ifdef DDM_DISABLE_POOLS
+			(void)count;
+#else
+			if (count > m_FreeCount)
+			{
+				AddSlab(count - m_FreeCount);
+			}
+#endif
+		}
+
+		/// <summary>
+		/// Get the amount of free blocks
+		/// </summary>
+		/// <returns>Amount of free blocks</returns>
+		size_t GetFreeCount() const { return m_FreeCount; }
+
+	private:
+		SlabPool() = default;
+
+		// Free blocks store a pointer to the next free block
+		struct FreeBlock
+		{
+			FreeBlock* pNext;
+		};
+
+		// Alignment of every block
+		static constexpr size_t m_Alignment{ std::max(BlockAlignment, alignof(FreeBlock)) };
+
+		// Size of every block, rounded up to the alignment
+		static constexpr size_t m_BlockSize{ (std::max(BlockSize, sizeof(FreeBlock)) + m_Alignment - 1) / m_Alignment * m_Alignment };
+
+		// Default amount of blocks in a new slab
+		static constexpr size_t m_BlocksPerSlab{ 256 };
+
+		// First free block
+		FreeBlock* m_pFreeList{};
+
+		// Amount of free blocks
+		size_t m_FreeCount{};
+
+		// All allocated slabs
+		std::vector<void*> m_pSlabs{};
+
+		/// <summary>
+		/// Allocate a new slab and add its blocks to the free list
+		/// </summary>
+		/// <param name="blockCount: ">Amount of blocks in the slab</param>
+		void AddSlab(size_t blockCount)
+		{
+			// Allocate the memory for the slab
+			auto pSlab{ static_cast<std::byte*>(::operator new(blockCount * m_BlockSize, std::align_val_t{ m_Alignment })) };
+			m_pSlabs.push_back(pSlab);
+
+			// Add the blocks to the free list back to front, so they get handed out in address order
+			for (size_t index{ blockCount }; index > 0; --index)
+			{
+				Deallocate(pSlab + (index - 1) * m_BlockSize);
+			}
+		}
+	};
+
+	template <class T>
+	class PoolAllocator final
+	{
+	public:
+		using value_type = T;
+
+		/// <summary>
+		/// Default constructor
+		/// </summary>
+		PoolAllocator() = default;
+
+		/// <summary>
+		/// Converting constructor, needed to rebind the allocator to other types
+		/// </summary>
+		template <class U>
+		PoolAllocator(const PoolAllocator<U>&) {}
+
+		/// <summary>
+		/// Allocate memory for n objects, single objects are taken from the pool
+		/// </summary>
+		/// <param name="n: ">Amount of objects</param>
+		/// <returns>Pointer to the memory</returns>
+		T* allocate(size_t n)
+		{
+			if (n == 1)
+			{
+				return static_cast<T*>(SlabPool<sizeof(T), alignof(T)>::GetInstance().Allocate());
+			}
+
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		/// <summary>
+		/// Release memory for n objects
+		/// </summary>
+		/// <param name="pMemory: ">Pointer to the memory</param>
+		/// <param name="n: ">Amount of objects</param>
+		void deallocate(T* pMemory, size_t n)
+		{
+			if (n == 1)
+			{
+				SlabPool<sizeof(T), alignof(T)>::GetInstance().Deallocate(pMemory);
+				return;
+			}
+
+			std::allocator<T>{}.deallocate(pMemory, n);
+		}
+
+		/// <summary>
+		/// All pool allocators share the same pools, so they are always equal
+		/// </summary>
+		template <class U>
+		bool operator==(const PoolAllocator<U>&) const { return true; }
+	};
+}
+
+#endif // !PoolAllocatorIncluded
@@ -0,0 +1,235 @@
+// Profiler.cpp
+
+// Header include
+#include "Profiler.h"
+
+#ifdef DDM_ENABLE_PROFILING
+
+// Standard library includes
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	// A single recorded marker
+	// The exporting thread can read a marker while its thread overwrites it, so every field is atomic
+	// and the sequence tells which write the marker belongs to, markers that changed while being read are dropped
+	struct Marker
+	{
+		// Write index of the marker plus one, 0 while the marker is being written
+		std::atomic<uint64_t> Sequence{};
+
+		std::atomic<const char*> pName{};
+		std::atomic<uint64_t> Start{};
+		std::atomic<uint64_t> End{};
+	};
+
+	// Amount of markers every thread keeps, older markers are overwritten, has to be a power of two
+	constexpr uint64_t kBufferSize{ 1 << 16 };
+
+	// Ring buffer of a single thread, only written by its own thread
+	struct ThreadBuffer
+	{
+		// The recorded markers
+		std::unique_ptr<Marker[]> pMarkers{ std::make_unique<Marker[]>(kBufferSize) };
+
+		// Amount of markers ever written, the next marker goes to WriteIndex % kBufferSize
+		std::atomic<uint64_t> WriteIndex{};
+
+		// Name shown in the trace
+		std::atomic<const char*> pName{ nullptr };
+
+		// Id shown in the trace
+		uint32_t ThreadId{};
+	};
+
+	// Guards the list of buffers, only locked when a thread records its first marker and when exporting
+	std::mutex g_BuffersMutex{};
+
+	// Buffers of every thread that recorded a marker, kept alive after the thread exits so its markers can be exported
+	std::vector<std::unique_ptr<ThreadBuffer>> g_pBuffers{};
+
+	// Start time of the current capture
+	std::atomic<uint64_t> g_CaptureStart{};
+
+	// Get the buffer of the calling thread, creates it on first use
+	ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local ThreadBuffer* pBuffer{ []()
+			{
+				std::lock_guard lock{ g_BuffersMutex };
+
+				auto& pNewBuffer{ g_pBuffers.emplace_back(std::make_unique<ThreadBuffer>()) };
+				pNewBuffer->ThreadId = static_cast<uint32_t>(g_pBuffers.size());
+
+				return pNewBuffer.get();
+			}() };
+
+		return *pBuffer;
+	}
+
+	// Write a string to the trace with quotes and backslashes escaped
+	void WriteEscaped(std::ofstream& file, const char* pText)
+	{
+		for (; *pText != '\0'; ++pText)
+		{
+			if (*pText == '"' || *pText == '\\')
+				file << '\\';
+
+			file << *pText;
+		}
+	}
+}
+
+uint64_t DDM::Profiler::Detail::GetTimestamp()
+{
+	// Timestamps start at the first call, so they stay small in the trace
+	static const auto epoch{ std::chrono::steady_clock::now() };
+
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void DDM::Profiler::Detail::WriteMarker(const char* pName, uint64_t start, uint64_t end)
+{
+	auto& buffer{ GetThreadBuffer() };
+
+	// Only this thread writes the index, the release makes the marker visible to the exporting thread
+	const uint64_t index{ buffer.WriteIndex.load(std::memory_order_relaxed) };
+	auto& marker{ buffer.pMarkers[index & (kBufferSize - 1)] };
+
+	// Mark the slot as busy before overwriting it, the fence keeps the fields from being written before the mark
+	marker.Sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	marker.pName.store(pName, std::memory_order_relaxed);
+	marker.Start.store(start, std::memory_order_relaxed);
+	marker.End.store(end, std::memory_order_relaxed);
+
+	marker.Sequence.store(index + 1, std::memory_order_release);
+	buffer.WriteIndex.store(index + 1, std::memory_order_release);
+}
+
+void DDM::Profiler::BeginCapture()
+{
+	g_CaptureStart.store(Detail::GetTimestamp(), std::memory_order_relaxed);
+	Detail::g_Capturing.store(true, std::memory_order_relaxed);
+}
+
+bool DDM::Profiler::EndCapture(const std::string& fileName)
+{
+	Detail::g_Capturing.store(false, std::memory_order_relaxed);
+
+	std::ofstream file{ fileName };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open trace file " << fileName << "\n";
+		return false;
+	}
+
+	const uint64_t captureStart{ g_CaptureStart.load(std::memory_order_relaxed) };
+
+	// Amount of markers written to the file
+	size_t markerCount{};
+
+	// Chrome trace timestamps are in microseconds
+	file << std::fixed << std::setprecision(3);
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	bool isFirst{ true };
+
+	std::lock_guard lock{ g_BuffersMutex };
+
+	for (const auto& pBuffer : g_pBuffers)
+	{
+		// Name the thread
+		if (const char* pName{ pBuffer->pName.load(std::memory_order_relaxed) }; pName != nullptr)
+		{
+			file << (isFirst ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << pBuffer->ThreadId << ",\"args\":{\"name\":\"";
+			WriteEscaped(file, pName);
+			file << "\"}}";
+
+			isFirst = false;
+		}
+
+		// Only the last kBufferSize markers are still in the buffer
+		const uint64_t writeIndex{ pBuffer->WriteIndex.load(std::memory_order_acquire) };
+		const uint64_t firstIndex{ writeIndex > kBufferSize ? writeIndex - kBufferSize : 0 };
+
+		for (uint64_t index{ firstIndex }; index < writeIndex; ++index)
+		{
+			const Marker& marker{ pBuffer->pMarkers[index & (kBufferSize - 1)] };
+
+			// Scopes that started before the capture ended can still write markers and wrap around the buffer,
+			// skip the marker if it is being written or was overwritten by a newer one
+			if (marker.Sequence.load(std::memory_order_acquire) != index + 1)
+				continue;
+
+			const char* pName{ marker.pName.load(std::memory_order_relaxed) };
+			const uint64_t start{ marker.Start.load(std::memory_order_relaxed) };
+			const uint64_t end{ marker.End.load(std::memory_order_relaxed) };
+
+			// Drop the marker if it changed while it was read
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (marker.Sequence.load(std::memory_order_relaxed) != index + 1)
+				continue;
+
+			// Skip markers of earlier captures
+			if (start < captureStart)
+				continue;
+
+			file << (isFirst ? "" : ",\n") << "{\"name\":\"";
+			WriteEscaped(file, pName);
+			file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << pBuffer->ThreadId
+				<< ",\"ts\":" << static_cast<double>(start) / 1000.0
+				<< ",\"dur\":" << static_cast<double>(end - start) / 1000.0 << "}";
+
+			isFirst = false;
+			++markerCount;
+		}
+	}
+
+	file << "\n]}\n";
+
+	std::cout << "Wrote " << markerCount << " profiler markers to " << fileName << "\n";
+
+	return true;
+}
+
+bool DDM::Profiler::IsCapturing()
+{
+	return Detail::g_Capturing.load(std::memory_order_relaxed);
+}
+
+void DDM::Profiler::SetThreadName(const char* pName)
+{
+	GetThreadBuffer().pName.store(pName, std::memory_order_relaxed);
+}
+
+#else
+
+void DDM::Profiler::BeginCapture()
+{
+}
+
+bool DDM::Profiler::EndCapture(const std::string&)
+{
+	return false;
+}
+
+bool DDM::Profiler::IsCapturing()
+{
+	return false;
+}
+
+void DDM::Profiler::SetThreadName(const char*)
+{
+}
+
+#endif
@@ -0,0 +1,132 @@
+// Profiler.h
+// This file contains scoped cpu profiling markers that can be exported as a chrome trace
+// Every thread writes its markers to its own ring buffer, so recording takes no locks
+// Markers are only recorded while a capture is running, open the exported file in chrome://tracing or ui.perfetto.dev
+// The markers are only compiled in when DDM_ENABLE_PROFILING is defined, otherwise all macros expand to nothing
+
+#ifndef ProfilerIncluded
+#define ProfilerIncluded
+
+// Standard library includes
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace DDM
+{
+	namespace Profiler
+	{
+		// Start recording markers, markers of a previous capture are discarded
+		void BeginCapture();
+
+		// Stop recording markers and write them to a file
+		// Parameters:
+		//     fileName: name of the chrome trace json file
+		// Returns true if the file was written
+		bool EndCapture(const std::string& fileName);
+
+		// Check if markers are being recorded
+		bool IsCapturing();
+
+		// Set the name of the calling thread shown in the trace
+		// Parameters:
+		//     pName: name of the thread, has to stay valid for the lifetime of the program
+		void SetThreadName(const char* pName);
+
+		// Check if the profiler is compiled in
+		constexpr bool IsEnabled()
+		{
+#ifdef DDM_ENABLE_PROFILING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+#ifdef DDM_ENABLE_PROFILING
+		namespace Detail
+		{
+			// Indicates markers are recorded, checked by every marker so kept outside of the source file
+			inline std::atomic<bool> g_Capturing{ false };
+
+			// Get the time since the profiler started in nanoseconds
+			uint64_t GetTimestamp();
+
+			// Write a marker to the ring buffer of the calling thread
+			// Parameters:
+			//     pName: name of the marker, has to stay valid for the lifetime of the program
+			//     start: start time in nanoseconds
+			//     end: end time in nanoseconds
+			void WriteMarker(const char* pName, uint64_t start, uint64_t end);
+		}
+
+		// Records the time between its construction and destruction
+		class Scope final
+		{
+		public:
+			// Constructor
+			// Parameters:
+			//     pName: name of the marker, has to stay valid for the lifetime of the program
+			explicit Scope(const char* pName)
+				:m_pName{ pName }
+			{
+				// Only pay for the timestamps while capturing
+				if (Detail::g_Capturing.load(std::memory_order_relaxed))
+				{
+					m_Start = Detail::GetTimestamp();
+					m_IsRecording = true;
+				}
+			}
+
+			// Destructor
+			~Scope()
+			{
+				if (m_IsRecording)
+				{
+					Detail::WriteMarker(m_pName, m_Start, Detail::GetTimestamp());
+				}
+			}
+
+			// Rule of five
+			Scope(const Scope& other) = delete;
+			Scope(Scope&& other) = delete;
+			Scope& operator=(const Scope& other) = delete;
+			Scope& operator=(Scope&& other) = delete;
+
+		private:
+			// Name of the marker
+			const char* m_pName{};
+
+			// Start time in nanoseconds
+			uint64_t m_Start{};
+
+			// Indicates a capture was running when the scope started
+			bool m_IsRecording{ false };
+		};
+#endif
+	}
+}
+
+#ifdef DDM_ENABLE_PROFILING
+
+#define DDM_PROFILE_CONCAT_INNER(a, b) a##b
+#define DDM_PROFILE_CONCAT(a, b) DDM_PROFILE_CONCAT_INNER(a, b)
+
+// Record the time until the end of the current scope, the name has to be a string literal
+#define DDM_PROFILE_SCOPE(name) ::DDM::Profiler::Scope DDM_PROFILE_CONCAT(ddmProfileScope, __LINE__){ name }
+
+// Record the time until the end of the current function
+#define DDM_PROFILE_FUNCTION() DDM_PROFILE_SCOPE(__FUNCTION__)
+
+// Name the calling thread in the trace, the name has to be a string literal
+#define DDM_PROFILE_THREAD(name) ::DDM::Profiler::SetThreadName(name)
+
+#else
+
+#define DDM_PROFILE_SCOPE(name)
+#define DDM_PROFILE_FUNCTION()
+#define DDM_PROFILE_THREAD(name)
+
+#endif
+
+#endif // !ProfilerIncluded
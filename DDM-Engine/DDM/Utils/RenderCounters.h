@@ -0,0 +1,116 @@
+// RenderCounters.h
+// This file counts the draw calls, binds and descriptor updates issued while recording a frame
+// The counts of the last finished frame are shown in the info panel and written with every frame of a benchmark,
+// so a change that breaks batching shows up as a jump in draws or binds
+
+#ifndef RenderCountersIncluded
+#define RenderCountersIncluded
+
+// Standard library includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace DDM
+{
+	// Every counted render operation
+	enum class RenderCounter
+	{
+		DrawCalls,
+		Instances,
+		Indices,
+		PipelineBinds,
+		DescriptorSetBinds,
+		VertexBufferBinds,
+		IndexBufferBinds,
+		DescriptorUpdates,
+		Count
+	};
+
+	namespace RenderCounters
+	{
+		// Amount of counters
+		constexpr size_t kCounterCount{ static_cast<size_t>(RenderCounter::Count) };
+
+		// The value of every counter
+		using Values = std::array<uint64_t, kCounterCount>;
+
+		namespace Detail
+		{
+			// Counts of the current frame
+			inline std::array<std::atomic<uint64_t>, kCounterCount> g_FrameCounters{};
+
+			// Counts of the last finished frame
+			inline std::array<std::atomic<uint64_t>, kCounterCount> g_LastFrameCounters{};
+		}
+
+		// Count render operations in the current frame
+		// Parameters:
+		//     counter: the counted operation
+		//     count: the amount of operations
+		inline void Add(RenderCounter counter, uint64_t count = 1)
+		{
+			Detail::g_FrameCounters[static_cast<size_t>(counter)].fetch_add(count, std::memory_order_relaxed);
+		}
+
+		// Finish the current frame, called once per frame by the engine loop
+		inline void EndFrame()
+		{
+			for (size_t index{}; index < kCounterCount; ++index)
+			{
+				Detail::g_LastFrameCounters[index].store(Detail::g_FrameCounters[index].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		// Get a count of the last finished frame
+		// Parameters:
+		//     counter: the requested operation
+		inline uint64_t GetLastFrame(RenderCounter counter)
+		{
+			return Detail::g_LastFrameCounters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+		}
+
+		// Get every count of the last finished frame
+		inline Values GetLastFrame()
+		{
+			Values values{};
+
+			for (size_t index{}; index < kCounterCount; ++index)
+			{
+				values[index] = Detail::g_LastFrameCounters[index].load(std::memory_order_relaxed);
+			}
+
+			return values;
+		}
+
+		// Get the display name of a counter
+		// Parameters:
+		//     counter: the requested operation
+		constexpr const char* GetName(RenderCounter counter)
+		{
+			switch (counter)
+			{
+			case RenderCounter::DrawCalls:
+				return "DrawCalls";
+			case RenderCounter::Instances:
+				return "Instances";
+			case RenderCounter::Indices:
+				return "Indices";
+			case RenderCounter::PipelineBinds:
+				return "PipelineBinds";
+			case RenderCounter::DescriptorSetBinds:
+				return "DescriptorSetBinds";
+			case RenderCounter::VertexBufferBinds:
+				return "VertexBufferBinds";
+			case RenderCounter::IndexBufferBinds:
+				return "IndexBufferBinds";
+			case RenderCounter::DescriptorUpdates:
+				return "DescriptorUpdates";
+			default:
+				return "Unknown";
+			}
+		}
+	}
+}
+
+#endif // !RenderCountersIncluded
@@ -0,0 +1,81 @@
+// ResourceTracker.cpp
+
+// Header include
+#include "ResourceTracker.h"
+
+// Standard library includes
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	// A tracked device memory allocation
+	struct Allocation
+	{
+		VkDeviceSize Size{};
+		uint32_t MemoryTypeIndex{};
+	};
+
+	// Every live allocation and the bytes per memory type
+	struct AllocationTable
+	{
+		std::mutex Mutex{};
+		std::unordered_map<VkDeviceMemory, Allocation> Allocations{};
+		std::array<std::atomic<uint64_t>, VK_MAX_MEMORY_TYPES> AllocatedBytes{};
+	};
+
+	// Memory is freed from singleton destructors, so the table is never destroyed to outlive all of them
+	AllocationTable& GetTable()
+	{
+		static AllocationTable* pTable{ new AllocationTable{} };
+		return *pTable;
+	}
+}
+
+void DDM::ResourceTracker::TrackAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex)
+{
+	if (memory == VK_NULL_HANDLE || memoryTypeIndex >= VK_MAX_MEMORY_TYPES)
+		return;
+
+	auto& table{ GetTable() };
+
+	std::lock_guard lock{ table.Mutex };
+
+	table.Allocations[memory] = Allocation{ size, memoryTypeIndex };
+	table.AllocatedBytes[memoryTypeIndex].fetch_add(size, std::memory_order_relaxed);
+}
+
+void DDM::ResourceTracker::UntrackAllocation(VkDeviceMemory memory)
+{
+	if (memory == VK_NULL_HANDLE)
+		return;
+
+	auto& table{ GetTable() };
+
+	std::lock_guard lock{ table.Mutex };
+
+	auto it{ table.Allocations.find(memory) };
+
+	if (it == table.Allocations.end())
+		return;
+
+	table.AllocatedBytes[it->second.MemoryTypeIndex].fetch_sub(it->second.Size, std::memory_order_relaxed);
+	table.Allocations.erase(it);
+}
+
+uint64_t DDM::ResourceTracker::GetAllocatedBytes(uint32_t memoryTypeIndex)
+{
+	if (memoryTypeIndex >= VK_MAX_MEMORY_TYPES)
+		return 0;
+
+	return GetTable().AllocatedBytes[memoryTypeIndex].load(std::memory_order_relaxed);
+}
+
+uint64_t DDM::ResourceTracker::GetAllocationCount()
+{
+	auto& table{ GetTable() };
+
+	std::lock_guard lock{ table.Mutex };
+
+	return table.Allocations.size();
+}
@@ -0,0 +1,105 @@
+// ResourceTracker.h
+// This file keeps track of the vulkan objects and device memory the engine has alive
+// The counts are shown by the telemetry manager and its device memory is the fallback when VK_EXT_memory_budget is missing
+// Objects are tracked where they are created and destroyed, which never happens in the per frame hot path
+
+#ifndef ResourceTrackerIncluded
+#define ResourceTrackerIncluded
+
+// File includes
+#include "Includes/VulkanIncludes.h"
+
+// Standard library includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace DDM
+{
+	// Every tracked kind of vulkan object
+	enum class TrackedResource
+	{
+		Buffers,
+		Images,
+		DescriptorSets,
+		Count
+	};
+
+	namespace ResourceTracker
+	{
+		// Amount of tracked kinds of objects
+		constexpr size_t kResourceCount{ static_cast<size_t>(TrackedResource::Count) };
+
+		namespace Detail
+		{
+			// Amount of live objects of every kind
+			inline std::array<std::atomic<int64_t>, kResourceCount> g_ResourceCounts{};
+		}
+
+		// Record created objects
+		// Parameters:
+		//     resource: the kind of object
+		//     count: the amount of objects
+		inline void Add(TrackedResource resource, int64_t count = 1)
+		{
+			Detail::g_ResourceCounts[static_cast<size_t>(resource)].fetch_add(count, std::memory_order_relaxed);
+		}
+
+		// Record destroyed objects
+		// Parameters:
+		//     resource: the kind of object
+		//     count: the amount of objects
+		inline void Remove(TrackedResource resource, int64_t count = 1)
+		{
+			Detail::g_ResourceCounts[static_cast<size_t>(resource)].fetch_sub(count, std::memory_order_relaxed);
+		}
+
+		// Get the amount of live objects of a kind
+		// Parameters:
+		//     resource: the kind of object
+		inline int64_t GetCount(TrackedResource resource)
+		{
+			return Detail::g_ResourceCounts[static_cast<size_t>(resource)].load(std::memory_order_relaxed);
+		}
+
+		// Get the display name of a kind of object
+		// Parameters:
+		//     resource: the kind of object
+		constexpr const char* GetName(TrackedResource resource)
+		{
+			switch (resource)
+			{
+			case TrackedResource::Buffers:
+				return "Buffers";
+			case TrackedResource::Images:
+				return "Images";
+			case TrackedResource::DescriptorSets:
+				return "DescriptorSets";
+			default:
+				return "Unknown";
+			}
+		}
+
+		// Record a device memory allocation
+		// Parameters:
+		//     memory: handle of the allocated memory
+		//     size: size of the allocation in bytes
+		//     memoryTypeIndex: the memory type the memory was allocated from
+		void TrackAllocation(VkDeviceMemory memory, VkDeviceSize size, uint32_t memoryTypeIndex);
+
+		// Record that device memory was freed, memory that was never tracked is ignored
+		// Parameters:
+		//     memory: handle of the freed memory
+		void UntrackAllocation(VkDeviceMemory memory);
+
+		// Get the amount of bytes allocated from a memory type
+		// Parameters:
+		//     memoryTypeIndex: the requested memory type
+		uint64_t GetAllocatedBytes(uint32_t memoryTypeIndex);
+
+		// Get the amount of live device memory allocations
+		uint64_t GetAllocationCount();
+	}
+}
+
+#endif // !ResourceTrackerIncluded
@@ -0,0 +1,142 @@
+// SlotTable.h
+// This file defines generational handles and the slot table that resolves them
+// A handle stays valid until the object it refers to is removed, after that it resolves to nullptr
+// even if the slot gets reused, because the generation of the slot no longer matches
+
+#ifndef SlotTableIncluded
+#define SlotTableIncluded
+
+// Standard library includes
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace DDM
+{
+	template <class T>
+	struct Handle final
+	{
+		// Index used for handles that don't refer to anything
+		static constexpr uint32_t kInvalidIndex{ std::numeric_limits<uint32_t>::max() };
+
+		// Index of the slot in the slot table
+		uint32_t index{ kInvalidIndex };
+
+		// Generation of the slot when the handle was created
+		uint32_t generation{};
+
+		/// <summary>
+		/// Check if the handle was ever assigned, does not check if the object still exists
+		/// </summary>
+		/// <returns>Boolean indicating if the handle is assigned</returns>
+		bool IsAssigned() const { return index != kInvalidIndex; }
+
+		/// <summary>
+		/// Compare two handles
+		/// </summary>
+		bool operator==(const Handle& other) const = default;
+	};
+
+	template <class T>
+	class SlotTable final
+	{
+	public:
+		/// <summary>
+		/// Default constructor
+		/// </summary>
+		SlotTable() = default;
+
+		/// <summary>
+		/// Default destructor
+		/// </summary>
+		~SlotTable() = default;
+
+		// Rule of five
+		SlotTable(const SlotTable& other) = delete;
+		SlotTable(SlotTable&& other) = delete;
+		SlotTable& operator=(const SlotTable& other) = delete;
+		SlotTable& operator=(SlotTable&& other) = delete;
+
+		/// <summary>
+		/// Add an object to the table
+		/// </summary>
+		/// <param name="pObject: ">Pointer to the object</param>
+		/// <returns>Handle to the object</returns>
+		Handle<T> Insert(T* pObject)
+		{
+			uint32_t index{};
+
+			// Reuse a free slot if there is one, otherwise add a new one
+			if (!m_FreeSlots.empty())
+			{
+				index = m_FreeSlots.back();
+				m_FreeSlots.pop_back();
+			}
+			else
+			{
+				index = static_cast<uint32_t>(m_Slots.size());
+				m_Slots.emplace_back();
+			}
+
+			m_Slots[index].pObject = pObject;
+
+			return Handle<T>{ index, m_Slots[index].generation };
+		}
+
+		/// <summary>
+		/// Remove an object from the table, all handles to it become invalid
+		/// </summary>
+		/// <param name="handle: ">Handle to the object</param>
+		void Remove(Handle<T> handle)
+		{
+			// If the handle is already invalid, return
+			if (Get(handle) == nullptr)
+			{
+				return;
+			}
+
+			// Clear the slot and bump its generation
+			auto& slot{ m_Slots[handle.index] };
+			slot.pObject = nullptr;
+			++slot.generation;
+
+			m_FreeSlots.push_back(handle.index);
+		}
+
+		/// <summary>
+		/// Resolve a handle
+		/// </summary>
+		/// <param name="handle: ">The handle to resolve</param>
+		/// <returns>Pointer to the object, nullptr if it no longer exists</returns>
+		T* Get(Handle<T> handle) const
+		{
+			if (handle.index >= m_Slots.size())
+			{
+				return nullptr;
+			}
+
+			const auto& slot{ m_Slots[handle.index] };
+
+			return slot.generation == handle.generation ? slot.pObject : nullptr;
+		}
+
+	private:
+		// Slot in the table
+		struct Slot
+		{
+			// Pointer to the object, nullptr if the slot is free
+			T* pObject{};
+
+			// Incremented every time the object in the slot is removed
+			uint32_t generation{};
+		};
+
+		// All slots
+		std::vector<Slot> m_Slots{};
+
+		// Indices of free slots
+		std::vector<uint32_t> m_FreeSlots{};
+	};
+}
+
+#endif // !SlotTableIncluded
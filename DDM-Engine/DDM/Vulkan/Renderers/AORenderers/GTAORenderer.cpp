@@ -6,6 +6,7 @@
 #include "Vulkan/VulkanUtils.h"
 #include "Vulkan/VulkanObject.h"
 #include "Vulkan/VulkanManagers/SyncObjectManager.h"
+#include "Vulkan/VulkanManagers/GpuProfiler.h"
 #include "Vulkan/VulkanWrappers/SwapchainWrapper.h"
 #include "Vulkan/VulkanWrappers/RenderpassWrapper.h"
 #include "Vulkan/VulkanWrappers/ImGuiWrapper.h"
@@ -30,6 +31,13 @@
 
 #include "DataTypes/DescriptorObjects/UboDescriptorObject.h"
 
+#include "Utils/Profiler.h"
+#include "Utils/RenderCounters.h"
+#include "Utils/ResourceTracker.h"
+
+// Standard library includes
+#include <algorithm>
+
 DDM::GTAORenderer::GTAORenderer()
 {
 	auto surface{ VulkanObject::GetInstance().GetSurface() };
@@ -73,16 +81,20 @@ DDM::GTAORenderer::~GTAORenderer()
 
 	vkDestroyDescriptorSetLayout(device, m_LightingDescriptorSetLayout, nullptr);
 
+	// Destroying the pool frees its descriptor sets
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_LightingDescriptorSets.size()));
 	vkDestroyDescriptorPool(device, m_LightingDescriptorPool, nullptr);
 
 
 	vkDestroyDescriptorSetLayout(device, m_AoBlurDescriptorSetLayout, nullptr);
 
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoBlurDescriptorSets.size()));
 	vkDestroyDescriptorPool(device, m_AoBlurDescriptorPool, nullptr);
 
 
 	vkDestroyDescriptorSetLayout(device, m_AoGenDescriptorSetLayout, nullptr);
 
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoGenDescriptorSets.size()));
 	vkDestroyDescriptorPool(device, m_AoGenDescriptorPool, nullptr);
 }
 
@@ -96,12 +108,12 @@ void DDM::GTAORenderer::Render()
 	auto device{ vulkanObject.GetDevice() };
 	auto& queueObject{ vulkanObject.GetQueueObject() };
 
-	vkWaitForFences(device, 1, &m_pSyncObjectManager->GetInFlightFence(currentFrame), VK_TRUE, UINT64_MAX);
+	// The engine loop already waited before sampling input, so this only waits when rendering outside of it
+	vulkanObject.WaitForFrame();
 
 
 	uint32_t imageIndex{};
-	VkResult result = vkAcquireNextImageKHR(device, m_pSwapchainWrapper->GetSwapchain(),
-		UINT64_MAX, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), VK_NULL_HANDLE, &imageIndex);
+	VkResult result = m_pSwapchainWrapper->AcquireNextImage(device, queueObject.graphicsQueue, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), imageIndex);
 
 
 	//SetNewSamples(currentFrame, imageIndex);
@@ -148,25 +160,13 @@ void DDM::GTAORenderer::Render()
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
 
-	VkPresentInfoKHR presentInfo{};
-	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-	presentInfo.waitSemaphoreCount = 1;
-	presentInfo.pWaitSemaphores = signalSemaphores;
-
-	VkSwapchainKHR swapChains[] = { m_pSwapchainWrapper->GetSwapchain() };
-	presentInfo.swapchainCount = 1;
-	presentInfo.pSwapchains = swapChains;
-	presentInfo.pImageIndices = &imageIndex;
-
-	presentInfo.pResults = nullptr;
-
-	result = vkQueuePresentKHR(queueObject.presentQueue, &presentInfo);
+	// Present the image, or signal the end of the frame when rendering offscreen
+	result = m_pSwapchainWrapper->Present(queueObject.presentQueue, signalSemaphores[0], imageIndex);
 
 
 	auto& window{ Window::GetInstance().GetWindowStruct() };
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized)
+	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized || m_pSwapchainWrapper->NeedsRecreation())
 	{
 		RecreateSwapChain();
 		window.FrameBufferResized = false;
@@ -187,6 +187,11 @@ DDM::RenderpassWrapper* DDM::GTAORenderer::GetDefaultRenderpass()
 	return m_pRenderpass.get();
 }
 
+VkFence DDM::GTAORenderer::GetInFlightFence(uint32_t frame)
+{
+	return m_pSyncObjectManager->GetInFlightFence(frame);
+}
+
 void DDM::GTAORenderer::AddDefaultPipelines()
 {
 	// Get config manager
@@ -767,8 +772,8 @@ void DDM::GTAORenderer::InitImgui()
 	init_info.Allocator = VK_NULL_HANDLE;
 	// Set min image count to the minimum image count of the swapchain
 	init_info.MinImageCount = m_pSwapchainWrapper->GetMinImageCount();
-	// Set the image count to the max amount of frames in flight
-	init_info.ImageCount = static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames());
+	// Set the image count to the max amount of frames in flight, imgui needs at least the minimum image count
+	init_info.ImageCount = std::max(static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames()), init_info.MinImageCount);
 	// Give functoin for error handling
 	init_info.CheckVkResultFn = [](VkResult /*err*/) { /* error handling */ };
 	// Give the max amount of samples per mixel
@@ -791,6 +796,8 @@ void DDM::GTAORenderer::CleanupImgui()
 
 void DDM::GTAORenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint32_t imageIndex)
 {
+	DDM_PROFILE_FUNCTION();
+
 	auto frame = VulkanObject::GetInstance().GetCurrentFrame();
 
 	VkCommandBufferBeginInfo beginInfo{};
@@ -802,6 +809,12 @@ void DDM::GTAORenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint
 	{
 		throw std::runtime_error("failed to begin recording command buffer!");
 	}
+
+	auto pGpuProfiler{ VulkanObject::GetInstance().GetGpuProfiler() };
+
+	// Collect the gpu timings of the previous use of this frame and start measuring
+	pGpuProfiler->BeginFrame(commandBuffer, frame);
+
 	auto extent{ m_pSwapchainWrapper->GetExtent() };
 
 	VkViewport viewport{};
@@ -820,54 +833,78 @@ void DDM::GTAORenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint
 
 	// Depth prepass
 	m_pRenderpass->BeginRenderPass(commandBuffer, m_pSwapchainWrapper->GetFrameBuffer(imageIndex, m_pRenderpass.get()), extent);
+	pGpuProfiler->BeginScope(commandBuffer, "Depth");
 
 	SceneManager::GetInstance().RenderDepth();
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	// G-buffer pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "G-buffer");
 
 	SceneManager::GetInstance().Render();
 
 	SceneManager::GetInstance().RenderTransparancy();
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	// AO Map pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "AO generation");
 
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pAoPipeline->GetPipeline());
+	RenderCounters::Add(RenderCounter::PipelineBinds);
 
 	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pAoPipeline->GetPipelineLayout(), 0, 1,
 		&m_AoGenDescriptorSets[frame], 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorSetBinds);
 
 	VulkanObject::GetInstance().DrawQuad(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	// AO Blur pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "AO blur");
 
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pAoBlurPipeline->GetPipeline());
+	RenderCounters::Add(RenderCounter::PipelineBinds);
 
 	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pAoBlurPipeline->GetPipelineLayout(), 0, 1,
 		&m_AoBlurDescriptorSets[frame], 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorSetBinds);
 
 	VulkanObject::GetInstance().DrawQuad(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 
 	// Lighting pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "Lighting");
 
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pLightingPipeline->GetPipeline());
+	RenderCounters::Add(RenderCounter::PipelineBinds);
 
 	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pLightingPipeline->GetPipelineLayout(), 0, 1,
 		&m_LightingDescriptorSets[frame], 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorSetBinds);
 
 	VulkanObject::GetInstance().DrawQuad(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 
 	// ImgGui pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "ImGui");
 
 	// Render the ImGui
 	m_pImGuiWrapper->Render(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	vkCmdEndRenderPass(commandBuffer);
 
 	VkImage swapchainImage = m_pSwapchainWrapper->GetSwapchainImage(imageIndex);
@@ -898,6 +935,8 @@ void DDM::GTAORenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint
 	);
 
 
+	pGpuProfiler->EndFrame(commandBuffer);
+
 	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to record command buffer!");
@@ -942,10 +981,13 @@ void DDM::GTAORenderer::RecreateSwapChain()
 void DDM::GTAORenderer::ResetDescriptorSets()
 {
 	vkFreeDescriptorSets(VulkanObject::GetInstance().GetDevice(), m_LightingDescriptorPool, static_cast<uint32_t>(m_LightingDescriptorSets.size()), m_LightingDescriptorSets.data());
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_LightingDescriptorSets.size()));
 
 	vkFreeDescriptorSets(VulkanObject::GetInstance().GetDevice(), m_AoGenDescriptorPool, static_cast<uint32_t>(m_AoGenDescriptorSets.size()), m_AoGenDescriptorSets.data());
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoGenDescriptorSets.size()));
 
 	vkFreeDescriptorSets(VulkanObject::GetInstance().GetDevice(), m_AoBlurDescriptorPool, static_cast<uint32_t>(m_AoBlurDescriptorSets.size()), m_AoBlurDescriptorSets.data());
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoBlurDescriptorSets.size()));
 
 	SetupDescriptorObjects();
 
@@ -1278,6 +1320,8 @@ void DDM::GTAORenderer::CreateAoGenDescriptorSets()
 	{
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
+
+	ResourceTracker::Add(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoGenDescriptorSets.size()));
 }
 
 void DDM::GTAORenderer::CreateAoBlurDescriptorSets()
@@ -1308,6 +1352,8 @@ void DDM::GTAORenderer::CreateAoBlurDescriptorSets()
 	{
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
+
+	ResourceTracker::Add(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AoBlurDescriptorSets.size()));
 }
 
 void DDM::GTAORenderer::CreateLightingDescriptorSets()
@@ -1338,6 +1384,8 @@ void DDM::GTAORenderer::CreateLightingDescriptorSets()
 	{
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
+
+	ResourceTracker::Add(TrackedResource::DescriptorSets, static_cast<int64_t>(m_LightingDescriptorSets.size()));
 }
 
 void DDM::GTAORenderer::UpdateDescriptorSets(int frame, int swapchainIndex)
@@ -1352,7 +1400,7 @@ void DDM::GTAORenderer::UpdateDescriptorSets(int frame, int swapchainIndex)
 void DDM::GTAORenderer::UpdateAoGenDescriptorSets(int frame, int swapchainIndex)
 {
 	// Create a vector of descriptor writes
-	std::vector<VkWriteDescriptorSet> descriptorWrites{};
+	FrameVector<VkWriteDescriptorSet> descriptorWrites{};
 
 	// Initialize current binding with 0
 	int binding{};
@@ -1373,12 +1421,13 @@ void DDM::GTAORenderer::UpdateAoGenDescriptorSets(int frame, int swapchainIndex)
 	//vkDeviceWaitIdle(VulkanRenderer::GetInstance().GetDevice());
 	// Update descriptorsets
 	vkUpdateDescriptorSets(VulkanObject::GetInstance().GetDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorUpdates, descriptorWrites.size());
 }
 
 void DDM::GTAORenderer::UpdateAoBlurDescriptorSets(int frame, int swapchainIndex)
 {
 	// Create a vector of descriptor writes
-	std::vector<VkWriteDescriptorSet> descriptorWrites{};
+	FrameVector<VkWriteDescriptorSet> descriptorWrites{};
 
 	// Initialize current binding with 0
 	int binding{};
@@ -1393,13 +1442,14 @@ void DDM::GTAORenderer::UpdateAoBlurDescriptorSets(int frame, int swapchainIndex
 	//vkDeviceWaitIdle(VulkanRenderer::GetInstance().GetDevice());
 	// Update descriptorsets
 	vkUpdateDescriptorSets(VulkanObject::GetInstance().GetDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorUpdates, descriptorWrites.size());
 
 }
 
 void DDM::GTAORenderer::UpdateLightingDescriptorSets(int frame)
 {
 	// Create a vector of descriptor writes
-	std::vector<VkWriteDescriptorSet> descriptorWrites{};
+	FrameVector<VkWriteDescriptorSet> descriptorWrites{};
 
 	// Initialize current binding with 0
 	int binding{};
@@ -1422,4 +1472,5 @@ void DDM::GTAORenderer::UpdateLightingDescriptorSets(int frame)
 	//vkDeviceWaitIdle(VulkanRenderer::GetInstance().GetDevice());
 	// Update descriptorsets
 	vkUpdateDescriptorSets(VulkanObject::GetInstance().GetDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorUpdates, descriptorWrites.size());
 }
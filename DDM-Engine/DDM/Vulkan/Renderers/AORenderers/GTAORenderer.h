@@ -44,6 +44,8 @@ namespace DDM
 
 		virtual RenderpassWrapper* GetDefaultRenderpass() override;
 
+		virtual VkFence GetInFlightFence(uint32_t frame) override;
+
 		virtual void AddDefaultPipelines();
 
 	private:
@@ -6,6 +6,7 @@
 #include "Vulkan/VulkanUtils.h"
 #include "Vulkan/VulkanObject.h"
 #include "Vulkan/VulkanManagers/SyncObjectManager.h"
+#include "Vulkan/VulkanManagers/GpuProfiler.h"
 #include "Vulkan/VulkanWrappers/SwapchainWrapper.h"
 #include "Vulkan/VulkanWrappers/RenderpassWrapper.h"
 #include "Vulkan/VulkanWrappers/ImGuiWrapper.h"
@@ -23,6 +24,13 @@
 
 #include "Managers/ConfigManager.h"
 
+#include "Utils/Profiler.h"
+#include "Utils/RenderCounters.h"
+#include "Utils/ResourceTracker.h"
+
+// Standard library includes
+#include <algorithm>
+
 DDM::DeferredRenderer::DeferredRenderer()
 {
 	auto surface{ VulkanObject::GetInstance().GetSurface() };
@@ -64,6 +72,8 @@ DDM::DeferredRenderer::~DeferredRenderer()
 
 	vkDestroyDescriptorSetLayout(device, m_DescriptorSetLayout, nullptr);
 
+	// Destroying the pool frees its descriptor sets
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_DescriptorSets.size()));
 	vkDestroyDescriptorPool(device, m_DescriptorPool, nullptr);
 }
 
@@ -76,11 +86,11 @@ void DDM::DeferredRenderer::Render()
 	auto device{ vulkanObject.GetDevice() };
 	auto& queueObject{ vulkanObject.GetQueueObject() };
 
-	vkWaitForFences(device, 1, &m_pSyncObjectManager->GetInFlightFence(currentFrame), VK_TRUE, UINT64_MAX);
+	// The engine loop already waited before sampling input, so this only waits when rendering outside of it
+	vulkanObject.WaitForFrame();
 
 	uint32_t imageIndex{};
-	VkResult result = vkAcquireNextImageKHR(device, m_pSwapchainWrapper->GetSwapchain(),
-		UINT64_MAX, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), VK_NULL_HANDLE, &imageIndex);
+	VkResult result = m_pSwapchainWrapper->AcquireNextImage(device, queueObject.graphicsQueue, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), imageIndex);
 
 	if (result == VK_ERROR_OUT_OF_DATE_KHR)
 	{
@@ -120,25 +130,13 @@ void DDM::DeferredRenderer::Render()
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
 
-	VkPresentInfoKHR presentInfo{};
-	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-	presentInfo.waitSemaphoreCount = 1;
-	presentInfo.pWaitSemaphores = signalSemaphores;
-
-	VkSwapchainKHR swapChains[] = { m_pSwapchainWrapper->GetSwapchain() };
-	presentInfo.swapchainCount = 1;
-	presentInfo.pSwapchains = swapChains;
-	presentInfo.pImageIndices = &imageIndex;
-
-	presentInfo.pResults = nullptr;
-
-	result = vkQueuePresentKHR(queueObject.presentQueue, &presentInfo);
+	// Present the image, or signal the end of the frame when rendering offscreen
+	result = m_pSwapchainWrapper->Present(queueObject.presentQueue, signalSemaphores[0], imageIndex);
 
 
 	auto& window{ Window::GetInstance().GetWindowStruct() };
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized)
+	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized || m_pSwapchainWrapper->NeedsRecreation())
 	{
 		RecreateSwapChain();
 		window.FrameBufferResized = false;
@@ -159,6 +157,11 @@ DDM::RenderpassWrapper* DDM::DeferredRenderer::GetDefaultRenderpass()
 	return m_pRenderpass.get();
 }
 
+VkFence DDM::DeferredRenderer::GetInFlightFence(uint32_t frame)
+{
+	return m_pSyncObjectManager->GetInFlightFence(frame);
+}
+
 void DDM::DeferredRenderer::AddDefaultPipelines()
 {
 	// Get config manager
@@ -522,8 +525,8 @@ void DDM::DeferredRenderer::InitImgui()
 	init_info.Allocator = VK_NULL_HANDLE;
 	// Set min image count to the minimum image count of the swapchain
 	init_info.MinImageCount = m_pSwapchainWrapper->GetMinImageCount();
-	// Set the image count to the max amount of frames in flight
-	init_info.ImageCount = static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames());
+	// Set the image count to the max amount of frames in flight, imgui needs at least the minimum image count
+	init_info.ImageCount = std::max(static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames()), init_info.MinImageCount);
 	// Give functoin for error handling
 	init_info.CheckVkResultFn = [](VkResult /*err*/) { /* error handling */ };
 	// Give the max amount of samples per mixel
@@ -546,6 +549,8 @@ void DDM::DeferredRenderer::CleanupImgui()
 
 void DDM::DeferredRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint32_t imageIndex)
 {
+	DDM_PROFILE_FUNCTION();
+
 	auto frame = VulkanObject::GetInstance().GetCurrentFrame();
 
 	VkCommandBufferBeginInfo beginInfo{};
@@ -557,6 +562,12 @@ void DDM::DeferredRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer,
 	{
 		throw std::runtime_error("failed to begin recording command buffer!");
 	}
+
+	auto pGpuProfiler{ VulkanObject::GetInstance().GetGpuProfiler() };
+
+	// Collect the gpu timings of the previous use of this frame and start measuring
+	pGpuProfiler->BeginFrame(commandBuffer, frame);
+
 	auto extent{ m_pSwapchainWrapper->GetExtent() };
 
 	VkViewport viewport{};
@@ -573,34 +584,51 @@ void DDM::DeferredRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer,
 	scissor.extent = extent;
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-	
+	// Depth prepass
 	m_pRenderpass->BeginRenderPass(commandBuffer, m_pSwapchainWrapper->GetFrameBuffer(imageIndex, m_pRenderpass.get()), extent);
+	pGpuProfiler->BeginScope(commandBuffer, "Depth");
 
 
 	SceneManager::GetInstance().RenderDepth();
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 
+	// G-buffer pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "G-buffer");
 
 	SceneManager::GetInstance().Render();
 
 	SceneManager::GetInstance().RenderTransparancy();
 
+	pGpuProfiler->EndScope(commandBuffer);
 
+
+	// Lighting pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "Lighting");
 
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pLightingPipeline->GetPipeline());
+	RenderCounters::Add(RenderCounter::PipelineBinds);
 
 	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pLightingPipeline->GetPipelineLayout(), 0, 1,
 		&m_DescriptorSets[frame], 0, nullptr);
+	RenderCounters::Add(RenderCounter::DescriptorSetBinds);
 
 	VulkanObject::GetInstance().DrawQuad(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
+	// ImGui pass
 	vkCmdNextSubpass(commandBuffer, VK_SUBPASS_CONTENTS_INLINE);
+	pGpuProfiler->BeginScope(commandBuffer, "ImGui");
 
 	// Render the ImGui
 	m_pImGuiWrapper->Render(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	vkCmdEndRenderPass(commandBuffer);
 
 	VkImage swapchainImage = m_pSwapchainWrapper->GetSwapchainImage(imageIndex);
@@ -631,6 +659,8 @@ void DDM::DeferredRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer,
 	);
 
 
+	pGpuProfiler->EndFrame(commandBuffer);
+
 	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to record command buffer!");
@@ -675,6 +705,7 @@ void DDM::DeferredRenderer::RecreateSwapChain()
 void DDM::DeferredRenderer::ResetDescriptorSets()
 {
 	vkFreeDescriptorSets(VulkanObject::GetInstance().GetDevice(), m_DescriptorPool, static_cast<uint32_t>(m_DescriptorSets.size()), m_DescriptorSets.data());
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_DescriptorSets.size()));
 
 	SetupDescriptorObjects();
 
@@ -788,13 +819,14 @@ void DDM::DeferredRenderer::CreateDescriptorSets()
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
 
+	ResourceTracker::Add(TrackedResource::DescriptorSets, static_cast<int64_t>(m_DescriptorSets.size()));
 
 
 	// Loop trough all the descriptor sets
 	for (int i{}; i < static_cast<int>(m_DescriptorSets.size()); i++)
 	{
 		// Create a vector of descriptor writes
-		std::vector<VkWriteDescriptorSet> descriptorWrites{};
+		FrameVector<VkWriteDescriptorSet> descriptorWrites{};
 
 		// Initialize current binding with 0
 		int binding{};
@@ -809,5 +841,6 @@ void DDM::DeferredRenderer::CreateDescriptorSets()
 		//vkDeviceWaitIdle(VulkanRenderer::GetInstance().GetDevice());
 		// Update descriptorsets
 		vkUpdateDescriptorSets(VulkanObject::GetInstance().GetDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+		RenderCounters::Add(RenderCounter::DescriptorUpdates, descriptorWrites.size());
 	}
 }
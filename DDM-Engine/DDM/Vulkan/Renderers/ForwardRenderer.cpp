@@ -9,6 +9,7 @@
 #include "Vulkan/VulkanUtils.h"
 #include "Vulkan/VulkanObject.h"
 #include "Vulkan/VulkanManagers/SyncObjectManager.h"
+#include "Vulkan/VulkanManagers/GpuProfiler.h"
 #include "Vulkan/VulkanWrappers/SwapchainWrapper.h"
 #include "Vulkan/VulkanWrappers/RenderpassWrapper.h"
 #include "Vulkan/VulkanWrappers/ImGuiWrapper.h"
@@ -22,6 +23,11 @@
 
 #include "Engine/Window.h"
 
+#include "Utils/Profiler.h"
+
+// Standard library includes
+#include <algorithm>
+
 DDM::ForwardRenderer::ForwardRenderer()
 {
 	auto surface{ VulkanObject::GetInstance().GetSurface() };
@@ -61,11 +67,11 @@ void DDM::ForwardRenderer::Render()
 	auto device{ vulkanObject.GetDevice() };
 	auto& queueObject{ vulkanObject.GetQueueObject() };
 
-	vkWaitForFences(device, 1, &m_pSyncObjectManager->GetInFlightFence(currentFrame), VK_TRUE, UINT64_MAX);
+	// The engine loop already waited before sampling input, so this only waits when rendering outside of it
+	vulkanObject.WaitForFrame();
 
 	uint32_t imageIndex{};
-	VkResult result = vkAcquireNextImageKHR(device, m_pSwapchainWrapper->GetSwapchain(),
-		UINT64_MAX, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), VK_NULL_HANDLE, &imageIndex);
+	VkResult result = m_pSwapchainWrapper->AcquireNextImage(device, queueObject.graphicsQueue, m_pSyncObjectManager->GetImageAvailableSemaphore(currentFrame), imageIndex);
 
 	if (result == VK_ERROR_OUT_OF_DATE_KHR)
 	{
@@ -105,25 +111,13 @@ void DDM::ForwardRenderer::Render()
 		throw std::runtime_error("failed to submit draw command buffer!");
 	}
 
-	VkPresentInfoKHR presentInfo{};
-	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-	presentInfo.waitSemaphoreCount = 1;
-	presentInfo.pWaitSemaphores = signalSemaphores;
-
-	VkSwapchainKHR swapChains[] = { m_pSwapchainWrapper->GetSwapchain() };
-	presentInfo.swapchainCount = 1;
-	presentInfo.pSwapchains = swapChains;
-	presentInfo.pImageIndices = &imageIndex;
-
-	presentInfo.pResults = nullptr;
-
-	result = vkQueuePresentKHR(queueObject.presentQueue, &presentInfo);
+	// Present the image, or signal the end of the frame when rendering offscreen
+	result = m_pSwapchainWrapper->Present(queueObject.presentQueue, signalSemaphores[0], imageIndex);
 
 
 	auto& window{ Window::GetInstance().GetWindowStruct() };
 
-	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized)
+	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || window.FrameBufferResized || m_pSwapchainWrapper->NeedsRecreation())
 	{
 		RecreateSwapChain();
 		window.FrameBufferResized = false;
@@ -136,6 +130,8 @@ void DDM::ForwardRenderer::Render()
 
 void DDM::ForwardRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, uint32_t imageIndex)
 {
+	DDM_PROFILE_FUNCTION();
+
 	VkCommandBufferBeginInfo beginInfo{};
 	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT; // Optional
@@ -146,6 +142,11 @@ void DDM::ForwardRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, u
 		throw std::runtime_error("failed to begin recording command buffer!");
 	}
 
+	auto pGpuProfiler{ VulkanObject::GetInstance().GetGpuProfiler() };
+
+	// Collect the gpu timings of the previous use of this frame and start measuring
+	pGpuProfiler->BeginFrame(commandBuffer, VulkanObject::GetInstance().GetCurrentFrame());
+
 	auto extent{ m_pSwapchainWrapper->GetExtent() };
 
 	VkViewport viewport{};
@@ -163,6 +164,7 @@ void DDM::ForwardRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, u
 	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
 	m_pRenderpass->BeginRenderPass(commandBuffer, m_pSwapchainWrapper->GetFrameBuffer(imageIndex, m_pRenderpass.get()), extent);
+	pGpuProfiler->BeginScope(commandBuffer, "Scene");
 
 	SceneManager::GetInstance().RenderSkybox();
 
@@ -170,11 +172,19 @@ void DDM::ForwardRenderer::RecordCommandBuffer(VkCommandBuffer& commandBuffer, u
 
 	SceneManager::GetInstance().RenderTransparancy();
 
+	pGpuProfiler->EndScope(commandBuffer);
+
+	pGpuProfiler->BeginScope(commandBuffer, "ImGui");
+
 	// Render the ImGui
 	m_pImGuiWrapper->Render(commandBuffer);
 
+	pGpuProfiler->EndScope(commandBuffer);
+
 	vkCmdEndRenderPass(commandBuffer);
 
+	pGpuProfiler->EndFrame(commandBuffer);
+
 	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 	{
 		throw std::runtime_error("failed to record command buffer!");
@@ -372,8 +382,8 @@ void DDM::ForwardRenderer::InitImgui()
 	init_info.Allocator = VK_NULL_HANDLE;
 	// Set min image count to the minimum image count of the swapchain
 	init_info.MinImageCount = m_pSwapchainWrapper->GetMinImageCount();
-	// Set the image count to the max amount of frames in flight
-	init_info.ImageCount = static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames());
+	// Set the image count to the max amount of frames in flight, imgui needs at least the minimum image count
+	init_info.ImageCount = std::max(static_cast<uint32_t>(VulkanObject::GetInstance().GetMaxFrames()), init_info.MinImageCount);
 	// Give functoin for error handling
 	init_info.CheckVkResultFn = [](VkResult /*err*/) { /* error handling */ };
 	// Give the max amount of samples per mixel
@@ -403,6 +413,11 @@ DDM::RenderpassWrapper* DDM::ForwardRenderer::GetDefaultRenderpass()
 	return m_pRenderpass.get();
 }
 
+VkFence DDM::ForwardRenderer::GetInFlightFence(uint32_t frame)
+{
+	return m_pSyncObjectManager->GetInFlightFence(frame);
+}
+
 void DDM::ForwardRenderer::AddDefaultPipelines()
 {
 	// Get config manager
@@ -423,4 +438,9 @@ void DDM::ForwardRenderer::AddDefaultPipelines()
 	VulkanObject::GetInstance().AddGraphicsPipeline(skyboxPipelineName, {
 		configManager.GetString("SkyboxVertName"),
 		configManager.GetString("SkyboxFragName") });
+
+	// Add instanced pipeline, draws one mesh many times with a model matrix per instance
+	VulkanObject::GetInstance().AddGraphicsPipeline(configManager.GetString("InstancedPipelineName"), {
+		configManager.GetString("InstancedVertName"),
+		configManager.GetString("DefaultFragName") });
 }
@@ -39,11 +39,13 @@ namespace DDM
 		ForwardRenderer& operator=(ForwardRenderer&& other) = delete;
 
 		virtual void Render() override;
-		  
+
 		virtual VkExtent2D GetExtent() override;
 		  
 		virtual RenderpassWrapper* GetDefaultRenderpass() override;
 
+		virtual VkFence GetInFlightFence(uint32_t frame) override;
+
 		virtual void AddDefaultPipelines();
 	private:
 		enum
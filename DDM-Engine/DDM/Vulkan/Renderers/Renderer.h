@@ -34,6 +34,9 @@ namespace DDM
 
 		virtual RenderpassWrapper* GetDefaultRenderpass() = 0;
 
+		// Get the fence that is signaled when the gpu is done with a frame in flight
+		virtual VkFence GetInFlightFence(uint32_t frame) = 0;
+
 		virtual void AddDefaultPipelines() = 0;
 	};
 }
@@ -9,6 +9,8 @@
 
 #include "CommandpoolManager.h"
 
+#include "Utils/ResourceTracker.h"
+
 // Standard library includes
 #include <stdexcept>
 
@@ -36,6 +38,8 @@ void DDM::BufferCreator::CreateBuffer(DDM::GPUObject* pGPUObject, VkDeviceSize s
 		throw std::runtime_error("failed to create buffer!");
 	}
 
+	ResourceTracker::Add(TrackedResource::Buffers);
+
 	// Create memory requiremnts object
 	VkMemoryRequirements memRequirements;
 	// Get the memory requirements
@@ -57,6 +61,8 @@ void DDM::BufferCreator::CreateBuffer(DDM::GPUObject* pGPUObject, VkDeviceSize s
 		throw std::runtime_error("failed to allocate buffer memory!");
 	}
 
+	ResourceTracker::TrackAllocation(bufferMemory, allocInfo.allocationSize, allocInfo.memoryTypeIndex);
+
 	// Bind the buffer to the buffer memory
 	vkBindBufferMemory(device, buffer, bufferMemory, 0);
 }
@@ -111,8 +117,10 @@ void DDM::BufferCreator::CreateVertexBuffer(DDM::GPUObject* pGPUObject, DDM::Com
 
 	// Destroy staging buffer
 	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	ResourceTracker::Remove(TrackedResource::Buffers);
 	// Free staging buffer memory
 	vkFreeMemory(device, stagingBufferMemory, nullptr);
+	ResourceTracker::UntrackAllocation(stagingBufferMemory);
 
 }
 
@@ -145,7 +153,9 @@ void DDM::BufferCreator::CreateIndexBuffer(DDM::GPUObject* pGPUObject, DDM::Comm
 
 	// Destroy staging buffer
 	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	ResourceTracker::Remove(TrackedResource::Buffers);
 
 	// Free staging buffer memory
 	vkFreeMemory(device, stagingBufferMemory, nullptr);
+	ResourceTracker::UntrackAllocation(stagingBufferMemory);
 }
\ No newline at end of file
@@ -0,0 +1,349 @@
+// GpuProfiler.cpp
+
+// Header include
+#include "GpuProfiler.h"
+
+// File includes
+#include "Includes/ImGuiIncludes.h"
+
+#include "Managers/ConfigManager.h"
+
+#include "Vulkan/VulkanWrappers/QueryPool.h"
+
+// Standard library includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+DDM::GpuProfiler::GpuProfiler(VkPhysicalDevice physicalDevice, uint32_t queueFamily, uint32_t maxFrames, bool collectStatistics)
+{
+	VkPhysicalDeviceProperties deviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+
+	// Without this limit the graphics queue is not guaranteed to support timestamps
+	m_IsSupported = deviceProperties.limits.timestampComputeAndGraphics == VK_TRUE;
+	m_TimestampPeriod = deviceProperties.limits.timestampPeriod;
+
+	// A queue family can write less than 64 valid bits, 0 means it doesn't support timestamps at all
+	uint32_t queueFamilyCount{};
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	const uint32_t validBits{ queueFamily < queueFamilyCount ? queueFamilies[queueFamily].timestampValidBits : 0 };
+
+	m_IsSupported = m_IsSupported && validBits > 0;
+	m_TimestampMask = validBits >= 64 ? ~uint64_t{} : (uint64_t{ 1 } << validBits) - 1;
+
+	if (!m_IsSupported)
+	{
+		std::cout << "Gpu timestamps are not supported, gpu profiling is disabled\n";
+		return;
+	}
+
+	// Create a query pool for every frame in flight
+	m_pQueryPools.reserve(maxFrames);
+
+	for (uint32_t frame{}; frame < maxFrames; ++frame)
+	{
+		m_pQueryPools.push_back(std::make_unique<QueryPool>(kMaxScopes * 2, VK_QUERY_TYPE_TIMESTAMP));
+	}
+
+	// Pipeline statistics use a pool of their own, one query per scope
+	m_CollectStatistics = collectStatistics;
+
+	if (m_CollectStatistics)
+	{
+		m_pStatisticsPools.reserve(maxFrames);
+
+		for (uint32_t frame{}; frame < maxFrames; ++frame)
+		{
+			m_pStatisticsPools.push_back(std::make_unique<QueryPool>(kMaxScopes, VK_QUERY_TYPE_PIPELINE_STATISTICS, kStatistics));
+		}
+	}
+
+	m_RecordedScopes.resize(maxFrames);
+
+	for (auto& scopes : m_RecordedScopes)
+	{
+		scopes.reserve(kMaxScopes);
+	}
+
+	m_OpenScopes.reserve(kMaxScopes);
+}
+
+DDM::GpuProfiler::~GpuProfiler() = default;
+
+void DDM::GpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+	if (!m_IsSupported)
+		return;
+
+	m_CurrentFrame = frame;
+
+	// The fence of this frame was waited on, so its previous results are available
+	CollectResults(frame);
+
+	m_pQueryPools[frame]->ResetPool(commandBuffer);
+
+	if (m_CollectStatistics)
+	{
+		m_pStatisticsPools[frame]->ResetPool(commandBuffer);
+	}
+
+	m_RecordedScopes[frame].clear();
+	m_OpenScopes.clear();
+	m_DroppedScopes = 0;
+	m_IsStatisticsQueryActive = false;
+
+	// The frame scope contains every other scope
+	BeginScope(commandBuffer, "Frame");
+}
+
+void DDM::GpuProfiler::EndFrame(VkCommandBuffer commandBuffer)
+{
+	if (!m_IsSupported)
+		return;
+
+	// Close scopes that were left open, including the frame scope
+	while (!m_OpenScopes.empty())
+	{
+		EndScope(commandBuffer);
+	}
+
+	m_DroppedScopes = 0;
+}
+
+void DDM::GpuProfiler::BeginScope(VkCommandBuffer commandBuffer, const char* pName)
+{
+	if (!m_IsSupported)
+		return;
+
+	auto& scopes{ m_RecordedScopes[m_CurrentFrame] };
+
+	// Leave room for the end timestamp of every open scope
+	if (scopes.size() >= kMaxScopes)
+	{
+		// Count the scope so its EndScope doesn't close the scope around it
+		++m_DroppedScopes;
+		return;
+	}
+
+	// Bottom of pipe makes the timestamp wait for the work recorded before it
+	const int query{ m_pQueryPools[m_CurrentFrame]->WriteTimeStamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT) };
+
+	if (query < 0)
+	{
+		++m_DroppedScopes;
+		return;
+	}
+
+	int statisticsQuery{ -1 };
+
+	// Statistics queries can not be nested, so only the outermost scope inside the frame scope counts them
+	if (m_CollectStatistics && !m_OpenScopes.empty() && !m_IsStatisticsQueryActive)
+	{
+		statisticsQuery = m_pStatisticsPools[m_CurrentFrame]->BeginQuery(commandBuffer);
+		m_IsStatisticsQueryActive = statisticsQuery >= 0;
+	}
+
+	m_OpenScopes.push_back(scopes.size());
+	scopes.push_back(RecordedScope{ pName, query, -1, statisticsQuery });
+}
+
+void DDM::GpuProfiler::EndScope(VkCommandBuffer commandBuffer)
+{
+	if (!m_IsSupported)
+		return;
+
+	// Scopes that were dropped are the innermost ones, so they are ended first
+	if (m_DroppedScopes > 0)
+	{
+		--m_DroppedScopes;
+		return;
+	}
+
+	if (m_OpenScopes.empty())
+		return;
+
+	auto& scope{ m_RecordedScopes[m_CurrentFrame][m_OpenScopes.back()] };
+	m_OpenScopes.pop_back();
+
+	if (scope.StatisticsQuery >= 0)
+	{
+		m_pStatisticsPools[m_CurrentFrame]->EndQuery(commandBuffer, scope.StatisticsQuery);
+		m_IsStatisticsQueryActive = false;
+	}
+
+	scope.EndQuery = m_pQueryPools[m_CurrentFrame]->WriteTimeStamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+}
+
+float DDM::GpuProfiler::GetAverage(const std::string& name) const
+{
+	auto it{ std::find_if(m_Stats.begin(), m_Stats.end(), [&name](const ScopeStats& stats) { return stats.Name == name; }) };
+
+	return it != m_Stats.end() ? it->GetAverage() : 0.0f;
+}
+
+void DDM::GpuProfiler::OnGUI()
+{
+	ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Framed;
+
+	// Start tree
+	if (ImGui::TreeNodeEx("GPU timings", flags))
+	{
+		if (!m_IsSupported)
+		{
+			ImGui::Text("Gpu timestamps are not supported");
+			ImGui::TreePop();
+			return;
+		}
+
+		ImGui::Checkbox("Pause", &m_IsPaused);
+
+		ImGui::SameLine();
+
+		if (ImGui::Button("Dump to file"))
+		{
+			DumpToFile(ConfigManager::GetInstance().GetString("GpuTimingsFile"));
+		}
+
+		// Averages over the last frames, the frame scope comes first
+		for (const auto& stats : m_Stats)
+		{
+			ImGui::Text("%s: %.3f ms (last %.3f ms)", stats.Name.c_str(), stats.GetAverage(), stats.Last);
+
+			if (stats.HasStatistics)
+			{
+				ImGui::Indent();
+
+				for (size_t statistic{}; statistic < kStatisticCount; ++statistic)
+				{
+					ImGui::Text("%s: %llu", kStatisticNames[statistic], static_cast<unsigned long long>(stats.Statistics[statistic]));
+				}
+
+				ImGui::Unindent();
+			}
+		}
+
+		ImGui::TreePop();
+	}
+}
+
+bool DDM::GpuProfiler::DumpToFile(const std::string& fileName) const
+{
+	std::ofstream file{ fileName };
+
+	if (!file.is_open())
+	{
+		std::cout << "Could not open gpu timings file " << fileName << "\n";
+		return false;
+	}
+
+	file << "Scope,Average,Min,Max,Last,Samples";
+
+	for (const char* pStatisticName : kStatisticNames)
+	{
+		file << ',' << pStatisticName;
+	}
+
+	file << '\n';
+
+	for (const auto& stats : m_Stats)
+	{
+		const size_t sampleCount{ std::min(stats.SampleCount, kHistorySize) };
+		const auto [min, max] { std::minmax_element(stats.History.begin(), stats.History.begin() + sampleCount) };
+
+		file << stats.Name << ',' << stats.GetAverage() << ',' << *min << ',' << *max << ',' << stats.Last << ',' << sampleCount;
+
+		// Scopes without pipeline statistics leave the columns empty
+		for (uint64_t value : stats.Statistics)
+		{
+			file << ',';
+
+			if (stats.HasStatistics)
+				file << value;
+		}
+
+		file << '\n';
+	}
+
+	std::cout << "Wrote gpu timings of " << m_Stats.size() << " scopes to " << fileName << "\n";
+
+	return true;
+}
+
+void DDM::GpuProfiler::CollectResults(uint32_t frame)
+{
+	auto& scopes{ m_RecordedScopes[frame] };
+
+	if (scopes.empty() || m_IsPaused)
+		return;
+
+	// Skip the frame rather than wait when the results are somehow not there yet
+	if (!m_pQueryPools[frame]->GetResults(m_Results))
+		return;
+
+	const bool hasStatistics{ m_CollectStatistics && m_pStatisticsPools[frame]->GetResults(m_StatisticsResults) };
+
+	for (const auto& scope : scopes)
+	{
+		if (scope.EndQuery < 0)
+			continue;
+
+		// Only the valid bits are defined, masking the difference also handles a counter that wrapped around
+		const uint64_t ticks{ (m_Results[scope.EndQuery] - m_Results[scope.BeginQuery]) & m_TimestampMask };
+
+		auto& stats{ GetStats(scope.pName) };
+
+		// Ticks to nanoseconds to milliseconds
+		stats.AddSample(static_cast<float>(static_cast<double>(ticks) * m_TimestampPeriod / 1'000'000.0));
+
+		if (hasStatistics && scope.StatisticsQuery >= 0)
+		{
+			std::copy_n(m_StatisticsResults.begin() + static_cast<size_t>(scope.StatisticsQuery) * kStatisticCount, kStatisticCount, stats.Statistics.begin());
+			stats.HasStatistics = true;
+		}
+	}
+}
+
+DDM::GpuProfiler::ScopeStats& DDM::GpuProfiler::GetStats(const char* pName)
+{
+	auto it{ std::find_if(m_Stats.begin(), m_Stats.end(), [pName](const ScopeStats& stats) { return std::strcmp(stats.Name.c_str(), pName) == 0; }) };
+
+	if (it != m_Stats.end())
+		return *it;
+
+	auto& stats{ m_Stats.emplace_back() };
+	stats.Name = pName;
+
+	return stats;
+}
+
+void DDM::GpuProfiler::ScopeStats::AddSample(float time)
+{
+	History[NextIndex] = time;
+	NextIndex = (NextIndex + 1) % kHistorySize;
+
+	++SampleCount;
+	Last = time;
+}
+
+float DDM::GpuProfiler::ScopeStats::GetAverage() const
+{
+	const size_t sampleCount{ std::min(SampleCount, kHistorySize) };
+
+	if (sampleCount == 0)
+		return 0.0f;
+
+	float total{};
+
+	for (size_t index{}; index < sampleCount; ++index)
+	{
+		total += History[index];
+	}
+
+	return total / static_cast<float>(sampleCount);
+}
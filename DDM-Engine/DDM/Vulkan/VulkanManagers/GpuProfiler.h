@@ -0,0 +1,203 @@
+// GpuProfiler.h
+// This class measures the gpu time of named scopes inside the frame command buffer
+// Every frame in flight has its own timestamp query pool, the results of a frame are read
+// when its pool is reused, so the fence of that frame already guarantees they are available and nothing stalls
+// Optionally every scope inside the frame scope also counts pipeline statistics like primitives and fragment invocations
+
+#ifndef GpuProfilerIncluded
+#define GpuProfilerIncluded
+
+// File includes
+#include "Includes/VulkanIncludes.h"
+
+// Standard library includes
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DDM
+{
+	// Class forward declarations
+	class QueryPool;
+
+	class GpuProfiler final
+	{
+	public:
+		// Delete default constructor
+		GpuProfiler() = delete;
+
+		// Constructor
+		// Parameters:
+		//     physicalDevice: handle of the VkPhysicalDevice, used to check timestamp support
+		//     queueFamily: index of the queue family the frame command buffers are submitted to
+		//     maxFrames: the maximum amount of frames in flight
+		//     collectStatistics: count pipeline statistics per scope, requires the pipelineStatisticsQuery feature
+		GpuProfiler(VkPhysicalDevice physicalDevice, uint32_t queueFamily, uint32_t maxFrames, bool collectStatistics);
+
+		// Destructor
+		~GpuProfiler();
+
+		// Rule of five
+		GpuProfiler(const GpuProfiler& other) = delete;
+		GpuProfiler(GpuProfiler&& other) = delete;
+		GpuProfiler& operator=(const GpuProfiler& other) = delete;
+		GpuProfiler& operator=(GpuProfiler&& other) = delete;
+
+		// Collect the results of the previous use of this frame and start a new frame,
+		// has to be called right after beginning the command buffer, outside of a render pass
+		// Parameters:
+		//     commandBuffer: the command buffer of the current frame
+		//     frame: index of the current frame in flight
+		void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frame);
+
+		// Close the frame scope, has to be called before ending the command buffer
+		// Parameters:
+		//     commandBuffer: the command buffer of the current frame
+		void EndFrame(VkCommandBuffer commandBuffer);
+
+		// Start a named scope, scopes can be nested
+		// Pipeline statistics are only counted for the outermost scope inside the frame, which has to end in the subpass it started in
+		// Parameters:
+		//     commandBuffer: the command buffer of the current frame
+		//     pName: name of the scope, has to stay valid for the lifetime of the program
+		void BeginScope(VkCommandBuffer commandBuffer, const char* pName);
+
+		// End the most recently started scope, a scope that could not be recorded is ended without writing anything
+		// Parameters:
+		//     commandBuffer: the command buffer of the current frame
+		void EndScope(VkCommandBuffer commandBuffer);
+
+		// Check if the gpu supports timestamps on the graphics queue
+		bool IsSupported() const { return m_IsSupported; }
+
+		// Check if pipeline statistics are counted
+		bool IsCollectingStatistics() const { return m_CollectStatistics; }
+
+		// Get the rolling average of a scope in milliseconds, 0 if the scope was never measured
+		// Parameters:
+		//     name: name of the scope
+		float GetAverage(const std::string& name) const;
+
+		// Draw the rolling averages of every scope
+		void OnGUI();
+
+		// Write the rolling statistics and the last pipeline statistics of every scope to a csv file
+		// Parameters:
+		//     fileName: name of the file
+		// Returns true if the file was written
+		bool DumpToFile(const std::string& fileName) const;
+
+	private:
+		// Amount of frames the rolling statistics are taken over
+		static constexpr size_t kHistorySize{ 128 };
+
+		// Maximum amount of scopes in a single frame, every scope uses two queries
+		static constexpr int kMaxScopes{ 32 };
+
+		// Pipeline statistics counted per scope, results come in the order of the bits
+		static constexpr VkQueryPipelineStatisticFlags kStatistics
+		{
+			VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+			VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+			VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+			VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT
+		};
+
+		// Amount of pipeline statistics per scope
+		static constexpr size_t kStatisticCount{ 4 };
+
+		// Names of the pipeline statistics
+		static constexpr std::array<const char*, kStatisticCount> kStatisticNames
+		{
+			"Primitives", "VertexInvocations", "ClippedPrimitives", "FragmentInvocations"
+		};
+
+		// A scope recorded in a command buffer
+		struct RecordedScope
+		{
+			const char* pName{};
+			int BeginQuery{ -1 };
+			int EndQuery{ -1 };
+			int StatisticsQuery{ -1 };
+		};
+
+		// Rolling statistics of a single scope
+		struct ScopeStats
+		{
+			std::string Name{};
+			std::array<float, kHistorySize> History{};
+			size_t NextIndex{};
+			size_t SampleCount{};
+			float Last{};
+
+			// Pipeline statistics of the last measured frame
+			std::array<uint64_t, kStatisticCount> Statistics{};
+			bool HasStatistics{ false };
+
+			// Add a time in milliseconds
+			void AddSample(float time);
+
+			// Get the average over the history
+			float GetAverage() const;
+		};
+
+		// Timestamp queries of every frame in flight
+		std::vector<std::unique_ptr<QueryPool>> m_pQueryPools{};
+
+		// Pipeline statistics queries of every frame in flight, empty when statistics are not collected
+		std::vector<std::unique_ptr<QueryPool>> m_pStatisticsPools{};
+
+		// Scopes recorded in every frame in flight
+		std::vector<std::vector<RecordedScope>> m_RecordedScopes{};
+
+		// Indices of the open scopes of the current frame
+		std::vector<size_t> m_OpenScopes{};
+
+		// Statistics of every scope, in the order they were first seen
+		std::vector<ScopeStats> m_Stats{};
+
+		// Reused buffer for the timestamp results
+		std::vector<uint64_t> m_Results{};
+
+		// Reused buffer for the pipeline statistics results
+		std::vector<uint64_t> m_StatisticsResults{};
+
+		// Amount of open scopes of the current frame that were not recorded because the frame was full,
+		// once a frame is full every later scope is dropped, so these are always the innermost open scopes
+		int m_DroppedScopes{};
+
+		// Frame that is being recorded
+		uint32_t m_CurrentFrame{};
+
+		// Mask of the bits of a timestamp the queue family actually writes, the other bits are undefined
+		uint64_t m_TimestampMask{};
+
+		// Nanoseconds per timestamp tick
+		float m_TimestampPeriod{};
+
+		// Indicates the gpu supports timestamps
+		bool m_IsSupported{ false };
+
+		// Indicates pipeline statistics are counted
+		bool m_CollectStatistics{ false };
+
+		// Indicates a pipeline statistics query is active, they can not be nested
+		bool m_IsStatisticsQueryActive{ false };
+
+		// Indicates the results are paused in the gui
+		bool m_IsPaused{ false };
+
+		// Read the results of a frame and add them to the statistics
+		// Parameters:
+		//     frame: index of the frame in flight
+		void CollectResults(uint32_t frame);
+
+		// Get the statistics of a scope, creates them when the scope is new
+		// Parameters:
+		//     pName: name of the scope
+		ScopeStats& GetStats(const char* pName);
+	};
+}
+
+#endif // !GpuProfilerIncluded
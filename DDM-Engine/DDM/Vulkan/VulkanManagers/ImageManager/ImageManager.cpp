@@ -17,6 +17,9 @@
 #include "Vulkan/VulkanWrappers/GPUObject.h"
 #include "Vulkan/VulkanWrappers/Image.h"
 
+#include "Utils/Profiler.h"
+#include "Utils/ResourceTracker.h"
+
 // Standard library includes
 #include <stdexcept>
 #include <cmath>
@@ -82,6 +85,8 @@ VkImageView DDM::ImageManager::CreateImageView(VkDevice device, VkImage image, V
 
 void DDM::ImageManager::CreateCubeTexture(GPUObject* pGPUObject, Image* cubeTexture, const std::vector<std::string>& textureNames, CommandpoolManager* pCommandPoolManager)
 {
+	DDM_PROFILE_FUNCTION();
+
 	// Get device
 	auto device{ pGPUObject->GetDevice() };
 
@@ -204,6 +209,8 @@ void DDM::ImageManager::CreateCubeTexture(GPUObject* pGPUObject, Image* cubeText
 		throw std::runtime_error("Failed to create cube map image!");
 	}
 
+	ResourceTracker::Add(TrackedResource::Images);
+
 	// Create memory requirements object
 	VkMemoryRequirements memoryRequirements;
 	// Get the memory requirements
@@ -225,6 +232,8 @@ void DDM::ImageManager::CreateCubeTexture(GPUObject* pGPUObject, Image* cubeText
 		throw std::runtime_error("Failed to allocate memory for cube map image!");
 	}
 
+	ResourceTracker::TrackAllocation(cubeImageMemory, allocateInfo.allocationSize, allocateInfo.memoryTypeIndex);
+
 	// Bind the memory
 	vkBindImageMemory(device, cubeImage, cubeImageMemory, 0);
 
@@ -256,8 +265,10 @@ void DDM::ImageManager::CreateCubeTexture(GPUObject* pGPUObject, Image* cubeText
 
 	// Destroy the staging buffer
 	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	ResourceTracker::Remove(TrackedResource::Buffers);
 	// Free the staging buffer memory
 	vkFreeMemory(device, stagingBufferMemory, nullptr);
+	ResourceTracker::UntrackAllocation(stagingBufferMemory);
 
 
 	// Create image view create info
@@ -391,6 +402,8 @@ void DDM::ImageManager::CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffe
 
 void DDM::ImageManager::GenerateMipmaps(VkPhysicalDevice physicalDevice, VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
 {
+	DDM_PROFILE_FUNCTION();
+
 	// Create format properties object
 	VkFormatProperties formatProperties{};
 	// Get format properties
@@ -529,6 +542,8 @@ void DDM::ImageManager::GenerateMipmaps(VkPhysicalDevice physicalDevice, VkComma
 
 std::shared_ptr<DDM::Image> DDM::ImageManager::CreateTextureImage(const std::string& textureName)
 {
+	DDM_PROFILE_FUNCTION();
+
 	// Retrieve needed variables from vulkan object
 	auto& vulkanObject = VulkanObject::GetInstance();
 	auto device = vulkanObject.GetDevice();
@@ -573,6 +588,8 @@ std::shared_ptr<DDM::Image> DDM::ImageManager::CreateTextureImage(const std::str
 		throw std::runtime_error("failed to create image!");
 	}
 
+	ResourceTracker::Add(TrackedResource::Images);
+
 	// Retrieve memory requirements 
 	VkMemoryRequirements memRequirements;
 	vkGetImageMemoryRequirements(device, textureImage, &memRequirements);
@@ -589,6 +606,8 @@ std::shared_ptr<DDM::Image> DDM::ImageManager::CreateTextureImage(const std::str
 		throw std::runtime_error("failed to allocate image memory!");
 	}
 
+	ResourceTracker::TrackAllocation(textureImageMemory, allocInfo.allocationSize, allocInfo.memoryTypeIndex);
+
 	vkBindImageMemory(device, textureImage, textureImageMemory, 0);
 
 	
@@ -598,14 +617,23 @@ std::shared_ptr<DDM::Image> DDM::ImageManager::CreateTextureImage(const std::str
 
 void DDM::ImageManager::CreateTextureImage(GPUObject* pGPUObject, Image* texture, const std::string& textureName, DDM::CommandpoolManager* pCommandPoolManager)
 {
-	// Get device
-	auto device{ pGPUObject->GetDevice() };
+	DDM_PROFILE_FUNCTION();
 
 	// Load pixels of image
 	std::unique_ptr<STBImage> pImage = std::make_unique<STBImage>(textureName);
-	
-	int texWidth = pImage->GetWidth();
-	int texHeight = pImage->GetHeight();
+
+	CreateTextureImage(pGPUObject, texture, *pImage, pCommandPoolManager);
+}
+
+void DDM::ImageManager::CreateTextureImage(GPUObject* pGPUObject, Image* texture, STBImage& image, DDM::CommandpoolManager* pCommandPoolManager)
+{
+	DDM_PROFILE_FUNCTION();
+
+	// Get device
+	auto device{ pGPUObject->GetDevice() };
+
+	int texWidth = image.GetWidth();
+	int texHeight = image.GetHeight();
 
 	// Calculate max amount of miplevels based on texwidth and texheight
 	texture->SetMipLevels(static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1);
@@ -628,7 +656,7 @@ void DDM::ImageManager::CreateTextureImage(GPUObject* pGPUObject, Image* texture
 	// Map the memory of the staging buffer memory to the data pointer
 	vkMapMemory(device, stagingBufferMemory, 0, imageSize, 0, &data);
 	// Copy the data from the pixels to the data pointer
-	memcpy(data, pImage->GetPixels(), static_cast<size_t>(imageSize));
+	memcpy(data, image.GetPixels(), static_cast<size_t>(imageSize));
 	// Unmap the memory of the staging buffer
 	vkUnmapMemory(device, stagingBufferMemory);
 
@@ -656,8 +684,10 @@ void DDM::ImageManager::CreateTextureImage(GPUObject* pGPUObject, Image* texture
 
 	// Destroy the staging buffer
 	vkDestroyBuffer(device, stagingBuffer, nullptr);
+	ResourceTracker::Remove(TrackedResource::Buffers);
 	// Free the staging buffer memory
 	vkFreeMemory(device, stagingBufferMemory, nullptr);
+	ResourceTracker::UntrackAllocation(stagingBufferMemory);
 
 	// Get new single time command buffer
 	commandBuffer = pCommandPoolManager->BeginSingleTimeCommands(device);
@@ -669,6 +699,8 @@ void DDM::ImageManager::CreateTextureImage(GPUObject* pGPUObject, Image* texture
 
 void DDM::ImageManager::CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels, VkSampleCountFlagBits numSamples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, Image* texture)
 {
+	DDM_PROFILE_FUNCTION();
+
 	// Get required objects from vulkanObject
 	auto& vulkanObject = VulkanObject::GetInstance();
 	auto device = vulkanObject.GetDevice();
@@ -716,6 +748,8 @@ void DDM::ImageManager::CreateImage(uint32_t width, uint32_t height, uint32_t mi
 		throw std::runtime_error("failed to create image!");
 	}
 
+	ResourceTracker::Add(TrackedResource::Images);
+
 	// Create memory requirements object
 	VkMemoryRequirements memRequirements;
 	// Get memory requirements
@@ -737,6 +771,8 @@ void DDM::ImageManager::CreateImage(uint32_t width, uint32_t height, uint32_t mi
 		throw std::runtime_error("failed to allocate image memory!");
 	}
 
+	ResourceTracker::TrackAllocation(imageMemory, allocInfo.allocationSize, allocInfo.memoryTypeIndex);
+
 	// Bind the image memory
 	vkBindImageMemory(device, image, imageMemory, 0);
 
@@ -17,6 +17,7 @@ namespace DDM
 	class BufferCreator;
 	class CommandpoolManager;
 	class Image;
+	class STBImage;
 
 
 	class ImageManager final
@@ -84,6 +85,15 @@ namespace DDM
 		void CreateTextureImage(GPUObject* pGPUObject, Image*,
 			const std::string& textureName, CommandpoolManager* pCommandPoolManager);
 
+		// Create a given texture image from an image that was decoded already
+		// Parameters:
+		//     pGPUObject : a pointer to the GPU object 
+		//     texture: reference to the texture that will be created
+		//     image: the decoded image
+		//     pCommandPoolManager: pointer to the commandpool manager
+		void CreateTextureImage(GPUObject* pGPUObject, Image* texture,
+			STBImage& image, CommandpoolManager* pCommandPoolManager);
+
 		// Create a given cube texture image
 		// Parameters:
 		//     pGPUObject : a pointer to the GPU object 
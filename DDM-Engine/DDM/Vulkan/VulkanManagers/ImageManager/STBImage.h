@@ -1,6 +1,9 @@
 // STBImage.h
 // This class will serve as a wrapper for a single image from the STB library
 
+#ifndef _DDM_STB_IMAGE_
+#define _DDM_STB_IMAGE_
+
 // File includes
 #include "Includes/STBIncludes.h"
 
@@ -92,4 +95,6 @@ namespace DDM
 		// List of pixels of the image
 		std::vector<stbi_uc> m_Pixels{};
 	};
-}
\ No newline at end of file
+}
+
+#endif // !_DDM_STB_IMAGE_
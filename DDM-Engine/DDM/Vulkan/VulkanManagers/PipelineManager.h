@@ -58,6 +58,11 @@ namespace DDM
 		//     name: the name of the requested pipeline
 		PipelineWrapper* GetPipeline(const std::string& name);
 
+		// Check if a graphics pipeline was added, GetPipeline falls back to the default pipeline when it wasn't
+		// Parameters:
+		//     name: the name of the requested pipeline
+		bool HasPipeline(const std::string& name) const { return m_GraphicPipelines.contains(name); }
+
 	private:
 		// A map of all the graphics pipelines
 		// A string is used to as key for the pipelines
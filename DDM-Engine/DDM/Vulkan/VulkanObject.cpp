@@ -5,6 +5,7 @@
 
 // File includes
 #include "Engine/DDMEngine.h"
+#include "Engine/FramePacer.h"
 #include "Engine/Window.h"
 #include "Managers/SceneManager.h"
 #include "Managers/ConfigManager.h"
@@ -28,6 +29,7 @@
 #include "VulkanWrappers/GPUObject.h"
 #include "VulkanWrappers/ImGuiWrapper.h"
 #include "VulkanManagers/SyncObjectManager.h"
+#include "VulkanManagers/GpuProfiler.h"
 
 #include "Components/MeshRenderer.h"
 #include "Components/Camera.h"
@@ -38,12 +40,16 @@
 
 #include "Vulkan/VulkanWrappers/Image.h"
 
+#include "Utils/AllocationTracker.h"
+#include "Utils/Profiler.h"
+#include "Utils/RenderCounters.h"
+
 
 // Standard library includes
 #include <set>
 #include <algorithm>
 
-uint32_t DDM::VulkanObject::m_MaxFramesInFlight{ static_cast<uint32_t>(DDM::ConfigManager::GetInstance().GetInt("MaxFrames"))};
+uint32_t DDM::VulkanObject::m_MaxFramesInFlight{ DDM::FramePacer::GetInstance().GetFramesInFlight() };
 uint32_t DDM::VulkanObject::m_CurrentFrame{ 0 };
 
 DDM::VulkanObject::VulkanObject()
@@ -70,6 +76,12 @@ void DDM::VulkanObject::Setup(std::unique_ptr<Renderer> pRenderer)
 	m_pRenderer = std::move(pRenderer);
 
 	m_pRenderer->AddDefaultPipelines();
+
+	// Pipeline statistics are optional, they add a query around every pass
+	const bool collectStatistics{ GetGPUObject()->SupportsPipelineStatistics() && ConfigManager::GetInstance().GetBool("PipelineStatistics") };
+
+	// Query pools need the device, so the profiler is created once the object exists
+	m_pGpuProfiler = std::make_unique<GpuProfiler>(GetPhysicalDevice(), GetQueueObject().graphicsQueueIndex, m_MaxFramesInFlight, collectStatistics);
 }
 
 DDM::VulkanObject::~VulkanObject()
@@ -111,13 +123,36 @@ DDM::PipelineWrapper* DDM::VulkanObject::GetPipeline(const std::string& name)
 	return m_pPipelineManager->GetPipeline(name);
 }
 
+bool DDM::VulkanObject::HasPipeline(const std::string& name) const
+{
+	return m_pPipelineManager->HasPipeline(name);
+}
+
 void DDM::VulkanObject::Terminate()
 {
 	m_pRenderer.reset();
+
+	// Make sure no frame still writes to the query pools
+	vkDeviceWaitIdle(GetDevice());
+
+	m_pGpuProfiler.reset();
+}
+
+void DDM::VulkanObject::WaitForFrame()
+{
+	DDM_PROFILE_FUNCTION();
+
+	// Returns at once when the fence is already signaled, so the renderers can call it again before they reuse the frame
+	VkFence inFlightFence{ m_pRenderer->GetInFlightFence(m_CurrentFrame) };
+
+	vkWaitForFences(GetDevice(), 1, &inFlightFence, VK_TRUE, UINT64_MAX);
 }
 
 void DDM::VulkanObject::Render()
 {
+	DDM_PROFILE_FUNCTION();
+	DDM_ALLOCATION_SCOPE(Render);
+
 	m_pRenderer->Render();
 
 	++m_CurrentFrame %= m_MaxFramesInFlight;
@@ -136,6 +171,14 @@ void DDM::VulkanObject::CreateTexture(Image* texture, const std::string& texture
 	texture->SetImageView(m_pImageManager->CreateImageView(GetDevice(), texture->GetImage(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, texture->GetMipLevels()));
 }
 
+void DDM::VulkanObject::CreateTexture(Image* texture, STBImage& image)
+{
+	// Upload the image trough the image manager
+	m_pImageManager->CreateTextureImage(GetGPUObject(), texture, image, GetCommandPoolManager());
+	// Create the image view
+	texture->SetImageView(m_pImageManager->CreateImageView(GetDevice(), texture->GetImage(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, texture->GetMipLevels()));
+}
+
 void DDM::VulkanObject::CreateCubeTexture(Image* cubeTexture, const std::vector<std::string>& textureNames)
 {
 	// Create a cube texture trough image manager
@@ -204,6 +247,9 @@ void DDM::VulkanObject::EndSingleTimeCommands(VkCommandBuffer commandBuffer)
 void DDM::VulkanObject::DrawQuad(VkCommandBuffer commandBuffer)
 {
 	vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+
+	RenderCounters::Add(RenderCounter::DrawCalls);
+	RenderCounters::Add(RenderCounter::Instances);
 }
 
 DDM::BufferCreator* DDM::VulkanObject::GetBufferCreator()
@@ -31,7 +31,9 @@ namespace DDM
     class PipelineWrapper;
     class ImageManager;
     class CommandpoolManager;
+    class GpuProfiler;
     class Image;
+    class STBImage;
 
     class VulkanObject final : public Singleton<VulkanObject>
     {
@@ -49,6 +51,9 @@ namespace DDM
 
         void Terminate();
 
+        // Wait until the gpu is done with the last frame that used the current frame in flight
+        void WaitForFrame();
+
         void Render();
 
         // Add a new graphics pipeline
@@ -72,6 +77,11 @@ namespace DDM
 
         PipelineWrapper* GetPipeline(const std::string& name = "Default");
 
+        // Check if a graphics pipeline was added by the renderer
+        // Parameters:
+        //     name: the name of the requested pipeline
+        bool HasPipeline(const std::string& name) const;
+
         VkCommandBuffer& GetCurrentCommandBuffer();
 
         uint32_t GetCurrentFrame() const { return  m_CurrentFrame; }
@@ -112,6 +122,12 @@ namespace DDM
         //     textureName: textpath to the image
         void CreateTexture(Image* texture, const std::string& textureName);
 
+        // Create a texture from an image that was decoded already
+        // Parameters:
+        //     texture: reference to the texture object that will hold the texture
+        //     image: the decoded image
+        void CreateTexture(Image* texture, STBImage& image);
+
         // Create a cube texture
         // Parameters:
         //     cubeTexture: reference to the texture object
@@ -140,6 +156,8 @@ namespace DDM
 
        ImageManager* GetImageManager() { return m_pImageManager.get(); }
 
+       GpuProfiler* GetGpuProfiler() { return m_pGpuProfiler.get(); }
+
        // Begin a command buffer for a single command
        VkCommandBuffer BeginSingleTimeCommands();
 
@@ -187,6 +205,9 @@ namespace DDM
         // Pointer to the commandpool manager
         std::unique_ptr<CommandpoolManager> m_pCommandPoolManager{};
 
+        // Pointer to the gpu timestamp profiler
+        std::unique_ptr<GpuProfiler> m_pGpuProfiler{};
+
 
         uint32_t m_MipLevels{};
 
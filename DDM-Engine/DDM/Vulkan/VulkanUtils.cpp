@@ -93,8 +93,17 @@ DDM::QueueFamilyIndices VulkanUtils::FindQueueFamilies(VkPhysicalDevice physical
 		}
 
 		VkBool32 presentSupport = false;
-		// Check if the graphics family index is supported
-		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+
+		// Without a surface nothing is presented, the graphics queue is used to signal the end of a frame
+		if (surface == VK_NULL_HANDLE)
+		{
+			presentSupport = indices.graphicsFamily.has_value() && indices.graphicsFamily.value() == i;
+		}
+		else
+		{
+			// Check if the graphics family index is supported
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+		}
 
 		// If it is supported
 		if (presentSupport)
@@ -6,6 +6,7 @@
 // File includes
 #include "Includes/VulkanIncludes.h"
 #include "Vulkan/VulkanObject.h"
+#include "Utils/ResourceTracker.h"
 
 // Standard library include
 #include <vector>
@@ -37,9 +38,11 @@ namespace DDM
 		{
 			// Destroy the buffer
 			vkDestroyBuffer(VulkanObject::GetInstance().GetDevice(), m_Buffer, nullptr);
+			ResourceTracker::Remove(TrackedResource::Buffers);
 
 			// Free buffer memory
 			vkFreeMemory(VulkanObject::GetInstance().GetDevice(), m_BufferMemory, nullptr);
+			ResourceTracker::UntrackAllocation(m_BufferMemory);
 		}
 
 		/// <summary>
@@ -12,6 +12,11 @@
 
 #include "DataTypes/DescriptorObjects/DescriptorObject.h"
 
+#include "Utils/AllocationTracker.h"
+#include "Utils/FrameArena.h"
+#include "Utils/RenderCounters.h"
+#include "Utils/ResourceTracker.h"
+
 
 DDM::DescriptorPoolWrapper::DescriptorPoolWrapper(std::vector<std::unique_ptr<DDM::ShaderModuleWrapper>>& shaderModules)
 {
@@ -32,6 +37,9 @@ void DDM::DescriptorPoolWrapper::Cleanup(VkDevice device)
 {
 	if (m_DescriptorPool != VK_NULL_HANDLE)
 	{
+		// Destroying the pool frees every descriptorset allocated from it
+		ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AllocatedDescriptorSets * VulkanObject::GetInstance().GetMaxFrames()));
+
 		// Destroy the descriptorPool
 		vkDestroyDescriptorPool(device, m_DescriptorPool, nullptr);
 		m_DescriptorPool = VK_NULL_HANDLE;
@@ -97,23 +105,27 @@ void DDM::DescriptorPoolWrapper::CreateDescriptorSets(VkDescriptorSetLayout layo
 		throw std::runtime_error("failed to allocate descriptor sets!");
 	}
 
+	ResourceTracker::Add(TrackedResource::DescriptorSets, static_cast<int64_t>(descriptorSets.size()));
+
 	// Increase the amount of allocated descriptorsets
 	m_AllocatedDescriptorSets++;
 }
 
-void DDM::DescriptorPoolWrapper::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects)
+void DDM::DescriptorPoolWrapper::UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects)
 {
+	DDM_ALLOCATION_SCOPE(Descriptors);
+
 	// Loop trough all the descriptor sets
 	for (int i{}; i < static_cast<int>(descriptorSets.size()); i++)
 	{
 		// Create a vector of descriptor writes
-		std::vector<VkWriteDescriptorSet> descriptorWrites{};
+		FrameVector<VkWriteDescriptorSet> descriptorWrites{};
 
 		// Initialize current binding with 0
 		int binding{};
 
 		// Loop trough all descriptor objects and add the descriptor writes
-		for (auto& descriptorObject : descriptorObjects)
+		for (auto descriptorObject : descriptorObjects)
 		{
 			descriptorObject->AddDescriptorWrite(descriptorSets[i], descriptorWrites, binding, m_DescriptorsPerBinding[binding], i);
 		}
@@ -122,6 +134,7 @@ void DDM::DescriptorPoolWrapper::UpdateDescriptorSets(std::vector<VkDescriptorSe
 		//vkDeviceWaitIdle(VulkanRenderer::GetInstance().GetDevice());
 		// Update descriptorsets
 		vkUpdateDescriptorSets(VulkanObject::GetInstance().GetDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+		RenderCounters::Add(RenderCounter::DescriptorUpdates, descriptorWrites.size());
 	}
 }
 
@@ -129,6 +142,9 @@ void DDM::DescriptorPoolWrapper::ResizeDescriptorPool()
 {
 	vkDeviceWaitIdle(VulkanObject::GetInstance().GetDevice());
 
+	// Destroying the pool frees every descriptorset allocated from it
+	ResourceTracker::Remove(TrackedResource::DescriptorSets, static_cast<int64_t>(m_AllocatedDescriptorSets * VulkanObject::GetInstance().GetMaxFrames()));
+
 	// Destroy current descriptorpool
 	vkDestroyDescriptorPool(VulkanObject::GetInstance().GetDevice(), m_DescriptorPool, nullptr);
 
@@ -13,6 +13,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <span>
 
 namespace DDM
 {
@@ -63,9 +64,11 @@ namespace DDM
 		//     descriptorSets: the vector of descriptor sets that should be created in this function
 		void CreateDescriptorSets(VkDescriptorSetLayout layouts, std::vector<VkDescriptorSet>& descriptorSets);
 
-		// This function will update the given descriptorsets
+		// This function will update the given descriptorsets, the descriptor writes are allocated from the frame arena
 		// Parameters:
-		void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::vector<DescriptorObject*>& descriptorObjects);
+		//     descriptorSets: the descriptorsets to update
+		//     descriptorObjects: the descriptor objects in the order of their bindings
+		void UpdateDescriptorSets(std::vector<VkDescriptorSet>& descriptorSets, std::span<DescriptorObject* const> descriptorObjects);
 	private:
 		// The amount of bindings per descriptor set type
 		std::map<VkDescriptorType, int> m_DescriptorTypeCount{};
@@ -9,6 +9,8 @@
 #include "Vulkan/VulkanUtils.h"
 
 // Standard library includes
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <map>
 #include <set>
@@ -130,8 +132,13 @@ bool DDM::GPUObject::IsDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surf
 	// Boolean for adequaty of the swapchain
 	bool swapChainAdequate = false;
 
+	// Without a surface there is no swapchain, the renderers use offscreen images instead
+	if (surface == VK_NULL_HANDLE)
+	{
+		swapChainAdequate = true;
+	}
 	// If the extensions are supported
-	if (extensionsSupported)
+	else if (extensionsSupported)
 	{
 		// Get the swapchain support details
 		SwapChainSupportDetails swapChainSupport = VulkanUtils::QuerySwapChainSupport(device, surface);
@@ -177,6 +184,17 @@ bool DDM::GPUObject::CheckDeviceExtensionSupport(VkPhysicalDevice device)
 	return requiredExtensions.empty();
 }
 
+bool DDM::GPUObject::IsExtensionSupported(VkPhysicalDevice device, const char* pExtensionName)
+{
+	uint32_t extensionCount;
+	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+	return std::any_of(availableExtensions.begin(), availableExtensions.end(),
+		[pExtensionName](const VkExtensionProperties& extension) { return std::strcmp(extension.extensionName, pExtensionName) == 0; });
+}
 
 void DDM::GPUObject::CreateLogicalDevice(InstanceWrapper* pInstanceWrapper, VkSurfaceKHR surface)
 {
@@ -216,6 +234,12 @@ void DDM::GPUObject::CreateLogicalDevice(InstanceWrapper* pInstanceWrapper, VkSu
 	// Enable sampler rate shading
 	deviceFeatures.sampleRateShading = VK_TRUE;
 
+	// Enable pipeline statistics queries when available, they are optional for the gpu profiler
+	VkPhysicalDeviceFeatures supportedFeatures{};
+	vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+	m_SupportsPipelineStatistics = supportedFeatures.pipelineStatisticsQuery == VK_TRUE;
+	deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+
 	// Setup Query reset features
 	VkPhysicalDeviceHostQueryResetFeatures queryReset = {};
 	queryReset.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_QUERY_RESET_FEATURES;
@@ -226,6 +250,17 @@ void DDM::GPUObject::CreateLogicalDevice(InstanceWrapper* pInstanceWrapper, VkSu
 	deviceFeatures2.pNext = &queryReset;
 	deviceFeatures2.features = deviceFeatures;
 
+	// The required extensions, extended with the optional ones the device supports
+	std::vector<const char*> extensions{ m_DeviceExtensions };
+
+	// Memory budget is optional, without it the telemetry falls back to the memory the engine tracks itself
+	m_SupportsMemoryBudget = IsExtensionSupported(m_PhysicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+	if (m_SupportsMemoryBudget)
+	{
+		extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	}
+
 	// Create device create info
 	VkDeviceCreateInfo createInfo{};
 	createInfo.pNext = &deviceFeatures2;
@@ -238,9 +273,9 @@ void DDM::GPUObject::CreateLogicalDevice(InstanceWrapper* pInstanceWrapper, VkSu
 	// Give the requested device features
 	createInfo.pEnabledFeatures = nullptr; //&deviceFeatures;
 	// Set amount of extensions to the size of the extensions vector
-	createInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
+	createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
 	// Give pointer to data of extensions vector
-	createInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
+	createInfo.ppEnabledExtensionNames = extensions.data();
 
 	// Check if validation layers are enabled
 	if (pInstanceWrapper->ValidationLayersEnabled())
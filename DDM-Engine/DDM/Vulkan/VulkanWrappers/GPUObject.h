@@ -51,6 +51,12 @@ namespace DDM
 		// Get the device LUID
 		const uint8_t* GetDeviceLuid() const { return m_DeviceLuid; }
 
+		// Check if pipeline statistics queries were enabled on the logical device
+		bool SupportsPipelineStatistics() const { return m_SupportsPipelineStatistics; }
+
+		// Check if VK_EXT_memory_budget was enabled on the logical device
+		bool SupportsMemoryBudget() const { return m_SupportsMemoryBudget; }
+
 	private:
 		// Handle of the VkPhysicalDevice
 		VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
@@ -68,6 +74,12 @@ namespace DDM
 		// Object that holds the graphics and present family queues
 		QueueObject m_QueueObject{};
 
+		// Indicates the pipeline statistics query feature is enabled
+		bool m_SupportsPipelineStatistics{ false };
+
+		// Indicates VK_EXT_memory_budget is enabled
+		bool m_SupportsMemoryBudget{ false };
+
 
 		// Pick the physical device
 		void PickPhysicalDevice(InstanceWrapper* pInstanceWrapper, VkSurfaceKHR surface);
@@ -82,6 +94,12 @@ namespace DDM
 		//     device: the device to be checked
 		bool CheckDeviceExtensionSupport(VkPhysicalDevice device);
 
+		// Check if a given device supports a single extension
+		// Parameters:
+		//     device: the device to be checked
+		//     pExtensionName: name of the extension
+		bool IsExtensionSupported(VkPhysicalDevice device, const char* pExtensionName);
+
 		// Initialize the logical device
 		void CreateLogicalDevice(InstanceWrapper* pInstanceWrapper, VkSurfaceKHR surface);
 
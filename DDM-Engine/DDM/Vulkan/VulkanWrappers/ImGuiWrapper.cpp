@@ -7,10 +7,12 @@
 #include "Engine/DDMEngine.h"
 #include "Engine/Window.h"
 #include "Managers/SceneManager.h"
+#include "Managers/TimeManager.h"
 #include "Vulkan/VulkanObject.h"
 #include "Vulkan/VulkanWrappers/RenderpassWrapper.h"
 
 // Standard library includes
+#include <algorithm>
 #include <array>
 #include <stdexcept>
 
@@ -26,8 +28,14 @@ DDM::ImGuiWrapper::ImGuiWrapper(ImGui_ImplVulkan_InitInfo init_info, VkDevice de
 	// Create ImGui context
 	ImGui::CreateContext();
 
+	// Without a window the display size and time are set every frame instead of by the glfw backend
+	m_Headless = Window::GetInstance().IsHeadless();
+
 	// Initialize ImGui Vulkan backend
-	ImGui_ImplGlfw_InitForVulkan(Window::GetInstance().GetWindowStruct().pWindow, true);
+	if (!m_Headless)
+	{
+		ImGui_ImplGlfw_InitForVulkan(Window::GetInstance().GetWindowStruct().pWindow, true);
+	}
 
 	// Set the descriptorpool of the init_info
 	init_info.DescriptorPool = m_DescriptorPool;
@@ -51,7 +59,10 @@ void DDM::ImGuiWrapper::Cleanup(VkDevice device)
 	ImGui_ImplVulkan_Shutdown();
 
 	// Shut down glfw implementation
-	ImGui_ImplGlfw_Shutdown();
+	if (!m_Headless)
+	{
+		ImGui_ImplGlfw_Shutdown();
+	}
 
 	// Destroy context
 	ImGui::DestroyContext();
@@ -64,7 +75,22 @@ void DDM::ImGuiWrapper::Render(VkCommandBuffer commandBuffer)
 {
 	// Start ImGui frame
 	ImGui_ImplVulkan_NewFrame();
-	ImGui_ImplGlfw_NewFrame();
+
+	if (m_Headless)
+	{
+		auto& window{ Window::GetInstance().GetWindowStruct() };
+		auto& io{ ImGui::GetIO() };
+
+		io.DisplaySize = ImVec2(static_cast<float>(window.Width), static_cast<float>(window.Height));
+
+		// ImGui asserts on a delta time of 0, which the first frame can have
+		io.DeltaTime = std::max(TimeManager::GetInstance().GetDeltaTime(), 0.0001f);
+	}
+	else
+	{
+		ImGui_ImplGlfw_NewFrame();
+	}
+
 	ImGui::NewFrame();
 
 	if (m_ShowDemo)
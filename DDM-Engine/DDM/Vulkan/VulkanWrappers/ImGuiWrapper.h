@@ -50,6 +50,9 @@ namespace DDM
 		// Show the ImGui Demo
 		bool m_ShowDemo{ false };
 
+		// Indicates there is no window, so the glfw backend isn't used
+		bool m_Headless{ false };
+
 		// Initialization of descriptorpool
 		// Parameters:
 		//     device: handle for the VkDevice
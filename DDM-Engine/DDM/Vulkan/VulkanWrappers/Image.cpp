@@ -5,6 +5,7 @@
 
 // File includes
 #include "Vulkan/VulkanObject.h"
+#include "Utils/ResourceTracker.h"
 
 
 DDM::Image::Image()
@@ -23,6 +24,11 @@ DDM::Image::Image(const std::string& filepath)
 	VulkanObject::GetInstance().CreateTexture(this, filepath);
 }
 
+DDM::Image::Image(STBImage& image)
+{
+	VulkanObject::GetInstance().CreateTexture(this, image);
+}
+
 DDM::Image::~Image()
 {
 
@@ -82,6 +88,7 @@ void DDM::Image::Cleanup()
 	{
 		// Destroy the image
 		vkDestroyImage(device, m_Image, nullptr);
+		ResourceTracker::Remove(TrackedResource::Images);
 		m_Image = VK_NULL_HANDLE;
 	}
 
@@ -89,6 +96,7 @@ void DDM::Image::Cleanup()
 	{
 		// Free the memory
 		vkFreeMemory(device, m_ImageMemory, nullptr);
+		ResourceTracker::UntrackAllocation(m_ImageMemory);
 		m_ImageMemory = VK_NULL_HANDLE;
 	}
 }
\ No newline at end of file
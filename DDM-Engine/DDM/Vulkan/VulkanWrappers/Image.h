@@ -9,6 +9,9 @@
 
 namespace DDM
 {
+	// Class forward declarations
+	class STBImage;
+
 	class Image final
 	{
 	public:
@@ -18,6 +21,9 @@ namespace DDM
 
 		Image(const std::string& filepath);
 
+		// Create the texture from an image that was decoded already
+		Image(STBImage& image);
+
 		~Image();
 
 		void SetImage(VkImage image);
@@ -10,6 +10,8 @@
 
 #include "Managers/ConfigManager.h"
 
+#include "Engine/Window.h"
+
 // Standard library includes
 #include <stdexcept>
 #include <iostream>
@@ -169,16 +171,23 @@ bool DDM::InstanceWrapper::CheckValidationLayerSupport(const std::vector<const c
 
 std::vector<const char*> DDM::InstanceWrapper::GetRequiredExtensions(bool enableValidationLayers)
 {
-	// Crate uint fro the amount of glfw extensions
-	uint32_t glfwExtensionCount = 0;
-	// Create char** for the names of the glfw estensions
-	const char** glfwExtensions;
+	// Create a vector to hold the extensions
+	std::vector<const char*> extensions{};
+
+	// Surface extensions are only needed when there is a window to present to
+	if (!Window::GetInstance().IsHeadless())
+	{
+		// Crate uint fro the amount of glfw extensions
+		uint32_t glfwExtensionCount = 0;
+		// Create char** for the names of the glfw estensions
+		const char** glfwExtensions;
 
-	// Get the glfw extensions and their count
-	glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		// Get the glfw extensions and their count
+		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
 
-	// Create a vector to hold the extensions, starting from the address of glfwExtensions and ending at glfwExtensions + the amount of extensions
-	std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+		// Add the extensions, starting from the address of glfwExtensions and ending at glfwExtensions + the amount of extensions
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	// If the validation layers are enabled
 	if (enableValidationLayers)
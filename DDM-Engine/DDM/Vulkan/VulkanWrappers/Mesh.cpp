@@ -10,6 +10,8 @@
 
 #include "Includes/DDMModelLoaderIncludes.h"
 
+#include "Utils/RenderCounters.h"
+
 
 DDM::Mesh::Mesh(DDMML::Mesh* pMesh)
 {
@@ -41,12 +43,24 @@ DDM::Mesh::Mesh(const std::string& filePath)
 	m_pVertexBuffer = std::make_unique<Buffer<Vertex>>(vertices);
 }
 
+DDM::Mesh::Mesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	m_pIndexBuffer = std::make_unique<Buffer<uint32_t>>(indices);
+	m_pVertexBuffer = std::make_unique<Buffer<Vertex>>(vertices);
+}
+
 DDM::Mesh::~Mesh()
 {
 	
 }
 
 void DDM::Mesh::Render(PipelineWrapper* pPipeline, VkDescriptorSet* descriptorSet)
+{
+	// A regular render is a single instance without instance data
+	RenderInstanced(pPipeline, descriptorSet, VK_NULL_HANDLE, 1);
+}
+
+void DDM::Mesh::RenderInstanced(PipelineWrapper* pPipeline, VkDescriptorSet* descriptorSet, VkBuffer instanceBuffer, uint32_t instanceCount)
 {
 	// Get current commandbuffer
 	auto commandBuffer{ VulkanObject::GetInstance().GetCurrentCommandBuffer() };
@@ -55,22 +69,39 @@ void DDM::Mesh::Render(PipelineWrapper* pPipeline, VkDescriptorSet* descriptorSe
 	{
 		// Bind pipeline
 		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->GetPipeline());
+		RenderCounters::Add(RenderCounter::PipelineBinds);
 	}
 
 	// Set and bind vertex buffer
 	VkBuffer vertexBuffers[] = { m_pVertexBuffer->GetBuffer()};
 	VkDeviceSize offsets[] = { 0 };
 	vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+	RenderCounters::Add(RenderCounter::VertexBufferBinds);
+
+	if (instanceBuffer != VK_NULL_HANDLE)
+	{
+		// Bind instance buffer
+		vkCmdBindVertexBuffers(commandBuffer, InstanceData::kBinding, 1, &instanceBuffer, offsets);
+		RenderCounters::Add(RenderCounter::VertexBufferBinds);
+	}
 
 	// Bind index buffer
 	vkCmdBindIndexBuffer(commandBuffer, m_pIndexBuffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+	RenderCounters::Add(RenderCounter::IndexBufferBinds);
 
 	if (pPipeline != nullptr && descriptorSet != nullptr)
 	{
 		// Bind descriptor sets
 		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pPipeline->GetPipelineLayout(), 0, 1, descriptorSet, 0, nullptr);
+		RenderCounters::Add(RenderCounter::DescriptorSetBinds);
 	}
 
+	const uint32_t indexCount{ static_cast<uint32_t>(m_pIndexBuffer->GetDataCount()) };
+
 	// Draw
-	vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(m_pIndexBuffer->GetDataCount()), 1, 0, 0, 0);
+	vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, 0, 0, 0);
+
+	RenderCounters::Add(RenderCounter::DrawCalls);
+	RenderCounters::Add(RenderCounter::Instances, instanceCount);
+	RenderCounters::Add(RenderCounter::Indices, static_cast<uint64_t>(indexCount) * instanceCount);
 }
@@ -49,6 +49,15 @@ namespace DDM
 		/// <param name="descriptorSet: ">Descriptorsets to bind before drawing</param>
 		void Render(PipelineWrapper* pPipeline, VkDescriptorSet* descriptorSet);
 
+		/// <summary>
+		/// Render the model multiple times in one draw call
+		/// </summary>
+		/// <param name="pPipeline: ">Pointer to the pipeline used for drawing, should read instance data</param>
+		/// <param name="descriptorSet: ">Descriptorsets to bind before drawing</param>
+		/// <param name="instanceBuffer: ">Buffer holding one InstanceData per instance, VK_NULL_HANDLE to bind none</param>
+		/// <param name="instanceCount: ">Amount of instances to draw</param>
+		void RenderInstanced(PipelineWrapper* pPipeline, VkDescriptorSet* descriptorSet, VkBuffer instanceBuffer, uint32_t instanceCount);
+
 		/// <summary>
 		/// Query wether object is transparant
 		/// </summary>
@@ -70,6 +79,13 @@ namespace DDM
 		/// <param name="filePath: ">Filepath to the 3D model file</param>
 		Mesh(const std::string& filePath);
 
+		/// <summary>
+		/// Constructor
+		/// </summary>
+		/// <param name="vertices: ">Vertices of a model that was loaded already</param>
+		/// <param name="indices: ">Indices of a model that was loaded already</param>
+		Mesh(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
 		// Indicates wether 
 		bool m_IsTransparant{ false };
 		
@@ -69,6 +69,9 @@ void DDM::PipelineWrapper::CreatePipeline(VkDevice device, VkRenderPass renderPa
 
 	int index{};
 
+	// Instanced shaders read per instance data from a second vertex binding
+	bool readsInstanceData{ false };
+
 	// Loop trough the file paths and create a shader module for it
 	for (auto& filePath : filePaths)
 	{
@@ -79,6 +82,10 @@ void DDM::PipelineWrapper::CreatePipeline(VkDevice device, VkRenderPass renderPa
 			// If the shader stage is a fragment shader, increase the attachment count
 			attachmentCount = shaderModuleWrappers[index]->GetOutputAmount();
 		}
+		else if (shaderModuleWrappers[index]->GetShaderStage() == VK_SHADER_STAGE_VERTEX_BIT)
+		{
+			readsInstanceData = shaderModuleWrappers[index]->HasInputLocation(InstanceData::kFirstLocation);
+		}
 
 		index++;
 	}
@@ -100,14 +107,23 @@ void DDM::PipelineWrapper::CreatePipeline(VkDevice device, VkRenderPass renderPa
 	}
 
 	// Get the binding description for the vertex
-	auto bindingDescription = Vertex::getBindingDescription();
+	std::vector<VkVertexInputBindingDescription> bindingDescriptions{ Vertex::getBindingDescription() };
 	// Get the attribute description for the vertex
 	auto attributeDescription = Vertex::getAttributeDescription();
 
+	// Add the per instance binding and its attributes
+	if (readsInstanceData)
+	{
+		bindingDescriptions.push_back(InstanceData::getBindingDescription());
+
+		auto instanceAttributes{ InstanceData::getAttributeDescription() };
+		attributeDescription.insert(attributeDescription.end(), instanceAttributes.begin(), instanceAttributes.end());
+	}
+
 	// Create vertex input info
 	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 	// Setup vertex input info
-	SetupVertexInputState(vertexInputInfo, &bindingDescription, attributeDescription);
+	SetupVertexInputState(vertexInputInfo, bindingDescriptions, attributeDescription);
 
 	// Create input assembly state create info
 	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
@@ -278,14 +294,14 @@ void DDM::PipelineWrapper::CreateDescriptorSetLayout(VkDevice device, std::vecto
 	}
 }
 
-void DDM::PipelineWrapper::SetupVertexInputState(VkPipelineVertexInputStateCreateInfo& vertexInputInfo, VkVertexInputBindingDescription* bindingDescription, std::vector<VkVertexInputAttributeDescription>& attributeDescriptions)
+void DDM::PipelineWrapper::SetupVertexInputState(VkPipelineVertexInputStateCreateInfo& vertexInputInfo, std::vector<VkVertexInputBindingDescription>& bindingDescriptions, std::vector<VkVertexInputAttributeDescription>& attributeDescriptions)
 {
 	// Set type to pipeline vertex input state create info
 	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	// Set binding descriptorcount to 1
-	vertexInputInfo.vertexBindingDescriptionCount = 1;
-	// Give the correct binding description
-	vertexInputInfo.pVertexBindingDescriptions = bindingDescription;
+	// Set binding description count to the size of the bindingDescriptions array
+	vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+	// Give the data of the bindingDescriptions array
+	vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 	// Set binding of attribute description count to the size of the attributeDescription array
 	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
 	// Give the data of the attributeDescriptions arry
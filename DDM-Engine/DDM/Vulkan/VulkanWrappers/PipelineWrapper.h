@@ -90,8 +90,10 @@ namespace DDM
 		// Set up vertex input state create info
 		// Parameters:
 		//     vertexInputStateInfo: a reference to the vertex input state create info to avoid creating a new one in the function
+		//     bindingDescriptions: the vertex buffer bindings
+		//     attributeDescriptions: the attributes of all bindings
 		void SetupVertexInputState(VkPipelineVertexInputStateCreateInfo& vertexInputInfo,
-			VkVertexInputBindingDescription* bindingDescription,
+			std::vector<VkVertexInputBindingDescription>& bindingDescriptions,
 			std::vector<VkVertexInputAttributeDescription>& attributeDescriptions);
 
 		// Set up the rasterizer
@@ -6,10 +6,20 @@
 // File includes
 #include "Vulkan/VulkanObject.h"
 
+// Standard library includes
+#include <algorithm>
+#include <bit>
 
-DDM::QueryPool::QueryPool(int queryCount, VkQueryType queryType)
-	:m_QueryCount{queryCount}, m_QueryType{queryType}
+
+DDM::QueryPool::QueryPool(int queryCount, VkQueryType queryType, VkQueryPipelineStatisticFlags pipelineStatistics)
+	:m_QueryCount{queryCount}, m_QueryType{queryType}, m_PipelineStatistics{pipelineStatistics}
 {
+	// A pipeline statistics query returns a value for every enabled statistic
+	if (m_QueryType == VK_QUERY_TYPE_PIPELINE_STATISTICS)
+	{
+		m_ValuesPerQuery = std::popcount(m_PipelineStatistics);
+	}
+
 	// Query query pool
 	SetupQueryPool();
 
@@ -35,85 +45,148 @@ void DDM::QueryPool::ResetPool()
 	m_QueryMessages.reserve(m_QueryCount);
 }
 
-void DDM::QueryPool::WriteTimeStamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage)
+void DDM::QueryPool::ResetPool(VkCommandBuffer commandBuffer)
+{
+	// Record the reset, the queries are unavailable until the command buffer executes
+	vkCmdResetQueryPool(commandBuffer, m_QueryPool, 0, m_QueryCount);
+
+	// Reset current query
+	m_CurrentQuery = 0;
+
+	// Reset query messages list
+	m_QueryMessages.clear();
+}
+
+int DDM::QueryPool::WriteTimeStamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage)
 {
 	// Only write timestamp if query type is correct and current query is lower than querycount
 	if (m_QueryType == VK_QUERY_TYPE_TIMESTAMP && m_CurrentQuery < m_QueryCount)
 	{
 		// Write timestamp and increase current query
 		vkCmdWriteTimestamp(commandBuffer, pipelineStage, m_QueryPool, m_CurrentQuery);
-		++m_CurrentQuery;
+		return m_CurrentQuery++;
 	}
+
+	return -1;
 }
 
-void DDM::QueryPool::PrintTimestamps()
+int DDM::QueryPool::BeginQuery(VkCommandBuffer commandBuffer)
 {
-	// Only print if query type is correct
-	if (m_QueryType == VK_QUERY_TYPE_TIMESTAMP)
+	// Timestamps are written, not begun
+	if (m_QueryType == VK_QUERY_TYPE_TIMESTAMP || m_CurrentQuery >= m_QueryCount)
+	{
+		return -1;
+	}
+
+	vkCmdBeginQuery(commandBuffer, m_QueryPool, m_CurrentQuery, 0);
+	return m_CurrentQuery++;
+}
+
+void DDM::QueryPool::EndQuery(VkCommandBuffer commandBuffer, int query)
+{
+	if (query >= 0)
+	{
+		vkCmdEndQuery(commandBuffer, m_QueryPool, query);
+	}
+}
+
+bool DDM::QueryPool::GetResults(std::vector<uint64_t>& results)
+{
+	results.clear();
+
+	if (m_CurrentQuery == 0)
 	{
-		vkQueueWaitIdle(VulkanObject::GetInstance().GetQueueObject().graphicsQueue);
+		return false;
+	}
 
-		// Create vector of timestamps of size querycount
-		std::vector<uint64_t> timeStamps(m_QueryCount * 2);
+	// The values of every query are followed by its availability value
+	const size_t stride{ static_cast<size_t>(m_ValuesPerQuery) + 1 };
+	m_ResultData.resize(static_cast<size_t>(m_CurrentQuery) * stride);
+
+	// Query pool results without the wait bit, so this never stalls on the gpu
+	VkResult result = vkGetQueryPoolResults(
+		VulkanObject::GetInstance().GetDevice(),
+		m_QueryPool,
+		0,
+		m_CurrentQuery,
+		sizeof(uint64_t) * m_ResultData.size(),
+		m_ResultData.data(),
+		sizeof(uint64_t) * stride,
+		VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+	);
+
+	if (result != VK_SUCCESS && result != VK_NOT_READY)
+	{
+		return false;
+	}
 
-		// Query pool results
-		vkGetQueryPoolResults(
-			VulkanObject::GetInstance().GetDevice(),
-			m_QueryPool,
-			0,
-			m_QueryCount,
-			sizeof(uint64_t) * timeStamps.size(),
-			timeStamps.data(),
-			sizeof(uint64_t) * 2,
-			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
-		);
+	results.resize(static_cast<size_t>(m_CurrentQuery) * m_ValuesPerQuery);
 
-		auto physicalDevice = VulkanObject::GetInstance().GetPhysicalDevice();
+	bool allAvailable{ true };
 
-		VkPhysicalDeviceProperties deviceProperties{};
-		vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+	for (size_t query{}; query < static_cast<size_t>(m_CurrentQuery); ++query)
+	{
+		const uint64_t* pQueryData{ m_ResultData.data() + query * stride };
 
-		float timestampPeriod = deviceProperties.limits.timestampPeriod;
+		std::copy(pQueryData, pQueryData + m_ValuesPerQuery, results.begin() + query * m_ValuesPerQuery);
 
-		// Loop trough timestamps and print them
-		for (uint64_t index{}; index < timeStamps.size() - 2; index += 2)
+		if (pQueryData[m_ValuesPerQuery] == 0)
 		{
-			uint64_t rawTimeStamp = timeStamps[index];
-			double timestampNs = rawTimeStamp * timestampPeriod;
+			allAvailable = false;
+		}
+	}
 
-			uint64_t avail = timeStamps[index + 1];
+	return allAvailable;
+}
 
-			if (avail == 0)
-			{
-				continue;
-			}
+void DDM::QueryPool::PrintTimestamps()
+{
+	// Only print if query type is correct
+	if (m_QueryType != VK_QUERY_TYPE_TIMESTAMP)
+	{
+		return;
+	}
+
+	// Timestamps that are still in flight are not printed, call this after the fence of the frame was waited on
+	std::vector<uint64_t> timeStamps{};
+	if (!GetResults(timeStamps))
+	{
+		std::cout << "Timestamps are not available yet" << std::endl;
+		return;
+	}
 
-			if (index > 0)
-			{
-				uint64_t rawTimeStamp2 = timeStamps[index - 2];
-				double timestampNs2 = rawTimeStamp2 * timestampPeriod;
+	auto physicalDevice = VulkanObject::GetInstance().GetPhysicalDevice();
 
-				double deltaTime = static_cast<double>(rawTimeStamp - rawTimeStamp2);
-				deltaTime *= timestampPeriod;
+	VkPhysicalDeviceProperties deviceProperties{};
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
 
-				std::cout << "DeltaTime: " << deltaTime << " nanoseconds" << std::endl;
-			}
+	double timestampPeriod = deviceProperties.limits.timestampPeriod;
 
-			std::string message{};
+	// Loop trough timestamps and print them
+	for (size_t index{}; index < timeStamps.size(); ++index)
+	{
+		double timestampNs = static_cast<double>(timeStamps[index]) * timestampPeriod;
 
-			if (m_QueryMessages.size() > index / 2)
-			{
-				message = m_QueryMessages[index / 2];
-			}
-			else
-			{
-				message = "Timestamp " + std::to_string(index / 2) + ": ";
-			}
+		if (index > 0)
+		{
+			double deltaTime = static_cast<double>(timeStamps[index] - timeStamps[index - 1]);
+			deltaTime *= timestampPeriod;
 
-			std::cout << message << timestampNs << " nanoseconds" << std::endl;
+			std::cout << "DeltaTime: " << deltaTime << " nanoseconds" << std::endl;
+		}
 
+		std::string message{};
 
+		if (m_QueryMessages.size() > index)
+		{
+			message = m_QueryMessages[index];
 		}
+		else
+		{
+			message = "Timestamp " + std::to_string(index) + ": ";
+		}
+
+		std::cout << message << timestampNs << " nanoseconds" << std::endl;
 	}
 }
 
@@ -131,6 +204,7 @@ void DDM::QueryPool::SetupQueryPool()
 	createInfo.flags = 0;
 	createInfo.queryType = m_QueryType;
 	createInfo.queryCount = m_QueryCount;
+	createInfo.pipelineStatistics = m_PipelineStatistics;
 
 	// Create query pool
 	vkCreateQueryPool(VulkanObject::GetInstance().GetDevice(), &createInfo, nullptr, &m_QueryPool);
@@ -24,7 +24,8 @@ namespace DDM
 		/// </summary>
 		/// <param name="queryCount: ">Amount of possible queries, default: 64</param>
 		/// <param name="queryType: ">Vulkan type of queries, default: VK_QUERY_TYPE_TIMESTAMP</param>
-		QueryPool(int queryCount = 64, VkQueryType queryType = VK_QUERY_TYPE_TIMESTAMP);
+		/// <param name="pipelineStatistics: ">Statistics every query counts when the type is VK_QUERY_TYPE_PIPELINE_STATISTICS, default: none</param>
+		QueryPool(int queryCount = 64, VkQueryType queryType = VK_QUERY_TYPE_TIMESTAMP, VkQueryPipelineStatisticFlags pipelineStatistics = 0);
 
 		// Destructor
 		~QueryPool();
@@ -37,19 +38,59 @@ namespace DDM
 		QueryPool& operator=(QueryPool&&) = delete;
 
 		/// <summary>
-		/// Reset the query pool
+		/// Reset the query pool from the host
 		/// </summary>
 		void ResetPool();
 
+		/// <summary>
+		/// Reset the query pool inside a command buffer, has to be recorded outside of a render pass
+		/// </summary>
+		/// <param name="commandBuffer: ">Current commandbuffer to record the reset in</param>
+		void ResetPool(VkCommandBuffer commandBuffer);
+
 		/// <summary>
 		/// Write a timestamp
 		/// </summary>
 		/// <param name="commandBuffer: ">Current commandbuffer to write timestamp to</param>
 		/// <param name="pipelineStage: ">Vulkan pipeline stage to put timestamp in, default: TOP_OF_PIPE</param>
-		void WriteTimeStamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+		/// <returns>Index of the written query, -1 if the pool is full</returns>
+		int WriteTimeStamp(VkCommandBuffer commandBuffer, VkPipelineStageFlagBits pipelineStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+
+		/// <summary>
+		/// Begin a query that is not a timestamp, only one query of a pool can be active at a time
+		/// </summary>
+		/// <param name="commandBuffer: ">Current commandbuffer to begin the query in</param>
+		/// <returns>Index of the started query, -1 if the pool is full</returns>
+		int BeginQuery(VkCommandBuffer commandBuffer);
 
 		/// <summary>
-		/// Print the timestamps written to the querypool
+		/// End a query started with BeginQuery, in the same subpass it was started in
+		/// </summary>
+		/// <param name="commandBuffer: ">Current commandbuffer to end the query in</param>
+		/// <param name="query: ">Index returned by BeginQuery</param>
+		void EndQuery(VkCommandBuffer commandBuffer, int query);
+
+		/// <summary>
+		/// Read the results of the written queries without waiting for the gpu
+		/// </summary>
+		/// <param name="results: ">Reference to the vector that receives GetValuesPerQuery() values per written query</param>
+		/// <returns>True if every written query was available</returns>
+		bool GetResults(std::vector<uint64_t>& results);
+
+		/// <summary>
+		/// Get the amount of queries written since the last reset
+		/// </summary>
+		/// <returns>Amount of written queries</returns>
+		int GetWrittenQueryCount() const { return m_CurrentQuery; }
+
+		/// <summary>
+		/// Get the amount of values every query returns, one per statistic for pipeline statistics queries
+		/// </summary>
+		/// <returns>Amount of values per query</returns>
+		int GetValuesPerQuery() const { return m_ValuesPerQuery; }
+
+		/// <summary>
+		/// Print the timestamps written to the querypool that are already available
 		/// </summary>
 		void PrintTimestamps();
 
@@ -69,8 +110,17 @@ namespace DDM
 		const int m_QueryCount{};
 		const VkQueryType m_QueryType{};
 
+		// Statistics counted by pipeline statistics queries
+		const VkQueryPipelineStatisticFlags m_PipelineStatistics{};
+
+		// Amount of values every query returns
+		int m_ValuesPerQuery{ 1 };
+
 		std::vector<std::string> m_QueryMessages{};
 
+		// Raw results with availability, kept to avoid an allocation on every read
+		std::vector<uint64_t> m_ResultData{};
+
 		/// <summary>
 		/// Querypool creation function
 		/// </summary>
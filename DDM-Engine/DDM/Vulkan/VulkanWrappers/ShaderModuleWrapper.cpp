@@ -141,6 +141,14 @@ bool DDM::ShaderModuleWrapper::ShouldEnableBlend(int index) const
 	return true;
 }
 
+bool DDM::ShaderModuleWrapper::HasInputLocation(uint32_t location) const
+{
+	SpvReflectResult result{};
+	auto pVariable{ spvReflectGetInputVariableByLocation(&m_ReflectShaderModule, location, &result) };
+
+	return result == SPV_REFLECT_RESULT_SUCCESS && pVariable != nullptr;
+}
+
 void DDM::ShaderModuleWrapper::CreateShaderModule(VkDevice device)
 {
 	// Create modlue create info
@@ -60,6 +60,11 @@ namespace DDM
 
 		bool ShouldEnableBlend(int index) const;
 
+		// Check if the shader reads an input variable at a location
+		// Parameters:
+		//     location: the location of the input variable
+		bool HasInputLocation(uint32_t location) const;
+
 	private:
 		// The binary code from the shader
 		std::vector<char> m_ShaderCode{};
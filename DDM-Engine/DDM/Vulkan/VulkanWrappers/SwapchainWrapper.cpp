@@ -4,6 +4,7 @@
 #include "SwapchainWrapper.h"
 
 // File includes
+#include "Engine/FramePacer.h"
 #include "Engine/Window.h"
 
 #include "GPUObject.h"
@@ -20,12 +21,23 @@
 // Standard library includes
 #include <stdexcept>
 #include <algorithm>
+#include <array>
 
 DDM::SwapchainWrapper::SwapchainWrapper(GPUObject* pGPUObject, VkSurfaceKHR surface,
 	DDM::ImageManager* pImageManager, VkSampleCountFlagBits msaaSamples)
 {
+	// Without a surface, render to offscreen images
+	m_Offscreen = surface == VK_NULL_HANDLE;
+
 	// Initialize the swapchain
-	CreateSwapChain(pGPUObject, surface);
+	if (m_Offscreen)
+	{
+		CreateOffscreenImages(pImageManager);
+	}
+	else
+	{
+		CreateSwapChain(pGPUObject, surface);
+	}
 	// Initialize the image views
 	CreateSwapchainImageViews(pGPUObject->GetDevice(), pImageManager);
 }
@@ -83,7 +95,14 @@ void DDM::SwapchainWrapper::SetupSwapchain(GPUObject* pGPUObject, VkSurfaceKHR s
 	DDM::ImageManager* pImageManager, VkCommandBuffer commandBuffer, std::vector<RenderpassWrapper*>& renderpasses)
 {
 	// Initalize the swapchain
-	CreateSwapChain(pGPUObject, surface);
+	if (m_Offscreen)
+	{
+		CreateOffscreenImages(pImageManager);
+	}
+	else
+	{
+		CreateSwapChain(pGPUObject, surface);
+	}
 	// Initialize swapchain image views
 	CreateSwapchainImageViews(pGPUObject->GetDevice(), pImageManager);
 	// Setup color and depth resources
@@ -207,6 +226,83 @@ void DDM::SwapchainWrapper::CreateSwapChain(GPUObject* pGPUObject, VkSurfaceKHR
 	}
 }
 
+void DDM::SwapchainWrapper::CreateOffscreenImages(DDM::ImageManager* pImageManager)
+{
+	// Get a reference to the window struct, the offscreen images are the size of the window in the config file
+	auto& windowStruct{ Window::GetInstance().GetWindowStruct() };
+
+	// There is no surface to ask, use the format and image count a swapchain would usually get
+	m_SwapChainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+	m_SwapChainExtent = { static_cast<uint32_t>(windowStruct.Width), static_cast<uint32_t>(windowStruct.Height) };
+	m_MinImageCount = kOffscreenImageCount - 1;
+	m_ImageAmount = kOffscreenImageCount;
+	m_NextOffscreenImage = 0;
+
+	m_pSwapchainImages.resize(m_ImageAmount);
+
+	for (auto& pImage : m_pSwapchainImages)
+	{
+		// The images own their memory, so they are freed when the last reference is released
+		pImage = std::make_shared<Image>();
+
+		// Transfer source so the result can be copied for inspection
+		pImageManager->CreateImage(m_SwapChainExtent.width, m_SwapChainExtent.height, 1, VK_SAMPLE_COUNT_1_BIT, m_SwapChainImageFormat,
+			VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, pImage.get());
+	}
+}
+
+VkResult DDM::SwapchainWrapper::AcquireNextImage(VkDevice device, VkQueue queue, VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex)
+{
+	if (!m_Offscreen)
+	{
+		return vkAcquireNextImageKHR(device, m_SwapChain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+	}
+
+	// Offscreen images are used in order, the in flight fence already guarantees the image is no longer in use
+	imageIndex = m_NextOffscreenImage;
+	m_NextOffscreenImage = (m_NextOffscreenImage + 1) % m_ImageAmount;
+
+	// Signal the semaphore with an empty submit, so the renderers can wait on it like on a swapchain image
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &imageAvailableSemaphore;
+
+	return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
+VkResult DDM::SwapchainWrapper::Present(VkQueue queue, VkSemaphore renderFinishedSemaphore, uint32_t imageIndex)
+{
+	if (!m_Offscreen)
+	{
+		VkPresentInfoKHR presentInfo{};
+		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+
+		presentInfo.waitSemaphoreCount = 1;
+		presentInfo.pWaitSemaphores = &renderFinishedSemaphore;
+
+		presentInfo.swapchainCount = 1;
+		presentInfo.pSwapchains = &m_SwapChain;
+		presentInfo.pImageIndices = &imageIndex;
+
+		presentInfo.pResults = nullptr;
+
+		return vkQueuePresentKHR(queue, &presentInfo);
+	}
+
+	// Nothing is shown, but the semaphore still has to be waited on before it is signaled again
+	VkPipelineStageFlags waitStage{ VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.pWaitSemaphores = &renderFinishedSemaphore;
+	submitInfo.pWaitDstStageMask = &waitStage;
+
+	return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
 void DDM::SwapchainWrapper::CreateSwapchainImageViews(VkDevice device, DDM::ImageManager* pImageManager)
 {
 	// Loop trough the amount of images
@@ -219,14 +315,19 @@ void DDM::SwapchainWrapper::CreateSwapchainImageViews(VkDevice device, DDM::Imag
 
 void DDM::SwapchainWrapper::Cleanup(VkDevice device)
 {
-	for (auto& swapchainImage : m_pSwapchainImages)
+	// Offscreen images own their views and destroy them themselves
+	if (!m_Offscreen)
 	{
-		vkDestroyImageView(device, swapchainImage->GetImageView(), nullptr);
+		for (auto& swapchainImage : m_pSwapchainImages)
+		{
+			vkDestroyImageView(device, swapchainImage->GetImageView(), nullptr);
+		}
 	}
 
 	m_pSwapchainImages.clear();
 	// Destroy the swapchain
 	vkDestroySwapchainKHR(device, m_SwapChain, nullptr);
+	m_SwapChain = VK_NULL_HANDLE;
 }
 
 void DDM::SwapchainWrapper::RecreateSwapChain(GPUObject* pGPUObject, VkSurfaceKHR surface,
@@ -316,16 +417,32 @@ VkSurfaceFormatKHR DDM::SwapchainWrapper::ChooseSwapSurfaceFormat(const std::vec
 
 VkPresentModeKHR DDM::SwapchainWrapper::ChooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
 {
-	// Loop trough the available presentModes
-	for (const auto& availablePresentMode : availablePresentModes)
+	auto& framePacer{ FramePacer::GetInstance() };
+
+	// Remember the request, the swapchain is recreated when a different mode is requested
+	m_RequestedPresentMode = framePacer.GetPresentMode();
+
+	constexpr std::array<VkPresentModeKHR, static_cast<size_t>(PresentMode::Count)> vulkanPresentModes
 	{
-		// If current presentmode is mailbox, return it
-		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-		{
-			return availablePresentMode;
-		}
+		VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR
+	};
+
+	const VkPresentModeKHR requestedPresentMode{ vulkanPresentModes[static_cast<size_t>(m_RequestedPresentMode)] };
+
+	// If the requested presentmode is available, return it
+	if (std::find(availablePresentModes.begin(), availablePresentModes.end(), requestedPresentMode) != availablePresentModes.end())
+	{
+		framePacer.SetActivePresentMode(m_RequestedPresentMode);
+		return requestedPresentMode;
 	}
 
-	// If no suitable format was found, return fifo mode
+	// If the requested presentmode isn't available, return fifo mode, which is always supported
+	framePacer.SetActivePresentMode(PresentMode::Fifo);
 	return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+bool DDM::SwapchainWrapper::NeedsRecreation() const
+{
+	// Offscreen images don't have a present mode
+	return !m_Offscreen && m_RequestedPresentMode != FramePacer::GetInstance().GetPresentMode();
 }
\ No newline at end of file
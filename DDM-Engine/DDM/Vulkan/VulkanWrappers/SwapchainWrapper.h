@@ -1,10 +1,12 @@
 // SwapchainWrapper.h
 // This class will serve as a wrapper for the vulkan swapchain
+// Without a surface it owns a set of offscreen images instead, so renderers work the same when running headless
 
 #ifndef SwapchainWrapperIncluded
 #define SwapchainWrapperIncluded
 
 // File includes
+#include "Engine/FramePacer.h"
 #include "Includes/VulkanIncludes.h"
 #include "DataTypes/Structs.h"
 
@@ -29,7 +31,7 @@ namespace DDM
 		// Constructor
 		// Parameter:
 		//     pGPUObject: pointer to the GPUObject
-		//     surface: handle of the VkSurfaceKHR
+		//     surface: handle of the VkSurfaceKHR, VK_NULL_HANDLE to render to offscreen images
 		//     pImageManager: pointer to the image manager
 		//     msaaSamples: max amount of samples per pixel
 		SwapchainWrapper(GPUObject* pGPUObject, VkSurfaceKHR surface, DDM::ImageManager* pImageManager, VkSampleCountFlagBits msaaSamples);
@@ -73,6 +75,27 @@ namespace DDM
 		void RecreateSwapChain(GPUObject* pGPUObject, VkSurfaceKHR surface,
 			DDM::ImageManager* pImageManager, VkCommandBuffer commandBuffer, std::vector<RenderpassWrapper*>& renderpasses);
 
+		// Acquire the next image to render to
+		// Parameters:
+		//     device: handle of the VkDevice
+		//     queue: queue used to signal the semaphore when rendering offscreen
+		//     imageAvailableSemaphore: semaphore that is signaled when the image can be rendered to
+		//     imageIndex: reference to the index of the acquired image
+		VkResult AcquireNextImage(VkDevice device, VkQueue queue, VkSemaphore imageAvailableSemaphore, uint32_t& imageIndex);
+
+		// Present a rendered image, when rendering offscreen this only waits for the render to finish
+		// Parameters:
+		//     queue: the present queue
+		//     renderFinishedSemaphore: semaphore that is signaled when rendering is done
+		//     imageIndex: index of the rendered image
+		VkResult Present(VkQueue queue, VkSemaphore renderFinishedSemaphore, uint32_t imageIndex);
+
+		// Check if a different present mode was requested since the swapchain was created
+		bool NeedsRecreation() const;
+
+		// Check if the images are offscreen images instead of swapchain images
+		bool IsOffscreen() const { return m_Offscreen; }
+
 		// Get the swapchain
 		VkSwapchainKHR GetSwapchain() const { return m_SwapChain; }
 
@@ -94,9 +117,21 @@ namespace DDM
 
 		int GetSwapchainImageAmount();
 	private:
+		// Amount of offscreen images, enough to keep every frame in flight busy
+		static constexpr uint32_t kOffscreenImageCount{ 3 };
+
 		// Handle of the swapchaint
 		VkSwapchainKHR m_SwapChain = VK_NULL_HANDLE;
 
+		// Present mode that was requested when the swapchain was created
+		PresentMode m_RequestedPresentMode{};
+
+		// Indicates the images are offscreen images owned by this wrapper
+		bool m_Offscreen{ false };
+
+		// Index of the next offscreen image that will be acquired
+		uint32_t m_NextOffscreenImage{};
+
 		// The minimum amount of images
 		uint32_t m_MinImageCount{};
 
@@ -130,6 +165,11 @@ namespace DDM
 		//     surface: handle of the VkSurfaceKHR
 		void CreateSwapChain(GPUObject* pGPUObject, VkSurfaceKHR surface);
 
+		// Create the offscreen images that replace the swapchain when there is no surface
+		// Parameters:
+		//     pImageManager: pointer to the image manager
+		void CreateOffscreenImages(DDM::ImageManager* pImageManager);
+
 		// Create the color and depth image views
 		// Parameters:
 		//     device: handle of the VkDevice
@@ -10,6 +10,8 @@
 
 #include "DataTypes/Structs.h"
 
+#include "Engine/Window.h"
+
 
 DDM::VulkanCore::VulkanCore()
 {
@@ -18,11 +20,14 @@ DDM::VulkanCore::VulkanCore()
 
 	InstanceWrapper* pInstance = m_pInstance.get();
 
-	// Initialize surface
-	m_pSurface = std::make_unique<DDM::SurfaceWrapper>(pInstance);
+	// Initialize surface, a headless engine has nothing to present to
+	if (!Window::GetInstance().IsHeadless())
+	{
+		m_pSurface = std::make_unique<DDM::SurfaceWrapper>(pInstance);
+	}
 
 	// Initialize gpu object
-	m_pGpuObject = std::make_unique<DDM::GPUObject>(m_pInstance.get(), m_pSurface->GetSurface());
+	m_pGpuObject = std::make_unique<DDM::GPUObject>(m_pInstance.get(), GetSurface());
 	
 }
 
@@ -33,6 +38,10 @@ VkInstance DDM::VulkanCore::GetVulkanInstance()
 
 VkSurfaceKHR DDM::VulkanCore::GetSurface()
 {
+	// Without a surface the renderers render to offscreen images
+	if (m_pSurface == nullptr)
+		return VK_NULL_HANDLE;
+
 	return m_pSurface->GetSurface();
 }
 
@@ -38,7 +38,7 @@ namespace DDM
 		/// <summary>
 		/// Get the Vulkan surface
 		/// </summary>
-		/// <returns>Vulkan surface</returns>
+		/// <returns>Vulkan surface, VK_NULL_HANDLE when running headless</returns>
 		VkSurfaceKHR GetSurface();
 
 		/// <summary>
@@ -0,0 +1,35 @@
+#version 450
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec3 normal;
+layout(location = 4) in vec3 tangent;
+layout(location = 5) in vec4 boneIndices;
+layout(location = 6) in vec4 boneWeights;
+layout(location = 7) in float inUvSetIndex;
+
+// Per instance transformation, takes locations 8 to 11
+layout(location = 8) in mat4 instanceModel;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out float uvSetIndex;
+layout(location = 3) out vec3 fragNormal;
+
+void main()
+{
+    mat4 model = ubo.model * instanceModel;
+
+    gl_Position = ubo.proj * ubo.view * model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+	fragTexCoord = inTexCoord;
+    uvSetIndex = inUvSetIndex;
+	fragNormal = mat3(transpose(inverse(model))) * normal;
+}